@@ -0,0 +1,141 @@
+/** Micro-benchmark of the unitary gain and unitary loss scoring kernels
+ *
+ * Usage: bench_scoring [num_vertices] [tour_size] [repetitions]
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+#include "pctsp/heuristic.hh"
+#include "pctsp/scoring.hh"
+
+using namespace std::chrono;
+
+/** The scalar loop over tour edges that unitaryGainOfVertex used before the kernels */
+ExtensionVertex legacyUnitaryGainOfVertex(
+    PCTSPgraph& g,
+    std::list<PCTSPvertex>& tour,
+    EdgeCostMap& cost_map,
+    VertexPrizeMap& prize_map,
+    PCTSPvertex v
+) {
+    float max_gain = 0.0;
+    int index_of_extension = -1;
+    auto it = tour.begin();
+    PCTSPvertex u = *it;
+    int i = 0;
+    for (++it; it != tour.end(); ++it) {
+        PCTSPvertex w = *it;
+        auto edge_uv = boost::edge(u, v, g);
+        auto edge_vw = boost::edge(v, w, g);
+        auto edge_uw = boost::edge(u, w, g);
+        if (edge_uv.second && edge_vw.second) {
+            float gain = unitaryGain(prize_map[v], cost_map[edge_uw.first], cost_map[edge_uv.first], cost_map[edge_vw.first]);
+            if (gain > max_gain) {
+                max_gain = gain;
+                index_of_extension = i;
+            }
+        }
+        u = w;
+        i++;
+    }
+    return {index_of_extension, max_gain};
+}
+
+template <typename TFunction>
+double timeInMilliseconds(int repetitions, TFunction function) {
+    auto start = steady_clock::now();
+    for (int r = 0; r < repetitions; r++) function();
+    return duration_cast<duration<double, std::milli>>(steady_clock::now() - start).count() / repetitions;
+}
+
+void printRow(std::string name, double milliseconds, double baseline) {
+    std::cout << std::left << std::setw(40) << name
+        << std::right << std::setw(12) << std::fixed << std::setprecision(3) << milliseconds << " ms"
+        << std::setw(10) << std::setprecision(2) << baseline / milliseconds << "x" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::stoi(argv[1]) : 1000;
+    int k = argc > 2 ? std::stoi(argv[2]) : 500;
+    int repetitions = argc > 3 ? std::stoi(argv[3]) : 5;
+    k = std::min(k, n);
+
+    // random complete graph with a tour over the first k vertices
+    std::mt19937 generator (PCTSP_DEFAULT_SEED);
+    std::uniform_int_distribution<int> random_value (1, 100);
+    PCTSPgraph graph (n);
+    for (int u = 0; u < n; u++)
+        for (int v = u + 1; v < n; v++)
+            boost::add_edge(u, v, graph);
+    EdgeCostMap cost_map = boost::get(edge_weight, graph);
+    VertexPrizeMap prize_map = boost::get(vertex_distance, graph);
+    for (auto edge : boost::make_iterator_range(boost::edges(graph))) cost_map[edge] = random_value(generator);
+    for (auto u : boost::make_iterator_range(boost::vertices(graph))) prize_map[u] = random_value(generator);
+    std::list<PCTSPvertex> tour;
+    for (int u = 0; u < k; u++) tour.push_back(u);
+    tour.push_back(0);
+    PCTSPdenseCostMap dense_cost_map (graph, cost_map);
+
+    std::cout << "Scoring " << n - k << " vertices against a tour with " << k << " edges" << std::endl;
+    std::cout << "Best kernel on this CPU: " << bestScoringKernel() << " (1 scalar, 2 SSE4.1, 3 AVX2)" << std::endl << std::endl;
+
+    // end-to-end: the unitary gain of every vertex outside the tour
+    float checksum = 0.0;
+    double baseline = timeInMilliseconds(repetitions, [&]() {
+        for (int v = k; v < n; v++) checksum += legacyUnitaryGainOfVertex(graph, tour, cost_map, prize_map, v).value;
+    });
+    printRow("legacy loop (adjacency list)", baseline, baseline);
+    printRow("unitaryGainOfVertex (adjacency list)", timeInMilliseconds(repetitions, [&]() {
+        for (int v = k; v < n; v++) checksum += unitaryGainOfVertex(graph, tour, cost_map, prize_map, v).value;
+    }), baseline);
+    printRow("unitaryGainOfVertex (dense matrix)", timeInMilliseconds(repetitions, [&]() {
+        for (int v = k; v < n; v++) checksum += unitaryGainOfVertex(graph, tour, dense_cost_map, prize_map, v).value;
+    }), baseline);
+    std::cout << std::endl;
+
+    // kernels only: costs already gathered into contiguous arrays
+    std::vector<std::vector<CostNumberType>> cost_to_tour (n - k, std::vector<CostNumberType>(k + 1));
+    std::vector<int> is_adjacent (k + 1, 1);
+    std::vector<CostNumberType> tour_cost (k);
+    std::vector<PCTSPvertex> path (tour.begin(), tour.end());
+    for (int i = 0; i < k; i++) tour_cost[i] = dense_cost_map.cost(path[i], path[i + 1]);
+    for (int v = k; v < n; v++)
+        for (int i = 0; i <= k; i++) cost_to_tour[v - k][i] = dense_cost_map.cost(v, path[i]);
+
+    std::vector<std::pair<std::string, unsigned int>> kernels = {
+        {"scalar", ScoringKernel::SCALAR}, {"SSE4.1", ScoringKernel::SSE41}, {"AVX2", ScoringKernel::AVX2}
+    };
+    double scalar_gain = 0.0;
+    for (auto& [name, kernel] : kernels) {
+        if (!isScoringKernelSupported(kernel)) continue;
+        double milliseconds = timeInMilliseconds(repetitions * 10, [&]() {
+            for (int v = k; v < n; v++)
+                checksum += argmaxUnitaryGain(prize_map[v], cost_to_tour[v - k].data(), is_adjacent.data(), tour_cost.data(), k, kernel).value;
+        });
+        if (kernel == ScoringKernel::SCALAR) scalar_gain = milliseconds;
+        printRow("argmaxUnitaryGain " + name, milliseconds, scalar_gain);
+    }
+    std::cout << std::endl;
+
+    // unitary loss of n candidate paths
+    std::vector<CostNumberType> external_cost (n);
+    std::vector<PrizeNumberType> external_prize (n);
+    for (int i = 0; i < n; i++) {
+        external_cost[i] = random_value(generator);
+        external_prize[i] = random_value(generator);
+    }
+    double scalar_loss = 0.0;
+    for (auto& [name, kernel] : kernels) {
+        if (!isScoringKernelSupported(kernel)) continue;
+        double milliseconds = timeInMilliseconds(repetitions * 1000, [&]() {
+            checksum += argminUnitaryLoss(external_cost.data(), external_prize.data(), 10, 50, n, kernel).value;
+        });
+        if (kernel == ScoringKernel::SCALAR) scalar_loss = milliseconds;
+        printRow("argminUnitaryLoss " + name, milliseconds, scalar_loss);
+    }
+    std::cout << std::endl << "checksum " << checksum << std::endl;
+    return 0;
+}
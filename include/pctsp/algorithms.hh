@@ -3,16 +3,21 @@
 /** Exact algorithms for PCTSP */
 
 #include <iostream>
+#include <optional>
 #include "scip/message_default.h"
 
 #include "branching.hh"
 #include "constraint.hh"
 #include "cost_cover.hh"
 #include "cycle_cover.hh"
+#include "dual_ascent.hh"
 #include "event_handlers.hh"
 #include "heuristic.hh"
+#include "lagrangian.hh"
 #include "logger.hh"
 #include "preprocessing.hh"
+#include "primal_dual.hh"
+#include "pricing.hh"
 #include "solution.hh"
 #include "stats.hh"
 #include "subtour_elimination.hh"
@@ -29,11 +34,11 @@ getVariableNameFromEdge(std::map<TEdge, SCIP_VAR*>& edge_variable_map,
     return variable_name;
 }
 
-/** Add edge variables to the PCTSP SCIP model */
-template <typename TGraph, typename TCostMap, typename VariableMap>
+/** Add variables of the edges in the range to the PCTSP SCIP model */
+template <typename TGraph, typename TCostMap, typename VariableMap, typename EdgeIt>
 SCIP_RETCODE PCTSPaddEdgeVariables(SCIP* scip, TGraph& graph, TCostMap& cost_map,
-    VariableMap& variable_map) {
-    for (auto edge : make_iterator_range(edges(graph))) {
+    VariableMap& variable_map, EdgeIt first, EdgeIt last) {
+    for (auto edge : make_iterator_range(first, last)) {
         SCIP_VAR* edge_variable;
         CostNumberType cost_of_edge = cost_map[edge];
         SCIP_CALL(SCIPcreateVar(scip, &edge_variable, NULL, 0.0, 1.0,
@@ -48,12 +53,39 @@ SCIP_RETCODE PCTSPaddEdgeVariables(SCIP* scip, TGraph& graph, TCostMap& cost_map
     return SCIP_OKAY;
 }
 
+/** Add edge variables to the PCTSP SCIP model */
+template <typename TGraph, typename TCostMap, typename VariableMap>
+SCIP_RETCODE PCTSPaddEdgeVariables(SCIP* scip, TGraph& graph, TCostMap& cost_map,
+    VariableMap& variable_map) {
+    auto [first, last] = edges(graph);
+    return PCTSPaddEdgeVariables(scip, graph, cost_map, variable_map, first, last);
+}
+
 SCIP_RETCODE addHeuristicVarsToSolver(
     SCIP* scip,
     SCIP_HEUR* heur,
     std::vector<SCIP_VAR*> vars
 );
 
+/** Raise the lower bound of the root node to the lower bound on the total cost of the edges */
+SCIP_RETCODE includeCostLowerBound(SCIP* scip, double lower_bound);
+
+/** Fix the edges and vertices that the Lagrangian bound rules out of every improving tour */
+SCIP_RETCODE fixVariablesWithLagrangianBound(
+    SCIP* scip,
+    PCTSPgraph& graph,
+    std::map<PCTSPedge, SCIP_VAR*>& edge_variable_map,
+    LagrangianBound& bound
+);
+
+/** Fix the self loops of the vertices that dual ascent rules out of every improving tour to zero */
+SCIP_RETCODE fixVerticesEliminatedByDualAscent(
+    SCIP* scip,
+    PCTSPgraph& graph,
+    std::map<PCTSPedge, SCIP_VAR*>& edge_variable_map,
+    DualAscentBound& bound
+);
+
 template <typename TGraph, typename EdgeVariableMap, typename EdgeIt>
 SCIP_RETCODE addHeuristicEdgesToSolver(
     SCIP* scip,
@@ -101,7 +133,10 @@ SCIP_RETCODE addHeuristicTourToSolver(
  * elimiation constraints (SECs).
  *
  * This function sets the objective function, adds the variables,
- * and adds the constraints.
+ * and adds the constraints. If core edges are given, only they get
+ * variables (they must include every self loop) and the degree
+ * constraints are modifiable so that the other edges can be priced.
+ * If degree_conss is given, it maps every vertex to its degree constraint.
  */
 template <typename TGraph, typename TCostMap, typename WeightMap>
 SCIP_RETCODE PCTSPmodelWithoutSECs(
@@ -111,9 +146,15 @@ SCIP_RETCODE PCTSPmodelWithoutSECs(
     WeightMap& weight_map,
     int& quota,
     typename TGraph::vertex_descriptor& root_vertex,
-    std::map<typename TGraph::edge_descriptor, SCIP_VAR*>& variable_map) {
+    std::map<typename TGraph::edge_descriptor, SCIP_VAR*>& variable_map,
+    std::vector<typename TGraph::edge_descriptor> core_edges = std::vector<typename TGraph::edge_descriptor>(),
+    std::map<typename TGraph::vertex_descriptor, SCIP_CONS*>* degree_conss = NULL) {
     // from the graph, create the variables on edges and nodes
-    SCIP_CALL(PCTSPaddEdgeVariables(scip, graph, cost_map, variable_map));
+    bool is_core_only = core_edges.size() > 0;
+    if (is_core_only)
+        SCIP_CALL(PCTSPaddEdgeVariables(scip, graph, cost_map, variable_map, core_edges.begin(), core_edges.end()));
+    else
+        SCIP_CALL(PCTSPaddEdgeVariables(scip, graph, cost_map, variable_map));
     int nvars = SCIPgetNVars(scip);
 
     // add objective function
@@ -134,7 +175,7 @@ SCIP_RETCODE PCTSPmodelWithoutSECs(
 
     // add constraint to ensure a vertex is adjacent to exactly two edges in
     // the tour
-    SCIP_CALL(PCTSPaddDegreeTwoConstraint(scip, graph, variable_map));
+    SCIP_CALL(PCTSPaddDegreeTwoConstraint(scip, graph, variable_map, is_core_only, degree_conss));
 
     return SCIP_OKAY;
 }
@@ -162,6 +203,15 @@ std::vector<std::pair<PCTSPvertex, PCTSPvertex>> solvePrizeCollectingTSP(
     std::string& name
 );
 
+/** Bounds and the number of cuts and nodes of a solved model */
+SummaryStats getSummaryStatsFromSCIP(SCIP* scip);
+
+/**
+ * @brief Solve the prize collecting TSP with branch and cut.
+ *
+ * When dual_ascent is set, the edges that dual ascent eliminates are removed
+ * from graph, so the graph of the caller is modified.
+ */
 std::vector<std::pair<PCTSPvertex, PCTSPvertex>> solvePrizeCollectingTSP(
     SCIP* scip,
     PCTSPgraph& graph,
@@ -184,7 +234,16 @@ std::vector<std::pair<PCTSPvertex, PCTSPvertex>> solvePrizeCollectingTSP(
     int sec_sepafreq = 1,
     bool simple_rules_only = true,
     std::filesystem::path solver_dir = "./pctsp",
-    float time_limit = 14400
+    float time_limit = 14400,
+    bool dual_ascent = false,
+    int pricing_num_neighbors = 0,
+    bool sec_union_find = false,
+    bool sec_manage_rows = false,
+    double node_selection_memory_limit = 0,
+    bool separation_controller = false,
+    int sec_max_cuts_per_round = -1,
+    bool lagrangian_fixing = false,
+    bool sec_shrink_support_graph = false
 );
 
 std::map<PCTSPedge, SCIP_VAR*> modelPrizeCollectingTSP(
@@ -201,9 +260,68 @@ std::map<PCTSPedge, SCIP_VAR*> modelPrizeCollectingTSP(
     bool sec_maxflow_mincut = true,
     int sec_max_tailing_off_iterations = -1,
     int sec_sepafreq = 1,
+    bool simple_rules_only = true,
+    int pricing_num_neighbors = 0
+);
+
+/**
+ * @brief Build the model like the overload above, but fill an edge variable
+ * map owned by the caller. The problem data points to the map, so it must
+ * live as long as the problem, e.g. when the model is kept between solves.
+ */
+SCIP_RETCODE modelPrizeCollectingTSP(
+    SCIP* scip,
+    PCTSPgraph& graph,
+    std::vector<PCTSPedge>& solution_edges,
+    EdgeCostMap& cost_map,
+    VertexPrizeMap& prize_map,
+    PrizeNumberType& quota,
+    PCTSPvertex& root_vertex,
+    PCTSPedgeVariableMap& edge_variable_map,
+    std::string& name,
+    bool sec_disjoint_tour = true,
+    double sec_lp_gap_improvement_threshold = 0.01,
+    bool sec_maxflow_mincut = true,
+    int sec_max_tailing_off_iterations = -1,
+    int sec_sepafreq = 1,
+    bool simple_rules_only = true,
+    int pricing_num_neighbors = 0
+);
+
+/**
+ * @brief Include the plugins of the PCTSP model: branching rules, constraint
+ * handlers (including the SEC handler), node selection, separators and
+ * heuristics. Plugins stay in SCIP after SCIPfreeProb, so include them once
+ * per SCIP instance and create any number of problems afterwards.
+ */
+SCIP_RETCODE includePrizeCollectingTSPPlugins(
+    SCIP* scip,
+    bool sec_disjoint_tour = true,
+    double sec_lp_gap_improvement_threshold = 0.01,
+    bool sec_maxflow_mincut = true,
+    int sec_max_tailing_off_iterations = -1,
+    int sec_sepafreq = 1,
     bool simple_rules_only = true
 );
 
+/**
+ * @brief Create the PCTSP problem in a SCIP instance whose plugins are
+ * included, see includePrizeCollectingTSPPlugins. The problem data points to
+ * the graph, quota, root vertex and edge variable map.
+ */
+SCIP_RETCODE createPrizeCollectingTSPProblem(
+    SCIP* scip,
+    PCTSPgraph& graph,
+    std::vector<PCTSPedge>& heuristic_edges,
+    EdgeCostMap& cost_map,
+    VertexPrizeMap& prize_map,
+    PrizeNumberType& quota,
+    PCTSPvertex& root_vertex,
+    PCTSPedgeVariableMap& edge_variable_map,
+    std::string& name,
+    int pricing_num_neighbors = 0
+);
+
 std::map<PCTSPedge, SCIP_VAR*> modelPrizeCollectingTSP(
     SCIP* scip,
     PCTSPgraph& graph,
@@ -219,7 +337,8 @@ std::map<PCTSPedge, SCIP_VAR*> modelPrizeCollectingTSP(
     bool sec_maxflow_mincut = true,
     int sec_max_tailing_off_iterations = -1,
     int sec_sepafreq = 1,
-    bool simple_rules_only = true
+    bool simple_rules_only = true,
+    int pricing_num_neighbors = 0
 );
 
 #endif
\ No newline at end of file
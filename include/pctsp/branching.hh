@@ -12,6 +12,8 @@ struct BranchingStrategy {
     static const unsigned int STRONG;
     static const unsigned int STRONG_AT_TREE_TOP;
     static const unsigned int DEFAULT;
+    static const unsigned int VERTEX;
+    static const unsigned int CUT_SET;
 };
 
 struct BRANCHING_RULE_NAMES {
@@ -34,6 +36,12 @@ void setStrongBranchingStrategy(SCIP* scip);
 
 void setStrongAtTreeTopBranchingStrategy(SCIP* scip, int strong_branching_max_depth);
 
+/** Branch on vertices with the PCTSP vertex rule, then with reliability pseudo costs */
+void setVertexBranchingStrategy(SCIP* scip);
+
+/** Branch on cut sets when the SEC handler is tailing off, otherwise with reliability pseudo costs */
+void setCutSetBranchingStrategy(SCIP* scip);
+
 void setBranchingStrategy(SCIP* scip, unsigned int strategy, int max_depth);
 
 void setBranchingStrategy(SCIP* scip, unsigned int strategy);
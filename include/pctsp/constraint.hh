@@ -16,6 +16,9 @@ using namespace boost;
 using namespace scip;
 using namespace std;
 
+const std::string DEGREE_TWO_CONS_PREFIX = "degree-two-constraint-";
+const std::string PRIZE_CONS_NAME = "prize-constraint";
+
 template <typename TEdge>
 std::map<const char *, int>
 getVariableNameToWeightMap(std::map<TEdge, SCIP_VAR *> &edge_variable_map,
@@ -48,9 +51,15 @@ SCIP_RETCODE PCTSPaddRootVertexConstraint(SCIP *scip,
     return SCIP_OKAY;
 }
 
+/** Add the degree constraints x(delta(v)) = 2 y_v. Edges without a variable
+ * are left out. If the constraints are modifiable, priced edges can join them.
+ * If degree_conss is given, it maps every vertex to its degree constraint.
+ */
 template <typename TGraph, typename EdgeVariableMap>
 SCIP_RETCODE PCTSPaddDegreeTwoConstraint(SCIP *scip, TGraph &graph,
-                                         EdgeVariableMap &edge_variable_map) {
+                                         EdgeVariableMap &edge_variable_map,
+                                         bool modifiable = false,
+                                         std::map<typename TGraph::vertex_descriptor, SCIP_CONS *> *degree_conss = NULL) {
     // for each vertex in the graph, get the variable that represents the vertex
     // then add a constraint that sets the sum of the variables of the neighbors
     // to be equal to the value of the vertex variable.
@@ -74,7 +83,7 @@ SCIP_RETCODE PCTSPaddDegreeTwoConstraint(SCIP *scip, TGraph &graph,
 
         SCIP_CONS *cons = nullptr;
         std::string cons_name =
-            std::string("degree-two-constraint-") + std::to_string(cons_count);
+            DEGREE_TWO_CONS_PREFIX + std::to_string(cons_count);
         SCIP_VAR *vars[num_neighbors];
         double coefs[num_neighbors];
         vars[0] = variable;
@@ -82,17 +91,21 @@ SCIP_RETCODE PCTSPaddDegreeTwoConstraint(SCIP *scip, TGraph &graph,
         for (auto neighbor :
              make_iterator_range(adjacent_vertices(vertex, graph))) {
             auto adjacent_edge = edge(vertex, neighbor, graph);
-            if (adjacent_edge.first != e.first) {
-                SCIP_VAR *neighbor_var = edge_variable_map[adjacent_edge.first];
-                vars[neighbor_index] = neighbor_var;
+            auto neighbor_var = edge_variable_map.find(adjacent_edge.first);
+            if (adjacent_edge.first != e.first &&
+                neighbor_var != edge_variable_map.end()) {
+                vars[neighbor_index] = neighbor_var->second;
                 coefs[neighbor_index] = 1;
                 neighbor_index++;
             }
         }
         // add the variables to an equality constraint
         SCIP_CALL(SCIPcreateConsBasicLinear(scip, &cons, cons_name.c_str(),
-                                            num_neighbors, vars, coefs, 0, 0));
+                                            neighbor_index, vars, coefs, 0, 0));
+        if (modifiable) SCIP_CALL(SCIPsetConsModifiable(scip, cons, TRUE));
         SCIP_CALL(SCIPaddCons(scip, cons));
+        // the problem keeps the constraint after it is released
+        if (degree_conss != NULL) (*degree_conss)[vertex] = cons;
         // release the constraint
         SCIP_CALL(SCIPreleaseCons(scip, &cons));
 
@@ -121,7 +134,7 @@ SCIP_RETCODE PCTSPaddPrizeConstraint(SCIP *scip, VariableMap &variable_map,
     // SCIP_CALL(SCIPcreateConsBasicLinear(scip, &cons, "prize-constraint", 0,
     // NULL,
     //                                     NULL, -SCIPinfinity(scip), -quota));
-    SCIP_CALL(SCIPcreateConsLinear(scip, &cons, "prize-constraint", 0, NULL,
+    SCIP_CALL(SCIPcreateConsLinear(scip, &cons, PRIZE_CONS_NAME.c_str(), 0, NULL,
                                    NULL, -SCIPinfinity(scip), -quota, TRUE, TRUE,
                                    TRUE, TRUE, TRUE, FALSE, false, FALSE, FALSE,
                                    FALSE));
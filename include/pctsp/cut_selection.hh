@@ -0,0 +1,43 @@
+/** Select the subtour elimination constraints of a separation round */
+
+#ifndef __PCTSP_CUT_SELECTION__
+#define __PCTSP_CUT_SELECTION__
+
+#include <string>
+#include <vector>
+#include <objscip/objscip.h>
+
+#include "graph.hh"
+#include "sciputils.hh"
+
+/** A violated SEC over the vertex set S with target t, or the aggregated SEC over S */
+struct SECCandidate {
+    std::string name;
+    VarVector vars;
+    std::vector<double> coefs;             // the right hand side is zero
+    std::vector<PCTSPvertex> vertex_set;   // sorted
+    PCTSPvertex target;
+    bool aggregated;
+    std::string separator;                 // name of the separator that found the SEC
+    double violation;
+    double efficacy;                       // violation divided by the norm of the coefficients
+};
+
+/** Cosine of the angle between the coefficient vectors of two SECs */
+double cutParallelism(SECCandidate& first, SECCandidate& second);
+
+/**
+ * @brief Indices of at most max_cuts candidates in order of decreasing
+ * efficacy, skipping every candidate whose parallelism with a selected
+ * candidate is larger than max_parallelism.
+ */
+std::vector<std::size_t> selectCuts(std::vector<SECCandidate>& candidates, int max_cuts, double max_parallelism);
+
+/**
+ * @brief The aggregated SEC of the candidates over the same vertex set S
+ * without the root: the sum of the SECs for every target in S divided by |S|,
+ * x(E(S)) <= (|S| - 1) / |S| * y(S). One row stands for every target.
+ */
+SECCandidate aggregateSECs(SCIP* scip, SCIP_SOL* sol, std::vector<SECCandidate*>& candidates);
+
+#endif
@@ -1,52 +1,71 @@
 #ifndef __PCTSP_CYCLE_COVER__
 #define __PCTSP_CYCLE_COVER__
 
+#include <map>
+#include <set>
 #include <boost/graph/connected_components.hpp>
 #include <objscip/objscip.h>
 #include <objscip/objscipdefplugins.h>
 
 #include "data_structures.hh"
 #include "graph.hh"
+#include "pricing.hh"
 #include "sciputils.hh"
 #include "solution.hh"
 
+/** Variables and coefficients of the cycle cover x(E(S)) - y(S) <= -1 over the vertex set */
 template <typename TGraph, typename TVertexIt, typename TEdgeVarMap>
-SCIP_RETCODE addCycleCover(
+void fillCycleCoverVars(
     SCIP* scip,
-    SCIP_CONSHDLR* conshdlr,
     TGraph& graph,
-    TVertexIt& first_vertex_it,
-    TVertexIt& last_vertex_it,
+    TVertexIt first_vertex_it,
+    TVertexIt last_vertex_it,
     TEdgeVarMap& edge_variable_map,
-    SCIP_SOL* sol,
-    SCIP_RESULT* result
+    VarVector& all_vars,
+    std::vector<double>& var_coefs
 ) {
-    // do nothing if there are no vertices to iterate over
-    if (std::distance(first_vertex_it, last_vertex_it) == 0) return SCIP_OKAY;
-
     // get induced edge variables
     auto first_vertex_it_copy1 = first_vertex_it;    // make a copy of the start iterator
     auto induced_edges = getEdgesInducedByVertices(graph, first_vertex_it_copy1, last_vertex_it);
+    induced_edges = filterEdgesWithVariables(induced_edges, edge_variable_map);
     auto edge_var_vector = getEdgeVariables(scip, graph, edge_variable_map, induced_edges);
-    assert (first_vertex_it != first_vertex_it_copy1);
 
     // get vertex variables
     auto first_vertex_it_copy2 = first_vertex_it;    // make a copy of the start iterator
     auto self_loops = getSelfLoops(graph, first_vertex_it_copy2, last_vertex_it);
     auto vertex_var_vector = getEdgeVariables(scip, graph, edge_variable_map, self_loops);
-    assert (first_vertex_it != first_vertex_it_copy2);
 
-    // x(E(S)) <= y(S) - 1
     auto nvars = edge_var_vector.size() + vertex_var_vector.size();
-    VarVector all_vars(nvars);
-    std::vector<double> var_coefs(nvars);
+    all_vars.resize(nvars);
+    var_coefs.resize(nvars);
     fillPositiveNegativeVars(edge_var_vector, vertex_var_vector, all_vars, var_coefs);
+}
+
+template <typename TGraph, typename TVertexIt, typename TEdgeVarMap>
+SCIP_RETCODE addCycleCover(
+    SCIP* scip,
+    SCIP_CONSHDLR* conshdlr,
+    TGraph& graph,
+    TVertexIt& first_vertex_it,
+    TVertexIt& last_vertex_it,
+    TEdgeVarMap& edge_variable_map,
+    SCIP_SOL* sol,
+    SCIP_RESULT* result
+) {
+    // do nothing if there are no vertices to iterate over
+    if (std::distance(first_vertex_it, last_vertex_it) == 0) return SCIP_OKAY;
+
+    // x(E(S)) <= y(S) - 1
+    VarVector all_vars;
+    std::vector<double> var_coefs;
+    fillCycleCoverVars(scip, graph, first_vertex_it, last_vertex_it, edge_variable_map, all_vars, var_coefs);
     double lhs = -SCIPinfinity(scip);
     double rhs = -1;
     std::string name = "CycleCover_" + joinVariableNames(all_vars);
 
     // add constraint/row
-    return addRow(scip, conshdlr, result, sol, all_vars, var_coefs, lhs, rhs, name);
+    std::vector<PCTSPvertex> vertex_set (first_vertex_it, last_vertex_it);
+    return addInducedEdgesRow(scip, conshdlr, result, sol, all_vars, var_coefs, lhs, rhs, name, vertex_set);
 }
 
 SCIP_RETCODE addCycleCover(
@@ -148,6 +167,9 @@ const std::string CYCLE_COVER_DESCRIPTION = "Inequalities are added if a set of
 class CycleCoverConshdlr : public scip::ObjConshdlr {
 private:
     int _num_conss_added;
+    bool keep_cycle_covers;
+    std::set<std::vector<PCTSPvertex>> kept_cycle_covers;
+    std::map<std::vector<PCTSPvertex>, std::string> cycle_covers_in_problem;
 
 public:
     CycleCoverConshdlr(SCIP* scip, const std::string& name, const std::string& description)
@@ -155,6 +177,7 @@ public:
             FALSE, FALSE, TRUE, SCIP_PROPTIMING_BEFORELP, SCIP_PRESOLTIMING_FAST)
     { 
         _num_conss_added = 0;
+        keep_cycle_covers = false;
     }
 
     CycleCoverConshdlr(SCIP* scip)
@@ -164,6 +187,27 @@ public:
     }
 
     unsigned int getNumConssAdded();
+
+    /** Remember the vertex set of every separated cycle cover */
+    void setKeepCycleCovers(bool keep);
+
+    /** Remember the vertex set of a separated cycle cover if cycle covers are kept */
+    void keepCycleCover(std::vector<PCTSPvertex> vertex_set);
+
+    /** Number of kept cycle covers, valid or not */
+    std::size_t getNumKeptCycleCovers();
+
+    /**
+     * @brief Sync the original problem with the kept cycle covers after the
+     * prizes or the quota changed.
+     *
+     * A cycle cover is only valid while the prize of its vertex set is less
+     * than the quota. Valid cycle covers that are not in the original problem
+     * are added as separated linear constraints and cycle covers that are no
+     * longer valid are deleted. Must be called in the problem stage.
+     */
+    SCIP_RETCODE addKeptCycleCoversToProblem(SCIP* scip);
+
     SCIP_DECL_CONSCHECK(scip_check);
     SCIP_DECL_CONSENFOPS(scip_enfops);
     SCIP_DECL_CONSENFOLP(scip_enfolp);
@@ -1,8 +1,10 @@
 #ifndef __PCTSP_DATA_STRUCTURES__
 #define __PCTSP_DATA_STRUCTURES__
 
+#include "dense_graph.hh"
 #include "graph.hh"
 #include <boost/graph/filtered_graph.hpp>
+#include <memory>
 
 /** SCIP user problem data for PCTSP */
 class ProbDataPCTSP : public scip::ObjProbData
@@ -15,6 +17,7 @@ class ProbDataPCTSP : public scip::ObjProbData
     PCTSPgraph* graph_;
     Vertex* root_vertex_;
     EdgeVarLookup* edge_variable_map_;
+    std::unique_ptr<PCTSPdenseCostMap> dense_cost_map_;
 
 public:
     /** default constructor */
@@ -43,6 +46,12 @@ public:
     /** Get the mapping from edges to variables */
     EdgeVarLookup* getEdgeVariableMap();
 
+    /** Get the dense cost matrix of the input graph. NULL unless the graph is complete. */
+    PCTSPdenseCostMap* getDenseCostMap();
+
+    /** Take ownership of the dense cost matrix of the input graph */
+    void setDenseCostMap(std::unique_ptr<PCTSPdenseCostMap> dense_cost_map);
+
 };
 
 template <typename TGraph>
@@ -0,0 +1,254 @@
+/** A dense cost matrix for complete graphs */
+
+#ifndef __PCTSP_DENSE_GRAPH__
+#define __PCTSP_DENSE_GRAPH__
+
+#include <vector>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <boost/range/adaptor/filtered.hpp>
+#include <boost/range/irange.hpp>
+#include <boost/range/iterator_range.hpp>
+
+#include "exception.hh"
+#include "graph.hh"
+#include "walk.hh"
+
+/**
+ * @brief Row-major n x n matrix of the edge costs of a graph.
+ *
+ * Stores the cost and the index of the edge between every pair of vertices,
+ * so the cost, adjacency and descriptor of an edge are found in O(1) without
+ * searching the adjacency list. Functions that take a cost map have overloads
+ * for DenseCostMap that never call boost::edge, so passing a DenseCostMap
+ * as the TCostMap template parameter selects the fast path at compile time.
+ *
+ * Uses O(n^2) memory, so only build it when the graph is complete (see isCompleteGraph).
+ */
+template <typename TGraph>
+class DenseCostMap {
+public:
+    typedef typename boost::graph_traits<TGraph>::vertex_descriptor Vertex;
+    typedef typename boost::graph_traits<TGraph>::edge_descriptor Edge;
+
+    // readable property map interface so the matrix can be used as a weight map
+    typedef Edge key_type;
+    typedef CostNumberType value_type;
+    typedef const CostNumberType& reference;
+    typedef boost::readable_property_map_tag category;
+
+    template <typename TCostMap>
+    DenseCostMap(TGraph& graph, TCostMap& cost_map) : graph_(&graph), n_(boost::num_vertices(graph)) {
+        costs_ = std::vector<CostNumberType>(n_ * n_, 0);
+        edge_index_ = std::vector<int>(n_ * n_, -1);
+        for (auto edge : boost::make_iterator_range(boost::edges(graph))) {
+            auto u = boost::source(edge, graph);
+            auto v = boost::target(edge, graph);
+            int index = edges_.size();
+            edges_.push_back(edge);
+            costs_[u * n_ + v] = cost_map[edge];
+            costs_[v * n_ + u] = cost_map[edge];
+            edge_index_[u * n_ + v] = index;
+            edge_index_[v * n_ + u] = index;
+        }
+    }
+
+    const CostNumberType& operator[](const Edge& edge) const {
+        return costs_[boost::source(edge, *graph_) * n_ + boost::target(edge, *graph_)];
+    }
+
+    /** Cost of the edge between u and v. Zero if there is no such edge. */
+    CostNumberType cost(Vertex u, Vertex v) const {
+        return costs_[u * n_ + v];
+    }
+
+    /** Change the cost of the edge between u and v, e.g. after the cost map was updated */
+    void setCost(Vertex u, Vertex v, CostNumberType cost) {
+        costs_[u * n_ + v] = cost;
+        costs_[v * n_ + u] = cost;
+    }
+
+    bool hasEdge(Vertex u, Vertex v) const {
+        return edge_index_[u * n_ + v] >= 0;
+    }
+
+    /** Descriptor of the edge between u and v. Check hasEdge first. */
+    Edge getEdge(Vertex u, Vertex v) const {
+        return edges_[edge_index_[u * n_ + v]];
+    }
+
+    std::size_t numVertices() const {
+        return n_;
+    }
+
+    /** Every vertex, in the order of the rows of the matrix */
+    boost::integer_range<Vertex> vertices() const {
+        return boost::irange<Vertex>(0, n_);
+    }
+
+private:
+    TGraph* graph_;
+    std::size_t n_;
+    std::vector<CostNumberType> costs_;
+    std::vector<int> edge_index_;
+    std::vector<Edge> edges_;
+};
+
+template <typename TGraph>
+const CostNumberType& get(const DenseCostMap<TGraph>& cost_map, const typename DenseCostMap<TGraph>::Edge& edge) {
+    return cost_map[edge];
+}
+
+/**
+ * @brief True if there is an edge between every pair of distinct vertices.
+ *
+ * Self loops are ignored and the graph is assumed to have no parallel edges.
+ */
+template <typename TGraph>
+bool isCompleteGraph(TGraph& graph) {
+    std::size_t n = boost::num_vertices(graph);
+    std::size_t m = 0;
+    for (auto edge : boost::make_iterator_range(boost::edges(graph))) {
+        if (boost::source(edge, graph) != boost::target(edge, graph)) m++;
+    }
+    return n > 1 && m == n * (n - 1) / 2;
+}
+
+/**
+ * @brief Call the function with a dense cost matrix if the graph is complete,
+ * otherwise call it with the given cost map.
+ *
+ * @param function Generic callable taking the cost map as its only argument
+ */
+template <typename TGraph, typename TCostMap, typename TFunction>
+auto callWithBestCostMap(TGraph& graph, TCostMap& cost_map, TFunction function) {
+    if (isCompleteGraph(graph)) {
+        DenseCostMap<TGraph> dense_cost_map (graph, cost_map);
+        return function(dense_cost_map);
+    }
+    return function(cost_map);
+}
+
+// Edge lookups that are O(1) for dense cost maps
+
+template <typename TGraph, typename TCostMap>
+bool hasEdge(
+    TGraph& graph,
+    TCostMap& /* cost_map */,
+    typename TGraph::vertex_descriptor u,
+    typename TGraph::vertex_descriptor v
+) {
+    return boost::edge(u, v, graph).second;
+}
+
+template <typename TGraph>
+bool hasEdge(
+    TGraph& /* graph */,
+    DenseCostMap<TGraph>& cost_map,
+    typename TGraph::vertex_descriptor u,
+    typename TGraph::vertex_descriptor v
+) {
+    return cost_map.hasEdge(u, v);
+}
+
+template <typename TGraph, typename TCostMap>
+auto adjacentVertices(
+    TGraph& graph,
+    TCostMap& /* cost_map */,
+    typename TGraph::vertex_descriptor u
+) {
+    return boost::make_iterator_range(boost::adjacent_vertices(u, graph));
+}
+
+/**
+ * @brief Get the vertices adjacent to u by scanning the row of u in the matrix.
+ */
+template <typename TGraph>
+auto adjacentVertices(
+    TGraph& /* graph */,
+    DenseCostMap<TGraph>& cost_map,
+    typename TGraph::vertex_descriptor u
+) {
+    return cost_map.vertices() | boost::adaptors::filtered([&cost_map, u](typename TGraph::vertex_descriptor w) {
+        return cost_map.hasEdge(u, w);
+    });
+}
+
+/**
+ * @brief Get the cost of the edge between u and v and whether the edge exists.
+ */
+template <typename TGraph, typename TCostMap>
+std::pair<CostNumberType, bool> costOfVertexPair(
+    TGraph& graph,
+    TCostMap& cost_map,
+    typename TGraph::vertex_descriptor u,
+    typename TGraph::vertex_descriptor v
+) {
+    auto edge = boost::edge(u, v, graph);
+    if (!edge.second) return {0, false};
+    return {cost_map[edge.first], true};
+}
+
+template <typename TGraph>
+std::pair<CostNumberType, bool> costOfVertexPair(
+    TGraph& /* graph */,
+    DenseCostMap<TGraph>& cost_map,
+    typename TGraph::vertex_descriptor u,
+    typename TGraph::vertex_descriptor v
+) {
+    return {cost_map.cost(u, v), cost_map.hasEdge(u, v)};
+}
+
+template <typename TGraph, typename TVertexIt>
+CostNumberType totalCost(
+    TGraph& /* graph */,
+    TVertexIt& first_vertex_it,
+    TVertexIt& last_vertex_it,
+    DenseCostMap<TGraph>& cost_map
+) {
+    CostNumberType cost = 0;
+    if (first_vertex_it == last_vertex_it) return cost;
+    auto prev_vertex = *first_vertex_it;
+    for (auto it = std::next(first_vertex_it); it != last_vertex_it; it++) {
+        if (!cost_map.hasEdge(prev_vertex, *it)) {
+            throw EdgeNotFoundException(std::to_string(prev_vertex), std::to_string(*it));
+        }
+        cost += cost_map.cost(prev_vertex, *it);
+        prev_vertex = *it;
+    }
+    return cost;
+}
+
+template <typename TGraph, typename TVertexIt>
+std::vector<typename TGraph::edge_descriptor> getEdgesInducedByVertices(
+    TGraph& /* graph */,
+    DenseCostMap<TGraph>& cost_map,
+    TVertexIt& first_vertex_it,
+    TVertexIt& last_vertex_it
+) {
+    typedef typename TGraph::edge_descriptor TEdge;
+    std::vector<TEdge> edges;
+    for (; first_vertex_it != last_vertex_it; first_vertex_it++) {
+        for (auto it = std::next(first_vertex_it); it != last_vertex_it; it++) {
+            if (cost_map.hasEdge(*first_vertex_it, *it)) {
+                edges.push_back(cost_map.getEdge(*first_vertex_it, *it));
+            }
+        }
+    }
+    return edges;
+}
+
+template <typename TGraph>
+std::vector<typename TGraph::edge_descriptor> getEdgesInducedByVertices(
+    TGraph& graph,
+    DenseCostMap<TGraph>& cost_map,
+    std::vector<typename TGraph::vertex_descriptor>& vertices
+) {
+    auto first = vertices.begin();
+    auto last = vertices.end();
+    return getEdgesInducedByVertices(graph, cost_map, first, last);
+}
+
+typedef DenseCostMap<PCTSPgraph> PCTSPdenseCostMap;
+
+#endif
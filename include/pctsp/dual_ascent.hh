@@ -0,0 +1,114 @@
+/** Dual ascent lower bound and edge elimination for the prize collecting TSP */
+
+#ifndef __PCTSP_DUAL_ASCENT__
+#define __PCTSP_DUAL_ASCENT__
+
+#include <vector>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/range/iterator_range.hpp>
+
+const int DUAL_ASCENT_MAX_ROUNDS = 12;
+
+/** Undirected edge of the graph given to dual ascent */
+struct DualAscentEdge {
+    std::size_t source;
+    std::size_t target;
+    double cost;
+};
+
+/** Lower bound of dual ascent and the edges and vertices it eliminates */
+struct DualAscentBound {
+    double lower_bound;
+    double quota_multiplier;
+    int num_rounds;
+    std::vector<double> reduced_costs;          // arc 2e goes from source to target, arc 2e + 1 goes back
+    std::vector<double> distances_from_root;    // shortest paths from the root in the reduced costs
+    std::vector<double> distances_to_root;      // shortest paths to the root in the reduced costs
+    std::vector<bool> is_edge_eliminated;       // the edge is in no tour that costs at most the upper bound
+    std::vector<bool> is_vertex_eliminated;     // no tour that costs at most the upper bound visits the vertex
+};
+
+/**
+ * @brief Wong's dual ascent on the directed cut relaxation of the prize collecting TSP.
+ *
+ * Orienting a tour from the root gives a directed cycle that enters every set
+ * of vertices that contains a visited vertex and not the root. The relaxation
+ * with these cuts and the quota is a prize collecting Steiner arborescence
+ * problem. For a quota multiplier lambda, every vertex v can raise the duals of
+ * the cuts that separate it from the root by at most lambda * prize(v), and the
+ * dual bound is the sum of the raised duals minus lambda * (prize of all
+ * vertices - quota). The cuts of each vertex are raised in turn by a Dijkstra
+ * search from the vertex along reversed arcs of the reduced costs, and lambda
+ * is searched on a log scale for at most max_rounds ascents.
+ *
+ * A tour that visits v costs at least the lower bound plus the reduced distance
+ * from the root to v and back, and a tour that uses an edge costs at least the
+ * lower bound plus the reduced cost of the edge and the reduced distances
+ * to and from its ends. Edges and vertices whose bound exceeds the upper bound
+ * are eliminated. Self loops are ignored.
+ */
+DualAscentBound dualAscent(
+    std::size_t n,
+    const std::vector<DualAscentEdge>& edges,
+    const std::vector<double>& prizes,
+    double quota,
+    std::size_t root,
+    double upper_bound,
+    int max_rounds = DUAL_ASCENT_MAX_ROUNDS
+);
+
+/**
+ * @brief Dual ascent on the graph. Edges are indexed in the order of
+ * boost::edges without self loops.
+ */
+template <typename TGraph, typename TCostMap, typename TPrizeMap>
+DualAscentBound dualAscent(
+    TGraph& graph,
+    TCostMap& cost_map,
+    TPrizeMap& prize_map,
+    int quota,
+    typename TGraph::vertex_descriptor root_vertex,
+    double upper_bound,
+    int max_rounds = DUAL_ASCENT_MAX_ROUNDS
+) {
+    std::size_t n = boost::num_vertices(graph);
+    std::vector<DualAscentEdge> edges;
+    for (auto edge : boost::make_iterator_range(boost::edges(graph))) {
+        std::size_t u = boost::source(edge, graph);
+        std::size_t v = boost::target(edge, graph);
+        if (u == v) continue;
+        edges.push_back({u, v, (double) cost_map[edge]});
+    }
+    std::vector<double> prizes (n);
+    for (std::size_t u = 0; u < n; u++) prizes[u] = prize_map[u];
+    return dualAscent(n, edges, prizes, quota, root_vertex, upper_bound, max_rounds);
+}
+
+/**
+ * @brief Remove the edges eliminated by dual ascent from the graph, and every
+ * edge of an eliminated vertex. Self loops are kept, so the vertex stays in the
+ * graph and its self loop variable can be fixed to zero.
+ * Returns the number of removed edges.
+ */
+template <typename TGraph>
+std::size_t removeEliminatedEdges(TGraph& graph, const DualAscentBound& bound) {
+    std::vector<typename boost::graph_traits<TGraph>::edge_descriptor> eliminated;
+    std::size_t index = 0;
+    auto is_vertex_eliminated = [&bound](std::size_t u) {
+        return u < bound.is_vertex_eliminated.size() && bound.is_vertex_eliminated[u];
+    };
+    for (auto edge : boost::make_iterator_range(boost::edges(graph))) {
+        std::size_t u = boost::source(edge, graph);
+        std::size_t v = boost::target(edge, graph);
+        if (u == v) continue;
+        if ((index < bound.is_edge_eliminated.size() && bound.is_edge_eliminated[index])
+            || is_vertex_eliminated(u) || is_vertex_eliminated(v))
+            eliminated.push_back(edge);
+        index++;
+    }
+    for (auto edge : eliminated) boost::remove_edge(edge, graph);
+    return eliminated.size();
+}
+
+#endif
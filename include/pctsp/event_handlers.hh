@@ -5,6 +5,8 @@
 #include "stats.hh"
 
 const std::string NODE_EVENTHDLR_NAME = "pctsp_node_handler";
+const std::string BOUNDS_EVENTHDLR_NAME = "pctsp_bound_handler";
+const std::string COST_LOWER_BOUND_EVENTHDLR_NAME = "pctsp_cost_lower_bound_handler";
 
 NodeStats newStatsForNode(SCIP* scip, SCIP_NODE* node);
 
@@ -31,12 +33,17 @@ public:
 
    NodeStats getNodeStats(SCIP* scip);
 
+   /** Bytes allocated for the node statistics */
+   std::size_t getMemoryUsed();
+
    void addCurrentNode(SCIP* scip);
 
    void incrementNumSecDisjointTour(SCIP* scip, unsigned int n_cuts);
 
    void incrementNumSecMaxflowMincut(SCIP* scip, unsigned int n_cuts);
 
+   void incrementNumSecUnionFind(SCIP* scip, unsigned int n_cuts);
+
    /** destructor of event handler to free user data (called when SCIP is exiting) */
    virtual SCIP_DECL_EVENTFREE(scip_free);
 
@@ -85,7 +92,7 @@ public:
    BoundsEventHandler(
       SCIP* scip
       )
-      : ObjEventhdlr(scip, "pctsp_bound_handler","Record upper and lower bounds")
+      : ObjEventhdlr(scip, BOUNDS_EVENTHDLR_NAME.c_str(), "Record upper and lower bounds")
    {
       using namespace std::chrono;
       _last_timestamp = time_point_cast<SubSeconds>(system_clock::now());
@@ -96,6 +103,9 @@ public:
 
    std::vector<Bounds> getBoundsVector();
 
+   /** Bytes allocated for the bounds */
+   std::size_t getMemoryUsed();
+
    /** destructor of event handler to free user data (called when SCIP is exiting) */
    virtual SCIP_DECL_EVENTFREE(scip_free);
 
@@ -133,4 +143,38 @@ public:
    virtual SCIP_DECL_EVENTEXEC(scip_exec);
 };
 
-#endif
\ No newline at end of file
+/**
+ * @brief Event handler that raises the lower bound of the root node to a
+ * lower bound on the cost of every feasible tour, e.g. from the primal-dual
+ * algorithm, dual ascent or the Lagrangian bound.
+ *
+ * Children inherit the bound of the root, so the bound prunes the tree without
+ * adding a dense row over every edge variable to the LP.
+ */
+class CostLowerBoundEventhdlr : public scip::ObjEventhdlr
+{
+   double lower_bound_;
+public:
+   /** default constructor */
+   CostLowerBoundEventhdlr(
+      SCIP* scip,
+      double lower_bound
+      )
+      : ObjEventhdlr(scip, COST_LOWER_BOUND_EVENTHDLR_NAME.c_str(), "raise the lower bound of the root node to a bound on the cost")
+   {
+      lower_bound_ = lower_bound;
+   }
+
+   double getLowerBound();
+
+   /** solving process initialization method of event handler (called when branch and bound process is about to begin) */
+   virtual SCIP_DECL_EVENTINITSOL(scip_initsol);
+
+   /** solving process deinitialization method of event handler (called before branch and bound process data is freed) */
+   virtual SCIP_DECL_EVENTEXITSOL(scip_exitsol);
+
+   /** execution method of event handler: raise the bound when the root node is focused */
+   virtual SCIP_DECL_EVENTEXEC(scip_exec);
+};
+
+#endif
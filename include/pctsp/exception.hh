@@ -83,6 +83,25 @@ class TargetVertexFound : public std::exception {
         }
 };
 
+class SubtreeSolveError : public std::exception {
+    std::string message;
+
+public:
+    SubtreeSolveError(int retcode) : message(std::string("SCIP failed to solve a subtree with return code ") + std::to_string(retcode)) {}
+
+    const char* what() const throw() { return message.c_str(); }
+};
+
+class VariantSolveError : public std::exception {
+    std::string message;
+
+public:
+    VariantSolveError(const std::string& variant, int retcode)
+        : message(std::string("SCIP failed to solve the portfolio variant ") + variant + " with return code " + std::to_string(retcode)) {}
+
+    const char* what() const throw() { return message.c_str(); }
+};
+
 class FileDoesNotExistError : public std::filesystem::filesystem_error {
     private:
         const std::string message = "File does not exist: ";
@@ -151,6 +151,18 @@ std::vector<SCIP_VAR*> getEdgeVariables(
     std::vector<PCTSPedge>& edges
 );
 
+/**
+ * @brief Keep the edges that have a variable in the model, e.g. when edge variables are priced
+ */
+template <typename TEdge, typename EdgeVariableMap>
+std::vector<TEdge> filterEdgesWithVariables(std::vector<TEdge>& edges, EdgeVariableMap& edge_variable_map) {
+    std::vector<TEdge> edges_with_variables;
+    for (auto const& edge : edges) {
+        if (edge_variable_map.count(edge) > 0) edges_with_variables.push_back(edge);
+    }
+    return edges_with_variables;
+}
+
 template <typename TGraph, typename EdgeIt>
 void printEdges(TGraph& graph, EdgeIt& first, EdgeIt& last) {
     // typedef typename boost::graph_traits< TGraph >::edge_descriptor TEdge;
@@ -1,17 +1,30 @@
 #ifndef __PCTSP_HEURISTIC__
 #define __PCTSP_HEURISTIC__
 
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/graph_traits.hpp>
+#include <chrono>
+#include <cmath>
 #include <exception>
+#include <functional>
+#include <future>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <random>
+#include <thread>
 
 #include <scip/scip.h>
 
+#include "branching.hh"
+#include "dense_graph.hh"
 #include "exception.hh"
 #include "graph.hh"
 #include "logger.hh"
+#include "neighborhood.hh"
+#include "scoring.hh"
 #include "walk.hh"
 
 using namespace boost;
@@ -25,12 +38,6 @@ void includeHeuristics(SCIP* scip);
 
 float unitaryGain(int prize_v, CostNumberType cost_uw, CostNumberType cost_uv, CostNumberType cost_vw);
 
-struct ExtensionVertex {
-    int index;
-    float value;
-};
-
-
 float unitaryLoss(
     int& external_path_prize,
     int& internal_path_prize,
@@ -68,34 +75,19 @@ ExtensionVertex chooseExtensionPathFromCandidates(
     std::vector<std::list<typename TGraph::vertex_descriptor>> external_path_candidates,
     std::vector<typename TGraph::vertex_descriptor> internal_path
 ) {
-    ExtensionVertex best_candidate = {-1, 0.0};
-    int current_index = 0;
-    bool extension_found = false;
-    for (auto& external_path : external_path_candidates) {
-        // if the external path has prize greater than the internal path
-        int internal_path_prize = totalPrize(prize_map, internal_path);
-        int external_path_prize = totalPrize(prize_map, external_path);
-        float prize_diff = external_path_prize - internal_path_prize;
-
-        if (prize_diff > 0) {
-            // then calculate the unitary loss of the external path between i and j
-            int external_path_cost = totalCost(graph, external_path, cost_map);
-            int internal_path_cost = totalCost(graph, internal_path, cost_map);
-            auto loss_ij = unitaryLoss(
-                external_path_prize,
-                internal_path_prize,
-                external_path_cost,
-                internal_path_cost
-            );
-            if ((loss_ij < best_candidate.value) || !(extension_found)) {
-                best_candidate.value = loss_ij;
-                best_candidate.index = current_index;
-                extension_found = true;
-            }
-        }
-        current_index ++;
+    int n = external_path_candidates.size();
+    if (n == 0) return {-1, 0.0};
+    int internal_path_prize = totalPrize(prize_map, internal_path);
+    int internal_path_cost = totalCost(graph, internal_path, cost_map);
+    std::vector<PrizeNumberType> external_path_prize (n);
+    std::vector<CostNumberType> external_path_cost (n);
+    for (int i = 0; i < n; i++) {
+        external_path_prize[i] = totalPrize(prize_map, external_path_candidates[i]);
+        // the unitary loss is only needed if the external path has prize greater than the internal path
+        if (external_path_prize[i] > internal_path_prize)
+            external_path_cost[i] = totalCost(graph, external_path_candidates[i], cost_map);
     }
-    return best_candidate;
+    return argminUnitaryLoss(external_path_cost.data(), external_path_prize.data(), internal_path_cost, internal_path_prize, n);
 }
 
 /**
@@ -145,6 +137,58 @@ void swapPathsInTour(std::list<TVertex>& tour, std::list<TVertex>& new_path, int
     }
 }
 
+/**
+ * @brief Replace the section of the tour from first to last index with the new path
+ * and keep the set of vertices in the tour up to date.
+ */
+template<typename TVertex>
+void swapPathsInTour(std::list<TVertex>& tour, std::list<TVertex>& new_path, int& first_index, int& last_index, VertexBitset& in_tour) {
+    auto start = tour.begin();
+    auto end = tour.end();
+    auto old_path = getSubpathOfCycle(start, end, first_index, last_index);
+    for (auto u : old_path) in_tour.reset(u);
+    for (auto u : new_path) in_tour.set(u);
+    swapPathsInTour(tour, new_path, first_index, last_index);
+}
+
+/**
+ * @brief Replace the section of the tour from first to last index with the new path,
+ * keep the set of vertices in the tour up to date and invalidate the external paths
+ * that depend on vertices joining or leaving the tour.
+ */
+template<typename TVertex>
+void swapPathsInTour(
+    std::list<TVertex>& tour,
+    std::list<TVertex>& new_path,
+    int& first_index,
+    int& last_index,
+    VertexBitset& in_tour,
+    ExternalPathIndex& external_path_index
+) {
+    auto start = tour.begin();
+    auto end = tour.end();
+    auto old_path = getSubpathOfCycle(start, end, first_index, last_index);
+    for (auto u : old_path) {
+        if (std::find(new_path.begin(), new_path.end(), u) == new_path.end())
+            external_path_index.invalidate(u);
+    }
+    for (auto u : new_path) {
+        if (std::find(old_path.begin(), old_path.end(), u) == old_path.end())
+            external_path_index.invalidate(u);
+    }
+    swapPathsInTour(tour, new_path, first_index, last_index, in_tour);
+}
+
+/**
+ * @brief The set of vertices in the tour as a bitset.
+ */
+template <typename TGraph>
+VertexBitset vertexBitsetOfTour(TGraph& graph, std::list<typename TGraph::vertex_descriptor>& tour) {
+    VertexBitset in_tour (boost::num_vertices(graph));
+    for (auto u : tour) in_tour.set(u);
+    return in_tour;
+}
+
 int numFeasibleExtensions(std::vector<bool>& is_feasible_extension);
 
 float averageUnitaryLoss(std::vector<float>& unitary_loss, std::vector<bool>& is_feasible_extension);
@@ -162,15 +206,15 @@ void findExtensionPaths(
     int& path_depth_limit,
     std::vector<float>& unitary_loss,
     std::vector<bool>& is_feasible_extension,
-    std::vector<std::list<typename TGraph::vertex_descriptor>>& extension_paths
+    std::vector<std::list<typename TGraph::vertex_descriptor>>& extension_paths,
+    NeighborhoodIndex& neighborhood,
+    VertexBitset& in_tour,
+    ExternalPathIndex& external_path_index
 ) {
     typedef typename TGraph::vertex_descriptor VertexDescriptor;
 
     int k = tour.size() - 1;
 
-    // create a set of vertices in tour
-    std::unordered_set<VertexDescriptor> vertices_in_tour(std::begin(tour), std::end(tour));
-
     for (int i = 0; i < k; i++) {
         int j = (i + step_size) % k;
         auto it = tour.begin();
@@ -191,41 +235,28 @@ void findExtensionPaths(
 
         // check if the root is an internal vertex (not an endpoint) inside the internal path
         if ((path_depth_limit == 2) && is_root_internal_vertex) {
-            if (boost::edge(vi, root_vertex, graph).second && boost::edge(root_vertex, vj, graph).second) {
+            if (hasEdge(graph, cost_map, vi, root_vertex) && hasEdge(graph, cost_map, root_vertex, vj)) {
                 std::list<VertexDescriptor> path_iuj = {vi, root_vertex, vj};
                 external_path_candidates.push_back(path_iuj);
             }
         }
 
         else if (path_depth_limit == 2) {
-            // look at every vertex that is adjacent to both i and j
-            auto neighbors = neighborIntersection(graph, vi, vj);
-            for (const auto& u : neighbors) {
-                if (vertices_in_tour.count(u) == 0) {
-                    std::list<VertexDescriptor> path_iuj = {vi, u, vj};
-                    external_path_candidates.push_back(path_iuj);
-                }
+            // look at every vertex that is adjacent to both i and j and not in the tour
+            for (VertexDescriptor u : neighborhood.commonNeighborsNotIn(vi, vj, in_tour)) {
+                std::list<VertexDescriptor> path_iuj = {vi, u, vj};
+                external_path_candidates.push_back(path_iuj);
             }
         }
         // need to check that root vertex is not an *internal* vertex between i and j
         else if (path_depth_limit > 2 && !(is_root_internal_vertex)) {
-            // filter the graph by marking vertices that are already in the tour
-            auto n_vertices = num_vertices(graph);
-            std::vector<bool> marked (n_vertices);
-            for (auto h: tour) marked[h] = true;
-            // find a path using BFS from i to j using unmarked vertices
-            std::vector<VertexDescriptor> parent (n_vertices);
-            breadthFirstSearch(graph, vi, marked, parent, path_depth_limit - 1);
-
-            for (auto neighbor : boost::make_iterator_range(boost::adjacent_vertices(vj, graph))) {
-                if (vertices_in_tour.count(neighbor) == 0 && marked[neighbor]) {
-                    auto path_ij = pathInTreeFromParents(parent, vi, neighbor);
-                    path_ij.push_back(vj);
-
-                    // path is only a candidate if it has prize larger than internal path
-                    if (totalPrize(prize_map, path_ij) > totalPrize(prize_map, internal_path))
-                        external_path_candidates.push_back(path_ij);
-                }
+            // meet in the middle of the memoised search trees of i and j
+            for (auto& path : external_path_index.externalPaths(vi, vj)) {
+                std::list<VertexDescriptor> path_ij (path.begin(), path.end());
+
+                // path is only a candidate if it has prize larger than internal path
+                if (totalPrize(prize_map, path_ij) > totalPrize(prize_map, internal_path))
+                    external_path_candidates.push_back(path_ij);
             }
         }
         ExtensionVertex best_candidate = chooseExtensionPathFromCandidates(graph, cost_map, prize_map, external_path_candidates, internal_path);
@@ -243,6 +274,25 @@ void findExtensionPaths(
     }
 }
 
+template <typename TGraph, typename TCostMap, typename TPrizeMap>
+void findExtensionPaths(
+    TGraph& graph,
+    std::list<typename TGraph::vertex_descriptor>& tour,
+    TCostMap& cost_map,
+    TPrizeMap& prize_map,
+    typename TGraph::vertex_descriptor& root_vertex,
+    int& step_size,
+    int& path_depth_limit,
+    std::vector<float>& unitary_loss,
+    std::vector<bool>& is_feasible_extension,
+    std::vector<std::list<typename TGraph::vertex_descriptor>>& extension_paths
+) {
+    NeighborhoodIndex neighborhood (graph);
+    auto in_tour = vertexBitsetOfTour(graph, tour);
+    ExternalPathIndex external_path_index (neighborhood, in_tour, path_depth_limit);
+    findExtensionPaths(graph, tour, cost_map, prize_map, root_vertex, step_size, path_depth_limit, unitary_loss, is_feasible_extension, extension_paths, neighborhood, in_tour, external_path_index);
+}
+
 template <typename TGraph, typename TCostMap, typename TPrizeMap>
 void pathExtension(
     TGraph& graph,
@@ -251,9 +301,12 @@ void pathExtension(
     TPrizeMap& prize_map,
     typename TGraph::vertex_descriptor& root_vertex,
     int step_size,
-    int path_depth_limit
+    int path_depth_limit,
+    NeighborhoodIndex& neighborhood
 ) {
     typedef typename boost::graph_traits<TGraph>::vertex_descriptor VertexDescriptor;
+    auto in_tour = vertexBitsetOfTour(graph, tour);
+    ExternalPathIndex external_path_index (neighborhood, in_tour, path_depth_limit);
 
     bool exists_path_with_below_avg_loss = true;
     bool calculate_avg_loss = true;
@@ -268,7 +321,7 @@ void pathExtension(
         std::vector<std::list<VertexDescriptor>> extension_paths(k);
 
         // find all possible extension paths of length path_depth_limit
-        findExtensionPaths(graph, tour, cost_map, prize_map, root_vertex, step_size, path_depth_limit, unitary_loss, is_feasible_extension, extension_paths);
+        findExtensionPaths(graph, tour, cost_map, prize_map, root_vertex, step_size, path_depth_limit, unitary_loss, is_feasible_extension, extension_paths, neighborhood, in_tour, external_path_index);
 
         // get the number of possible extensions
         auto num_feasible_extensions = numFeasibleExtensions(is_feasible_extension);
@@ -291,7 +344,7 @@ void pathExtension(
             if (exists_path_with_below_avg_loss) {
                 auto external_path = extension_paths[index_of_smallest_loss];
                 int last_index =  index_of_smallest_loss + step_size;
-                swapPathsInTour(tour, external_path, index_of_smallest_loss, last_index);
+                swapPathsInTour(tour, external_path, index_of_smallest_loss, last_index, in_tour, external_path_index);
             }
         } else {
             exists_path_with_below_avg_loss = false;
@@ -300,6 +353,20 @@ void pathExtension(
     }
 }
 
+template <typename TGraph, typename TCostMap, typename TPrizeMap>
+void pathExtension(
+    TGraph& graph,
+    std::list<typename TGraph::vertex_descriptor>& tour,
+    TCostMap& cost_map,
+    TPrizeMap& prize_map,
+    typename TGraph::vertex_descriptor& root_vertex,
+    int step_size,
+    int path_depth_limit
+) {
+    NeighborhoodIndex neighborhood (graph);
+    pathExtension(graph, tour, cost_map, prize_map, root_vertex, step_size, path_depth_limit, neighborhood);
+}
+
 template <typename TGraph, typename TCostMap, typename TPrizeMap>
 void extensionUnitaryLoss(
     TGraph& graph,
@@ -325,9 +392,12 @@ void pathExtensionUntilPrizeFeasible(
     typename TGraph::vertex_descriptor& root_vertex,
     int& quota,
     int& step_size,
-    int& path_depth_limit
+    int& path_depth_limit,
+    NeighborhoodIndex& neighborhood
 ) {
     typedef typename boost::graph_traits<TGraph>::vertex_descriptor VertexDescriptor;
+    auto in_tour = vertexBitsetOfTour(graph, tour);
+    ExternalPathIndex external_path_index (neighborhood, in_tour, path_depth_limit);
     int prize = totalPrizeOfTour(prize_map, tour);
     int num_feasible_extensions = 1;
     int i = 0;
@@ -341,7 +411,7 @@ void pathExtensionUntilPrizeFeasible(
         std::vector<std::list<VertexDescriptor>> extension_paths(k);
 
         // find all possible extension paths of length path_depth_limit
-        findExtensionPaths(graph, tour, cost_map, prize_map, root_vertex, step_size, path_depth_limit, unitary_loss, is_feasible_extension, extension_paths);
+        findExtensionPaths(graph, tour, cost_map, prize_map, root_vertex, step_size, path_depth_limit, unitary_loss, is_feasible_extension, extension_paths, neighborhood, in_tour, external_path_index);
         num_feasible_extensions = numFeasibleExtensions(is_feasible_extension);
 
         // extend the tour with the path of smallest unitary loss
@@ -351,11 +421,26 @@ void pathExtensionUntilPrizeFeasible(
             auto smallest_loss = unitary_loss[index_of_smallest_loss];
             auto external_path = extension_paths[index_of_smallest_loss];
             int last_index = (index_of_smallest_loss + step_size) % k;
-            swapPathsInTour(tour, external_path, index_of_smallest_loss, last_index);
+            swapPathsInTour(tour, external_path, index_of_smallest_loss, last_index, in_tour, external_path_index);
         }
     }
 }
 
+template <typename TGraph, typename TCostMap, typename TPrizeMap>
+void pathExtensionUntilPrizeFeasible(
+    TGraph& graph,
+    std::list<typename TGraph::vertex_descriptor>& tour,
+    TCostMap& cost_map,
+    TPrizeMap& prize_map,
+    typename TGraph::vertex_descriptor& root_vertex,
+    int& quota,
+    int& step_size,
+    int& path_depth_limit
+) {
+    NeighborhoodIndex neighborhood (graph);
+    pathExtensionUntilPrizeFeasible(graph, tour, cost_map, prize_map, root_vertex, quota, step_size, path_depth_limit, neighborhood);
+}
+
 
 template <typename TGraph, typename TCostMap, typename TPrizeMap>
 ExtensionVertex unitaryGainOfVertex(
@@ -365,54 +450,34 @@ ExtensionVertex unitaryGainOfVertex(
     TPrizeMap& prize_map, typename TGraph::vertex_descriptor vertex
 ) {
     typedef typename boost::graph_traits<TGraph>::vertex_descriptor VertexDescriptor;
-    typedef typename std::list<VertexDescriptor>::iterator tour_iterator_t;
-    tour_iterator_t tour_iterator = tour.begin();
-    VertexDescriptor prev_vertex_id = *tour_iterator;
-    VertexDescriptor u = boost::vertex(prev_vertex_id, g);
     VertexDescriptor v = boost::vertex(vertex, g);
+    int n = tour.size() - 1;
 
-    // calculate the unitary gain of a vertex
-    float max_gain = 0.0;
-    int prize_of_v = prize_map[v];
-    int index_of_extension;
-    // iterate over the endpoints of each edge in the tour to find max unitary
-    // gain
+    // gather the costs from v to every vertex of the tour and the costs of tour edges
+    // into contiguous arrays, then find the max unitary gain with a vectorized kernel
+    std::vector<CostNumberType> cost_to_tour (n + 1);
+    std::vector<int> is_adjacent (n + 1);
+    std::vector<CostNumberType> tour_cost (n);
     int i = 0;
-    ++tour_iterator;
-    for (; tour_iterator != tour.end(); ++tour_iterator) {
-        VertexDescriptor w = boost::vertex(*tour_iterator, g);
-        auto edge_uv = edge(u, v, g).first;
-        bool uv_exists = edge(u, v, g).second;
-        auto edge_vw = edge(v, w, g).first;
-        bool vw_exists = edge(v, w, g).second;
-        auto edge_uw = edge(u, w, g).first; // edge in tour, assume it exists
-        bool uw_exists = edge(u, w, g).second;
-        if (!uw_exists) {
-            string error_message =
-                "Edge between " + std::to_string(prev_vertex_id) + " and " +
-                std::to_string(*tour_iterator) + " does not exist. \n";
-            throw std::invalid_argument(error_message);
-        }
-
-        // check edges exist from (u, vertex) and (vertex, v)
-        if ((vw_exists) && (uv_exists)) {
-            CostNumberType cost_uv = cost_map[edge_uv];
-            CostNumberType cost_vw = cost_map[edge_vw];
-            CostNumberType cost_uw = cost_map[edge_uw];
-            float gain = unitaryGain(prize_of_v, cost_uw, cost_uv, cost_vw);
-            if (gain > max_gain) {
-                max_gain = gain;
-                index_of_extension = i;
+    VertexDescriptor u = *tour.begin();
+    for (auto w : tour) {
+        auto cost_vw = costOfVertexPair(g, cost_map, v, w);
+        cost_to_tour[i] = cost_vw.first;
+        is_adjacent[i] = cost_vw.second;
+        if (i > 0) {
+            auto cost_uw = costOfVertexPair(g, cost_map, u, w); // edge in tour, assume it exists
+            if (!cost_uw.second) {
+                string error_message =
+                    "Edge between " + std::to_string(u) + " and " +
+                    std::to_string(w) + " does not exist. \n";
+                throw std::invalid_argument(error_message);
             }
+            tour_cost[i - 1] = cost_uw.first;
         }
         u = w;
-        prev_vertex_id = *tour_iterator;
         i++;
     }
-    ExtensionVertex gain_of_vertex = ExtensionVertex();
-    gain_of_vertex.value = max_gain;
-    gain_of_vertex.index = index_of_extension;
-    return gain_of_vertex;
+    return argmaxUnitaryGain(prize_map[v], cost_to_tour.data(), is_adjacent.data(), tour_cost.data(), n);
 }
 
 template <typename GainMap, typename VertexSet>
@@ -468,6 +533,62 @@ typename TGraph::vertex_descriptor findVertexWithBiggestGain(
     return biggest_gain_vertex;
 }
 
+/**
+ * @brief Find the vertex with the biggest unitary gain, only scoring the
+ * candidate neighbours of the endpoints of each tour edge.
+ *
+ * Scores O(k K) insertions for a tour with k edges and K candidates per vertex
+ * instead of O(n k). Without candidate lists every vertex is scored.
+ */
+template <typename TGraph, typename TCostMap, typename TPrizeMap, typename GainMap, typename VertexSet>
+typename TGraph::vertex_descriptor findVertexWithBiggestGain(
+    TGraph& graph,
+    std::list<typename TGraph::vertex_descriptor>& tour,
+    TCostMap& cost_map,
+    TPrizeMap& prize_map,
+    GainMap& gain_map,
+    VertexSet& vertices_in_tour,
+    const CandidateLists& candidates)
+{
+    typedef typename graph_traits<TGraph>::vertex_descriptor VertexDescriptor;
+    if (candidates.empty())
+        return findVertexWithBiggestGain(graph, tour, cost_map, prize_map, gain_map, vertices_in_tour);
+
+    // best insertion of every candidate over the tour edges it is near to
+    gain_map.clear();
+    std::vector<VertexDescriptor> path (tour.begin(), tour.end());
+    for (int i = 0; i + 1 < (int) path.size(); i++) {
+        auto u = path[i];
+        auto w = path[i + 1];
+        auto cost_uw = costOfVertexPair(graph, cost_map, u, w);
+        for (auto endpoint : {u, w}) {
+            for (VertexDescriptor v : candidates[endpoint]) {
+                if (vertices_in_tour.count(v) > 0) continue;
+                auto& gain = gain_map.try_emplace(v, ExtensionVertex{-1, 0.0}).first->second;
+                auto cost_uv = costOfVertexPair(graph, cost_map, u, v);
+                auto cost_vw = costOfVertexPair(graph, cost_map, v, w);
+                if (!cost_uv.second || !cost_vw.second) continue;
+                float value = unitaryGain(prize_map[v], cost_uw.first, cost_uv.first, cost_vw.first);
+                if (value > gain.value) gain = {i, value};
+            }
+        }
+    }
+    float biggest_gain = 0.0;
+    VertexDescriptor biggest_gain_vertex;
+    bool found_biggest_gain = false;
+    for (auto const& [vertex, gain] : gain_map) {
+        if (gain.value > biggest_gain) {
+            biggest_gain_vertex = vertex;
+            biggest_gain = gain.value;
+            found_biggest_gain = true;
+        }
+    }
+    if (!found_biggest_gain) {
+        throw NoGainVertexFoundException();
+    }
+    return biggest_gain_vertex;
+}
+
 template <typename GainMap, typename Tour, typename Vertex>
 void insertBiggestGainVertexIntoTour(
     Tour& tour,
@@ -490,7 +611,8 @@ void extensionUnitaryGain(
     TGraph& g,
     std::list<typename TGraph::vertex_descriptor>& tour,
     TCostMap& cost_map,
-    TPrizeMap& prize_map
+    TPrizeMap& prize_map,
+    const CandidateLists& candidates = CandidateLists()
 ) {
     typedef typename TGraph::vertex_descriptor VertexDescriptor;
     // we assume that the first and last vertex in the tour are the same
@@ -510,7 +632,7 @@ void extensionUnitaryGain(
     while (exists_vertices_with_above_avg_gain) {
         try {
             VertexDescriptor biggest_gain_vertex = findVertexWithBiggestGain(
-                g, tour, cost_map, prize_map, gain_map, vertices_in_tour);
+                g, tour, cost_map, prize_map, gain_map, vertices_in_tour, candidates);
             float biggest_gain = gain_map[biggest_gain_vertex].value;
             // only calculate the average gain once
             if (calculate_avg_gain) {
@@ -539,7 +661,8 @@ void extensionUntilPrizeFeasible(
     std::list<typename TGraph::vertex_descriptor>& tour,
     TCostMap& cost_map,
     TPrizeMap& prize_map,
-    int quota
+    int quota,
+    const CandidateLists& candidates = CandidateLists()
 ) {
     // Run the extension algorithm until the total prize of the tour is greater
     // than the quota. We don't calculate the average gain, the only termination
@@ -562,7 +685,7 @@ void extensionUntilPrizeFeasible(
     while (prize < quota && insert_a_vertex) {
         try {
             auto biggest_gain_vertex = findVertexWithBiggestGain(
-                g, tour, cost_map, prize_map, gain_map, vertices_in_tour);
+                g, tour, cost_map, prize_map, gain_map, vertices_in_tour, candidates);
             if (insert_a_vertex) {
                 insertBiggestGainVertexIntoTour(tour, biggest_gain_vertex,
                     gain_map);
@@ -682,10 +805,9 @@ std::list<std::list<typename TGraph::vertex_descriptor>> findCollapsePaths (
 
 
     // for each neighbour of the source vertex
-    for (VD collapse_vertex: boost::make_iterator_range(boost::adjacent_vertices(source, graph))) {
+    for (VD collapse_vertex: adjacentVertices(graph, cost_map, source)) {
         // check if there exists an edge from v to root
-        auto edge = boost::edge(collapse_vertex, target, graph);
-        bool edge_exists = edge.second;
+        bool edge_exists = hasEdge(graph, cost_map, collapse_vertex, target);
         auto prize_of_new_tour = prize_of_internal_path + prize_map[collapse_vertex];
         if (edge_exists && ! in_internal_path[collapse_vertex] && prize_of_new_tour >= quota && source != target) {
             std::list<VD> collapse = {source, collapse_vertex, target};
@@ -784,6 +906,19 @@ std::list<typename TGraph::vertex_descriptor> collapse(
 }
 
 
+/**
+ * @brief Neighbourhood index that extension paths are searched in: the whole
+ * graph, or only the candidate neighbours when candidate lists are given.
+ */
+template <typename TGraph>
+NeighborhoodIndex extensionNeighborhood(TGraph& graph, const CandidateLists& candidates = CandidateLists()) {
+    return candidates.empty() ? NeighborhoodIndex(graph) : NeighborhoodIndex::fromCandidateLists(candidates);
+}
+
+/**
+ * @brief Path extension & collapse with a neighbourhood index built by the caller,
+ * so searches that call this repeatedly build the index only once.
+ */
 template <typename TGraph, typename TCostMap, typename TPrizeMap>
 std::list<typename TGraph::vertex_descriptor> pathExtensionCollapse(
     TGraph& graph,
@@ -792,9 +927,10 @@ std::list<typename TGraph::vertex_descriptor> pathExtensionCollapse(
     TPrizeMap& prize_map,
     PrizeNumberType& quota,
     typename TGraph::vertex_descriptor& root_vertex,
-    bool collapse_shortest_paths = false,
-    int path_depth_limit = 2,
-    int step_size = 1
+    bool collapse_shortest_paths,
+    int path_depth_limit,
+    int step_size,
+    NeighborhoodIndex& neighborhood
 ) {
     typedef typename TGraph::vertex_descriptor TVertex;
     typedef typename std::list<TVertex> TTour;
@@ -811,7 +947,7 @@ std::list<typename TGraph::vertex_descriptor> pathExtensionCollapse(
     else {
         // search for a feasible tour using extension until prize feasible
         for (int step = 1; step <= step_size; step++) {
-            pathExtensionUntilPrizeFeasible(graph, tour, cost_map, prize_map, root_vertex, quota, step, path_depth_limit);
+            pathExtensionUntilPrizeFeasible(graph, tour, cost_map, prize_map, root_vertex, quota, step, path_depth_limit, neighborhood);
             prize_of_tour = totalPrizeOfTour(prize_map, tour);
             if (prize_of_tour >= quota) {
                 best_tour = tour;
@@ -832,7 +968,7 @@ std::list<typename TGraph::vertex_descriptor> pathExtensionCollapse(
 
     // now play ping pong between extension and collapse to find a better tour
     for (int step = 1; step <= step_size; step++) {
-        pathExtension(graph, tour, cost_map, prize_map, root_vertex, step, path_depth_limit);
+        pathExtension(graph, tour, cost_map, prize_map, root_vertex, step, path_depth_limit, neighborhood);
         tour = collapse(graph, tour, cost_map, prize_map, quota, root_vertex, collapse_shortest_paths);
         auto tour_cost = totalCost(graph, tour, cost_map);
         if (tour_cost < best_cost) {
@@ -844,4 +980,612 @@ std::list<typename TGraph::vertex_descriptor> pathExtensionCollapse(
     return ReorderTourFromRoot(best_tour, root_vertex);
 }
 
-#endif
\ No newline at end of file
+template <typename TGraph, typename TCostMap, typename TPrizeMap>
+std::list<typename TGraph::vertex_descriptor> pathExtensionCollapse(
+    TGraph& graph,
+    std::list<typename TGraph::vertex_descriptor>& init_tour,
+    TCostMap& cost_map,
+    TPrizeMap& prize_map,
+    PrizeNumberType& quota,
+    typename TGraph::vertex_descriptor& root_vertex,
+    bool collapse_shortest_paths = false,
+    int path_depth_limit = 2,
+    int step_size = 1,
+    const CandidateLists& candidates = CandidateLists()
+) {
+    // with candidate lists, extension paths only use candidate neighbours
+    NeighborhoodIndex neighborhood = extensionNeighborhood(graph, candidates);
+    return pathExtensionCollapse(graph, init_tour, cost_map, prize_map, quota, root_vertex, collapse_shortest_paths, path_depth_limit, step_size, neighborhood);
+}
+
+// Iterated local search
+
+struct IlsAcceptance {
+    static const unsigned int SIMULATED_ANNEALING;
+    static const unsigned int THRESHOLD;
+};
+
+/**
+ * @brief Returns true if every pair of consecutive vertices in the tour are adjacent.
+ */
+template <typename TGraph>
+bool isTourInGraph(TGraph& graph, std::list<typename TGraph::vertex_descriptor>& tour) {
+    if (tour.size() < 2) return false;
+    auto prev_it = tour.begin();
+    for (auto it = std::next(tour.begin()); it != tour.end(); it++) {
+        if (!boost::edge(*prev_it, *it, graph).second) return false;
+        prev_it = it;
+    }
+    return true;
+}
+
+/**
+ * @brief Improve the tour by replacing two edges (t_i, t_i+1) and (t_j, t_j+1)
+ * with (t_i, t_j) and (t_i+1, t_j+1) whenever the new edges exist and are cheaper.
+ *
+ * The root vertex stays at the start and end of the tour.
+ * At most max_passes passes over the tour are made.
+ * Returns true if the tour was improved.
+ */
+template <typename TGraph, typename TCostMap>
+bool twoOpt(
+    TGraph& graph,
+    std::list<typename TGraph::vertex_descriptor>& tour,
+    TCostMap& cost_map,
+    int max_passes = 1
+) {
+    typedef typename TGraph::vertex_descriptor VertexDescriptor;
+    std::vector<VertexDescriptor> path (tour.begin(), tour.end());
+    int k = path.size() - 1;
+    bool improved = false;
+    bool improved_this_pass = true;
+    for (int pass = 0; pass < max_passes && improved_this_pass; pass++) {
+        improved_this_pass = false;
+        for (int i = 0; i < k - 2; i++) {
+            auto cost_ab = costOfVertexPair(graph, cost_map, path[i], path[i + 1]);
+            for (int j = i + 2; j < k; j++) {
+                // reversing the whole cycle gives back the same tour
+                if (i == 0 && j == k - 1) continue;
+                auto cost_ac = costOfVertexPair(graph, cost_map, path[i], path[j]);
+                if (!cost_ac.second) continue;
+                auto cost_bd = costOfVertexPair(graph, cost_map, path[i + 1], path[j + 1]);
+                if (!cost_bd.second) continue;
+                auto cost_cd = costOfVertexPair(graph, cost_map, path[j], path[j + 1]);
+                CostNumberType delta = cost_ac.first + cost_bd.first - cost_ab.first - cost_cd.first;
+                if (delta < 0) {
+                    std::reverse(path.begin() + i + 1, path.begin() + j + 1);
+                    cost_ab = costOfVertexPair(graph, cost_map, path[i], path[i + 1]);
+                    improved = true;
+                    improved_this_pass = true;
+                }
+            }
+        }
+    }
+    if (improved) tour.assign(path.begin(), path.end());
+    return improved;
+}
+
+/**
+ * @brief 2-opt with neighbour lists: the new edge (t_i, t_j) must join t_i
+ * to one of its candidate neighbours. Without candidate lists every pair of
+ * tour edges is tried.
+ */
+template <typename TGraph, typename TCostMap>
+bool twoOpt(
+    TGraph& graph,
+    std::list<typename TGraph::vertex_descriptor>& tour,
+    TCostMap& cost_map,
+    const CandidateLists& candidates,
+    int max_passes = 1
+) {
+    typedef typename TGraph::vertex_descriptor VertexDescriptor;
+    if (candidates.empty()) return twoOpt(graph, tour, cost_map, max_passes);
+    std::vector<VertexDescriptor> path (tour.begin(), tour.end());
+    int k = path.size() - 1;
+    std::vector<int> position (boost::num_vertices(graph), -1);
+    for (int i = 0; i < k; i++) position[path[i]] = i;
+    bool improved = false;
+    bool improved_this_pass = true;
+    for (int pass = 0; pass < max_passes && improved_this_pass; pass++) {
+        improved_this_pass = false;
+        for (int i = 0; i < k - 2; i++) {
+            auto cost_ab = costOfVertexPair(graph, cost_map, path[i], path[i + 1]);
+            for (auto c : candidates[path[i]]) {
+                int j = position[c];
+                // reversing the whole cycle gives back the same tour
+                if (j < i + 2 || j >= k || (i == 0 && j == k - 1)) continue;
+                auto cost_ac = costOfVertexPair(graph, cost_map, path[i], path[j]);
+                if (!cost_ac.second) continue;
+                auto cost_bd = costOfVertexPair(graph, cost_map, path[i + 1], path[j + 1]);
+                if (!cost_bd.second) continue;
+                auto cost_cd = costOfVertexPair(graph, cost_map, path[j], path[j + 1]);
+                CostNumberType delta = cost_ac.first + cost_bd.first - cost_ab.first - cost_cd.first;
+                if (delta < 0) {
+                    std::reverse(path.begin() + i + 1, path.begin() + j + 1);
+                    for (int h = i + 1; h <= j; h++) position[path[h]] = h;
+                    cost_ab = costOfVertexPair(graph, cost_map, path[i], path[i + 1]);
+                    improved = true;
+                    improved_this_pass = true;
+                }
+            }
+        }
+    }
+    if (improved) tour.assign(path.begin(), path.end());
+    return improved;
+}
+
+/**
+ * @brief Reconnect the tour A B C D as A C B D where the root is in segment A.
+ *
+ * Returns false (and leaves the tour unchanged) if the tour is too small
+ * or if none of the sampled reconnections only use edges of the graph.
+ */
+template <typename TGraph, typename TRandomGenerator>
+bool doubleBridgeMove(
+    TGraph& graph,
+    std::list<typename TGraph::vertex_descriptor>& tour,
+    TRandomGenerator& generator,
+    int max_attempts = 10
+) {
+    typedef typename TGraph::vertex_descriptor VertexDescriptor;
+    int k = tour.size() - 1;
+    if (k < 4) return false;
+    std::vector<VertexDescriptor> path (tour.begin(), tour.end());
+    std::uniform_int_distribution<int> position(1, k - 1);
+    for (int attempt = 0; attempt < max_attempts; attempt++) {
+        // cut points a < b < c split the tour into segments [0,a) [a,b) [b,c) [c,k]
+        std::vector<int> cuts = {position(generator), position(generator), position(generator)};
+        std::sort(cuts.begin(), cuts.end());
+        int a = cuts[0], b = cuts[1], c = cuts[2];
+        if (a == b || b == c) continue;
+        if (!boost::edge(path[a - 1], path[b], graph).second) continue;
+        if (!boost::edge(path[c - 1], path[a], graph).second) continue;
+        if (!boost::edge(path[b - 1], path[c], graph).second) continue;
+        std::list<VertexDescriptor> new_tour (path.begin(), path.begin() + a);
+        new_tour.insert(new_tour.end(), path.begin() + b, path.begin() + c);
+        new_tour.insert(new_tour.end(), path.begin() + a, path.begin() + b);
+        new_tour.insert(new_tour.end(), path.begin() + c, path.end());
+        tour = new_tour;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Remove a random (non-root) vertex from the tour if its neighbours in the tour are adjacent.
+ */
+template <typename TGraph, typename TRandomGenerator>
+bool dropRandomVertex(
+    TGraph& graph,
+    std::list<typename TGraph::vertex_descriptor>& tour,
+    TRandomGenerator& generator
+) {
+    int k = tour.size() - 1;
+    if (k < 4) return false;
+    std::uniform_int_distribution<int> position(1, k - 1);
+    int i = position(generator);
+    auto it = std::next(tour.begin(), i);
+    auto prev_vertex = *std::prev(it);
+    auto next_vertex = *std::next(it);
+    if (!boost::edge(prev_vertex, next_vertex, graph).second) return false;
+    tour.erase(it);
+    return true;
+}
+
+/**
+ * @brief Insert a random vertex that is not in the tour at the position of largest unitary gain.
+ */
+template <typename TGraph, typename TCostMap, typename TPrizeMap, typename TRandomGenerator>
+bool addRandomVertex(
+    TGraph& graph,
+    std::list<typename TGraph::vertex_descriptor>& tour,
+    TCostMap& cost_map,
+    TPrizeMap& prize_map,
+    TRandomGenerator& generator
+) {
+    typedef typename TGraph::vertex_descriptor VertexDescriptor;
+    std::vector<bool> in_tour (boost::num_vertices(graph), false);
+    for (auto u : tour) in_tour[u] = true;
+    std::vector<VertexDescriptor> candidates;
+    for (auto u : boost::make_iterator_range(boost::vertices(graph))) {
+        if (!in_tour[u]) candidates.push_back(u);
+    }
+    if (candidates.size() == 0) return false;
+    std::uniform_int_distribution<int> choice(0, candidates.size() - 1);
+    auto vertex = candidates[choice(generator)];
+    auto gain = unitaryGainOfVertex(graph, tour, cost_map, prize_map, vertex);
+    if (gain.value <= 0) return false;
+    tour.insert(std::next(tour.begin(), gain.index + 1), vertex);
+    return true;
+}
+
+/**
+ * @brief Kick the tour out of its local optimum.
+ *
+ * Applies a double-bridge move and then drops and adds `strength` random vertices.
+ * The quota is restored afterwards by extension along paths of the neighbourhood index.
+ */
+template <typename TGraph, typename TCostMap, typename TPrizeMap, typename TRandomGenerator>
+void perturbTour(
+    TGraph& graph,
+    std::list<typename TGraph::vertex_descriptor>& tour,
+    TCostMap& cost_map,
+    TPrizeMap& prize_map,
+    PrizeNumberType& quota,
+    typename TGraph::vertex_descriptor& root_vertex,
+    TRandomGenerator& generator,
+    int path_depth_limit,
+    NeighborhoodIndex& neighborhood,
+    int strength = 2
+) {
+    doubleBridgeMove(graph, tour, generator);
+    for (int i = 0; i < strength; i++) {
+        dropRandomVertex(graph, tour, generator);
+        addRandomVertex(graph, tour, cost_map, prize_map, generator);
+    }
+    // respect the quota by extending the perturbed tour
+    if (totalPrizeOfTour(prize_map, tour) < quota) {
+        int step_size = 1;
+        pathExtensionUntilPrizeFeasible(graph, tour, cost_map, prize_map, root_vertex, quota, step_size, path_depth_limit, neighborhood);
+    }
+    if (totalPrizeOfTour(prize_map, tour) < quota) {
+        extensionUntilPrizeFeasible(graph, tour, cost_map, prize_map, quota);
+    }
+}
+
+/**
+ * @brief Should the candidate tour replace the current tour?
+ *
+ * @param acceptance_parameter Initial temperature (simulated annealing) or initial
+ * threshold (threshold accepting) as a fraction of the cost of the current tour.
+ * @param progress Fraction of the search budget already used
+ */
+template <typename TRandomGenerator>
+bool acceptCandidateTour(
+    CostNumberType current_cost,
+    CostNumberType candidate_cost,
+    unsigned int acceptance,
+    float acceptance_parameter,
+    float progress,
+    TRandomGenerator& generator
+) {
+    if (candidate_cost <= current_cost) return true;
+    float delta = candidate_cost - current_cost;
+    if (acceptance == IlsAcceptance::THRESHOLD) {
+        float threshold = acceptance_parameter * (1.0 - progress) * current_cost;
+        return delta <= threshold;
+    }
+    // geometric cooling down to one percent of the initial temperature
+    float temperature = acceptance_parameter * current_cost * std::pow(0.01, progress);
+    if (temperature <= 0) return false;
+    std::uniform_real_distribution<float> uniform(0.0, 1.0);
+    return uniform(generator) < std::exp(- delta / temperature);
+}
+
+/**
+ * @brief Iterated local search on top of path extension & collapse.
+ *
+ * Perturbs the current tour, re-optimises it with path extension & collapse
+ * followed by 2-opt, then accepts the new tour according to the acceptance criterion.
+ * Stops after time_limit seconds or after max_iterations iterations (if non-negative).
+ *
+ * @return The least-cost prize-feasible tour found (empty if none found)
+ */
+template <typename TGraph, typename TCostMap, typename TPrizeMap>
+std::list<typename TGraph::vertex_descriptor> iteratedLocalSearch(
+    TGraph& graph,
+    std::list<typename TGraph::vertex_descriptor>& init_tour,
+    TCostMap& cost_map,
+    TPrizeMap& prize_map,
+    PrizeNumberType& quota,
+    typename TGraph::vertex_descriptor& root_vertex,
+    bool collapse_shortest_paths = false,
+    int path_depth_limit = 2,
+    int step_size = 1,
+    float time_limit = 60,
+    unsigned int acceptance = IlsAcceptance::SIMULATED_ANNEALING,
+    float acceptance_parameter = 0.05,
+    int max_iterations = -1,
+    unsigned int seed = PCTSP_DEFAULT_SEED,
+    const CandidateLists& candidates = CandidateLists()
+) {
+    typedef typename TGraph::vertex_descriptor TVertex;
+    typedef typename std::list<TVertex> TTour;
+    using namespace std::chrono;
+    auto start_time = steady_clock::now();
+    std::mt19937 generator (seed);
+    // every iteration searches the same neighbourhood, so index it once
+    NeighborhoodIndex neighborhood = extensionNeighborhood(graph, candidates);
+
+    // the starting point is a local optimum of path extension & collapse
+    TTour best_tour = pathExtensionCollapse(graph, init_tour, cost_map, prize_map, quota, root_vertex, collapse_shortest_paths, path_depth_limit, step_size, neighborhood);
+    if (best_tour.size() == 0 || totalPrizeOfTour(prize_map, best_tour) < quota) {
+        BOOST_LOG_TRIVIAL(warning) << "Iterated local search did not find a prize-feasible starting tour.";
+        return best_tour;
+    }
+    twoOpt(graph, best_tour, cost_map, candidates);
+    auto best_cost = totalCost(graph, best_tour, cost_map);
+    TTour current_tour = best_tour;
+    auto current_cost = best_cost;
+
+    int iteration = 0;
+    float elapsed = duration_cast<duration<float>>(steady_clock::now() - start_time).count();
+    while (elapsed < time_limit && (max_iterations < 0 || iteration < max_iterations)) {
+        TTour candidate = current_tour;
+        perturbTour(graph, candidate, cost_map, prize_map, quota, root_vertex, generator, path_depth_limit, neighborhood);
+        if (!isTourInGraph(graph, candidate)) candidate = current_tour;
+        candidate = pathExtensionCollapse(graph, candidate, cost_map, prize_map, quota, root_vertex, collapse_shortest_paths, path_depth_limit, step_size, neighborhood);
+        elapsed = duration_cast<duration<float>>(steady_clock::now() - start_time).count();
+        iteration++;
+
+        // candidate tours that do not satisfy the quota are rejected
+        if (candidate.size() == 0 || totalPrizeOfTour(prize_map, candidate) < quota) continue;
+        twoOpt(graph, candidate, cost_map, candidates);
+        auto candidate_cost = totalCost(graph, candidate, cost_map);
+        if (candidate_cost < best_cost) {
+            best_cost = candidate_cost;
+            best_tour = candidate;
+            BOOST_LOG_TRIVIAL(debug) << "ILS iteration " << iteration << " found tour with cost " << best_cost;
+        }
+        float progress = time_limit > 0 ? std::min(elapsed / time_limit, (float) 1.0) : 1.0;
+        if (max_iterations > 0) progress = std::max(progress, (float) iteration / (float) max_iterations);
+        if (acceptCandidateTour(current_cost, candidate_cost, acceptance, acceptance_parameter, progress, generator)) {
+            current_tour = candidate;
+            current_cost = candidate_cost;
+        }
+    }
+    BOOST_LOG_TRIVIAL(info) << "Iterated local search finished after " << iteration << " iterations with best cost " << best_cost;
+    return ReorderTourFromRoot(best_tour, root_vertex);
+}
+
+// Memetic search
+
+template <typename TVertex> struct MemeticIndividual {
+    std::list<TVertex> tour;
+    CostNumberType cost;
+    bool is_feasible;
+};
+
+/**
+ * @brief Edge-assembly style crossover for tours with optional vertices.
+ *
+ * The child starts as a copy of parent A. Parent B is then scanned from the root:
+ * every sub-path of B that leaves the child at u, visits only vertices outside
+ * the child and re-enters the child at w replaces the sub-path of the child
+ * between u and w with probability one half. The edges of a replacement
+ * sub-path all come from B, so the child is always a simple cycle of the graph.
+ * The child may no longer satisfy the quota.
+ */
+template <typename TGraph, typename TRandomGenerator>
+std::list<typename TGraph::vertex_descriptor> tourCrossover(
+    TGraph& graph,
+    std::list<typename TGraph::vertex_descriptor>& parent_a,
+    std::list<typename TGraph::vertex_descriptor>& parent_b,
+    TRandomGenerator& generator
+) {
+    typedef typename TGraph::vertex_descriptor VertexDescriptor;
+    if (parent_a.size() < 4 || parent_b.size() < 4) return parent_a;
+
+    // cycles without the repeated root at the end
+    std::vector<VertexDescriptor> child (parent_a.begin(), std::prev(parent_a.end()));
+    std::vector<VertexDescriptor> cycle_b (parent_b.begin(), std::prev(parent_b.end()));
+    std::vector<int> position (boost::num_vertices(graph), -1);
+    auto update_positions = [&]() {
+        std::fill(position.begin(), position.end(), -1);
+        for (int i = 0; i < (int) child.size(); i++) position[child[i]] = i;
+    };
+    update_positions();
+    std::bernoulli_distribution coin (0.5);
+
+    int k_b = cycle_b.size();
+    int i = 0;
+    while (i < k_b) {
+        VertexDescriptor u = cycle_b[i];
+        int j = i + 1;
+        while (j < i + k_b && position[cycle_b[j % k_b]] < 0) j++;
+        VertexDescriptor w = cycle_b[j % k_b];
+        if (j > i + 1 && u != w && position[u] >= 0 && coin(generator)) {
+            std::vector<VertexDescriptor> inner (cycle_b.begin() + i + 1, cycle_b.begin() + j);
+            int p = position[u];
+            int q = position[w];
+            if (p > q) {
+                // walk from w to u instead so the root stays at the front of the child
+                std::swap(p, q);
+                std::reverse(inner.begin(), inner.end());
+            }
+            std::vector<VertexDescriptor> new_child (child.begin(), child.begin() + p + 1);
+            new_child.insert(new_child.end(), inner.begin(), inner.end());
+            new_child.insert(new_child.end(), child.begin() + q, child.end());
+            child = new_child;
+            update_positions();
+        }
+        i = j;
+    }
+    std::list<VertexDescriptor> tour (child.begin(), child.end());
+    tour.push_back(child.front());
+    return tour;
+}
+
+/**
+ * @brief Restore the quota of the tour by extension, then improve it with
+ * path extension & collapse followed by 2-opt.
+ *
+ * The neighbourhood index is only read, so threads may share it.
+ */
+template <typename TGraph, typename TCostMap, typename TPrizeMap>
+MemeticIndividual<typename TGraph::vertex_descriptor> repairAndImproveTour(
+    TGraph& graph,
+    std::list<typename TGraph::vertex_descriptor>& tour,
+    TCostMap& cost_map,
+    TPrizeMap& prize_map,
+    PrizeNumberType& quota,
+    typename TGraph::vertex_descriptor& root_vertex,
+    bool collapse_shortest_paths,
+    int path_depth_limit,
+    int step_size,
+    const CandidateLists& candidates,
+    NeighborhoodIndex& neighborhood
+) {
+    MemeticIndividual<typename TGraph::vertex_descriptor> individual;
+    if (totalPrizeOfTour(prize_map, tour) < quota) {
+        extensionUntilPrizeFeasible(graph, tour, cost_map, prize_map, quota, candidates);
+    }
+    individual.tour = pathExtensionCollapse(graph, tour, cost_map, prize_map, quota, root_vertex, collapse_shortest_paths, path_depth_limit, step_size, neighborhood);
+    individual.is_feasible = individual.tour.size() > 0 && totalPrizeOfTour(prize_map, individual.tour) >= quota;
+    individual.cost = std::numeric_limits<CostNumberType>::max();
+    if (individual.is_feasible) {
+        twoOpt(graph, individual.tour, cost_map, candidates);
+        individual.cost = totalCost(graph, individual.tour, cost_map);
+    }
+    return individual;
+}
+
+/**
+ * @brief Run every job on the thread pool and wait for all of them to finish.
+ */
+template <typename TJob>
+void runJobsOnThreadPool(boost::asio::thread_pool& pool, std::vector<TJob>& jobs) {
+    std::vector<std::future<void>> futures;
+    for (auto& job : jobs) {
+        auto task = std::make_shared<std::packaged_task<void()>>(job);
+        futures.push_back(task->get_future());
+        boost::asio::post(pool, [task]() { (*task)(); });
+    }
+    // get() re-throws any exception raised inside a job
+    for (auto& future : futures) future.get();
+}
+
+/**
+ * @brief Population-based (memetic) search on top of path extension & collapse.
+ *
+ * The initial population is the path extension & collapse tour and perturbations of it.
+ * Each generation, pairs of parents chosen by binary tournament are recombined with
+ * tourCrossover and the children are repaired and improved by extension, path extension
+ * & collapse and 2-opt on a pool of num_threads threads (all hardware threads if
+ * num_threads is not positive). The best population_size distinct tours survive.
+ *
+ * Every child is given its own random seed drawn before the generation starts,
+ * so the search is deterministic for a fixed seed and number of generations
+ * regardless of the number of threads. The time limit is checked between generations.
+ *
+ * @return The least-cost prize-feasible tour found (empty if none found)
+ */
+template <typename TGraph, typename TCostMap, typename TPrizeMap>
+std::list<typename TGraph::vertex_descriptor> memeticSearch(
+    TGraph& graph,
+    std::list<typename TGraph::vertex_descriptor>& init_tour,
+    TCostMap& cost_map,
+    TPrizeMap& prize_map,
+    PrizeNumberType& quota,
+    typename TGraph::vertex_descriptor& root_vertex,
+    bool collapse_shortest_paths = false,
+    int path_depth_limit = 2,
+    int step_size = 1,
+    float time_limit = 60,
+    int num_threads = 1,
+    int population_size = 16,
+    int max_generations = -1,
+    unsigned int seed = PCTSP_DEFAULT_SEED,
+    const CandidateLists& candidates = CandidateLists()
+) {
+    typedef typename TGraph::vertex_descriptor TVertex;
+    typedef MemeticIndividual<TVertex> TIndividual;
+    using namespace std::chrono;
+    auto start_time = steady_clock::now();
+    std::mt19937 generator (seed);
+    if (num_threads <= 0) num_threads = std::max(std::thread::hardware_concurrency(), (unsigned int) 1);
+    population_size = std::max(population_size, 2);
+    // every child searches the same neighbourhood, so index it once
+    NeighborhoodIndex neighborhood = extensionNeighborhood(graph, candidates);
+
+    // the first individual is a local optimum of path extension & collapse
+    std::list<TVertex> first_tour = init_tour;
+    auto first = repairAndImproveTour(graph, first_tour, cost_map, prize_map, quota, root_vertex, collapse_shortest_paths, path_depth_limit, step_size, candidates, neighborhood);
+    if (!first.is_feasible) {
+        BOOST_LOG_TRIVIAL(warning) << "Memetic search did not find a prize-feasible starting tour.";
+        return first.tour;
+    }
+    boost::asio::thread_pool pool (num_threads);
+
+    // the rest of the initial population are perturbations of the first individual
+    std::vector<TIndividual> population (population_size, first);
+    std::vector<std::function<void()>> jobs;
+    for (int i = 1; i < population_size; i++) {
+        unsigned int child_seed = generator();
+        jobs.push_back([&, i, child_seed]() {
+            std::mt19937 child_generator (child_seed);
+            auto tour = first.tour;
+            perturbTour(graph, tour, cost_map, prize_map, quota, root_vertex, child_generator, path_depth_limit, neighborhood, 1 + i % 4);
+            if (!isTourInGraph(graph, tour)) tour = first.tour;
+            population[i] = repairAndImproveTour(graph, tour, cost_map, prize_map, quota, root_vertex, collapse_shortest_paths, path_depth_limit, step_size, candidates, neighborhood);
+        });
+    }
+    runJobsOnThreadPool(pool, jobs);
+
+    auto is_better = [](const TIndividual& a, const TIndividual& b) {
+        if (a.is_feasible != b.is_feasible) return a.is_feasible;
+        return a.cost < b.cost;
+    };
+    auto is_same_tour = [](const TIndividual& a, const TIndividual& b) {
+        if (a.cost != b.cost || a.tour.size() != b.tour.size()) return false;
+        return a.tour == b.tour || std::equal(a.tour.begin(), a.tour.end(), b.tour.rbegin());
+    };
+    auto select_survivors = [&](std::vector<TIndividual>& candidates) {
+        std::stable_sort(candidates.begin(), candidates.end(), is_better);
+        std::vector<TIndividual> survivors;
+        for (auto& candidate : candidates) {
+            if ((int) survivors.size() >= population_size || !candidate.is_feasible) break;
+            bool is_duplicate = std::any_of(survivors.begin(), survivors.end(), [&](const TIndividual& survivor) {
+                return is_same_tour(candidate, survivor);
+            });
+            if (!is_duplicate) survivors.push_back(candidate);
+        }
+        return survivors;
+    };
+    population = select_survivors(population);
+    auto best_cost = population.front().cost;
+
+    int generation = 0;
+    float elapsed = duration_cast<duration<float>>(steady_clock::now() - start_time).count();
+    while (elapsed < time_limit && (max_generations < 0 || generation < max_generations)) {
+        // binary tournament selection of the parents
+        std::uniform_int_distribution<int> pick (0, population.size() - 1);
+        auto tournament = [&]() {
+            int a = pick(generator);
+            int b = pick(generator);
+            return std::min(a, b);  // the population is sorted by cost
+        };
+        std::vector<TIndividual> offspring (population_size);
+        jobs.clear();
+        for (int i = 0; i < population_size; i++) {
+            int parent_a = tournament();
+            int parent_b = tournament();
+            unsigned int child_seed = generator();
+            jobs.push_back([&, i, parent_a, parent_b, child_seed]() {
+                std::mt19937 child_generator (child_seed);
+                auto tour = tourCrossover(graph, population[parent_a].tour, population[parent_b].tour, child_generator);
+                // mutate children that did not inherit anything from the second parent
+                if (tour == population[parent_a].tour) {
+                    perturbTour(graph, tour, cost_map, prize_map, quota, root_vertex, child_generator, path_depth_limit, neighborhood);
+                    if (!isTourInGraph(graph, tour)) tour = population[parent_a].tour;
+                }
+                offspring[i] = repairAndImproveTour(graph, tour, cost_map, prize_map, quota, root_vertex, collapse_shortest_paths, path_depth_limit, step_size, candidates, neighborhood);
+            });
+        }
+        runJobsOnThreadPool(pool, jobs);
+        generation++;
+
+        population.insert(population.end(), offspring.begin(), offspring.end());
+        population = select_survivors(population);
+        if (population.front().cost < best_cost) {
+            best_cost = population.front().cost;
+            BOOST_LOG_TRIVIAL(debug) << "Memetic search generation " << generation << " found tour with cost " << best_cost;
+        }
+        elapsed = duration_cast<duration<float>>(steady_clock::now() - start_time).count();
+    }
+    pool.join();
+    BOOST_LOG_TRIVIAL(info) << "Memetic search finished after " << generation << " generations with best cost " << best_cost;
+    return ReorderTourFromRoot(population.front().tour, root_vertex);
+}
+
+#endif
@@ -0,0 +1,93 @@
+/** k-d tree over vertex coordinates for nearest neighbour candidate lists */
+
+#ifndef __PCTSP_KDTREE__
+#define __PCTSP_KDTREE__
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/range/iterator_range.hpp>
+
+#include "neighborhood.hh"
+
+typedef std::pair<double, double> Point2D;
+
+/**
+ * @brief Balanced 2-d tree for K nearest neighbour queries in the plane.
+ */
+class KdTree {
+public:
+    KdTree(const std::vector<Point2D>& points);
+
+    /**
+     * @brief Indices of the (at most) k points nearest to the query point,
+     * nearest first with ties broken by the smallest index.
+     * The excluded index is never returned.
+     */
+    std::vector<std::size_t> nearest(const Point2D& query, std::size_t k, std::size_t excluded) const;
+
+private:
+    struct Node {
+        std::size_t point;
+        int axis;
+        int left;
+        int right;
+    };
+    int build(std::vector<std::size_t>& indices, int first, int last, int depth);
+    void search(int node, const Point2D& query, std::size_t k, std::size_t excluded, std::vector<std::pair<double, std::size_t>>& heap) const;
+
+    std::vector<Point2D> points_;
+    std::vector<Node> nodes_;
+    int root_;
+};
+
+double squaredDistance(const Point2D& a, const Point2D& b);
+
+/**
+ * @brief For every vertex, the (at most) k nearest vertices in the plane
+ * that are adjacent to it in the graph, nearest first.
+ *
+ * Low degree vertices sort their neighbours by distance. High degree
+ * vertices query the k-d tree, doubling the number of points returned
+ * until k of them are neighbours.
+ */
+template <typename TGraph>
+CandidateLists nearestNeighborCandidates(TGraph& graph, const std::vector<Point2D>& coordinates, std::size_t k) {
+    std::size_t n = num_vertices(graph);
+    CandidateLists candidates (n);
+    if (k == 0 || n == 0) return candidates;
+    KdTree tree (coordinates);
+    std::vector<bool> is_neighbor (n, false);
+    for (std::size_t u = 0; u < n; u++) {
+        std::vector<std::size_t> neighbors;
+        for (auto v : boost::make_iterator_range(adjacent_vertices(u, graph))) {
+            if (v != u && !is_neighbor[v]) {
+                is_neighbor[v] = true;
+                neighbors.push_back(v);
+            }
+        }
+        if (neighbors.size() <= 4 * k) {
+            auto closer = [&](std::size_t a, std::size_t b) {
+                double distance_a = squaredDistance(coordinates[u], coordinates[a]);
+                double distance_b = squaredDistance(coordinates[u], coordinates[b]);
+                return distance_a < distance_b || (distance_a == distance_b && a < b);
+            };
+            std::sort(neighbors.begin(), neighbors.end(), closer);
+            candidates[u].assign(neighbors.begin(), neighbors.begin() + std::min(k, neighbors.size()));
+        }
+        else {
+            for (std::size_t query_size = k; candidates[u].size() < k; query_size *= 2) {
+                candidates[u].clear();
+                for (auto v : tree.nearest(coordinates[u], query_size, u)) {
+                    if (is_neighbor[v] && candidates[u].size() < k) candidates[u].push_back(v);
+                }
+                if (query_size >= n) break;
+            }
+        }
+        for (auto v : neighbors) is_neighbor[v] = false;
+    }
+    return candidates;
+}
+
+#endif
@@ -0,0 +1,110 @@
+/** Lagrangian relaxation lower bound for the prize collecting TSP */
+
+#ifndef __PCTSP_LAGRANGIAN__
+#define __PCTSP_LAGRANGIAN__
+
+#include <limits>
+#include <vector>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/range/iterator_range.hpp>
+
+#include "primal_dual.hh"
+
+const int LAGRANGIAN_MAX_ITERATIONS = 1000;
+
+/** Edge of the graph given to the Lagrangian relaxation */
+struct LagrangianEdge {
+    std::size_t source;
+    std::size_t target;
+    double cost;
+};
+
+/** Best bound found by subgradient optimisation and the variables it fixes */
+struct LagrangianBound {
+    double lower_bound;
+    double upper_bound;
+    std::vector<double> vertex_multipliers;     // multipliers of the degree constraints
+    double quota_multiplier;                    // multiplier of the quota divided by the largest prize
+    int num_iterations;
+    std::vector<bool> is_edge_fixed;            // the edge is in no tour that costs at most the upper bound
+    std::vector<bool> is_vertex_fixed;          // every tour that costs at most the upper bound visits the vertex
+};
+
+/**
+ * @brief Lagrangian lower bound on the cost of a prize feasible tour.
+ *
+ * A dummy vertex z is joined to the root by a fixed edge and to every other
+ * vertex v by an edge meaning "v is not visited". A tour without one of its
+ * root edges, plus the edges to z of the unvisited vertices, is a spanning
+ * tree of V + z, so the subproblem is a minimum spanning tree of V + z with
+ * one extra edge at the root. The degree constraints x(delta(v)) = 2 y_v and
+ * the quota are relaxed with multipliers that are updated by subgradient
+ * optimisation with Polyak steps towards the upper bound.
+ *
+ * At the best multipliers, reduced costs of the spanning tree fix edges that
+ * are in no tour cheaper than the upper bound, and vertices whose "not
+ * visited" edge cannot be in a tour cheaper than the upper bound.
+ * Self loops are ignored.
+ */
+LagrangianBound lagrangianBound(
+    std::size_t n,
+    const std::vector<LagrangianEdge>& edges,
+    const std::vector<double>& prizes,
+    double quota,
+    std::size_t root,
+    double upper_bound,
+    int max_iterations = LAGRANGIAN_MAX_ITERATIONS
+);
+
+/**
+ * @brief Lagrangian lower bound of the graph. Edges are indexed in the order of
+ * boost::edges without self loops. If the upper bound is not positive, the
+ * cost of the primal-dual tour is used instead.
+ */
+template <typename TGraph, typename TCostMap, typename TPrizeMap>
+LagrangianBound lagrangianBound(
+    TGraph& graph,
+    TCostMap& cost_map,
+    TPrizeMap& prize_map,
+    PrizeNumberType quota,
+    typename TGraph::vertex_descriptor root_vertex,
+    double upper_bound = 0.0,
+    int max_iterations = LAGRANGIAN_MAX_ITERATIONS
+) {
+    std::size_t n = boost::num_vertices(graph);
+    std::vector<LagrangianEdge> edges;
+    double total_cost = 0.0;
+    for (auto edge : boost::make_iterator_range(boost::edges(graph))) {
+        std::size_t u = boost::source(edge, graph);
+        std::size_t v = boost::target(edge, graph);
+        if (u == v) continue;
+        edges.push_back({u, v, (double) cost_map[edge]});
+        total_cost += cost_map[edge];
+    }
+    std::vector<double> prizes (n);
+    for (std::size_t u = 0; u < n; u++) prizes[u] = prize_map[u];
+    if (upper_bound <= 0.0) {
+        std::list<typename TGraph::vertex_descriptor> tour;
+        primalDualTour(graph, tour, cost_map, prize_map, quota, root_vertex);
+        upper_bound = tour.empty() ? total_cost : totalCost(graph, tour, cost_map);
+    }
+    return lagrangianBound(n, edges, prizes, quota, root_vertex, upper_bound, max_iterations);
+}
+
+/** Edges of the graph fixed to zero by the Lagrangian bound */
+template <typename TGraph>
+std::vector<typename boost::graph_traits<TGraph>::edge_descriptor> lagrangianFixedEdges(
+    TGraph& graph,
+    const LagrangianBound& bound
+) {
+    std::vector<typename boost::graph_traits<TGraph>::edge_descriptor> fixed_edges;
+    std::size_t index = 0;
+    for (auto edge : boost::make_iterator_range(boost::edges(graph))) {
+        if (boost::source(edge, graph) == boost::target(edge, graph)) continue;
+        if (index < bound.is_edge_fixed.size() && bound.is_edge_fixed[index]) fixed_edges.push_back(edge);
+        index++;
+    }
+    return fixed_edges;
+}
+
+#endif
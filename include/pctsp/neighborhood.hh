@@ -0,0 +1,217 @@
+/** Index over the neighbourhoods of vertices for fast common-neighbour queries */
+
+#ifndef __PCTSP_NEIGHBORHOOD__
+#define __PCTSP_NEIGHBORHOOD__
+
+#include <cstdint>
+#include <iterator>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/range/iterator_range.hpp>
+
+/**
+ * @brief Packed set of vertices with one bit per vertex.
+ */
+class VertexBitset {
+public:
+    VertexBitset(std::size_t n = 0);
+
+    void set(std::size_t u);
+    void reset(std::size_t u);
+    bool test(std::size_t u) const;
+
+    /** Remove every vertex from the set */
+    void clear();
+
+    std::size_t size() const;
+    const std::vector<std::uint64_t>& words() const;
+
+private:
+    std::size_t n_;
+    std::vector<std::uint64_t> words_;
+};
+
+/**
+ * @brief Forward iterator over the neighbours of a vertex in ascending order.
+ *
+ * Walks the sorted adjacency array, or the set bits of the adjacency bitset
+ * one word at a time, so the neighbours are read in place without a copy.
+ */
+class NeighborIterator {
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef std::size_t value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const std::size_t* pointer;
+    typedef std::size_t reference;
+
+    NeighborIterator() : array_(nullptr), words_(nullptr), num_words_(0), word_(0), bits_(0) {}
+
+    /** Position in a sorted adjacency array */
+    explicit NeighborIterator(const std::size_t* array)
+        : array_(array), words_(nullptr), num_words_(0), word_(0), bits_(0) {}
+
+    /** First set bit of the bitset at or after the given word */
+    NeighborIterator(const std::uint64_t* words, std::size_t num_words, std::size_t word)
+        : array_(nullptr), words_(words), num_words_(num_words), word_(word), bits_(word < num_words ? words[word] : 0) {
+        skipEmptyWords();
+    }
+
+    std::size_t operator*() const {
+        if (array_) return *array_;
+        return word_ * 64 + __builtin_ctzll(bits_);
+    }
+
+    NeighborIterator& operator++() {
+        if (array_) ++array_;
+        else {
+            bits_ &= bits_ - 1;
+            skipEmptyWords();
+        }
+        return *this;
+    }
+
+    NeighborIterator operator++(int) {
+        NeighborIterator copy (*this);
+        ++(*this);
+        return copy;
+    }
+
+    bool operator==(const NeighborIterator& other) const {
+        return array_ == other.array_ && word_ == other.word_ && bits_ == other.bits_;
+    }
+
+    bool operator!=(const NeighborIterator& other) const {
+        return !(*this == other);
+    }
+
+private:
+    void skipEmptyWords() {
+        while (bits_ == 0 && word_ < num_words_) {
+            if (++word_ < num_words_) bits_ = words_[word_];
+        }
+    }
+
+    const std::size_t* array_;
+    const std::uint64_t* words_;
+    std::size_t num_words_;
+    std::size_t word_;
+    std::uint64_t bits_;
+};
+
+typedef boost::iterator_range<NeighborIterator> NeighborRange;
+
+/** Candidate neighbours of every vertex, e.g. its K nearest neighbours */
+typedef std::vector<std::vector<std::size_t>> CandidateLists;
+
+/** Codes for how the neighbourhood index stores adjacency */
+struct NeighborhoodRepresentation {
+    static const unsigned int AUTO;
+    static const unsigned int SORTED_ADJACENCY;
+    static const unsigned int BITSET;
+};
+
+/**
+ * @brief Sorted adjacency arrays (sparse graphs) or packed adjacency bitsets
+ * (dense graphs) that answer "which vertices are adjacent to both u and v
+ * and not in the set X" without sorting or hashing.
+ *
+ * Sorted arrays are intersected by galloping through the longer array.
+ * Bitsets are intersected one 64-bit word at a time with AND / ANDNOT.
+ * AUTO picks bitsets when the average degree is at least n / 64, where a word
+ * of the bitset covers as many vertices as one entry of an adjacency array.
+ * Only one of the two representations is kept in memory.
+ * Self loops are ignored.
+ */
+class NeighborhoodIndex {
+public:
+    template <typename TGraph>
+    NeighborhoodIndex(TGraph& graph, unsigned int representation = NeighborhoodRepresentation::AUTO) {
+        std::vector<std::vector<std::size_t>> adjacency (num_vertices(graph));
+        for (auto edge : boost::make_iterator_range(edges(graph))) {
+            std::size_t u = source(edge, graph);
+            std::size_t v = target(edge, graph);
+            if (u == v) continue;
+            adjacency[u].push_back(v);
+            adjacency[v].push_back(u);
+        }
+        build(adjacency, representation);
+    }
+
+    /**
+     * @brief Index over the graph whose edges are (u, v) for every candidate v of u,
+     * so extension only considers candidate neighbours.
+     */
+    static NeighborhoodIndex fromCandidateLists(const CandidateLists& candidates, unsigned int representation = NeighborhoodRepresentation::AUTO);
+
+    bool usesBitsets() const;
+    std::size_t numVertices() const;
+
+    /** Sorted neighbours of u, read in place from the array or the bitset of u */
+    NeighborRange neighbors(std::size_t u) const;
+
+    /**
+     * @brief Vertices adjacent to both u and v that are not in the excluded set,
+     * in ascending order.
+     */
+    std::vector<std::size_t> commonNeighborsNotIn(std::size_t u, std::size_t v, const VertexBitset& excluded) const;
+
+private:
+    NeighborhoodIndex() = default;
+    void build(std::vector<std::vector<std::size_t>>& adjacency, unsigned int representation);
+
+    std::size_t n_;
+    bool uses_bitsets_;
+    std::vector<std::vector<std::size_t>> sorted_adjacency_;
+    std::vector<VertexBitset> adjacency_bitsets_;
+};
+
+/**
+ * @brief Paths of at most k edges between two tour vertices whose internal
+ * vertices are all outside the tour.
+ *
+ * Each tour vertex keeps a breadth first search tree of radius ceil(k / 2) over
+ * the vertices outside the tour. A path from u to v is the tree path from u to a
+ * meeting vertex followed by the tree path from the meeting vertex to v, so the
+ * trees of u and v together cover every path length up to k.
+ *
+ * Trees are memoised between queries. A tree is only searched again after one
+ * of the vertices it reached, or one of the tour vertices that blocked it, joins
+ * or leaves the tour; call invalidate for those vertices.
+ */
+class ExternalPathIndex {
+public:
+    ExternalPathIndex(const NeighborhoodIndex& neighborhood, const VertexBitset& in_tour, int path_depth_limit);
+
+    /**
+     * @brief Simple paths from u to v with between 2 and k edges and no
+     * internal vertex in the tour. At most one path per meeting vertex.
+     */
+    std::vector<std::vector<std::size_t>> externalPaths(std::size_t u, std::size_t v);
+
+    /** Forget every search tree that depends on whether u is in the tour */
+    void invalidate(std::size_t u);
+
+    /** Number of breadth first searches run since construction */
+    std::size_t numSearches() const;
+
+private:
+    struct SearchTree {
+        bool is_valid = false;
+        std::vector<std::size_t> vertices;
+        std::unordered_map<std::size_t, std::pair<std::size_t, int>> parent_and_depth;
+    };
+    SearchTree& searchTree(std::size_t source);
+
+    const NeighborhoodIndex& neighborhood_;
+    const VertexBitset& in_tour_;
+    int path_depth_limit_;
+    int radius_;
+    std::vector<SearchTree> trees_;
+    std::vector<std::unordered_set<std::size_t>> sources_touching_;
+    std::size_t num_searches_;
+};
+
+#endif
@@ -1,8 +1,79 @@
 #ifndef __PCTSP_NODE_SELECTION__
 #define __PCTSP_NODE_SELECTION__
 
-#include <scip/scip.h>
+#include <string>
+#include <vector>
+#include <objscip/objscip.h>
+
+const std::string MEMORY_NODESEL_NAME = "pctsp_memory";
+const std::string MEMORY_NODESEL_DESC = "Best estimate search that plunges while memory is short";
+const int MEMORY_NODESEL_STDPRIORITY = 300000;      // above the estimate selector
+const int MEMORY_NODESEL_MEMSAVEPRIORITY = 300000;
 
 void includeNodeSelection(SCIP* scip);
 
-#endif
\ No newline at end of file
+/** A change of the mode of the memory aware node selector */
+struct NodeSelectionSwitch {
+    long long node_number;  // number of nodes processed before the switch
+    double memory_used;     // tracked memory in MB
+    bool plunging;          // true if the selector started to plunge
+};
+
+/**
+ * @brief Best estimate search that plunges while memory is short.
+ *
+ * The tracked memory is the memory of SCIP plus the node statistics and bounds
+ * recorded by the PCTSP event handlers. Once it passes switch_fraction of the
+ * memory limit, the selector takes the children and then the siblings of the
+ * last node before any leaf, so that open subtrees are closed rather than
+ * opened. Once it drops below switch_back_fraction of the limit, the node with
+ * the smallest estimate is selected again. Leaves are always ordered by
+ * estimate, then by lower bound.
+ */
+class MemoryAwareNodesel : public scip::ObjNodesel {
+private:
+    double memory_limit;          // MB
+    double switch_fraction;
+    double switch_back_fraction;
+    bool plunging;
+    std::vector<NodeSelectionSwitch> switches;
+
+public:
+    MemoryAwareNodesel(SCIP* scip, double _memory_limit, double _switch_fraction, double _switch_back_fraction)
+        : ObjNodesel(scip, MEMORY_NODESEL_NAME.c_str(), MEMORY_NODESEL_DESC.c_str(), MEMORY_NODESEL_STDPRIORITY,
+                     MEMORY_NODESEL_MEMSAVEPRIORITY)
+    {
+        memory_limit = _memory_limit;
+        switch_fraction = _switch_fraction;
+        switch_back_fraction = _switch_back_fraction;
+        plunging = false;
+    }
+
+    /** Memory of SCIP and the PCTSP event handlers in MB */
+    double getTrackedMemory(SCIP* scip);
+
+    bool isPlunging();
+
+    /** Start or stop plunging for the tracked memory in MB after node_number nodes */
+    void updateMode(double memory_used, long long node_number);
+
+    /** Every change of mode since the start of the solve */
+    std::vector<NodeSelectionSwitch> getSwitches();
+
+    SCIP_DECL_NODESELINITSOL(scip_initsol);
+    SCIP_DECL_NODESELSELECT(scip_select);
+    SCIP_DECL_NODESELCOMP(scip_comp);
+};
+
+/**
+ * @brief Include the memory aware node selector with a memory limit in MB.
+ * It has a higher priority than the selectors of includeNodeSelection.
+ */
+SCIP_RETCODE includeMemoryAwareNodeSelection(
+    SCIP* scip,
+    double memory_limit,
+    double switch_fraction = 0.8,
+    double switch_back_fraction = 0.6
+);
+
+#endif
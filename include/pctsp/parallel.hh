@@ -0,0 +1,161 @@
+/** Branch and bound over subtrees of the PCTSP search tree on several SCIP instances */
+
+#ifndef __PCTSP_PARALLEL__
+#define __PCTSP_PARALLEL__
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <vector>
+#include <objscip/objscip.h>
+
+#include "branching.hh"
+#include "graph.hh"
+#include "stats.hh"
+
+/** An open subtree: the vertices fixed on the path from the root node */
+struct SubtreeTask {
+    std::vector<std::pair<PCTSPvertex, bool>> fixings;  // (vertex, true) if the vertex must be visited
+    double lower_bound;                                 // dual bound of the parent subtree
+    bool splittable;                                    // false if the subtree must be solved to the end
+};
+
+/** The best tour found by any worker */
+class SharedIncumbent {
+private:
+    std::mutex mutex;
+    double cost;
+    std::vector<PCTSPedge> edges;
+
+public:
+    SharedIncumbent();
+
+    /** Replace the incumbent if the tour is cheaper, return true if it was replaced */
+    bool offer(double tour_cost, std::vector<PCTSPedge>& tour_edges);
+    double getCost();
+    std::vector<PCTSPedge> getEdges();
+};
+
+/** A SEC over the edges of the graph, so that any worker can add it to its problem */
+struct SharedSEC {
+    std::vector<PCTSPedge> edges;
+    std::vector<double> coefs;
+};
+
+/**
+ * @brief Subtour elimination constraints separated by any worker.
+ *
+ * SECs do not depend on the vertex fixings of a subtree, so every SEC is
+ * globally valid. SECs are keyed by constraint name and added at most once.
+ */
+class SharedSECPool {
+private:
+    std::mutex mutex;
+    std::map<std::string, SharedSEC> secs;
+    std::vector<std::string> names;  // in the order the SECs were added
+
+public:
+    /** Add a SEC, return false if a SEC with the same name is in the pool */
+    bool add(std::string name, SharedSEC& sec);
+    std::map<std::string, SharedSEC> getSECs();
+
+    /** SECs added after the first num_seen SECs, in the order they were added */
+    std::vector<std::pair<std::string, SharedSEC>> getSECsAddedAfter(std::size_t num_seen);
+    std::size_t size();
+};
+
+/**
+ * @brief One deque of subtrees per worker.
+ *
+ * A worker pops the newest subtree of its own deque, so that it dives into the
+ * subtrees it created, and otherwise steals the oldest subtree of the next
+ * worker with work, which is the largest subtree left. pop blocks while
+ * another worker is solving a subtree that may be split and returns false once
+ * every deque is empty and no worker is busy, or after stop.
+ */
+class WorkStealingQueue {
+private:
+    std::vector<std::deque<SubtreeTask>> deques;
+    std::mutex mutex;
+    std::condition_variable work_changed;
+    std::size_t num_busy_workers;
+    std::size_t num_stolen;
+    bool stopped;
+
+public:
+    WorkStealingQueue(std::size_t num_workers);
+
+    void push(std::size_t worker, SubtreeTask& task);
+
+    /** Take a subtree for the worker, the worker is busy until it calls finish */
+    bool pop(std::size_t worker, SubtreeTask& task);
+
+    /** Mark the subtree of the worker as done, push its children first */
+    void finish();
+
+    /** Wake every worker and let pop return false */
+    void stop();
+
+    /** Remove and return the subtrees that were never solved */
+    std::vector<SubtreeTask> drain();
+    std::size_t getNumStolen();
+};
+
+/** Bounds and best tour of a parallel solve */
+struct ParallelSolveStats {
+    SummaryStats summary;                   // nodes and cuts are summed over every subtree
+    std::vector<PCTSPedge> solution_edges;  // edges of the best tour without self loops
+    unsigned int num_subtrees;              // subtrees solved, including the root
+    unsigned int num_stolen_subtrees;       // subtrees solved by a worker that did not create them
+    std::size_t num_shared_secs;            // SECs in the central pool at the end
+    double solving_time;
+};
+
+/**
+ * @brief Solve the prize collecting TSP by branching on vertices across
+ * several SCIP instances.
+ *
+ * The root subtree is solved first. A subtree that is not solved within
+ * subtree_node_limit nodes is split on the self loops of its root LP with the
+ * most fractional values: the root subtree into at least num_workers subtrees,
+ * other subtrees into two. Every worker owns a SCIP instance with the PCTSP
+ * plugins and builds the model of a subtree with the vertex fixings, the SECs
+ * of the central pool and an objective limit equal to the cost of the
+ * incumbent. Subtrees are distributed with a WorkStealingQueue. Workers share
+ * new incumbents while solving and add the tours of other workers as
+ * solutions when they satisfy the vertex fixings of the subtree.
+ *
+ * In deterministic mode subtrees are solved in rounds of at most num_workers
+ * subtrees. Every subtree of a round sees the incumbent and SECs of the end of
+ * the previous round and the results are merged in the order of the subtrees,
+ * so the tour, bounds and node counts only depend on the input.
+ *
+ * The status is optimal if a tour was found and every subtree was closed,
+ * infeasible if no tour was found and every subtree was closed, and the time
+ * limit otherwise. The lower bound is the smallest bound of an open subtree.
+ * If SCIP fails to solve a subtree, no further subtrees are started and a
+ * SubtreeSolveError is thrown once every worker stopped.
+ */
+ParallelSolveStats solvePrizeCollectingTSPParallel(
+    PCTSPgraph& graph,
+    std::vector<PCTSPedge>& heuristic_edges,
+    EdgeCostMap& cost_map,
+    VertexPrizeMap& prize_map,
+    PrizeNumberType quota,
+    PCTSPvertex root_vertex,
+    std::size_t num_workers,
+    bool deterministic = false,
+    long long subtree_node_limit = 1000,
+    int branching_max_depth = -1,
+    unsigned int branching_strategy = BranchingStrategy::RELPSCOST,
+    bool sec_disjoint_tour = true,
+    double sec_lp_gap_improvement_threshold = 0.01,
+    bool sec_maxflow_mincut = true,
+    int sec_max_tailing_off_iterations = -1,
+    int sec_sepafreq = 1,
+    float time_limit = 14400,
+    std::string name = "pctsp-parallel"
+);
+
+#endif
@@ -0,0 +1,93 @@
+/** A pool of SCIP instances with the PCTSP plugins included */
+
+#ifndef __PCTSP_POOL__
+#define __PCTSP_POOL__
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+#include <objscip/objscip.h>
+
+#include "branching.hh"
+#include "graph.hh"
+#include "stats.hh"
+
+/** Bounds and best tour of an instance solved by the pool */
+struct PoolSolveResult {
+    SummaryStats summary;
+    std::vector<PCTSPedge> solution_edges;  // edges of the best tour without self loops
+    double solving_time;
+};
+
+/**
+ * @brief Solve many instances of the prize collecting TSP without creating a
+ * SCIP instance for each one.
+ *
+ * Every SCIP instance of the pool is created once with the message handler
+ * silenced and the PCTSP plugins, node event handler, branching strategy and
+ * SEC settings of the pool. A solve borrows a free instance, creates the
+ * problem, solves it and frees the problem with SCIPfreeProb, which keeps the
+ * plugins and parameters for the next instance. No log files are written.
+ *
+ * solve may be called from several threads; it blocks until an instance is
+ * free. solveBatch solves the instances on one thread per SCIP instance.
+ * Edge pricing, cost covers and cycle covers are not available in the pool.
+ */
+class SolverPool {
+private:
+    std::vector<SCIP*> environments;
+    std::vector<SCIP*> free_environments;
+    std::mutex environments_mutex;
+    std::condition_variable environment_released;
+    float time_limit;
+
+    /** Wait for a free SCIP instance and take it out of the pool */
+    SCIP* acquireEnvironment();
+
+    /** Return a SCIP instance without a problem to the pool */
+    void releaseEnvironment(SCIP* scip);
+
+public:
+    SolverPool(
+        std::size_t pool_size,
+        int branching_max_depth = -1,
+        unsigned int branching_strategy = BranchingStrategy::RELPSCOST,
+        bool sec_disjoint_tour = true,
+        double sec_lp_gap_improvement_threshold = 0.01,
+        bool sec_maxflow_mincut = true,
+        int sec_max_tailing_off_iterations = -1,
+        int sec_sepafreq = 1,
+        float time_limit = 14400
+    );
+    ~SolverPool();
+    SolverPool(const SolverPool&) = delete;
+    SolverPool& operator=(const SolverPool&) = delete;
+
+    std::size_t getPoolSize();
+    std::size_t getNumFreeEnvironments();
+
+    /** Solve one instance, self loops are added to the graph if missing */
+    PoolSolveResult solve(
+        PCTSPgraph& graph,
+        EdgeCostMap& cost_map,
+        VertexPrizeMap& prize_map,
+        PrizeNumberType quota,
+        PCTSPvertex root_vertex,
+        std::vector<PCTSPedge>& heuristic_edges,
+        std::string name = "pctsp-pool"
+    );
+
+    /**
+     * @brief Solve every instance in parallel, at most one per SCIP instance of
+     * the pool. The costs and prizes are the edge_weight and vertex_distance
+     * properties of each graph. Results are in the order of the graphs.
+     */
+    std::vector<PoolSolveResult> solveBatch(
+        std::vector<PCTSPgraph>& graphs,
+        std::vector<PrizeNumberType>& quotas,
+        std::vector<PCTSPvertex>& root_vertices,
+        std::string name = "pctsp-pool"
+    );
+};
+
+#endif
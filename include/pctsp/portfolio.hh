@@ -0,0 +1,73 @@
+/** Race differently configured solvers on the same instance of the prize collecting TSP */
+
+#ifndef __PCTSP_PORTFOLIO__
+#define __PCTSP_PORTFOLIO__
+
+#include <string>
+#include <vector>
+#include <objscip/objscip.h>
+
+#include "branching.hh"
+#include "graph.hh"
+#include "parallel.hh"
+#include "stats.hh"
+
+/** Branching and SEC settings of one solver of the portfolio */
+struct SolverVariant {
+    std::string name;
+    int branching_max_depth;
+    unsigned int branching_strategy;
+    bool sec_disjoint_tour;
+    double sec_lp_gap_improvement_threshold;
+    bool sec_maxflow_mincut;
+    int sec_max_tailing_off_iterations;
+    int sec_sepafreq;
+};
+
+/** Strong branching, reliability pseudo costs and strong branching at the top of the tree */
+std::vector<SolverVariant> defaultSolverVariants();
+
+/** Bounds and exchanges of one solver of the portfolio */
+struct VariantStats {
+    std::string name;
+    SummaryStats summary;
+    unsigned int num_imported_tours;     // tours of other variants added as solutions
+    unsigned int num_imported_secs;      // SECs of other variants added to the global cut pool
+    unsigned int num_exported_secs;      // SECs separated by this variant and put in the shared pool
+    bool finished;                       // true if the variant proved optimality or infeasibility
+    double solving_time;
+};
+
+/** Bounds and best tour of a portfolio solve */
+struct PortfolioSolveStats {
+    SummaryStats summary;                   // bounds over every variant, counts of the winner
+    std::vector<PCTSPedge> solution_edges;  // edges of the best tour without self loops
+    std::vector<VariantStats> variants;     // in the order of the variants
+    int winner;                             // index of the first variant to finish, -1 if none did
+    double solving_time;
+};
+
+/**
+ * @brief Solve the prize collecting TSP with several solver variants at
+ * once, each on its own thread and SCIP instance.
+ *
+ * After every node a variant adds the shared incumbent as a solution if it
+ * is cheaper than its own, adds the SECs separated by other variants to its
+ * global cut pool and puts the SECs it separated in the shared pool. The
+ * first variant to finish wins and interrupts the others. The upper bound is
+ * the cost of the shared incumbent and the lower bound is the best dual bound
+ * of any variant, since every variant solves the same problem.
+ */
+PortfolioSolveStats solvePrizeCollectingTSPPortfolio(
+    PCTSPgraph& graph,
+    std::vector<PCTSPedge>& heuristic_edges,
+    EdgeCostMap& cost_map,
+    VertexPrizeMap& prize_map,
+    PrizeNumberType quota,
+    PCTSPvertex root_vertex,
+    std::vector<SolverVariant>& variants,
+    float time_limit = 14400,
+    std::string name = "pctsp-portfolio"
+);
+
+#endif
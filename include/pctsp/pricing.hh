@@ -0,0 +1,144 @@
+/** Pricing edge variables into a sparse model of the prize collecting TSP */
+
+#ifndef __PCTSP_PRICING__
+#define __PCTSP_PRICING__
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/range/iterator_range.hpp>
+#include <objscip/objscip.h>
+
+#include "graph.hh"
+#include "sciputils.hh"
+
+/**
+ * @brief Edges of the sparse core of a complete graph: the k cheapest edges
+ * incident to every vertex, every self loop and every required edge
+ * (e.g. the edges of a heuristic tour). Edges are in the order of boost::edges.
+ */
+template <typename TGraph, typename TCostMap>
+std::vector<typename boost::graph_traits<TGraph>::edge_descriptor> nearestNeighborCoreEdges(
+    TGraph& graph,
+    TCostMap& cost_map,
+    std::size_t k,
+    std::vector<typename boost::graph_traits<TGraph>::edge_descriptor>& required_edges
+) {
+    typedef typename boost::graph_traits<TGraph>::edge_descriptor Edge;
+    std::set<Edge> core (required_edges.begin(), required_edges.end());
+    for (auto u : boost::make_iterator_range(boost::vertices(graph))) {
+        std::vector<std::pair<CostNumberType, Edge>> incident;
+        for (auto edge : boost::make_iterator_range(boost::out_edges(u, graph))) {
+            if (boost::source(edge, graph) != boost::target(edge, graph)) incident.push_back({cost_map[edge], edge});
+        }
+        auto last = incident.begin() + std::min(k, incident.size());
+        std::partial_sort(incident.begin(), last, incident.end(), [&](auto& a, auto& b) {
+            return a.first < b.first || (a.first == b.first && boost::target(a.second, graph) < boost::target(b.second, graph));
+        });
+        for (auto it = incident.begin(); it != last; it++) core.insert(it->second);
+    }
+    std::vector<Edge> core_edges;
+    for (auto edge : boost::make_iterator_range(boost::edges(graph))) {
+        if (boost::source(edge, graph) == boost::target(edge, graph) || core.count(edge) > 0) core_edges.push_back(edge);
+    }
+    return core_edges;
+}
+
+/** Edges of the graph without a variable in the model, ignoring self loops */
+std::vector<PCTSPedge> getEdgesWithoutVariables(PCTSPgraph& graph, PCTSPedgeVariableMap& edge_variable_map);
+
+const std::string EDGE_PRICER_NAME = "pctsp_edge_pricer";
+const std::string EDGE_PRICER_DESC = "Prices edges with negative reduced cost into the model";
+const int EDGE_PRICER_PRIORITY = 0;
+const bool EDGE_PRICER_DELAY = true;
+
+/**
+ * @brief Column generation over the edges that are not in the model.
+ *
+ * The reduced cost of an edge uv is its cost minus the duals of the degree
+ * constraints of u and v and every subtour elimination
+ * or cycle cover row whose vertex set contains both u and v. Rows of x(E(S))
+ * are modifiable, so they are registered with the pricer when separated and
+ * every priced edge inside S joins them. The prize, root and cost cover
+ * constraints only contain self loops, so they are never priced.
+ *
+ * The duals of the rows x(E(S)) <= ... are never positive, so they only raise
+ * the reduced cost and the rows are only scanned for edges whose reduced cost
+ * is negative without them. The rows are indexed by vertex, so only the rows
+ * of one endpoint of an edge are scanned. Each round adds at most as many edges as there
+ * are vertices, most negative reduced cost first.
+ */
+class EdgePricer : public scip::ObjPricer
+{
+private:
+    std::vector<PCTSPedge> priceable_edges_;
+    std::map<PCTSPvertex, SCIP_CONS*> orig_degree_conss_;
+    std::vector<SCIP_CONS*> degree_conss_;
+    std::vector<std::pair<SCIP_ROW*, std::vector<PCTSPvertex>>> induced_rows_;
+    std::vector<std::vector<std::size_t>> rows_of_vertex_;
+    unsigned int num_priced_vars_;
+
+    SCIP_RETCODE priceEdges(SCIP* scip, bool farkas, SCIP_RESULT* result);
+    SCIP_RETCODE addEdgeVariable(SCIP* scip, PCTSPedge edge);
+
+    /** Indices of the induced rows that contain both u and v */
+    std::vector<std::size_t> rowsContainingEdge(PCTSPvertex u, PCTSPvertex v);
+
+public:
+    EdgePricer(SCIP* scip, std::vector<PCTSPedge>& priceable_edges, std::map<PCTSPvertex, SCIP_CONS*>& degree_conss)
+        : ObjPricer(scip, EDGE_PRICER_NAME.c_str(), EDGE_PRICER_DESC.c_str(), EDGE_PRICER_PRIORITY, EDGE_PRICER_DELAY)
+    {
+        priceable_edges_ = priceable_edges;
+        orig_degree_conss_ = degree_conss;
+        num_priced_vars_ = 0;
+    }
+
+    /** Never price these edges, e.g. because they are fixed to zero */
+    void removePriceableEdges(std::vector<PCTSPedge>& edges);
+
+    /** Register a separated row over x(E(S)) so that priced edges inside S join it */
+    void addInducedEdgesRow(SCIP_ROW* row, std::vector<PCTSPvertex>& vertex_set);
+
+    unsigned int getNumPricedVars();
+
+    SCIP_DECL_PRICERINIT(scip_init);
+    SCIP_DECL_PRICEREXITSOL(scip_exitsol);
+    SCIP_DECL_PRICERREDCOST(scip_redcost);
+    SCIP_DECL_PRICERFARKAS(scip_farkas);
+};
+
+/** The edge pricer of the model. NULL if edges are not priced. */
+EdgePricer* findEdgePricer(SCIP* scip);
+
+/**
+ * @brief Include and activate the edge pricer, which prices the edges without a variable
+ * into the degree constraints of their endpoints.
+ */
+SCIP_RETCODE includeEdgePricer(
+    SCIP* scip,
+    PCTSPgraph& graph,
+    PCTSPedgeVariableMap& edge_variable_map,
+    std::map<PCTSPvertex, SCIP_CONS*>& degree_conss
+);
+
+/**
+ * @brief Add a row over the edges induced by the vertex set, see addRow.
+ * When edges are priced, the row is modifiable and registered with the pricer.
+ */
+SCIP_RETCODE addInducedEdgesRow(
+    SCIP* scip,
+    SCIP_CONSHDLR* conshdlr,
+    SCIP_RESULT* result,
+    SCIP_SOL* sol,
+    VarVector& vars,
+    std::vector<double>& var_coefs,
+    double& lhs,
+    double& rhs,
+    std::string& name,
+    std::vector<PCTSPvertex>& vertex_set,
+    SCIP_ROW** added_row = NULL
+);
+
+#endif
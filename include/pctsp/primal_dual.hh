@@ -0,0 +1,322 @@
+/** Primal-dual (Goemans-Williamson) initial solution and lower bound */
+
+#ifndef __PCTSP_PRIMAL_DUAL__
+#define __PCTSP_PRIMAL_DUAL__
+
+#include <deque>
+#include <vector>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/range/iterator_range.hpp>
+
+#include "heuristic.hh"
+
+/** Edge of the graph given to the primal-dual algorithm */
+struct PrimalDualEdge {
+    std::size_t source;
+    std::size_t target;
+    double cost;
+};
+
+/** Tree containing the root found by the primal-dual algorithm */
+struct PrimalDualTree {
+    std::vector<std::size_t> edges;     // indices of the edges in the tree
+    double dual_objective;              // sum of the duals of the sets not containing the root
+};
+
+/**
+ * @brief The Goemans-Williamson primal-dual algorithm for the rooted prize
+ * collecting Steiner tree with penalty[v] for leaving v out of the tree.
+ *
+ * Every component not containing the root grows its dual at the same rate
+ * until an edge between two components becomes tight (the components merge)
+ * or the duals inside the component equal its penalty (it stops growing).
+ * Events are kept in a priority queue and loads in a union-find, so the
+ * algorithm takes O(m log m) time in practice.
+ *
+ * The sum of the duals is a lower bound on the cost of the tree plus the
+ * penalties of the vertices outside the tree. The edges are not pruned.
+ */
+PrimalDualTree goemansWilliamsonTree(
+    std::size_t n,
+    const std::vector<PrimalDualEdge>& edges,
+    const std::vector<double>& penalties,
+    std::size_t root
+);
+
+/**
+ * @brief Strong pruning of a tree rooted at the root: a subtree is cut off
+ * when the penalties it collects (net of the edges it needs) do not pay for
+ * the edge joining it to its parent. Returns the indices of the kept edges.
+ */
+std::vector<std::size_t> strongPruning(
+    std::size_t n,
+    const std::vector<PrimalDualEdge>& edges,
+    const std::vector<std::size_t>& tree_edges,
+    const std::vector<double>& penalties,
+    std::size_t root
+);
+
+/**
+ * @brief Insert the vertex outside the tour that adds the least cost
+ * between two consecutive vertices of the tour. A tour of only the root
+ * is the walk (root, root). Returns false if no vertex can be inserted.
+ */
+template <typename TGraph, typename TCostMap>
+bool insertCheapestVertex(
+    TGraph& graph,
+    std::list<typename TGraph::vertex_descriptor>& tour,
+    TCostMap& cost_map
+) {
+    typedef typename TGraph::vertex_descriptor Vertex;
+    std::vector<bool> in_tour (boost::num_vertices(graph), false);
+    for (auto u : tour) in_tour[u] = true;
+    CostNumberType best_increase = std::numeric_limits<CostNumberType>::max();
+    auto best_position = tour.end();
+    Vertex best_vertex = 0;
+    auto it = tour.begin();
+    for (auto next = std::next(it); next != tour.end(); it++, next++) {
+        auto u = *it;
+        auto w = *next;
+        CostNumberType cost_uw = u == w ? 0 : costOfVertexPair(graph, cost_map, u, w).first;
+        for (auto x : boost::make_iterator_range(boost::adjacent_vertices(u, graph))) {
+            if (in_tour[x]) continue;
+            auto cost_xw = costOfVertexPair(graph, cost_map, x, w);
+            if (!cost_xw.second) continue;
+            CostNumberType increase = costOfVertexPair(graph, cost_map, u, x).first + cost_xw.first - cost_uw;
+            if (increase < best_increase) {
+                best_increase = increase;
+                best_position = next;
+                best_vertex = x;
+            }
+        }
+    }
+    if (best_position == tour.end()) return false;
+    tour.insert(best_position, best_vertex);
+    return true;
+}
+
+/**
+ * @brief Shortest path (in edges) from u to v whose internal vertices are
+ * not yet visited. The path excludes u and includes v; empty if none exists.
+ */
+template <typename TGraph>
+std::list<typename TGraph::vertex_descriptor> unvisitedPath(
+    TGraph& graph,
+    typename TGraph::vertex_descriptor u,
+    typename TGraph::vertex_descriptor v,
+    std::vector<bool>& visited
+) {
+    typedef typename TGraph::vertex_descriptor Vertex;
+    std::list<Vertex> path;
+    std::vector<Vertex> parent (boost::num_vertices(graph));
+    std::vector<bool> is_reached (boost::num_vertices(graph), false);
+    std::deque<Vertex> queue = {u};
+    is_reached[u] = true;
+    while (!queue.empty() && !is_reached[v]) {
+        auto w = queue.front();
+        queue.pop_front();
+        for (auto x : boost::make_iterator_range(boost::adjacent_vertices(w, graph))) {
+            if (is_reached[x]) continue;
+            if (x != v && visited[x]) continue;
+            is_reached[x] = true;
+            parent[x] = w;
+            if (x != v) queue.push_back(x);
+        }
+    }
+    if (!is_reached[v] || u == v) return path;
+    for (auto w = v; w != u; w = parent[w]) path.push_front(w);
+    return path;
+}
+
+/**
+ * @brief Turn a tree containing the root into a tour by visiting its vertices
+ * in depth first order and shortcutting. When two consecutive vertices are
+ * not adjacent the tour takes a shortest path through unvisited vertices, or
+ * skips the vertex if there is no such path.
+ */
+template <typename TGraph, typename TCostMap>
+std::list<typename TGraph::vertex_descriptor> shortcutTreeToTour(
+    TGraph& graph,
+    TCostMap& cost_map,
+    const std::vector<PrimalDualEdge>& edges,
+    const std::vector<std::size_t>& tree_edges,
+    typename TGraph::vertex_descriptor root_vertex
+) {
+    typedef typename TGraph::vertex_descriptor Vertex;
+    std::size_t n = boost::num_vertices(graph);
+    std::vector<std::vector<Vertex>> children (n);
+    for (auto e : tree_edges) {
+        children[edges[e].source].push_back(edges[e].target);
+        children[edges[e].target].push_back(edges[e].source);
+    }
+    // preorder of the tree
+    std::vector<Vertex> preorder;
+    std::vector<bool> is_seen (n, false);
+    std::vector<Vertex> stack = {root_vertex};
+    while (!stack.empty()) {
+        auto u = stack.back();
+        stack.pop_back();
+        if (is_seen[u]) continue;
+        is_seen[u] = true;
+        preorder.push_back(u);
+        for (auto it = children[u].rbegin(); it != children[u].rend(); it++) {
+            if (!is_seen[*it]) stack.push_back(*it);
+        }
+    }
+    std::vector<bool> visited (n, false);
+    std::list<Vertex> tour = {root_vertex};
+    visited[root_vertex] = true;
+    for (std::size_t i = 1; i < preorder.size(); i++) {
+        auto v = preorder[i];
+        if (visited[v]) continue;
+        if (hasEdge(graph, cost_map, tour.back(), v)) {
+            visited[v] = true;
+            tour.push_back(v);
+            continue;
+        }
+        auto path = unvisitedPath(graph, tour.back(), v, visited);
+        for (auto w : path) visited[w] = true;
+        tour.splice(tour.end(), path);
+    }
+    // close the tour, dropping the last vertices until the root can be reached
+    while (tour.size() > 1) {
+        if (hasEdge(graph, cost_map, tour.back(), root_vertex)) break;
+        auto path = unvisitedPath(graph, tour.back(), root_vertex, visited);
+        if (!path.empty()) {
+            path.pop_back();
+            for (auto w : path) visited[w] = true;
+            tour.splice(tour.end(), path);
+            break;
+        }
+        visited[tour.back()] = false;
+        tour.pop_back();
+    }
+    tour.push_back(root_vertex);
+    return tour;
+}
+
+/**
+ * @brief Primal-dual initial solution for the prize collecting TSP.
+ *
+ * The quota is relaxed with a Lagrange multiplier lambda, giving a prize
+ * collecting Steiner tree with penalty lambda * prize(v). A binary search
+ * finds the smallest lambda whose strongly pruned Goemans-Williamson tree
+ * collects the quota. The tree is shortcut into a tour which is repaired
+ * with extension (if prize was lost while shortcutting) and improved by 2-opt.
+ *
+ * The tour is empty if no prize feasible tour was found.
+ *
+ * Returns a lower bound on the cost of any prize feasible tour: every tour
+ * contains a tree, so for every lambda the sum of the duals minus
+ * lambda * (total positive prize - quota) is a lower bound. Only valid for
+ * non-negative costs; zero is returned otherwise.
+ */
+template <typename TGraph, typename TCostMap, typename TPrizeMap>
+double primalDualTour(
+    TGraph& graph,
+    std::list<typename TGraph::vertex_descriptor>& tour,
+    TCostMap& cost_map,
+    TPrizeMap& prize_map,
+    PrizeNumberType quota,
+    typename TGraph::vertex_descriptor root_vertex,
+    int max_iterations = 16
+) {
+    std::size_t n = boost::num_vertices(graph);
+    tour.clear();
+    std::vector<PrimalDualEdge> pd_edges;
+    double total_cost = 0.0;
+    double min_cost = std::numeric_limits<double>::max();
+    for (auto edge : boost::make_iterator_range(boost::edges(graph))) {
+        std::size_t u = boost::source(edge, graph);
+        std::size_t v = boost::target(edge, graph);
+        if (u == v) continue;
+        if (cost_map[edge] < 0) return 0.0;
+        pd_edges.push_back({u, v, (double) cost_map[edge]});
+        total_cost += cost_map[edge];
+        if (cost_map[edge] > 0) min_cost = std::min(min_cost, (double) cost_map[edge]);
+    }
+    double total_prize = 0.0;
+    double min_prize = std::numeric_limits<double>::max();
+    double max_prize = 0.0;
+    for (auto u : boost::make_iterator_range(boost::vertices(graph))) {
+        total_prize += std::max(0, (int) prize_map[u]);
+        if (prize_map[u] > 0) min_prize = std::min(min_prize, (double) prize_map[u]);
+        max_prize = std::max(max_prize, (double) prize_map[u]);
+    }
+    if (n == 0 || max_prize == 0 || total_prize < quota) return 0.0;
+
+    // the smallest lambda whose tree collects the quota
+    double lower_bound = 0.0;
+    std::vector<std::size_t> best_tree;
+    auto treeWithMultiplier = [&](double lambda) {
+        std::vector<double> penalties (n);
+        for (std::size_t u = 0; u < n; u++) penalties[u] = lambda * std::max(0, (int) prize_map[u]);
+        auto gw_tree = goemansWilliamsonTree(n, pd_edges, penalties, root_vertex);
+        lower_bound = std::max(lower_bound, gw_tree.dual_objective - lambda * (total_prize - quota));
+        auto pruned = strongPruning(n, pd_edges, gw_tree.edges, penalties, root_vertex);
+        std::vector<bool> in_tree (n, false);
+        in_tree[root_vertex] = true;
+        for (auto e : pruned) in_tree[pd_edges[e].source] = in_tree[pd_edges[e].target] = true;
+        PrizeNumberType prize = 0;
+        for (std::size_t u = 0; u < n; u++) if (in_tree[u]) prize += prize_map[u];
+        if (prize >= quota) {
+            best_tree = pruned;
+            return true;
+        }
+        return false;
+    };
+    // double lambda until the tree collects the quota, then bisect
+    double low = 0.0;
+    double high = std::max(1.0, min_cost) / max_prize;
+    double lambda_limit = total_cost / min_prize + 1.0;
+    while (!treeWithMultiplier(high)) {
+        if (high > lambda_limit) return lower_bound;
+        low = high;
+        high *= 2.0;
+    }
+    for (int i = 0; i < max_iterations; i++) {
+        double mid = (low + high) / 2.0;
+        if (treeWithMultiplier(mid)) high = mid;
+        else low = mid;
+    }
+
+    // shortcut then repair the tour
+    tour = shortcutTreeToTour(graph, cost_map, pd_edges, best_tree, root_vertex);
+    while (tour.size() < 4 && insertCheapestVertex(graph, tour, cost_map));
+    if (tour.size() < 4) {
+        tour.clear();
+        return lower_bound;
+    }
+    int int_quota = quota;
+    if (totalPrizeOfTour(prize_map, tour) < int_quota) {
+        extensionUntilPrizeFeasible(graph, tour, cost_map, prize_map, int_quota);
+    }
+    // longer paths replace an edge when no single vertex can be inserted, e.g. in bipartite graphs
+    int step_size = 1;
+    for (int path_depth_limit = 2; path_depth_limit <= 4 && totalPrizeOfTour(prize_map, tour) < int_quota; path_depth_limit++) {
+        pathExtensionUntilPrizeFeasible(graph, tour, cost_map, prize_map, root_vertex, int_quota, step_size, path_depth_limit);
+    }
+    if (totalPrizeOfTour(prize_map, tour) < int_quota) {
+        tour.clear();
+        return lower_bound;
+    }
+    twoOpt(graph, tour, cost_map, boost::num_vertices(graph));
+    return lower_bound;
+}
+
+/**
+ * @brief Edges of a tour that collects the quota, used to warm start a solve
+ * after the quota, costs or prizes changed: the previous best tour extended
+ * with path extension until it is prize feasible and improved by 2-opt,
+ * otherwise the primal-dual tour. Empty if neither collects the quota.
+ */
+std::vector<PCTSPedge> warmStartEdges(
+    PCTSPgraph& graph,
+    EdgeCostMap& cost_map,
+    VertexPrizeMap& prize_map,
+    PrizeNumberType quota,
+    PCTSPvertex& root_vertex,
+    std::list<PCTSPvertex> tour
+);
+
+#endif
@@ -0,0 +1,56 @@
+/** Solve the prize collecting TSP for a sorted list of quotas */
+
+#ifndef __PCTSP_QUOTA_SWEEP__
+#define __PCTSP_QUOTA_SWEEP__
+
+#include <vector>
+#include <objscip/objscip.h>
+
+#include "branching.hh"
+#include "graph.hh"
+
+/** Optimal tour for one quota of the sweep */
+struct QuotaSweepPoint {
+    PrizeNumberType quota;
+    SCIP_Status status;
+    double lower_bound;
+    double upper_bound;                     // cost of the best tour, infinite if none was found
+    PrizeNumberType prize;                  // prize collected by the best tour
+    std::vector<PCTSPedge> solution_edges;  // edges of the best tour without self loops
+    unsigned int num_kept_secs;             // SECs kept from previous quotas when the solve started
+    double solving_time;
+};
+
+/**
+ * @brief Solve the prize collecting TSP for every quota in ascending order and
+ * return the best tour of each quota, i.e. the cost/quota Pareto frontier.
+ *
+ * One model is built and reused: between solves the transformed problem is
+ * freed and only the right hand side of the prize constraint changes. The
+ * SECs do not depend on the quota, so every SEC separated for a quota is added
+ * to the model of the following quotas as a separated linear constraint. The
+ * first quota starts from the primal-dual tour and every following quota
+ * starts from the previous best tour repaired by warmStartEdges.
+ *
+ * The quotas are solved and returned in ascending order. The time limit is
+ * per quota.
+ */
+std::vector<QuotaSweepPoint> solveQuotaSweep(
+    SCIP* scip,
+    PCTSPgraph& graph,
+    EdgeCostMap& cost_map,
+    VertexPrizeMap& prize_map,
+    std::vector<PrizeNumberType>& quotas,
+    PCTSPvertex& root_vertex,
+    int branching_max_depth = -1,
+    unsigned int branching_strategy = BranchingStrategy::RELPSCOST,
+    std::string name = "pctsp-quota-sweep",
+    bool sec_disjoint_tour = true,
+    double sec_lp_gap_improvement_threshold = 0.01,
+    bool sec_maxflow_mincut = true,
+    int sec_max_tailing_off_iterations = -1,
+    int sec_sepafreq = 1,
+    float time_limit = 14400
+);
+
+#endif
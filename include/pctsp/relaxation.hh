@@ -0,0 +1,62 @@
+/** Root LP relaxation of the prize collecting TSP */
+
+#ifndef __PCTSP_RELAXATION__
+#define __PCTSP_RELAXATION__
+
+#include <vector>
+#include <objscip/objscip.h>
+
+#include "graph.hh"
+
+/** Bound of the root cutting plane loop, the cuts it added and the effort it took */
+struct RelaxationStats {
+    SCIP_Status status;
+    double lower_bound;                         // dual bound of the root node
+    unsigned int num_cost_cover_disjoint_paths;
+    unsigned int num_cost_cover_shortest_paths;
+    unsigned int num_cycle_cover;
+    unsigned int num_sec_disjoint_tour;         // number of SECs added with disjoint tour separation
+    unsigned int num_sec_maxflow_mincut;        // number of SECs added with max flow
+    unsigned int num_sec_union_find;            // number of SECs added with union-find separation
+    int num_separation_rounds;
+    long long num_lp_iterations;
+    double solving_time;                        // seconds spent by SCIP
+};
+
+/**
+ * @brief Solve only the root node of the branch and cut: the LP with the
+ * subtour elimination constraints and, optionally, cycle cover and cost
+ * cover inequalities as cutting planes.
+ *
+ * Only the plugins the cutting plane loop needs are included: the linear and
+ * integral constraint handlers, most infeasible branching, depth first node
+ * selection and no heuristics or general purpose separators. Solving stops at the node
+ * limit of one, nothing is written to file and the messages of SCIP are
+ * silenced. The cost of the heuristic edges is the upper bound of the cost
+ * cover inequalities added before solving; the heuristic is not given to
+ * SCIP, so the root is never pruned by it.
+ *
+ * The problem is freed before returning, so the SCIP instance must be new.
+ * A SCIP error is thrown as a scip::SCIPException.
+ */
+RelaxationStats solveRootRelaxation(
+    SCIP* scip,
+    PCTSPgraph& graph,
+    std::vector<PCTSPedge>& heuristic_edges,
+    EdgeCostMap& cost_map,
+    VertexPrizeMap& prize_map,
+    PrizeNumberType& quota,
+    PCTSPvertex& root_vertex,
+    bool cost_cover_disjoint_paths = false,
+    bool cost_cover_shortest_path = false,
+    bool cycle_cover = false,
+    std::vector<int> disjoint_paths_distances = std::vector<int>(),
+    bool sec_disjoint_tour = true,
+    double sec_lp_gap_improvement_threshold = 0.01,
+    bool sec_maxflow_mincut = true,
+    int sec_max_tailing_off_iterations = -1,
+    float time_limit = 14400,
+    bool sec_union_find = false
+);
+
+#endif
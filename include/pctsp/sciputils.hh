@@ -42,7 +42,9 @@ SCIP_RETCODE addRow(
     std::vector<double>& var_coefs,
     double& lhs,
     double& rhs,
-    std::string& name
+    std::string& name,
+    bool modifiable = false,
+    SCIP_ROW** added_row = NULL
 );
 
 #endif
\ No newline at end of file
@@ -0,0 +1,69 @@
+/** Vectorized kernels for scoring candidate insertions and extensions */
+
+#ifndef __PCTSP_SCORING__
+#define __PCTSP_SCORING__
+
+#include "graph.hh"
+
+struct ExtensionVertex {
+    int index;
+    float value;
+};
+
+/** Codes for the instruction set used by the scoring kernels */
+struct ScoringKernel {
+    static const unsigned int AUTO;
+    static const unsigned int SCALAR;
+    static const unsigned int SSE41;
+    static const unsigned int AVX2;
+};
+
+/**
+ * @brief The fastest kernel supported by the CPU, detected once at runtime.
+ */
+unsigned int bestScoringKernel();
+
+bool isScoringKernelSupported(unsigned int kernel);
+
+/**
+ * @brief Find the tour edge (t_i, t_i+1) with the largest unitary gain of
+ * inserting vertex v, that is prize_v / (c(v, t_i) + c(v, t_i+1) - c(t_i, t_i+1)).
+ *
+ * Only edges where v is adjacent to both endpoints are considered.
+ * Ties are broken by the smallest index, exactly like the scalar loop.
+ *
+ * @param cost_to_tour Costs c(v, t_i) for i = 0, ..., n (length n + 1)
+ * @param is_adjacent Non-zero if v is adjacent to t_i for i = 0, ..., n (length n + 1)
+ * @param tour_cost Costs c(t_i, t_i+1) for i = 0, ..., n - 1 (length n)
+ * @param n Number of edges in the tour
+ * @param kernel Instruction set. Unsupported kernels fall back to the scalar loop.
+ * @return Index of the best edge and its gain. Index is -1 if no gain is positive.
+ */
+ExtensionVertex argmaxUnitaryGain(
+    PrizeNumberType prize_v,
+    const CostNumberType* cost_to_tour,
+    const int* is_adjacent,
+    const CostNumberType* tour_cost,
+    int n,
+    unsigned int kernel = ScoringKernel::AUTO
+);
+
+/**
+ * @brief Find the external path with the smallest unitary loss
+ * (c_external - c_internal) / (p_external - p_internal).
+ *
+ * Only external paths with more prize than the internal path are considered.
+ * Ties are broken by the smallest index.
+ *
+ * @return Index of the best path and its loss. Index is -1 if no path is considered.
+ */
+ExtensionVertex argminUnitaryLoss(
+    const CostNumberType* external_cost,
+    const PrizeNumberType* external_prize,
+    CostNumberType internal_cost,
+    PrizeNumberType internal_prize,
+    int n,
+    unsigned int kernel = ScoringKernel::AUTO
+);
+
+#endif
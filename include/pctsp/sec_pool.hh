@@ -0,0 +1,112 @@
+/** Lifecycle of the subtour elimination rows of the LP */
+
+#ifndef __PCTSP_SEC_POOL__
+#define __PCTSP_SEC_POOL__
+
+#include <map>
+#include <string>
+#include <vector>
+#include <objscip/objscip.h>
+
+#include "graph.hh"
+
+/** A SEC row over the vertex set S with target t */
+struct SECRow {
+    SCIP_ROW* row;
+    std::vector<PCTSPvertex> vertex_set;  // sorted
+    PCTSPvertex target;
+    unsigned int age;                     // consecutive solved LPs with positive slack
+    bool pooled;                          // true once the row left the LP
+};
+
+/** Counts over every solve, the pooled and slack rows are those of the current solve */
+struct SECPoolStats {
+    std::size_t num_rows;       // rows ever added
+    std::size_t num_pooled;     // rows out of the LP
+    std::size_t num_slack;      // rows in the LP that were slack in the last solved LP
+    unsigned int num_readded;   // pooled rows added to the LP again
+    unsigned int num_dominated; // SECs not added because a nested SEC was violated as much
+    unsigned int num_maxflow_skipped;   // separation rounds without max flow because pooled rows were added
+};
+
+/**
+ * @brief Keep every SEC row that was added to the LP.
+ *
+ * SEC rows are removable, so SCIP drops them from the LP once they age, i.e.
+ * once they stay slack for lp/rowagelimit rounds. The pool keeps the rows it
+ * saw leave the LP and adds them again when the LP violates them, which is
+ * checked before the max flow separator runs. The rows are aged once per
+ * solved LP by SECPoolEventhdlr. A new SEC over S with target t
+ * is dominated and not added if a row of the pool with the same target over a
+ * subset or superset of S, or over S itself, is violated at least as much; a
+ * pooled row that dominates is added to the LP instead.
+ */
+class SECRowPool {
+private:
+    std::map<std::string, SECRow> rows;
+    std::map<PCTSPvertex, std::vector<std::string>> names_by_target;
+    std::size_t num_rows_added;
+    unsigned int num_readded;
+    unsigned int num_dominated;
+    unsigned int num_maxflow_skipped;
+
+public:
+    SECRowPool();
+
+    /** Keep a row that was added to the LP, the pool captures the row */
+    SCIP_RETCODE addRow(SCIP* scip, SCIP_ROW* row, std::vector<PCTSPvertex>& vertex_set, PCTSPvertex target);
+
+    /**
+     * @brief Count the slack rounds of the rows in the LP and pool the rows that
+     * left it. Call once per solved LP, see SECPoolEventhdlr.
+     */
+    void ageRows(SCIP* scip);
+
+    /** Add the pooled rows that are violated by the solution to the LP */
+    SCIP_RETCODE separate(SCIP* scip, SCIP_SOL* sol, SCIP_RESULT* result, int& num_rows_added);
+
+    /**
+     * @brief Set dominated to true if a row with the same target over a nested
+     * vertex set is violated at least as much as the new SEC. A dominating
+     * pooled row is added to the LP.
+     */
+    SCIP_RETCODE findDominatingRow(
+        SCIP* scip,
+        SCIP_SOL* sol,
+        SCIP_RESULT* result,
+        std::vector<PCTSPvertex>& vertex_set,
+        PCTSPvertex target,
+        double violation,
+        bool& dominated
+    );
+
+    /** Count a separation round in which max flow did not run because pooled rows were added */
+    void recordSkippedMaxflow();
+
+    SECPoolStats getStats();
+
+    /** Release every row at the end of the solve, the counts are kept */
+    SCIP_RETCODE clear(SCIP* scip);
+};
+
+const std::string SEC_POOL_EVENTHDLR_NAME = "pctsp_sec_pool_handler";
+
+/** Event handler that ages the rows of a SEC row pool every time an LP is solved */
+class SECPoolEventhdlr : public scip::ObjEventhdlr {
+private:
+    SECRowPool& pool_;
+
+public:
+    SECPoolEventhdlr(SCIP* scip, SECRowPool& pool)
+        : ObjEventhdlr(scip, SEC_POOL_EVENTHDLR_NAME.c_str(), "age the rows of the SEC row pool after every LP"),
+          pool_(pool) {}
+
+    virtual SCIP_DECL_EVENTINITSOL(scip_initsol);
+    virtual SCIP_DECL_EVENTEXITSOL(scip_exitsol);
+    virtual SCIP_DECL_EVENTEXEC(scip_exec);
+};
+
+/** Include the event handler that ages the rows of the pool, unless it is included */
+SCIP_RETCODE includeSECPoolEventhdlr(SCIP* scip, SECRowPool& pool);
+
+#endif
@@ -38,6 +38,9 @@ UndirectedCapacityGraph capacityGraphFromEdgeVector(
  * @param edge_variable_map Mapping from edges to the variables
  * @return CapacityVector
  */
+/** Capacity of an edge with the LP value, exact for the values zero, one and two */
+CapacityType capacityFromValue(SCIP* scip, double value);
+
 CapacityVector getCapacityVectorFromSol(
     SCIP* scip,
     PCTSPgraph& graph,
@@ -45,4 +48,71 @@ CapacityVector getCapacityVectorFromSol(
     std::map<PCTSPedge, SCIP_VAR*>& edge_variable_map
 );
 
+/** A vertex set S without the root and the targets t in S whose SEC is violated */
+struct ViolatedVertexSet {
+    std::vector<PCTSPvertex> vertex_set;   // sorted
+    std::vector<PCTSPvertex> targets;
+};
+
+/**
+ * @brief Heuristic SEC separation by merging the support edges with union-find.
+ *
+ * Edges are merged in order of decreasing LP value while x(E(S)) and y(S) are
+ * tracked for every component S. After all edges of the same LP value are
+ * merged, every changed component without the root is returned with the
+ * targets t such that x(E(S)) > y(S) - y_t + tolerance. Edges merged later
+ * only increase x(E(S)), so every returned SEC is violated. A set is returned
+ * at most once.
+ *
+ * @param num_vertices Number of vertices of the graph
+ * @param edges Support edges without self loops
+ * @param edge_values LP value of each support edge
+ * @param vertex_values LP value of the self loop of each vertex
+ * @param root_vertex Root of the tour
+ * @param tolerance Minimum violation of a returned SEC
+ */
+std::vector<ViolatedVertexSet> unionFindViolatedSets(
+    std::size_t num_vertices,
+    VertexPairVector& edges,
+    std::vector<double>& edge_values,
+    std::vector<double>& vertex_values,
+    PCTSPvertex root_vertex,
+    double tolerance
+);
+
+/** The support graph after shrinking, over one representative vertex per set of merged vertices */
+struct ShrunkSupportGraph {
+    VertexPairVector edges;
+    std::vector<double> edge_values;                           // sum over the merged edges
+    std::map<PCTSPvertex, std::vector<PCTSPvertex>> members;   // original vertices of each representative
+};
+
+/**
+ * @brief Shrink the LP support graph with rules of Padberg and Rinaldi.
+ *
+ * The rules are applied until neither merges a vertex:
+ *  - contract an edge with x_e >= 1 between vertices with y_u = y_v = 1 when
+ *    neither is the root, then the chains of such edges become single vertices;
+ *  - merge an original vertex w other than the root with one of its two
+ *    neighbours a and b in the shrunk graph if x(w:a) = x(w:b). Moving w to
+ *    the side of a never increases a cut and the degree of w keeps the SEC of
+ *    {w} satisfied.
+ *
+ * The SECs depend on their target vertex, so no vertex is ever merged with
+ * the root: a target on the root side cannot be cut off by a min cut.
+ *
+ * @param edges Support edges without self loops
+ * @param edge_values LP value of each support edge
+ * @param vertex_values LP value of the self loop of each vertex
+ * @param root_vertex Root of the tour
+ * @param tolerance Tolerance of the comparisons of LP values
+ */
+ShrunkSupportGraph shrinkSupportGraph(
+    VertexPairVector& edges,
+    std::vector<double>& edge_values,
+    std::vector<double>& vertex_values,
+    PCTSPvertex root_vertex,
+    double tolerance
+);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,111 @@
+/** Adapt the effort spent on each separator to the bound improvement it buys */
+
+#ifndef __PCTSP_SEPARATION_CONTROLLER__
+#define __PCTSP_SEPARATION_CONTROLLER__
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+#include <objscip/objscip.h>
+
+const std::string SEPARATION_CONTROLLER_NAME = "pctsp_separation_controller";
+const std::string SEPARATION_CONTROLLER_DESC = "Throttle separators whose bound improvement per second diminishes";
+
+const std::string DISJOINT_TOUR_SEPARATOR = "disjoint_tour";
+const std::string MAXFLOW_MINCUT_SEPARATOR = "maxflow_mincut";
+const std::string UNION_FIND_SEPARATOR = "union_find";
+const std::string CYCLE_COVER_SEPARATOR = "cycle_cover";
+const std::string COST_COVER_SEPARATOR = "cost_cover";
+
+/** One call of a separator */
+struct SeparationRound {
+    double time;                // seconds of the call on the solving clock of SCIP
+    double bound_improvement;   // share of the change of the LP bound after the call
+};
+
+/** A call of a separator whose bound improvement is not yet known */
+struct PendingSeparation {
+    std::string separator;
+    double time;
+    unsigned int num_cuts;
+};
+
+/** Totals of a separator over the solve */
+struct SeparatorStats {
+    unsigned int num_calls;
+    unsigned int num_skipped;
+    unsigned int num_probes;    // calls that ran only to refresh the window
+    unsigned int num_cuts;
+    double time;
+    double bound_improvement;
+};
+
+/**
+ * @brief Keep a sliding window of the bound improvement per second of
+ * every separator and skip the separators with diminishing returns.
+ *
+ * A separator records each call with its time and number of cuts. Times are
+ * differences of SCIPgetSolvingTime, which is a wall clock unless the
+ * timing/clocktype parameter says otherwise, so separators running in
+ * other threads or SCIP instances do not inflate them. When the
+ * LP of the same node is solved again, the change of the LP bound is shared
+ * among the calls since the last LP in proportion to their cuts. A separator
+ * with a full window is skipped if its return is below min_relative_return
+ * times the best return of any separator, except on every probe_frequency-th
+ * call, which refreshes its window. A separator is never skipped when asked
+ * to run as the fallback, e.g. because the cheaper separators found no cut.
+ */
+class SeparationController : public scip::ObjEventhdlr {
+private:
+    std::size_t window_size;
+    double min_relative_return;
+    unsigned int probe_frequency;
+    std::map<std::string, std::deque<SeparationRound>> windows;
+    std::map<std::string, SeparatorStats> stats;
+    std::map<std::string, unsigned int> skips_since_run;
+    std::vector<PendingSeparation> pending;  // calls since the last LP
+    SCIP_Longint last_lp_node;
+    double last_lp_bound;
+
+    double getReturn(const std::string& separator);
+
+public:
+    SeparationController(SCIP* scip, std::size_t _window_size, double _min_relative_return, unsigned int _probe_frequency)
+        : ObjEventhdlr(scip, SEPARATION_CONTROLLER_NAME.c_str(), SEPARATION_CONTROLLER_DESC.c_str())
+    {
+        window_size = _window_size;
+        min_relative_return = _min_relative_return;
+        probe_frequency = _probe_frequency;
+        last_lp_node = -1;
+        last_lp_bound = 0;
+    }
+
+    /** Return false if the separator should be skipped, counting skipped calls */
+    bool shouldRun(const std::string& separator, bool fallback);
+
+    /** Record a call of a separator with its time in seconds */
+    void recordCall(const std::string& separator, double time, unsigned int num_cuts);
+
+    /** Push a call whose bound improvement is known onto the window of the separator */
+    void recordRound(const std::string& separator, double time, double bound_improvement);
+
+    SeparatorStats getSeparatorStats(const std::string& separator);
+
+    SCIP_DECL_EVENTINITSOL(scip_initsol);
+    SCIP_DECL_EVENTEXITSOL(scip_exitsol);
+    SCIP_DECL_EVENTEXEC(scip_exec);
+};
+
+/** The separation controller, NULL if it is not included */
+SeparationController* findSeparationController(SCIP* scip);
+
+/** Include the separation controller, which the PCTSP separators consult when it is included */
+SCIP_RETCODE includeSeparationController(
+    SCIP* scip,
+    std::size_t window_size = 10,
+    double min_relative_return = 0.1,
+    unsigned int probe_frequency = 5
+);
+
+#endif
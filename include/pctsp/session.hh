@@ -0,0 +1,94 @@
+/** Re-solve the prize collecting TSP after small changes to the costs and prizes */
+
+#ifndef __PCTSP_SESSION__
+#define __PCTSP_SESSION__
+
+#include <list>
+#include <vector>
+#include <objscip/objscip.h>
+
+#include "branching.hh"
+#include "graph.hh"
+#include "stats.hh"
+
+/** Bounds, tour and warm start information of one solve of a session */
+struct SessionSolveStats {
+    SummaryStats summary;
+    PrizeNumberType prize;                  // prize collected by the best tour
+    std::vector<PCTSPedge> solution_edges;  // edges of the best tour without self loops
+    double warm_start_cost;                 // cost of the repaired tour, infinite if there was none
+    std::size_t num_kept_secs;              // SECs kept from previous solves when the solve started
+    std::size_t num_kept_cycle_covers;      // cycle covers kept from previous solves, valid or not
+    double solving_time;
+};
+
+/**
+ * @brief A model of the prize collecting TSP that is kept between solves so
+ * that edge costs, vertex prizes and the quota can change between solves.
+ *
+ * The session owns a copy of the graph, costs and prizes. An update frees the
+ * transformed problem and only changes the objective coefficient of an edge
+ * or the prize constraint. At the next solve every SEC separated so far is
+ * added to the original problem (SECs depend on neither costs nor prizes),
+ * every cycle cover is added while the prize of its vertex set is below the
+ * quota and deleted otherwise, and the previous best tour is repaired with
+ * warmStartEdges to give SCIP a starting solution.
+ *
+ * The session is neither copyable nor movable: the problem data points into it.
+ */
+class SolverSession {
+private:
+    SCIP* scip;
+    PCTSPgraph graph;
+    EdgeCostMap cost_map;
+    VertexPrizeMap prize_map;
+    PrizeNumberType quota;
+    PCTSPvertex root_vertex;
+    PCTSPedgeVariableMap edge_variable_map;
+    std::list<PCTSPvertex> best_tour;
+    bool cycle_cover;
+    float time_limit;
+
+    /** Free the transformed problem so that the original problem can be changed */
+    void freeTransform();
+
+    /** The edge between the vertices, throws EdgeNotFoundException if there is none */
+    PCTSPedge getEdge(PCTSPvertex u, PCTSPvertex v);
+
+public:
+    SolverSession(
+        PCTSPgraph& input_graph,
+        EdgeCostMap& input_cost_map,
+        VertexPrizeMap& input_prize_map,
+        PrizeNumberType quota,
+        PCTSPvertex root_vertex,
+        int branching_max_depth = -1,
+        unsigned int branching_strategy = BranchingStrategy::RELPSCOST,
+        bool cycle_cover = false,
+        std::string name = "pctsp-session",
+        bool sec_disjoint_tour = true,
+        double sec_lp_gap_improvement_threshold = 0.01,
+        bool sec_maxflow_mincut = true,
+        int sec_max_tailing_off_iterations = -1,
+        int sec_sepafreq = 1,
+        float time_limit = 14400
+    );
+    ~SolverSession();
+    SolverSession(const SolverSession&) = delete;
+    SolverSession& operator=(const SolverSession&) = delete;
+
+    void updateEdgeCost(PCTSPvertex u, PCTSPvertex v, CostNumberType cost);
+    void updateVertexPrize(PCTSPvertex vertex, PrizeNumberType prize);
+    void updateQuota(PrizeNumberType new_quota);
+
+    /** Solve the model with the current costs, prizes and quota. The time limit is per solve. */
+    SessionSolveStats solve();
+
+    PCTSPgraph& getGraph();
+    EdgeCostMap& getCostMap();
+    VertexPrizeMap& getPrizeMap();
+    PrizeNumberType getQuota();
+    SCIP* getSCIP();
+};
+
+#endif
@@ -44,11 +44,11 @@ struct PositiveEdgeVarFilter {
         TEdgeVariableMap* edge_var_map
     ) : scip(scip), sol(sol), edge_var_map(edge_var_map) {}
 
-    // return true if the edge variable is positive
+    // return true if the edge variable is positive. Edges without a variable are not in the solution.
     template <typename TEdge>
     bool operator()(const TEdge& e) const {
-        auto var = (*edge_var_map)[e];
-        return isVarPositive(scip, sol, var);
+        auto it = edge_var_map->find(e);
+        return it != edge_var_map->end() && isVarPositive(scip, sol, it->second);
     }
 };
 
@@ -21,6 +21,7 @@ struct SummaryStats {
     long long num_nodes;
     unsigned int num_sec_disjoint_tour;         // number of SECs added with disjoint tour separation
     unsigned int num_sec_maxflow_mincut;        // number of SECs added with max flow
+    unsigned int num_sec_union_find;            // number of SECs added with union-find separation
 };
 
 SummaryStats readSummaryStatsFromYaml(std::filesystem::path& filename);
@@ -39,6 +40,7 @@ const std::vector<std::string> NODE_STATS_COL_NAMES = {
     "node_id",
     "num_sec_disjoint_tour",
     "num_sec_maxflow_mincut",
+    "num_sec_union_find",
     "num_cost_cover_disjoint_paths",
     "num_cost_cover_shortest_paths",
     "num_cost_cover_steiner_tree",
@@ -54,6 +56,7 @@ struct NodeStats {
     unsigned int node_id;   // Id of node
     unsigned int num_sec_disjoint_tour;         // number of SECs added with disjoint tour separation
     unsigned int num_sec_maxflow_mincut;        // number of SECs added with max flow
+    unsigned int num_sec_union_find;            // number of SECs added with union-find separation
     unsigned int num_cost_cover_disjoint_paths; // num CC disjoint tour added
     unsigned int num_cost_cover_shortest_paths; // num CC shortest paths added
     unsigned int num_cost_cover_steiner_tree;   // num CC steiner tree added
@@ -65,6 +68,8 @@ unsigned int numDisjointTourSECs(std::vector<NodeStats>& node_stats);
 
 unsigned int numMaxflowMincutSECs(std::vector<NodeStats>& node_stats);
 
+unsigned int numUnionFindSECs(std::vector<NodeStats>& node_stats);
+
 // void writeNodeStatsToCSV(std::vector<NodeStats>& node_stats, std::string& file_path);
 
 void writeNodeStatsToCSV(std::vector<NodeStats>& node_stats, std::filesystem::path& file_path);
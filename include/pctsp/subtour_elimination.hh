@@ -1,9 +1,11 @@
 #ifndef __PCTSP_SUBTOUR_ELIMINATION__
 #define __PCTSP_SUBTOUR_ELIMINATION__
 
+#include "cut_selection.hh"
 #include "data_structures.hh"
 #include "graph.hh"
 #include "renaming.hh"
+#include "sec_pool.hh"
 #include "sciputils.hh"
 #include "solution.hh"
 
@@ -40,6 +42,22 @@ SCIP_RETCODE addSubtourEliminationConstraint(
     SCIP_RESULT* result              /**< pointer to store the result of the separation call */
 );
 
+/**
+ * @brief Add the SEC x(E(S)) <= y(S) - y_t, or its aggregated form, as a row.
+ * The row is kept for later solves and in the SEC row pool if they are enabled.
+ */
+SCIP_RETCODE addSubtourEliminationRow(
+    SCIP* scip,
+    SCIP_CONSHDLR* conshdlr,
+    std::vector<PCTSPvertex>& vertex_set,
+    PCTSPvertex target_vertex,
+    VarVector& all_vars,
+    std::vector<double>& var_coefs,
+    std::string& cons_name,
+    SCIP_SOL* sol,
+    SCIP_RESULT* result
+);
+
 SCIP_RETCODE PCTSPseparateSubtour(
     SCIP* scip,                 /**< SCIP data structure */
     SCIP_CONSHDLR* conshdlr,    /**< the constraint handler itself */
@@ -49,7 +67,8 @@ SCIP_RETCODE PCTSPseparateSubtour(
     SCIP_SOL* sol,              /**< primal solution that should be separated */
     SCIP_RESULT* result,         /**< pointer to store the result of the separation call */
     bool sec_disjoint_tour,
-    bool sec_maxflow_mincut
+    bool sec_maxflow_mincut,
+    bool sec_union_find = false
 );
 
 template <typename TEdgeWeightMap>
@@ -174,6 +193,21 @@ SCIP_RETCODE PCTSPseparateDisjointTour(
     return SCIP_OKAY;
 }
 
+/**
+ * @brief Separate the SECs of the sets found by unionFindViolatedSets on the
+ * LP support graph, one SEC for every violated target of a set.
+ */
+SCIP_RETCODE PCTSPseparateUnionFind(
+    SCIP* scip,
+    SCIP_CONSHDLR* conshdlr,
+    PCTSPgraph& input_graph,
+    PCTSPedgeVariableMap& edge_variable_map,
+    PCTSPvertex& root_vertex,
+    SCIP_SOL* sol,
+    SCIP_RESULT* result,
+    int& num_conss_added
+);
+
 SCIP_RETCODE PCTSPseparateMaxflowMincut(
     SCIP* scip,
     SCIP_CONSHDLR* conshdlr,
@@ -208,16 +242,54 @@ const bool SEC_CONSHDLR_DELAYSEPA = false; // false
 const bool SEC_CONSHDLR_DELAYPROP = false;
 const bool SEC_CONSHDLR_NEEDSCONS = false;
 
+// min cuts with flow below 2 + this tolerance are candidate sets for cut-set branching
+const double CUTSET_BRANCHING_NEAR_VIOLATION = 0.5;
+
 class PCTSPconshdlrSubtour : public scip::ObjConshdlr
 {
 
 private:
 
-    std::vector<std::list<double>> node_rolling_lp_gap;
+    std::list<double> rolling_lp_gap;       // at most sec_max_tailing_off_iterations gaps
+    SCIP_Longint rolling_lp_gap_node;       // number of the node of the gaps
+    SCIP_Longint rolling_lp_gap_lp;         // number of LPs solved when the last gap was kept
     bool sec_disjoint_tour;
     double sec_lp_gap_improvement_threshold;
     bool sec_maxflow_mincut;
+    bool sec_union_find;
+    bool shrink_support_graph;
+    unsigned int num_merged_vertices;
     int sec_max_tailing_off_iterations;
+    bool keep_secs;
+    std::map<std::string, std::pair<VarVector, std::vector<double>>> kept_secs;
+    std::set<std::string> secs_added_to_problem;
+    bool cutset_branching;
+    std::vector<std::vector<PCTSPvertex>> near_violated_sets;  // found by the min-cut separator
+    SCIP_Longint near_violated_sets_node;                      // number of the node of the sets
+    unsigned int num_cutset_branchings;
+    bool manage_sec_rows;
+    SECRowPool sec_row_pool;
+    int sec_max_cuts_per_round;         // -1 adds every separated SEC
+    double sec_max_parallelism;
+    unsigned int num_aggregated_secs;
+    bool collecting_secs;
+    std::string sec_candidate_separator;
+    std::vector<SECCandidate> sec_candidates;
+
+    /**
+     * @brief Branch on x(delta(S)) for the vertex set S not containing the root
+     * that is furthest from integral: the near-violated sets of the current node
+     * and the components of the LP support graph without the root.
+     */
+    SCIP_RETCODE branchOnCutSet(SCIP* scip, SCIP_RESULT* result);
+
+    /**
+     * @brief Keep the gap of the LP of the current node, unless the gap of the
+     * same LP was already kept. Enforcement adds a gap, and with cut-set
+     * branching each separation round adds one too, so the rolling gaps show
+     * whether the SECs still improve the bound of the node.
+     */
+    double recordLpGap(SCIP* scip);
 
 public:
 
@@ -239,8 +311,22 @@ public:
         sec_disjoint_tour = _sec_disjoint_tour;
         sec_lp_gap_improvement_threshold = _sec_lp_gap_improvement_threshold;
         sec_maxflow_mincut = _sec_maxflow_mincut;
+        sec_union_find = false;
+        shrink_support_graph = false;
+        num_merged_vertices = 0;
         sec_max_tailing_off_iterations = _sec_max_tailing_off_iterations;
-        node_rolling_lp_gap = {};
+        rolling_lp_gap = {};
+        rolling_lp_gap_node = -1;
+        rolling_lp_gap_lp = -1;
+        keep_secs = false;
+        cutset_branching = false;
+        near_violated_sets_node = -1;
+        num_cutset_branchings = 0;
+        manage_sec_rows = false;
+        sec_max_cuts_per_round = -1;
+        sec_max_parallelism = 1.0;
+        num_aggregated_secs = 0;
+        collecting_secs = false;
     }
 
     PCTSPconshdlrSubtour(SCIP* scip, bool _sec_disjoint_tour, bool _sec_maxflow_mincut)
@@ -248,9 +334,129 @@ public:
 
     
 
+    /**
+     * @brief Remember every SEC added to the LP. SECs do not depend on the quota, costs
+     * or prizes, so they stay valid when the problem is changed and solved again.
+     */
+    void setKeepSECs(bool keep);
+
+    /** Remember the SEC over the original variables if SECs are kept */
+    void keepSEC(std::string& name, VarVector& vars, std::vector<double>& var_coefs);
+
+    /** Number of kept SECs */
+    std::size_t getNumKeptSECs();
+
+    /** Kept SECs that are not yet in the original problem, by constraint name */
+    std::map<std::string, std::pair<VarVector, std::vector<double>>>& getKeptSECs();
+
+    /** Forget every kept SEC, e.g. before the problem is freed */
+    void clearKeptSECs();
+
+    /**
+     * @brief Add the kept SECs that are not yet in the original problem as
+     * linear constraints. They are separated rather than put in the initial LP.
+     * Call in the problem stage, e.g. after SCIPfreeTransform.
+     */
+    SCIP_RETCODE addKeptSECsToProblem(SCIP* scip);
+
+    /**
+     * @brief Branch on a cut set rather than a variable when a node is tailing off.
+     *
+     * S is a vertex set without the root whose cut x(delta(S)) is fractional in
+     * the LP. One child requires the tour to visit S with the local constraint
+     * x(delta(S)) >= 2, the other fixes the edges of the cut and the self loops
+     * of S to zero. If there is no such set, or columns are priced, the LP
+     * branching rules branch instead. Each separation round of the node counts
+     * towards tailing off, not only each enforcement.
+     */
+    void setCutSetBranching(bool branch_on_cut_sets);
+
+    /** Remember a vertex set without the root whose cut is close to violated at the current node */
+    void recordNearViolatedSet(SCIP* scip, std::vector<PCTSPvertex>& vertex_set);
+
+    /** Number of nodes that were branched on a cut set in the last solve */
+    unsigned int getNumCutSetBranchings();
+
+    /**
+     * @brief Separate SECs with union-find over the LP support edges, see
+     * unionFindViolatedSets. Max flow separation only runs when the
+     * union-find separation finds no SEC.
+     */
+    void setUnionFindSeparation(bool separate);
+
+    bool isSeparatingUnionFind();
+
+    /**
+     * @brief Run max flow separation on the LP support graph shrunk by
+     * shrinkSupportGraph. Cuts are expanded to the merged vertices.
+     */
+    void setShrinkSupportGraph(bool shrink);
+
+    bool isShrinkingSupportGraph();
+
+    /** Count the vertices that shrinking merged into another vertex */
+    void recordMergedVertices(unsigned int num_merged);
+
+    /** Number of vertices that shrinking merged into another vertex in the last solve */
+    unsigned int getNumMergedVertices();
+
+    /**
+     * @brief Keep the SEC rows in a SECRowPool, see SECRowPool. SCIP drops SEC
+     * rows from the LP once they are slack for max_age rounds.
+     */
+    SCIP_RETCODE setManageSECRows(SCIP* scip, bool manage, int max_age = 10);
+
+    bool isManagingSECRows();
+
+    SECRowPool& getSECRowPool();
+
+    /**
+     * @brief Add at most max_cuts_per_round SECs per separation round.
+     *
+     * The separators propose every violated SEC (S, t). For a vertex set S
+     * without the root with several targets, the aggregated SEC over S is
+     * proposed too. SECs are selected by efficacy, skipping SECs whose
+     * parallelism with a selected SEC is above max_parallelism, see selectCuts.
+     * A negative max_cuts_per_round adds every separated SEC. A max_cuts_per_round
+     * of zero is raised to one, so a round with a violated SEC always adds a SEC.
+     */
+    void setCutSelection(int max_cuts_per_round, double max_parallelism = 0.8);
+
+    bool isSelectingCuts();
+
+    /** Number of aggregated SECs that were selected in the last solve */
+    unsigned int getNumAggregatedSECs();
+
+    /** Collect the SECs of the separator rather than adding them */
+    void startCollectingSECs(const std::string& separator);
+
+    bool isCollectingSECs();
+
+    /** Remember a SEC of the separator if it is violated */
+    void collectSEC(
+        SCIP* scip,
+        SCIP_SOL* sol,
+        std::string& name,
+        VarVector& vars,
+        std::vector<double>& var_coefs,
+        std::vector<PCTSPvertex>& vertex_set,
+        PCTSPvertex target
+    );
+
+    /** Stop collecting SECs and add the selected SECs, counting them by separator */
+    SCIP_RETCODE addSelectedSECs(
+        SCIP* scip,
+        SCIP_CONSHDLR* conshdlr,
+        SCIP_SOL* sol,
+        SCIP_RESULT* result,
+        std::map<std::string, int>& num_selected
+    );
+
     SCIP_DECL_CONSCHECK(scip_check);
     SCIP_DECL_CONSENFOPS(scip_enfops);
     SCIP_DECL_CONSENFOLP(scip_enfolp);
+    SCIP_DECL_CONSINITSOL(scip_initsol);
+    SCIP_DECL_CONSEXITSOL(scip_exitsol);
     SCIP_DECL_CONSTRANS(scip_trans);
     SCIP_DECL_CONSLOCK(scip_lock);
     SCIP_DECL_CONSPRINT(scip_print);
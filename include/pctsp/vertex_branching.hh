@@ -0,0 +1,101 @@
+/** Branching on the vertices of the prize collecting TSP */
+
+#ifndef __PCTSP_VERTEX_BRANCHING__
+#define __PCTSP_VERTEX_BRANCHING__
+
+#include <map>
+#include <vector>
+#include <objscip/objscip.h>
+
+#include "graph.hh"
+
+const std::string VERTEX_BRANCHRULE_NAME = "pctsp_vertex";
+const std::string VERTEX_BRANCHRULE_DESC = "Branch on the self loops of vertices, then on edges leaving the root component";
+const int VERTEX_BRANCHRULE_PRIORITY = -20000;  // raised by setVertexBranchingStrategy
+const int VERTEX_BRANCHRULE_MAXDEPTH = -1;
+const double VERTEX_BRANCHRULE_MAXBOUNDDIST = 1.0;
+
+/**
+ * @brief Score of branching on the self loop of a vertex.
+ *
+ * The expected gains of the down branch (y_v = 0) and the up branch (y_v = 1)
+ * are the distances of the LP value to 0 and 1 multiplied by the pseudo cost
+ * of the branch. The product of the gains is weighted by the prize of the
+ * vertex and its distance to the root, both relative to the largest of the
+ * graph, so that valuable and remote vertices are decided first.
+ */
+double vertexBranchingScore(
+    double lp_value,
+    double relative_prize,
+    double relative_distance,
+    double pseudo_cost_down,
+    double pseudo_cost_up
+);
+
+/** Average gain in the LP bound per unit change of a self loop, per branch direction */
+struct VertexPseudoCost {
+    double down_gain_sum;
+    unsigned int num_down;
+    double up_gain_sum;
+    unsigned int num_up;
+};
+
+/** The branching that created a child node */
+struct VertexBranching {
+    PCTSPvertex vertex;
+    bool up;             // true if the self loop was fixed to one
+    double parent_bound; // LP bound of the parent node
+    double change;       // change of the LP value of the self loop
+};
+
+/**
+ * @brief Branch on the fractional self loop with the largest
+ * vertexBranchingScore, i.e. decide whether a vertex is visited.
+ *
+ * If every self loop is integral, branch on the fractional edge with one
+ * endpoint in the root component (the vertices reached from the root by edges
+ * with LP value one) that is closest to one half, preferring expensive edges.
+ * If there is no such edge, the rule does not run and the next rule branches.
+ *
+ * Pseudo costs are kept per vertex: a child records the vertex and direction
+ * of the branching, and the change of the LP bound is measured when the rule
+ * runs at the child. Vertices without measurements use the average pseudo
+ * cost of the measured vertices.
+ */
+class VertexBranchrule : public scip::ObjBranchrule {
+private:
+    std::vector<double> relative_prizes_;
+    std::vector<double> relative_distances_;
+    std::map<SCIP_VAR*, PCTSPedge> var_edges_;            // transformed variable to edge
+    std::vector<VertexPseudoCost> pseudo_costs_;
+    std::map<SCIP_Longint, VertexBranching> child_branchings_;  // keyed by the number of the child node
+
+    SCIP_RETCODE branchOnRootComponentEdge(SCIP* scip, SCIP_RESULT* result);
+
+public:
+    VertexBranchrule(SCIP* scip)
+        : ObjBranchrule(scip, VERTEX_BRANCHRULE_NAME.c_str(), VERTEX_BRANCHRULE_DESC.c_str(), VERTEX_BRANCHRULE_PRIORITY,
+                        VERTEX_BRANCHRULE_MAXDEPTH, VERTEX_BRANCHRULE_MAXBOUNDDIST) {}
+
+    VertexPseudoCost getVertexPseudoCost(PCTSPvertex vertex);
+
+    /** Average gain of the branch, or the average over every vertex if the vertex has no measurement */
+    double getPseudoCost(PCTSPvertex vertex, bool up);
+
+    /** Forget every pseudo cost and pending branching */
+    void resetPseudoCosts(std::size_t num_vertices);
+
+    /** Remember the branching that created the child node */
+    void recordChildBranching(SCIP_Longint node_number, VertexBranching branching);
+
+    /** Measure the pseudo cost of the branching that created the node from its LP bound */
+    void updatePseudoCost(SCIP_Longint node_number, double lp_bound);
+
+    SCIP_DECL_BRANCHINITSOL(scip_initsol);
+    SCIP_DECL_BRANCHEXECLP(scip_execlp);
+};
+
+/** Include the vertex branching rule if it is missing */
+SCIP_RETCODE includeVertexBranchrule(SCIP* scip);
+
+#endif
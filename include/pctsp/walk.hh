@@ -2,6 +2,8 @@
 #define __PCTSP_WALK__
 
 #include <algorithm>
+#include <list>
+#include <map>
 #include <string>
 #include <boost/graph/graph_traits.hpp>
 #include <boost/graph/dijkstra_shortest_paths.hpp>
@@ -69,6 +71,49 @@ std::vector<typename boost::graph_traits<TGraph>::edge_descriptor> getEdgesInWal
     return edges;
 }
 
+/**
+ * @brief Tour that starts and ends at the root and follows the edges of a
+ * simple cycle. Self loops are ignored. The tour is empty if the edges are
+ * not a simple cycle through the root.
+ */
+template <typename TGraph>
+std::list<typename boost::graph_traits<TGraph>::vertex_descriptor> tourFromCycleEdges(
+    TGraph& graph,
+    std::vector<typename boost::graph_traits<TGraph>::edge_descriptor>& edges,
+    typename boost::graph_traits<TGraph>::vertex_descriptor root_vertex
+) {
+    typedef typename boost::graph_traits<TGraph>::vertex_descriptor Vertex;
+    std::map<Vertex, std::vector<Vertex>> adjacent;
+    std::size_t num_edges = 0;
+    for (auto& edge : edges) {
+        auto u = boost::source(edge, graph);
+        auto v = boost::target(edge, graph);
+        if (u == v) continue;
+        adjacent[u].push_back(v);
+        adjacent[v].push_back(u);
+        num_edges++;
+    }
+    std::list<Vertex> tour;
+    for (auto const& [vertex, neighbors] : adjacent) {
+        if (neighbors.size() != 2) return tour;
+    }
+    if (adjacent.count(root_vertex) == 0) return tour;
+    tour.push_back(root_vertex);
+    Vertex previous = root_vertex;
+    Vertex current = adjacent[root_vertex].front();
+    while (current != root_vertex) {
+        tour.push_back(current);
+        auto& neighbors = adjacent[current];
+        Vertex next = neighbors[0] == previous ? neighbors[1] : neighbors[0];
+        previous = current;
+        current = next;
+    }
+    tour.push_back(root_vertex);
+    // the edges form more than one cycle
+    if (tour.size() != num_edges + 1) tour.clear();
+    return tour;
+}
+
 template <typename TEdgeIt, typename TCostMap>
 CostNumberType totalCost(TEdgeIt& first, TEdgeIt& last, TCostMap& cost_map) {
     CostNumberType cost = 0;
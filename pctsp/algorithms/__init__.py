@@ -1,7 +1,26 @@
 """Algorithms for the Prize-collecting Travelling Salesperson Problem"""
 
-from .algorithms import solve_pctsp
-from .data_structures import SummaryStats
+from .algorithms import (
+    lagrangian_bound,
+    parallel_solve,
+    portfolio_solve,
+    quota_sweep,
+    root_relaxation,
+    solve_pctsp,
+    SolverPool,
+    SolverSession,
+)
+from .data_structures import (
+    ParallelSolveResult,
+    PoolSolveResult,
+    PortfolioSolveResult,
+    QuotaSweepPoint,
+    RelaxationStats,
+    SessionSolveResult,
+    SolverVariant,
+    SummaryStats,
+    VariantStats,
+)
 from .extension_collapse import (
     collapse,
     extension_unitary_gain,
@@ -18,6 +37,9 @@ from .heuristic import (
     tour_from_vertex_disjoint_paths,
 )
 from .path_extension_collapse import (
+    IlsAcceptance,
+    iterated_local_search,
+    memetic_search,
     path_collapse,
     path_extension,
     path_extension_collapse,
@@ -35,19 +57,37 @@ __all__ = [
     "extension_unitary_gain_collapse",
     "extension_unitary_loss",
     "extension_until_prize_feasible",
+    "IlsAcceptance",
+    "iterated_local_search",
+    "lagrangian_bound",
+    "memetic_search",
+    "parallel_solve",
+    "portfolio_solve",
     "path_collapse",
     "path_extension_collapse",
     "path_extension_until_prize_feasible",
+    "quota_sweep",
     "find_cycle_from_bfs",
     "path_extension",
     "path_extension_collapse",
     "random_tour_complete_graph",
     "random_tour_from_disjoint_paths_map",
+    "root_relaxation",
     "solve_pctsp",
     "suurballes_heuristic",
     "suurballes_tour_initialization",
     "tour_from_vertex_disjoint_paths",
     "unitary_gain",
     "unitary_loss",
+    "ParallelSolveResult",
+    "PoolSolveResult",
+    "PortfolioSolveResult",
+    "QuotaSweepPoint",
+    "RelaxationStats",
+    "SessionSolveResult",
+    "SolverPool",
+    "SolverSession",
+    "SolverVariant",
     "SummaryStats",
+    "VariantStats",
 ]
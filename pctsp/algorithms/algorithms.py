@@ -2,6 +2,7 @@
 
 import logging
 from pathlib import Path
+from typing import List, Tuple
 import networkx as nx
 from pyscipopt import Model
 from tspwplib import (
@@ -14,11 +15,30 @@ from tspwplib import (
 )
 from ..constants import (
     FOUR_HOURS,
+    LAGRANGIAN_MAX_ITERATIONS,
     LP_GAP_IMPROVEMENT_THRESHOLD,
 )
+from .data_structures import (
+    ParallelSolveResult,
+    PoolSolveResult,
+    PortfolioSolveResult,
+    QuotaSweepPoint,
+    RelaxationStats,
+    SessionSolveResult,
+    SolverVariant,
+)
 
 # pylint: disable=import-error
-from ..libpypctsp import solve_pctsp_bind
+from ..libpypctsp import (
+    lagrangian_bound_bind,
+    parallel_solve_bind,
+    portfolio_solve_bind,
+    quota_sweep_bind,
+    root_relaxation_bind,
+    solve_pctsp_bind,
+    SolverPoolBind,
+    SolverSessionBind,
+)
 
 # pylint: enable=import-error
 
@@ -35,14 +55,23 @@ def solve_pctsp(
     cost_cover_shortest_path: bool = False,
     cycle_cover: bool = False,
     disjoint_paths_cost: VertexFunction = None,
+    dual_ascent: bool = False,
+    lagrangian_fixing: bool = False,
     logging_level: int = logging.INFO,
     name: str = "pctsp",
+    node_selection_memory_limit: float = 0,
+    pricing_num_neighbors: int = 0,
     solver_dir: Path = Path("."),
     sec_disjoint_tour: bool = True,
     sec_lp_gap_improvement_threshold: float = LP_GAP_IMPROVEMENT_THRESHOLD,
     sec_maxflow_mincut: bool = True,
     sec_max_tailing_off_iterations: int = -1,
     sec_sepafreq: int = 1,
+    sec_union_find: bool = False,
+    sec_manage_rows: bool = False,
+    sec_max_cuts_per_round: int = -1,
+    sec_shrink_support_graph: bool = False,
+    separation_controller: bool = False,
     simple_rules_only: bool = False,
     time_limit: float = FOUR_HOURS,
 ) -> EdgeList:
@@ -57,11 +86,28 @@ def solve_pctsp(
         cost_cover_disjoint_paths: True if disjoint paths cost cover inequality is used
         cost_cover_shortest_path: True if shortest paths cost cover inequality is used
         cycle_cover: True to add cycle cover inequalities
+        dual_ascent: True to delete edges eliminated by dual ascent before building the model
+        lagrangian_fixing: True to fix the edges and vertices that the Lagrangian bound
+            proves cannot be in or must be in a tour cheaper than the heuristic tour
         logging_level: How verbose should the logging be, e.g. logging.DEBUG?
         name: Name of the problem instance
+        node_selection_memory_limit: If positive, the memory in MB at which node selection
+            plunges to close open subtrees rather than following the best estimate
+        pricing_num_neighbors: If positive and the graph is complete, the model starts with
+            the edges to this many nearest neighbours of each vertex and prices in the others
         solver_dir: Directory to store logs and metrics
         sec_disjoint_tour: True if subtour elimination constraints using disjoint tours are used
         sec_maxflow_mincut: True if using the maxflow mincut SEC separation algorithm
+        sec_union_find: True to separate SECs with union-find over the LP support edges
+            before the maxflow mincut SEC separation algorithm
+        sec_manage_rows: True to keep the SEC rows that leave the LP in a pool and add
+            them again when they are violated, before the maxflow mincut SEC separation
+        sec_max_cuts_per_round: If not negative, add at most this many of the most
+            efficacious SECs per separation round, including aggregated SECs
+        sec_shrink_support_graph: True to shrink the LP support graph before the maxflow
+            mincut SEC separation algorithm
+        separation_controller: True to skip separators whose bound improvement per second
+            falls behind the other separators
         simple_rules_only: If true, use simple branching, node selection, and separation rules
         time_limit: Stop searching after this many seconds
 
@@ -103,7 +149,467 @@ def solve_pctsp(
         sec_maxflow_mincut,
         sec_max_tailing_off_iterations,
         sec_sepafreq,
+        sec_union_find,
+        sec_manage_rows,
+        node_selection_memory_limit,
+        separation_controller,
+        sec_max_cuts_per_round,
+        sec_shrink_support_graph,
         simple_rules_only,
         solver_dir,
         time_limit,
+        dual_ascent,
+        lagrangian_fixing,
+        pricing_num_neighbors,
+    )
+
+
+def lagrangian_bound(
+    graph: nx.Graph,
+    quota: int,
+    root_vertex: Vertex,
+    upper_bound: float = 0.0,
+    max_iterations: int = LAGRANGIAN_MAX_ITERATIONS,
+    logging_level: int = logging.INFO,
+) -> Tuple[float, float]:
+    """Lagrangian lower bound on the cost of a tour that collects the quota
+
+    Args:
+        graph: Undirected input graph with edge costs and vertex prizes
+        quota: The minimum prize the tour must collect
+        root_vertex: The tour must start and end at the root vertex
+        upper_bound: Cost of a known tour. If zero, the primal-dual heuristic finds a tour
+        max_iterations: Maximum number of subgradient iterations
+        logging_level: How verbose should the logging be, e.g. logging.DEBUG?
+
+    Returns:
+        Lower bound and the upper bound used for the subgradient steps
+    """
+    cost_dict = nx.get_edge_attributes(graph, EdgeFunctionName.cost.value)
+    prize_dict = nx.get_node_attributes(graph, VertexFunctionName.prize.value)
+    edges = list(graph.edges())
+    return lagrangian_bound_bind(
+        edges,
+        cost_dict,
+        prize_dict,
+        quota,
+        root_vertex,
+        upper_bound,
+        max_iterations,
+        logging_level,
+    )
+
+
+def quota_sweep(
+    graph: nx.Graph,
+    quotas: List[int],
+    root_vertex: Vertex,
+    branching_max_depth: int = -1,
+    branching_strategy: int = 0,
+    logging_level: int = logging.INFO,
+    name: str = "pctsp-quota-sweep",
+    sec_disjoint_tour: bool = True,
+    sec_lp_gap_improvement_threshold: float = LP_GAP_IMPROVEMENT_THRESHOLD,
+    sec_maxflow_mincut: bool = True,
+    sec_max_tailing_off_iterations: int = -1,
+    sec_sepafreq: int = 1,
+    time_limit: float = FOUR_HOURS,
+) -> List[QuotaSweepPoint]:
+    """Solve Prize-collecting TSP for every quota, reusing one model
+
+    The SECs separated for a quota are kept for the larger quotas and each solve
+    starts from the previous best tour extended until it collects the new quota.
+
+    Args:
+        graph: Undirected input graph with edge costs and vertex prizes
+        quotas: The minimum prize the tour must collect, one solve per quota
+        root_vertex: The tour must start and end at the root vertex
+        logging_level: How verbose should the logging be, e.g. logging.DEBUG?
+        name: Name of the problem instance
+        sec_disjoint_tour: True if subtour elimination constraints using disjoint tours are used
+        sec_maxflow_mincut: True if using the maxflow mincut SEC separation algorithm
+        time_limit: Stop searching after this many seconds for each quota
+
+    Returns:
+        Best tour and bounds of every quota in ascending order of quota
+    """
+    cost_dict = nx.get_edge_attributes(graph, EdgeFunctionName.cost.value)
+    prize_dict = nx.get_node_attributes(graph, VertexFunctionName.prize.value)
+    edges = list(graph.edges())
+    points = quota_sweep_bind(
+        edges,
+        cost_dict,
+        prize_dict,
+        quotas,
+        root_vertex,
+        branching_max_depth,
+        branching_strategy,
+        logging_level,
+        name,
+        sec_disjoint_tour,
+        sec_lp_gap_improvement_threshold,
+        sec_maxflow_mincut,
+        sec_max_tailing_off_iterations,
+        sec_sepafreq,
+        time_limit,
+    )
+    return [QuotaSweepPoint(**point) for point in points]
+
+
+class SolverSession:
+    """Prize-collecting TSP model that is kept between solves of a changing instance
+
+    Costs, prizes and the quota can be updated between solves. Each solve keeps
+    the subtour elimination constraints and the cycle covers that are still
+    valid, and starts from the previous best tour repaired for the new instance.
+    The input graph is copied, so updating the session does not change the graph.
+
+    Args:
+        graph: Undirected input graph with edge costs and vertex prizes
+        quota: The minimum prize the tour must collect
+        root_vertex: The tour must start and end at the root vertex
+        cycle_cover: True if cycle cover inequalities are separated
+        logging_level: How verbose should the logging be, e.g. logging.DEBUG?
+        name: Name of the problem instance
+        sec_disjoint_tour: True if subtour elimination constraints using disjoint tours are used
+        sec_maxflow_mincut: True if using the maxflow mincut SEC separation algorithm
+        time_limit: Stop searching after this many seconds for each solve
+    """
+
+    def __init__(
+        self,
+        graph: nx.Graph,
+        quota: int,
+        root_vertex: Vertex,
+        branching_max_depth: int = -1,
+        branching_strategy: int = 0,
+        cycle_cover: bool = False,
+        logging_level: int = logging.INFO,
+        name: str = "pctsp-session",
+        sec_disjoint_tour: bool = True,
+        sec_lp_gap_improvement_threshold: float = LP_GAP_IMPROVEMENT_THRESHOLD,
+        sec_maxflow_mincut: bool = True,
+        sec_max_tailing_off_iterations: int = -1,
+        sec_sepafreq: int = 1,
+        time_limit: float = FOUR_HOURS,
+    ) -> None:
+        cost_dict = nx.get_edge_attributes(graph, EdgeFunctionName.cost.value)
+        prize_dict = nx.get_node_attributes(graph, VertexFunctionName.prize.value)
+        edges = list(graph.edges())
+        self._session = SolverSessionBind(
+            edges,
+            cost_dict,
+            prize_dict,
+            quota,
+            root_vertex,
+            branching_max_depth,
+            branching_strategy,
+            cycle_cover,
+            logging_level,
+            name,
+            sec_disjoint_tour,
+            sec_lp_gap_improvement_threshold,
+            sec_maxflow_mincut,
+            sec_max_tailing_off_iterations,
+            sec_sepafreq,
+            time_limit,
+        )
+
+    def update_edge_cost(self, u: Vertex, v: Vertex, cost: int) -> None:
+        """Change the cost of the edge (u, v)"""
+        self._session.update_edge_cost(u, v, cost)
+
+    def update_vertex_prize(self, vertex: Vertex, prize: int) -> None:
+        """Change the prize of the vertex"""
+        self._session.update_vertex_prize(vertex, prize)
+
+    def update_quota(self, quota: int) -> None:
+        """Change the quota"""
+        self._session.update_quota(quota)
+
+    def solve(self) -> SessionSolveResult:
+        """Solve with the current costs, prizes and quota
+
+        Returns:
+            Best tour and bounds of the current instance
+        """
+        return SessionSolveResult(**self._session.solve())
+
+
+def _instance_bind_args(graph: nx.Graph, quota: int, root_vertex: Vertex) -> Tuple:
+    cost_dict = nx.get_edge_attributes(graph, EdgeFunctionName.cost.value)
+    prize_dict = nx.get_node_attributes(graph, VertexFunctionName.prize.value)
+    return list(graph.edges()), cost_dict, prize_dict, quota, root_vertex
+
+
+class SolverPool:
+    """Pool of SCIP instances that solves many small Prize-collecting TSP instances
+
+    The PCTSP plugins are included once per SCIP instance, so each solve only
+    creates and frees the problem. The branching and SEC settings are shared by
+    every solve of the pool. No log files are written.
+
+    Args:
+        pool_size: Number of SCIP instances, i.e. the number of parallel solves
+        logging_level: How verbose should the logging be, e.g. logging.DEBUG?
+        sec_disjoint_tour: True if subtour elimination constraints using disjoint tours are used
+        sec_maxflow_mincut: True if using the maxflow mincut SEC separation algorithm
+        time_limit: Stop searching after this many seconds for each instance
+    """
+
+    def __init__(
+        self,
+        pool_size: int = 1,
+        branching_max_depth: int = -1,
+        branching_strategy: int = 0,
+        logging_level: int = logging.INFO,
+        sec_disjoint_tour: bool = True,
+        sec_lp_gap_improvement_threshold: float = LP_GAP_IMPROVEMENT_THRESHOLD,
+        sec_maxflow_mincut: bool = True,
+        sec_max_tailing_off_iterations: int = -1,
+        sec_sepafreq: int = 1,
+        time_limit: float = FOUR_HOURS,
+    ) -> None:
+        self._pool = SolverPoolBind(
+            pool_size,
+            branching_max_depth,
+            branching_strategy,
+            logging_level,
+            sec_disjoint_tour,
+            sec_lp_gap_improvement_threshold,
+            sec_maxflow_mincut,
+            sec_max_tailing_off_iterations,
+            sec_sepafreq,
+            time_limit,
+        )
+
+    @property
+    def pool_size(self) -> int:
+        """Number of SCIP instances in the pool"""
+        return self._pool.get_pool_size()
+
+    def solve(
+        self,
+        graph: nx.Graph,
+        quota: int,
+        root_vertex: Vertex,
+        heuristic_edges: EdgeList = None,
+        name: str = "pctsp-pool",
+    ) -> PoolSolveResult:
+        """Solve one instance, starting from the primal-dual tour if no heuristic edges are given"""
+        if heuristic_edges is None:
+            heuristic_edges = []
+        result = self._pool.solve(
+            *_instance_bind_args(graph, quota, root_vertex), heuristic_edges, name
+        )
+        return PoolSolveResult(**result)
+
+    def solve_batch(
+        self,
+        instances: List[Tuple[nx.Graph, int, Vertex]],
+        name: str = "pctsp-pool",
+    ) -> List[PoolSolveResult]:
+        """Solve the (graph, quota, root vertex) instances in parallel
+
+        Returns:
+            Best tour and bounds of every instance in the order of the instances
+        """
+        bind_instances = [
+            _instance_bind_args(graph, quota, root_vertex)
+            for graph, quota, root_vertex in instances
+        ]
+        results = self._pool.solve_batch(bind_instances, name)
+        return [PoolSolveResult(**result) for result in results]
+
+
+def parallel_solve(
+    graph: nx.Graph,
+    quota: int,
+    root_vertex: Vertex,
+    num_workers: int,
+    heuristic_edges: EdgeList = None,
+    deterministic: bool = False,
+    subtree_node_limit: int = 1000,
+    branching_max_depth: int = -1,
+    branching_strategy: int = 0,
+    logging_level: int = logging.INFO,
+    name: str = "pctsp-parallel",
+    sec_disjoint_tour: bool = True,
+    sec_lp_gap_improvement_threshold: float = LP_GAP_IMPROVEMENT_THRESHOLD,
+    sec_maxflow_mincut: bool = True,
+    sec_max_tailing_off_iterations: int = -1,
+    sec_sepafreq: int = 1,
+    time_limit: float = FOUR_HOURS,
+) -> ParallelSolveResult:
+    """Solve Prize-collecting TSP by branching on vertices across several SCIP instances
+
+    Subtrees that are not solved within the node limit are split on the most
+    fractional vertices and shared between the workers, which also share the
+    best tour and the subtour elimination constraints.
+
+    Args:
+        graph: Undirected input graph with edge costs and vertex prizes
+        quota: The minimum prize the tour must collect
+        root_vertex: The tour must start and end at the root vertex
+        num_workers: Number of threads, each with its own SCIP instance
+        heuristic_edges: Edges of a feasible tour, the primal-dual tour is used if not given
+        deterministic: True to solve subtrees in rounds so that runs repeat
+        subtree_node_limit: Split a subtree after this many nodes
+        logging_level: How verbose should the logging be, e.g. logging.DEBUG?
+        name: Name of the problem instance
+        time_limit: Stop searching after this many seconds
+
+    Returns:
+        Best tour and bounds over every subtree
+    """
+    if heuristic_edges is None:
+        heuristic_edges = []
+    result = parallel_solve_bind(
+        *_instance_bind_args(graph, quota, root_vertex),
+        heuristic_edges,
+        num_workers,
+        deterministic,
+        subtree_node_limit,
+        branching_max_depth,
+        branching_strategy,
+        logging_level,
+        name,
+        sec_disjoint_tour,
+        sec_lp_gap_improvement_threshold,
+        sec_maxflow_mincut,
+        sec_max_tailing_off_iterations,
+        sec_sepafreq,
+        time_limit,
+    )
+    return ParallelSolveResult(**result)
+
+
+def portfolio_solve(
+    graph: nx.Graph,
+    quota: int,
+    root_vertex: Vertex,
+    variants: List[SolverVariant] = None,
+    heuristic_edges: EdgeList = None,
+    logging_level: int = logging.INFO,
+    name: str = "pctsp-portfolio",
+    time_limit: float = FOUR_HOURS,
+) -> PortfolioSolveResult:
+    """Race solver variants with different branching and SEC settings on their own threads
+
+    The variants share their best tours and subtour elimination constraints.
+    The first variant to prove optimality stops the others.
+
+    Args:
+        graph: Undirected input graph with edge costs and vertex prizes
+        quota: The minimum prize the tour must collect
+        root_vertex: The tour must start and end at the root vertex
+        variants: Settings of each solver, a default portfolio is used if not given
+        heuristic_edges: Edges of a feasible tour, the primal-dual tour is used if not given
+        logging_level: How verbose should the logging be, e.g. logging.DEBUG?
+        name: Name of the problem instance
+        time_limit: Stop searching after this many seconds
+
+    Returns:
+        Best tour and bounds over every variant, and statistics of each variant
+    """
+    if variants is None:
+        variants = []
+    if heuristic_edges is None:
+        heuristic_edges = []
+    variant_tuples = [
+        (
+            variant.name,
+            variant.branching_max_depth,
+            variant.branching_strategy,
+            variant.sec_disjoint_tour,
+            variant.sec_lp_gap_improvement_threshold,
+            variant.sec_maxflow_mincut,
+            variant.sec_max_tailing_off_iterations,
+            variant.sec_sepafreq,
+        )
+        for variant in variants
+    ]
+    result = portfolio_solve_bind(
+        *_instance_bind_args(graph, quota, root_vertex),
+        heuristic_edges,
+        variant_tuples,
+        logging_level,
+        name,
+        time_limit,
+    )
+    return PortfolioSolveResult(**result)
+
+
+def root_relaxation(
+    graph: nx.Graph,
+    quota: int,
+    root_vertex: Vertex,
+    heuristic_edges: EdgeList = None,
+    cost_cover_disjoint_paths: bool = False,
+    cost_cover_shortest_path: bool = False,
+    cycle_cover: bool = False,
+    disjoint_paths_cost: VertexFunction = None,
+    logging_level: int = logging.INFO,
+    sec_disjoint_tour: bool = True,
+    sec_lp_gap_improvement_threshold: float = LP_GAP_IMPROVEMENT_THRESHOLD,
+    sec_maxflow_mincut: bool = True,
+    sec_max_tailing_off_iterations: int = -1,
+    sec_union_find: bool = False,
+    time_limit: float = FOUR_HOURS,
+) -> RelaxationStats:
+    """Solve only the root node of the branch and cut: the LP relaxation with
+    subtour elimination constraints and, optionally, cycle cover and cost cover
+    inequalities as cutting planes. Nothing is written to file.
+
+    Args:
+        graph: Undirected input graph with edge costs and vertex prizes
+        quota: The minimum prize the tour must collect
+        root_vertex: The tour must start and end at the root vertex
+        heuristic_edges: Edges of a feasible tour whose cost is the upper bound of the cost cover
+            inequalities. The tour is not given to the solver.
+        cost_cover_disjoint_paths: True if disjoint paths cost cover inequality is used
+        cost_cover_shortest_path: True if shortest paths cost cover inequality is used
+        cycle_cover: True to add cycle cover inequalities
+        logging_level: How verbose should the logging be, e.g. logging.DEBUG?
+        sec_disjoint_tour: True if subtour elimination constraints using disjoint tours are used
+        sec_maxflow_mincut: True if using the maxflow mincut SEC separation algorithm
+        sec_union_find: True to separate SECs with union-find over the LP support edges
+            before the maxflow mincut SEC separation algorithm
+        time_limit: Stop searching after this many seconds
+
+    Returns:
+        Bound of the root node, the number of cuts of each type and the solving effort
+    """
+    cost_dict = nx.get_edge_attributes(graph, EdgeFunctionName.cost.value)
+    prize_dict = nx.get_node_attributes(graph, VertexFunctionName.prize.value)
+    edges = list(graph.edges())
+    initial_yes_instance = []
+    if heuristic_edges and is_pctsp_yes_instance(
+        graph, quota, root_vertex, heuristic_edges
+    ):
+        initial_yes_instance = heuristic_edges
+
+    if not disjoint_paths_cost:
+        cost_cover_disjoint_paths = False
+        disjoint_paths_cost = {}
+
+    stats = root_relaxation_bind(
+        edges,
+        initial_yes_instance,
+        cost_dict,
+        prize_dict,
+        quota,
+        root_vertex,
+        cost_cover_disjoint_paths,
+        cost_cover_shortest_path,
+        cycle_cover,
+        disjoint_paths_cost,
+        logging_level,
+        sec_disjoint_tour,
+        sec_lp_gap_improvement_threshold,
+        sec_maxflow_mincut,
+        sec_max_tailing_off_iterations,
+        sec_union_find,
+        time_limit,
     )
+    return RelaxationStats(**stats)
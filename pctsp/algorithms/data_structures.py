@@ -1,6 +1,7 @@
 """Data structures for Prize-collecting TSP"""
 
 from pathlib import Path
+from typing import List, Optional, Tuple
 from pydantic import BaseModel  # pylint: disable=no-name-in-module
 import yaml
 
@@ -19,6 +20,7 @@ class SummaryStats(BaseModel):  # pylint: disable=too-few-public-methods
     num_nodes: int
     num_sec_disjoint_tour: int
     num_sec_maxflow_mincut: int
+    num_sec_union_find: int = 0
 
     @classmethod
     def from_yaml(cls, yaml_filepath: Path):
@@ -26,3 +28,114 @@ class SummaryStats(BaseModel):  # pylint: disable=too-few-public-methods
         with open(yaml_filepath, "r", encoding="utf-8") as yaml_file:
             summary_dict = yaml.full_load(yaml_file)
             return cls(**summary_dict)
+
+
+class RelaxationStats(BaseModel):  # pylint: disable=too-few-public-methods
+    """Bound, cuts and effort of the root LP relaxation"""
+
+    status: int
+    lower_bound: float
+    num_cost_cover_disjoint_paths: int
+    num_cost_cover_shortest_paths: int
+    num_cycle_cover: int
+    num_sec_disjoint_tour: int
+    num_sec_maxflow_mincut: int
+    num_sec_union_find: int
+    num_separation_rounds: int
+    num_lp_iterations: int
+    solving_time: float
+
+
+class QuotaSweepPoint(BaseModel):  # pylint: disable=too-few-public-methods
+    """Best tour found for one quota of a quota sweep"""
+
+    quota: int
+    status: int
+    lower_bound: float
+    upper_bound: float
+    prize: int
+    edge_list: List[Tuple[int, int]]
+    num_kept_secs: int
+    solving_time: float
+
+
+class SessionSolveResult(BaseModel):  # pylint: disable=too-few-public-methods
+    """Best tour found by one solve of a solver session"""
+
+    status: int
+    lower_bound: float
+    upper_bound: float
+    quota: int
+    prize: int
+    edge_list: List[Tuple[int, int]]
+    warm_start_cost: float
+    num_kept_secs: int
+    num_kept_cycle_covers: int
+    num_nodes: int
+    solving_time: float
+
+
+class PoolSolveResult(BaseModel):  # pylint: disable=too-few-public-methods
+    """Best tour found for an instance solved by a solver pool"""
+
+    status: int
+    lower_bound: float
+    upper_bound: float
+    edge_list: List[Tuple[int, int]]
+    num_nodes: int
+    solving_time: float
+
+
+class ParallelSolveResult(BaseModel):  # pylint: disable=too-few-public-methods
+    """Best tour found by solving subtrees of the search tree on several SCIP instances"""
+
+    status: int
+    lower_bound: float
+    upper_bound: float
+    edge_list: List[Tuple[int, int]]
+    num_nodes: int
+    num_subtrees: int
+    num_stolen_subtrees: int
+    num_shared_secs: int
+    solving_time: float
+
+
+class SolverVariant(BaseModel):  # pylint: disable=too-few-public-methods
+    """Branching and subtour elimination settings of one solver of a portfolio"""
+
+    name: str
+    branching_max_depth: int = -1
+    branching_strategy: int = 0
+    sec_disjoint_tour: bool = True
+    sec_lp_gap_improvement_threshold: float = 0.01
+    sec_maxflow_mincut: bool = True
+    sec_max_tailing_off_iterations: int = -1
+    sec_sepafreq: int = 1
+
+
+class VariantStats(BaseModel):  # pylint: disable=too-few-public-methods
+    """Bounds and exchanges of one solver of a portfolio"""
+
+    name: str
+    status: int
+    lower_bound: float
+    upper_bound: float
+    num_nodes: int
+    num_imported_tours: int
+    num_imported_secs: int
+    num_exported_secs: int
+    finished: bool
+    solving_time: float
+
+
+class PortfolioSolveResult(BaseModel):  # pylint: disable=too-few-public-methods
+    """Best tour found by racing solver variants"""
+
+    status: int
+    lower_bound: float
+    upper_bound: float
+    edge_list: List[Tuple[int, int]]
+    num_nodes: int
+    winner: Optional[str] = None
+    variants: List[VariantStats]
+    solving_time: float
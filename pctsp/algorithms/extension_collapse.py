@@ -6,6 +6,7 @@ Annals of Operations Research 81, pages 289-305.
 """
 
 import logging
+from typing import Dict, Mapping, Optional, Tuple
 import networkx as nx
 from tspwplib import (
     EdgeFunctionName,
@@ -24,6 +25,28 @@ from ..libpypctsp import (
 
 # pylint: enable=import-error
 
+Coordinates = Mapping[Vertex, Tuple[float, float]]
+
+
+def coordinates_of_vertices(
+    graph: nx.Graph, coordinates: Optional[Coordinates] = None
+) -> Dict[Vertex, Tuple[float, float]]:
+    """Coordinates of every vertex in the graph, used to build nearest neighbour
+    candidate lists. Empty if any vertex of the graph does not have coordinates.
+
+    Args:
+        graph: Undirected input graph
+        coordinates: Position of each vertex in the plane
+
+    Returns:
+        Mapping from every vertex in the graph to its position
+    """
+    if not coordinates or any(u not in coordinates for u in graph.nodes()):
+        return {}
+    return {
+        u: (float(coordinates[u][0]), float(coordinates[u][1])) for u in graph.nodes()
+    }
+
 
 def collapse(
     graph: nx.Graph,
@@ -90,6 +113,8 @@ def extension_unitary_gain(
     graph: nx.Graph,
     tour: VertexList,
     logging_level: int = logging.INFO,
+    coordinates: Optional[Coordinates] = None,
+    num_candidates: int = 10,
 ) -> VertexList:
     """Implementation of the Extension algorithm with Unitary Gain
 
@@ -97,6 +122,9 @@ def extension_unitary_gain(
         graph: Undirected input graph
         tour: Tour that has the first and last vertex the same
         logging_level: Verbosity of logging.
+        coordinates: If given, only insert the num_candidates nearest neighbours
+            of the endpoints of each tour edge
+        num_candidates: Size of the nearest neighbour candidate lists
 
     Returns:
         Tour that has prize greater than or equal to the input tour
@@ -109,6 +137,8 @@ def extension_unitary_gain(
         tour,
         cost_dict,
         prize_dict,
+        coordinates_of_vertices(graph, coordinates),
+        num_candidates,
         logging_level,
     )
     return extended_tour
@@ -153,6 +183,8 @@ def extension_until_prize_feasible(
     graph: nx.Graph,
     tour: VertexList,
     quota: int,
+    coordinates: Optional[Coordinates] = None,
+    num_candidates: int = 10,
 ) -> VertexList:
     """Implementation of Extension & Collapse with unitary gain as described in
     the paper by Dell'Amico et al.
@@ -162,6 +194,9 @@ def extension_until_prize_feasible(
         graph: Undirected input graph with edge costs and vertex prizes
         tour: Tour that has the first and last vertex the same
         quota: The minimum prize the tour must collect
+        coordinates: If given, only insert the num_candidates nearest neighbours
+            of the endpoints of each tour edge
+        num_candidates: Size of the nearest neighbour candidate lists
 
     Returns:
         A collapsed, prize-feasible tour that has at most the same cost as the input tour
@@ -175,4 +210,6 @@ def extension_until_prize_feasible(
         cost_dict,
         prize_dict,
         quota,
+        coordinates_of_vertices(graph, coordinates),
+        num_candidates,
     )
@@ -1,6 +1,8 @@
 """The path extension & collapse algorithm"""
 
+from enum import IntEnum
 import logging
+from typing import Optional
 import networkx as nx
 from tspwplib import (
     EdgeFunctionName,
@@ -9,15 +11,26 @@ from tspwplib import (
     VertexList,
 )
 
+from .extension_collapse import Coordinates, coordinates_of_vertices
+
 # pylint: disable=import-error
 from ..libpypctsp import (
     collapse_bind,
+    iterated_local_search_bind,
+    memetic_search_bind,
     path_extension_bind,
     path_extension_collapse_bind,
     path_extension_until_prize_feasible_bind,
 )
 
 
+class IlsAcceptance(IntEnum):
+    """Acceptance criteria of iterated local search"""
+
+    SIMULATED_ANNEALING = 0
+    THRESHOLD = 1
+
+
 def path_collapse(
     graph: nx.Graph,
     tour: VertexList,
@@ -99,6 +112,8 @@ def path_extension_collapse(
     path_depth_limit: int = 2,
     step_size: int = 1,
     logging_level: int = logging.INFO,
+    coordinates: Optional[Coordinates] = None,
+    num_candidates: int = 10,
 ) -> VertexList:
     """Run the path extension & collapse heuristic
 
@@ -111,6 +126,9 @@ def path_extension_collapse(
         path_depth_limit: Length of the path to explore in order to extend the tour
         step_size: Gap between two vertices in the tour when trying to extend the tour
         logging_level: Verbosity of logging
+        coordinates: If given, extension and 2-opt only consider the
+            num_candidates nearest neighbours of each vertex
+        num_candidates: Size of the nearest neighbour candidate lists
 
     Returns:
         Tour that (hopefully) has prize above the quota
@@ -128,6 +146,8 @@ def path_extension_collapse(
         collapse_shortest_paths,
         path_depth_limit,
         step_size,
+        coordinates_of_vertices(graph, coordinates),
+        num_candidates,
         logging_level,
     )
 
@@ -172,3 +192,140 @@ def path_extension_until_prize_feasible(
         logging_level,
     )
     return extended_tour
+
+
+# pylint: disable=too-many-arguments
+def iterated_local_search(
+    graph: nx.Graph,
+    tour: VertexList,
+    root_vertex: Vertex,
+    quota: int,
+    collapse_shortest_paths: bool = False,
+    path_depth_limit: int = 2,
+    step_size: int = 1,
+    time_limit: float = 60.0,
+    acceptance: IlsAcceptance = IlsAcceptance.SIMULATED_ANNEALING,
+    acceptance_parameter: float = 0.05,
+    max_iterations: int = -1,
+    seed: int = 1,
+    logging_level: int = logging.INFO,
+    coordinates: Optional[Coordinates] = None,
+    num_candidates: int = 10,
+) -> VertexList:
+    """Iterated local search on top of path extension & collapse.
+
+    The tour is repeatedly perturbed with double-bridge moves and random vertex
+    drops/additions, then re-optimised with path extension & collapse and 2-opt.
+
+    Args:
+        graph: Undirected input graph
+        tour: Tour that has the first and last vertex the same
+        root_vertex: Tour starts and ends at this vertex
+        quota: Lower bound on total prize of tour
+        collapse_shortest_paths: If true, collapse the tour by finding shortest paths
+        path_depth_limit: Length of the path to explore in order to extend the tour
+        step_size: Gap between two vertices in the tour when trying to extend the tour
+        time_limit: Wall-clock budget in seconds
+        acceptance: Accept worse tours by simulated annealing or by a threshold
+        acceptance_parameter: Initial temperature or threshold as a fraction of the tour cost
+        max_iterations: Stop after this many iterations. Negative means no limit.
+        seed: Seed of the random number generator
+        logging_level: Verbosity of logging
+        coordinates: If given, extension and 2-opt only consider the
+            num_candidates nearest neighbours of each vertex
+        num_candidates: Size of the nearest neighbour candidate lists
+
+    Returns:
+        The least-cost prize-feasible tour found
+    """
+    cost_dict = nx.get_edge_attributes(graph, EdgeFunctionName.cost.value)
+    prize_dict = nx.get_node_attributes(graph, VertexFunctionName.prize.value)
+    edge_list = list(graph.edges())
+    return iterated_local_search_bind(
+        edge_list,
+        tour,
+        cost_dict,
+        prize_dict,
+        root_vertex,
+        quota,
+        collapse_shortest_paths,
+        path_depth_limit,
+        step_size,
+        time_limit,
+        int(acceptance),
+        acceptance_parameter,
+        max_iterations,
+        seed,
+        coordinates_of_vertices(graph, coordinates),
+        num_candidates,
+        logging_level,
+    )
+
+
+# pylint: disable=too-many-arguments
+def memetic_search(
+    graph: nx.Graph,
+    tour: VertexList,
+    root_vertex: Vertex,
+    quota: int,
+    collapse_shortest_paths: bool = False,
+    path_depth_limit: int = 2,
+    step_size: int = 1,
+    time_limit: float = 60.0,
+    num_threads: int = 1,
+    population_size: int = 16,
+    max_generations: int = -1,
+    seed: int = 1,
+    logging_level: int = logging.INFO,
+    coordinates: Optional[Coordinates] = None,
+    num_candidates: int = 10,
+) -> VertexList:
+    """Population-based (memetic) search on top of path extension & collapse.
+
+    Children are created by a crossover that splices sub-paths of one parent
+    into the other, then repaired and improved with extension, path extension
+    & collapse and 2-opt on a pool of threads.
+
+    Args:
+        graph: Undirected input graph
+        tour: Tour that has the first and last vertex the same
+        root_vertex: Tour starts and ends at this vertex
+        quota: Lower bound on total prize of tour
+        collapse_shortest_paths: If true, collapse the tour by finding shortest paths
+        path_depth_limit: Length of the path to explore in order to extend the tour
+        step_size: Gap between two vertices in the tour when trying to extend the tour
+        time_limit: Wall-clock budget in seconds
+        num_threads: Number of threads. Non-positive means all hardware threads.
+        population_size: Number of tours in the population
+        max_generations: Stop after this many generations. Negative means no limit.
+        seed: Seed of the random number generator
+        logging_level: Verbosity of logging
+        coordinates: If given, extension and 2-opt only consider the
+            num_candidates nearest neighbours of each vertex
+        num_candidates: Size of the nearest neighbour candidate lists
+
+    Returns:
+        The least-cost prize-feasible tour found
+    """
+    cost_dict = nx.get_edge_attributes(graph, EdgeFunctionName.cost.value)
+    prize_dict = nx.get_node_attributes(graph, VertexFunctionName.prize.value)
+    edge_list = list(graph.edges())
+    return memetic_search_bind(
+        edge_list,
+        tour,
+        cost_dict,
+        prize_dict,
+        root_vertex,
+        quota,
+        collapse_shortest_paths,
+        path_depth_limit,
+        step_size,
+        time_limit,
+        num_threads,
+        population_size,
+        max_generations,
+        seed,
+        coordinates_of_vertices(graph, coordinates),
+        num_candidates,
+        logging_level,
+    )
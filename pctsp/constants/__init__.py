@@ -3,6 +3,7 @@
 from .constants import (
     BOOST_LOGS_TXT,
     FOUR_HOURS,
+    LAGRANGIAN_MAX_ITERATIONS,
     LP_GAP_IMPROVEMENT_THRESHOLD,
     NULL_VERTEX,
     PCTSP_SUMMARY_STATS_YAML,
@@ -16,6 +17,7 @@ from .constants import (
 __all__ = [
     "BOOST_LOGS_TXT",
     "FOUR_HOURS",
+    "LAGRANGIAN_MAX_ITERATIONS",
     "LP_GAP_IMPROVEMENT_THRESHOLD",
     "NULL_VERTEX",
     "PCTSP_SUMMARY_STATS_YAML",
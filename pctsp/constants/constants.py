@@ -5,6 +5,7 @@ from tspwplib import Vertex
 
 NULL_VERTEX: Vertex = -sys.maxsize - 1
 FOUR_HOURS: float = (float)(60 * 60 * 4)
+LAGRANGIAN_MAX_ITERATIONS = 1000
 LP_GAP_IMPROVEMENT_THRESHOLD = 0.001
 BOOST_LOGS_TXT: str = "boost_logs.txt"
 SCIP_BOUNDS_CSV: str = "lower_upper_bounds.csv"
@@ -143,6 +143,10 @@ class Lab:
 
             # get the graph in networkx
             graph = tsp.get_graph()
+            # vertex coordinates for nearest neighbour candidate lists
+            node_coords = getattr(tsp, "node_coords", None)
+            if node_coords:
+                nx.set_node_attributes(graph, node_coords, name="coord")
             rename_edge_attributes(graph, {"weight": "cost"}, del_old_attr=True)
             try:  # londonaq dataset
                 rename_node_attributes(graph, {"demand": "prize"}, del_old_attr=True)
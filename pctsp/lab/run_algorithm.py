@@ -1,6 +1,7 @@
 """Functions for running algorithms using vials"""
 
 from datetime import datetime
+import math
 from logging import Logger
 from pathlib import Path
 from typing import Mapping, Optional, no_type_check
@@ -33,10 +34,13 @@ from ..algorithms import (
     extension_until_prize_feasible,
     solve_pctsp,
     find_cycle_from_bfs,
+    memetic_search,
     path_extension_collapse,
+    root_relaxation,
     suurballes_heuristic,
     suurballes_tour_initialization,
 )
+from ..constants import FOUR_HOURS
 from ..preprocessing import (
     remove_components_disconnected_from_vertex,
     remove_leaves,
@@ -64,11 +68,19 @@ def run_heuristic(
     collapse_shortest_paths: Optional[bool] = None,
     path_depth_limit: Optional[int] = None,
     step_size: Optional[int] = None,
+    time_limit: Optional[float] = None,
+    num_threads: Optional[int] = None,
+    num_candidates: Optional[int] = None,
 ) -> SimpleEdgeList:
-    """Run a Prize-collecting TSP heuristic"""
+    """Run a Prize-collecting TSP heuristic
+
+    If num_candidates is set and every vertex has a "coord" attribute, extension
+    and local search only consider the num_candidates nearest neighbours of a vertex.
+    """
     # initialise the below algorithms with a simple cycle generated from a DFS search
     small_tour = []
     prize_dict = nx.get_node_attributes(graph, VertexFunctionName.prize.value)
+    coordinates = nx.get_node_attributes(graph, "coord") if num_candidates else None
     if algorithm_name in [
         AlgorithmName.suurballes_extension_collapse,
         AlgorithmName.suurballes_heuristic,
@@ -79,6 +91,7 @@ def run_heuristic(
         raise ValueError(message)
     if algorithm_name in [
         AlgorithmName.bfs_extension_collapse,
+        AlgorithmName.bfs_memetic_path_extension_collapse,
         AlgorithmName.bfs_path_extension_collapse,
     ]:
         small_tour = find_cycle_from_bfs(graph, root_vertex)
@@ -101,7 +114,13 @@ def run_heuristic(
         AlgorithmName.suurballes_extension_collapse,
     ]:
         # run extension with unitary gain then collapse
-        extension_until_prize_feasible(graph, small_tour, quota)
+        extension_until_prize_feasible(
+            graph,
+            small_tour,
+            quota,
+            coordinates=coordinates,
+            num_candidates=num_candidates or 0,
+        )
         tour = extension_unitary_gain_collapse(
             graph,
             small_tour,
@@ -128,6 +147,29 @@ def run_heuristic(
             collapse_shortest_paths=collapse_paths,
             path_depth_limit=depth_limit,
             step_size=step,
+            coordinates=coordinates,
+            num_candidates=num_candidates or 0,
+        )
+        edge_list = edge_list_from_walk(tour)
+    elif algorithm_name == AlgorithmName.bfs_memetic_path_extension_collapse:
+        # pylint: disable=simplifiable-if-expression
+        collapse_paths = True if collapse_shortest_paths else False
+        depth_limit = (
+            graph.number_of_nodes() if not path_depth_limit else path_depth_limit
+        )
+        step = 10 if not step_size else step_size
+        tour = memetic_search(
+            graph,
+            small_tour,
+            root_vertex,
+            quota,
+            collapse_shortest_paths=collapse_paths,
+            path_depth_limit=depth_limit,
+            step_size=step,
+            time_limit=60.0 if not time_limit else time_limit,
+            num_threads=1 if num_threads is None else num_threads,
+            coordinates=coordinates,
+            num_candidates=num_candidates or 0,
         )
         edge_list = edge_list_from_walk(tour)
     else:
@@ -177,6 +219,7 @@ def run_algorithm(
         tree, biggest_vertex
     )
 
+    relaxation_bound = 0.0
     if vial.model_params.is_heuristic:
         edge_list = run_heuristic(
             graph,
@@ -188,6 +231,9 @@ def run_algorithm(
             logger=logger,
             path_depth_limit=vial.model_params.path_depth_limit,
             step_size=vial.model_params.step_size,
+            time_limit=vial.model_params.time_limit,
+            num_threads=vial.model_params.num_threads,
+            num_candidates=vial.model_params.num_candidates,
         )
 
     elif vial.model_params.is_exact:
@@ -226,19 +272,48 @@ def run_algorithm(
             cost_cover_disjoint_paths=vial.model_params.cost_cover_disjoint_paths,
             cost_cover_shortest_path=vial.model_params.cost_cover_shortest_path,
             disjoint_paths_cost=cost_map,
+            lagrangian_fixing=bool(vial.model_params.lagrangian_fixing),
             logging_level=logger.level,
             name=str(vial.uuid),
+            node_selection_memory_limit=vial.model_params.node_selection_memory_limit or 0,
             solver_dir=vial_dir,
             sec_disjoint_tour=vial.model_params.sec_disjoint_tour,
             sec_lp_gap_improvement_threshold=vial.model_params.sec_lp_gap_improvement_threshold,
             sec_maxflow_mincut=vial.model_params.sec_maxflow_mincut,
+            sec_max_cuts_per_round=-1
+            if vial.model_params.sec_max_cuts_per_round is None
+            else vial.model_params.sec_max_cuts_per_round,
             sec_max_tailing_off_iterations=vial.model_params.sec_max_tailing_off_iterations,
             sec_sepafreq=vial.model_params.sec_sepafreq,
+            sec_shrink_support_graph=bool(vial.model_params.sec_shrink_support_graph),
+            separation_controller=bool(vial.model_params.separation_controller),
             time_limit=vial.model_params.time_limit,
         )
         logger.info("Status of model: %s", model.getStatus())
         model.freeProb()
 
+    elif vial.model_params.is_relaxation:
+        # the disjoint tours relaxation only separates SECs with disjoint tours
+        relaxation = root_relaxation(
+            graph,
+            vial.data_config.quota,
+            vial.data_config.root,
+            cost_cover_disjoint_paths=bool(vial.model_params.cost_cover_disjoint_paths),
+            cost_cover_shortest_path=bool(vial.model_params.cost_cover_shortest_path),
+            disjoint_paths_cost=cost_map,
+            logging_level=logger.level,
+            sec_disjoint_tour=True,
+            sec_maxflow_mincut=False,
+            time_limit=vial.model_params.time_limit or FOUR_HOURS,
+        )
+        relaxation_bound = relaxation.lower_bound
+        edge_list = []
+        logger.info(
+            "Root relaxation bound is %s after %s separation rounds",
+            relaxation_bound,
+            relaxation.num_separation_rounds,
+        )
+
     else:
         raise NotImplementedError(
             f"{vial.model_params.algorithm.value} is not implemented"
@@ -259,6 +334,9 @@ def run_algorithm(
     objective = total_cost(
         nx.get_edge_attributes(graph, EdgeFunctionName.cost.value), edge_list
     )
+    if vial.model_params.is_relaxation:
+        # costs are integers, so the bound rounds up
+        objective = math.ceil(relaxation_bound - 1e-6)
     vertex_set = vertex_set_from_edge_list(edge_list)
     prize = total_prize(
         nx.get_node_attributes(graph, VertexFunctionName.prize.value), vertex_set
@@ -1,7 +1,14 @@
 
 #include "pctsp/algorithms.hh"
 #include "pctsp/heuristic.hh"
+#include "pctsp/kdtree.hh"
+#include "pctsp/parallel.hh"
+#include "pctsp/pool.hh"
+#include "pctsp/portfolio.hh"
+#include "pctsp/quota_sweep.hh"
+#include "pctsp/relaxation.hh"
 #include "pctsp/renaming.hh"
+#include "pctsp/session.hh"
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
@@ -52,9 +59,18 @@ std::vector<std::pair<PCTSPvertex, PCTSPvertex>> pySolvePrizeCollectingTSP(
     bool sec_maxflow_mincut,
     int sec_max_tailing_off_iterations,
     int sec_sepafreq,
+    bool sec_union_find,
+    bool sec_manage_rows,
+    double node_selection_memory_limit,
+    bool separation_controller,
+    int sec_max_cuts_per_round,
+    bool sec_shrink_support_graph,
     bool simple_rules_only,
     std::filesystem::path solver_dir,
-    float time_limit
+    float time_limit,
+    bool dual_ascent,
+    bool lagrangian_fixing,
+    int pricing_num_neighbors
 ) {
     PCTSPinitLogging(getBoostLevelFromPyLevel(log_level_py));
 
@@ -104,12 +120,510 @@ std::vector<std::pair<PCTSPvertex, PCTSPvertex>> pySolvePrizeCollectingTSP(
         sec_sepafreq,
         simple_rules_only,
         solver_dir,
-        time_limit
+        time_limit,
+        dual_ascent,
+        pricing_num_neighbors,
+        sec_union_find,
+        sec_manage_rows,
+        node_selection_memory_limit,
+        separation_controller,
+        sec_max_cuts_per_round,
+        lagrangian_fixing,
+        sec_shrink_support_graph
     );
     // give old names to vertices in returned edges
     return getOldEdges(vertex_bimap, solution_edges);
 }
 
+/** Solve the root LP relaxation. Returns the bound, cut counts and timing as a dict. */
+py::dict solveRootRelaxationBind(
+    std::vector<std::pair<PCTSPvertex, PCTSPvertex>>& edge_list,
+    std::vector<std::pair<PCTSPvertex, PCTSPvertex>>& heuristic_edges,
+    std::map<std::pair<PCTSPvertex, PCTSPvertex>, CostNumberType>& cost_dict,
+    std::map<PCTSPvertex, PrizeNumberType>& prize_dict,
+    PrizeNumberType& quota,
+    PCTSPvertex& root_vertex,
+    bool cost_cover_disjoint_paths,
+    bool cost_cover_shortest_path,
+    bool cycle_cover,
+    std::map<PCTSPvertex, CostNumberType>& disjoint_paths_map,
+    int log_level_py,
+    bool sec_disjoint_tour,
+    double sec_lp_gap_improvement_threshold,
+    bool sec_maxflow_mincut,
+    int sec_max_tailing_off_iterations,
+    bool sec_union_find,
+    float time_limit
+) {
+    PCTSPinitLogging(getBoostLevelFromPyLevel(log_level_py));
+
+    // rename vertices if they are not in range [0, n-1]
+    PCTSPgraph graph;
+    VertexBimap vertex_bimap;
+    auto new_edges = renameEdges(vertex_bimap, edge_list);
+    addEdgesToGraph(graph, new_edges);
+    auto heur_edges_renamed = getNewEdges(vertex_bimap, heuristic_edges);
+    auto heur_edges = edgesFromVertexPairs(graph, heur_edges_renamed);
+    auto new_root = getNewVertex(vertex_bimap, root_vertex);
+
+    // fill the cost map and prize map using renamed vertices
+    EdgeCostMap cost_map = boost::get(edge_weight, graph);
+    VertexPrizeMap prize_map = boost::get(vertex_distance, graph);
+    std::vector<PrizeNumberType> disjoint_paths_costs (boost::num_vertices(graph));
+    fillCostMapFromRenamedMap(graph, cost_map, cost_dict, vertex_bimap);
+    fillRenamedVertexMap(prize_map, prize_dict, vertex_bimap);
+    fillRenamedVertexMap(disjoint_paths_costs, disjoint_paths_map, vertex_bimap);
+
+    // a fresh SCIP instance that is never seen by python
+    SCIP* scip = NULL;
+    SCIPcreate(&scip);
+    auto stats = solveRootRelaxation(
+        scip, graph, heur_edges, cost_map, prize_map, quota, new_root,
+        cost_cover_disjoint_paths, cost_cover_shortest_path, cycle_cover, disjoint_paths_costs,
+        sec_disjoint_tour, sec_lp_gap_improvement_threshold, sec_maxflow_mincut,
+        sec_max_tailing_off_iterations, time_limit, sec_union_find
+    );
+    SCIPfree(&scip);
+
+    py::dict result;
+    result["status"] = enum_as_integer(stats.status);
+    result["lower_bound"] = stats.lower_bound;
+    result["num_cost_cover_disjoint_paths"] = stats.num_cost_cover_disjoint_paths;
+    result["num_cost_cover_shortest_paths"] = stats.num_cost_cover_shortest_paths;
+    result["num_cycle_cover"] = stats.num_cycle_cover;
+    result["num_sec_disjoint_tour"] = stats.num_sec_disjoint_tour;
+    result["num_sec_maxflow_mincut"] = stats.num_sec_maxflow_mincut;
+    result["num_sec_union_find"] = stats.num_sec_union_find;
+    result["num_separation_rounds"] = stats.num_separation_rounds;
+    result["num_lp_iterations"] = stats.num_lp_iterations;
+    result["solving_time"] = stats.solving_time;
+    return result;
+}
+
+/** Solve PCTSP for every quota. Returns one dict per quota in ascending order of quota. */
+std::vector<py::dict> quotaSweepBind(
+    std::vector<std::pair<PCTSPvertex, PCTSPvertex>>& edge_list,
+    std::map<std::pair<PCTSPvertex, PCTSPvertex>, CostNumberType>& cost_dict,
+    std::map<PCTSPvertex, PrizeNumberType>& prize_dict,
+    std::vector<PrizeNumberType>& quotas,
+    PCTSPvertex& root_vertex,
+    int branching_max_depth,
+    unsigned int branching_strategy,
+    int log_level_py,
+    std::string& name,
+    bool sec_disjoint_tour,
+    double sec_lp_gap_improvement_threshold,
+    bool sec_maxflow_mincut,
+    int sec_max_tailing_off_iterations,
+    int sec_sepafreq,
+    float time_limit
+) {
+    PCTSPinitLogging(getBoostLevelFromPyLevel(log_level_py));
+
+    // rename vertices if they are not in range [0, n-1]
+    PCTSPgraph graph;
+    VertexBimap vertex_bimap;
+    auto new_edges = renameEdges(vertex_bimap, edge_list);
+    addEdgesToGraph(graph, new_edges);
+    auto new_root = getNewVertex(vertex_bimap, root_vertex);
+
+    // fill the cost map and prize map using renamed vertices
+    EdgeCostMap cost_map = boost::get(edge_weight, graph);
+    VertexPrizeMap prize_map = boost::get(vertex_distance, graph);
+    fillCostMapFromRenamedMap(graph, cost_map, cost_dict, vertex_bimap);
+    fillRenamedVertexMap(prize_map, prize_dict, vertex_bimap);
+
+    // one SCIP instance is reused for every quota
+    SCIP* scip = NULL;
+    SCIPcreate(&scip);
+    auto frontier = solveQuotaSweep(
+        scip, graph, cost_map, prize_map, quotas, new_root, branching_max_depth, branching_strategy, name,
+        sec_disjoint_tour, sec_lp_gap_improvement_threshold, sec_maxflow_mincut,
+        sec_max_tailing_off_iterations, sec_sepafreq, time_limit
+    );
+    SCIPfree(&scip);
+
+    std::vector<py::dict> points;
+    for (auto& point : frontier) {
+        py::dict result;
+        result["quota"] = point.quota;
+        result["status"] = enum_as_integer(point.status);
+        result["lower_bound"] = point.lower_bound;
+        result["upper_bound"] = point.upper_bound;
+        result["prize"] = point.prize;
+        auto vertex_pairs = getVertexPairVectorFromEdgeSubset(graph, point.solution_edges);
+        result["edge_list"] = getOldEdges(vertex_bimap, vertex_pairs);
+        result["num_kept_secs"] = point.num_kept_secs;
+        result["solving_time"] = point.solving_time;
+        points.push_back(result);
+    }
+    return points;
+}
+
+/** A solver session over the renamed vertices of a python graph, see SolverSession */
+class SolverSessionBind {
+private:
+    VertexBimap vertex_bimap;
+    std::unique_ptr<SolverSession> session;
+
+    PCTSPvertex getRenamedVertex(PCTSPvertex vertex) {
+        if (vertex_bimap.right.find(vertex) == vertex_bimap.right.end())
+            throw VertexNotFoundException(std::to_string(vertex));
+        return getNewVertex(vertex_bimap, vertex);
+    }
+
+public:
+    SolverSessionBind(
+        std::vector<std::pair<PCTSPvertex, PCTSPvertex>>& edge_list,
+        std::map<std::pair<PCTSPvertex, PCTSPvertex>, CostNumberType>& cost_dict,
+        std::map<PCTSPvertex, PrizeNumberType>& prize_dict,
+        PrizeNumberType quota,
+        PCTSPvertex root_vertex,
+        int branching_max_depth,
+        unsigned int branching_strategy,
+        bool cycle_cover,
+        int log_level_py,
+        std::string& name,
+        bool sec_disjoint_tour,
+        double sec_lp_gap_improvement_threshold,
+        bool sec_maxflow_mincut,
+        int sec_max_tailing_off_iterations,
+        int sec_sepafreq,
+        float time_limit
+    ) {
+        PCTSPinitLogging(getBoostLevelFromPyLevel(log_level_py));
+
+        // rename vertices if they are not in range [0, n-1]
+        PCTSPgraph graph;
+        auto new_edges = renameEdges(vertex_bimap, edge_list);
+        addEdgesToGraph(graph, new_edges);
+        auto new_root = getNewVertex(vertex_bimap, root_vertex);
+
+        // fill the cost map and prize map using renamed vertices
+        EdgeCostMap cost_map = boost::get(edge_weight, graph);
+        VertexPrizeMap prize_map = boost::get(vertex_distance, graph);
+        fillCostMapFromRenamedMap(graph, cost_map, cost_dict, vertex_bimap);
+        fillRenamedVertexMap(prize_map, prize_dict, vertex_bimap);
+
+        session = std::make_unique<SolverSession>(
+            graph, cost_map, prize_map, quota, new_root, branching_max_depth, branching_strategy, cycle_cover, name,
+            sec_disjoint_tour, sec_lp_gap_improvement_threshold, sec_maxflow_mincut,
+            sec_max_tailing_off_iterations, sec_sepafreq, time_limit
+        );
+    }
+
+    void updateEdgeCost(PCTSPvertex u, PCTSPvertex v, CostNumberType cost) {
+        session->updateEdgeCost(getRenamedVertex(u), getRenamedVertex(v), cost);
+    }
+
+    void updateVertexPrize(PCTSPvertex vertex, PrizeNumberType prize) {
+        session->updateVertexPrize(getRenamedVertex(vertex), prize);
+    }
+
+    void updateQuota(PrizeNumberType quota) {
+        session->updateQuota(quota);
+    }
+
+    py::dict solve() {
+        auto stats = session->solve();
+        py::dict result;
+        result["status"] = enum_as_integer(stats.summary.status);
+        result["lower_bound"] = stats.summary.lower_bound;
+        result["upper_bound"] = stats.summary.upper_bound;
+        result["quota"] = session->getQuota();
+        result["prize"] = stats.prize;
+        auto vertex_pairs = getVertexPairVectorFromEdgeSubset(session->getGraph(), stats.solution_edges);
+        result["edge_list"] = getOldEdges(vertex_bimap, vertex_pairs);
+        result["warm_start_cost"] = stats.warm_start_cost;
+        result["num_kept_secs"] = stats.num_kept_secs;
+        result["num_kept_cycle_covers"] = stats.num_kept_cycle_covers;
+        result["num_nodes"] = stats.summary.num_nodes;
+        result["solving_time"] = stats.solving_time;
+        return result;
+    }
+};
+
+typedef std::tuple<
+    std::vector<std::pair<PCTSPvertex, PCTSPvertex>>,
+    std::map<std::pair<PCTSPvertex, PCTSPvertex>, CostNumberType>,
+    std::map<PCTSPvertex, PrizeNumberType>,
+    PrizeNumberType,
+    PCTSPvertex
+> PoolInstance;
+
+/** A pool of SCIP instances that solves python graphs, see SolverPool */
+class SolverPoolBind {
+private:
+    std::unique_ptr<SolverPool> pool;
+
+    /** Renamed graph with the costs and prizes as internal properties */
+    PCTSPgraph getRenamedGraph(
+        VertexBimap& vertex_bimap,
+        std::vector<std::pair<PCTSPvertex, PCTSPvertex>>& edge_list,
+        std::map<std::pair<PCTSPvertex, PCTSPvertex>, CostNumberType>& cost_dict,
+        std::map<PCTSPvertex, PrizeNumberType>& prize_dict
+    ) {
+        PCTSPgraph graph;
+        auto new_edges = renameEdges(vertex_bimap, edge_list);
+        addEdgesToGraph(graph, new_edges);
+        EdgeCostMap cost_map = boost::get(edge_weight, graph);
+        VertexPrizeMap prize_map = boost::get(vertex_distance, graph);
+        fillCostMapFromRenamedMap(graph, cost_map, cost_dict, vertex_bimap);
+        fillRenamedVertexMap(prize_map, prize_dict, vertex_bimap);
+        return graph;
+    }
+
+    py::dict getResultDict(PoolSolveResult& result, PCTSPgraph& graph, VertexBimap& vertex_bimap) {
+        py::dict dict;
+        dict["status"] = enum_as_integer(result.summary.status);
+        dict["lower_bound"] = result.summary.lower_bound;
+        dict["upper_bound"] = result.summary.upper_bound;
+        auto vertex_pairs = getVertexPairVectorFromEdgeSubset(graph, result.solution_edges);
+        dict["edge_list"] = getOldEdges(vertex_bimap, vertex_pairs);
+        dict["num_nodes"] = result.summary.num_nodes;
+        dict["solving_time"] = result.solving_time;
+        return dict;
+    }
+
+public:
+    SolverPoolBind(
+        std::size_t pool_size,
+        int branching_max_depth,
+        unsigned int branching_strategy,
+        int log_level_py,
+        bool sec_disjoint_tour,
+        double sec_lp_gap_improvement_threshold,
+        bool sec_maxflow_mincut,
+        int sec_max_tailing_off_iterations,
+        int sec_sepafreq,
+        float time_limit
+    ) {
+        PCTSPinitLogging(getBoostLevelFromPyLevel(log_level_py));
+        pool = std::make_unique<SolverPool>(
+            pool_size, branching_max_depth, branching_strategy, sec_disjoint_tour,
+            sec_lp_gap_improvement_threshold, sec_maxflow_mincut, sec_max_tailing_off_iterations,
+            sec_sepafreq, time_limit
+        );
+    }
+
+    std::size_t getPoolSize() {
+        return pool->getPoolSize();
+    }
+
+    py::dict solve(
+        std::vector<std::pair<PCTSPvertex, PCTSPvertex>>& edge_list,
+        std::map<std::pair<PCTSPvertex, PCTSPvertex>, CostNumberType>& cost_dict,
+        std::map<PCTSPvertex, PrizeNumberType>& prize_dict,
+        PrizeNumberType quota,
+        PCTSPvertex root_vertex,
+        std::vector<std::pair<PCTSPvertex, PCTSPvertex>>& heuristic_edges,
+        std::string& name
+    ) {
+        VertexBimap vertex_bimap;
+        auto graph = getRenamedGraph(vertex_bimap, edge_list, cost_dict, prize_dict);
+        EdgeCostMap cost_map = boost::get(edge_weight, graph);
+        VertexPrizeMap prize_map = boost::get(vertex_distance, graph);
+        auto new_root = getNewVertex(vertex_bimap, root_vertex);
+        auto heur_edges_renamed = getNewEdges(vertex_bimap, heuristic_edges);
+        auto heur_edges = edgesFromVertexPairs(graph, heur_edges_renamed);
+        auto result = pool->solve(graph, cost_map, prize_map, quota, new_root, heur_edges, name);
+        return getResultDict(result, graph, vertex_bimap);
+    }
+
+    std::vector<py::dict> solveBatch(std::vector<PoolInstance>& instances, std::string& name) {
+        std::vector<VertexBimap> vertex_bimaps (instances.size());
+        std::vector<PCTSPgraph> graphs;
+        std::vector<PrizeNumberType> quotas;
+        std::vector<PCTSPvertex> root_vertices;
+        for (std::size_t i = 0; i < instances.size(); i++) {
+            auto& [edge_list, cost_dict, prize_dict, quota, root_vertex] = instances[i];
+            graphs.push_back(getRenamedGraph(vertex_bimaps[i], edge_list, cost_dict, prize_dict));
+            quotas.push_back(quota);
+            root_vertices.push_back(getNewVertex(vertex_bimaps[i], root_vertex));
+        }
+        std::vector<PoolSolveResult> results;
+        {
+            // the instances are solved on threads of the pool
+            py::gil_scoped_release release;
+            results = pool->solveBatch(graphs, quotas, root_vertices, name);
+        }
+        std::vector<py::dict> dicts;
+        for (std::size_t i = 0; i < results.size(); i++) {
+            dicts.push_back(getResultDict(results[i], graphs[i], vertex_bimaps[i]));
+        }
+        return dicts;
+    }
+};
+
+/** Solve a python graph with subtrees of the search tree on several SCIP instances */
+py::dict parallelSolveBind(
+    std::vector<std::pair<PCTSPvertex, PCTSPvertex>>& edge_list,
+    std::map<std::pair<PCTSPvertex, PCTSPvertex>, CostNumberType>& cost_dict,
+    std::map<PCTSPvertex, PrizeNumberType>& prize_dict,
+    PrizeNumberType quota,
+    PCTSPvertex root_vertex,
+    std::vector<std::pair<PCTSPvertex, PCTSPvertex>>& heuristic_edges,
+    std::size_t num_workers,
+    bool deterministic,
+    long long subtree_node_limit,
+    int branching_max_depth,
+    unsigned int branching_strategy,
+    int log_level_py,
+    std::string& name,
+    bool sec_disjoint_tour,
+    double sec_lp_gap_improvement_threshold,
+    bool sec_maxflow_mincut,
+    int sec_max_tailing_off_iterations,
+    int sec_sepafreq,
+    float time_limit
+) {
+    PCTSPinitLogging(getBoostLevelFromPyLevel(log_level_py));
+
+    // rename vertices if they are not in range [0, n-1]
+    PCTSPgraph graph;
+    VertexBimap vertex_bimap;
+    auto new_edges = renameEdges(vertex_bimap, edge_list);
+    addEdgesToGraph(graph, new_edges);
+    auto new_root = getNewVertex(vertex_bimap, root_vertex);
+    auto heur_edges_renamed = getNewEdges(vertex_bimap, heuristic_edges);
+    auto heur_edges = edgesFromVertexPairs(graph, heur_edges_renamed);
+
+    // fill the cost map and prize map using renamed vertices
+    EdgeCostMap cost_map = boost::get(edge_weight, graph);
+    VertexPrizeMap prize_map = boost::get(vertex_distance, graph);
+    fillCostMapFromRenamedMap(graph, cost_map, cost_dict, vertex_bimap);
+    fillRenamedVertexMap(prize_map, prize_dict, vertex_bimap);
+
+    ParallelSolveStats stats;
+    {
+        // the subtrees are solved on threads of the workers
+        py::gil_scoped_release release;
+        stats = solvePrizeCollectingTSPParallel(
+            graph, heur_edges, cost_map, prize_map, quota, new_root, num_workers, deterministic,
+            subtree_node_limit, branching_max_depth, branching_strategy, sec_disjoint_tour,
+            sec_lp_gap_improvement_threshold, sec_maxflow_mincut, sec_max_tailing_off_iterations,
+            sec_sepafreq, time_limit, name
+        );
+    }
+    py::dict result;
+    result["status"] = enum_as_integer(stats.summary.status);
+    result["lower_bound"] = stats.summary.lower_bound;
+    result["upper_bound"] = stats.summary.upper_bound;
+    auto vertex_pairs = getVertexPairVectorFromEdgeSubset(graph, stats.solution_edges);
+    result["edge_list"] = getOldEdges(vertex_bimap, vertex_pairs);
+    result["num_nodes"] = stats.summary.num_nodes;
+    result["num_subtrees"] = stats.num_subtrees;
+    result["num_stolen_subtrees"] = stats.num_stolen_subtrees;
+    result["num_shared_secs"] = stats.num_shared_secs;
+    result["solving_time"] = stats.solving_time;
+    return result;
+}
+
+typedef std::tuple<std::string, int, unsigned int, bool, double, bool, int, int> SolverVariantTuple;
+
+/** Race solver variants on a python graph, the default variants are used if none are given */
+py::dict portfolioSolveBind(
+    std::vector<std::pair<PCTSPvertex, PCTSPvertex>>& edge_list,
+    std::map<std::pair<PCTSPvertex, PCTSPvertex>, CostNumberType>& cost_dict,
+    std::map<PCTSPvertex, PrizeNumberType>& prize_dict,
+    PrizeNumberType quota,
+    PCTSPvertex root_vertex,
+    std::vector<std::pair<PCTSPvertex, PCTSPvertex>>& heuristic_edges,
+    std::vector<SolverVariantTuple>& variant_tuples,
+    int log_level_py,
+    std::string& name,
+    float time_limit
+) {
+    PCTSPinitLogging(getBoostLevelFromPyLevel(log_level_py));
+
+    // rename vertices if they are not in range [0, n-1]
+    PCTSPgraph graph;
+    VertexBimap vertex_bimap;
+    auto new_edges = renameEdges(vertex_bimap, edge_list);
+    addEdgesToGraph(graph, new_edges);
+    auto new_root = getNewVertex(vertex_bimap, root_vertex);
+    auto heur_edges_renamed = getNewEdges(vertex_bimap, heuristic_edges);
+    auto heur_edges = edgesFromVertexPairs(graph, heur_edges_renamed);
+
+    // fill the cost map and prize map using renamed vertices
+    EdgeCostMap cost_map = boost::get(edge_weight, graph);
+    VertexPrizeMap prize_map = boost::get(vertex_distance, graph);
+    fillCostMapFromRenamedMap(graph, cost_map, cost_dict, vertex_bimap);
+    fillRenamedVertexMap(prize_map, prize_dict, vertex_bimap);
+
+    std::vector<SolverVariant> variants;
+    for (auto& [variant_name, depth, strategy, disjoint_tour, gap, maxflow, tailing, sepafreq] : variant_tuples) {
+        variants.push_back({variant_name, depth, strategy, disjoint_tour, gap, maxflow, tailing, sepafreq});
+    }
+    if (variants.size() == 0) variants = defaultSolverVariants();
+
+    PortfolioSolveStats stats;
+    {
+        // the variants are solved on their own threads
+        py::gil_scoped_release release;
+        stats = solvePrizeCollectingTSPPortfolio(
+            graph, heur_edges, cost_map, prize_map, quota, new_root, variants, time_limit, name
+        );
+    }
+    py::dict result;
+    result["status"] = enum_as_integer(stats.summary.status);
+    result["lower_bound"] = stats.summary.lower_bound;
+    result["upper_bound"] = stats.summary.upper_bound;
+    auto vertex_pairs = getVertexPairVectorFromEdgeSubset(graph, stats.solution_edges);
+    result["edge_list"] = getOldEdges(vertex_bimap, vertex_pairs);
+    result["num_nodes"] = stats.summary.num_nodes;
+    if (stats.winner >= 0) result["winner"] = variants[stats.winner].name;
+    std::vector<py::dict> variant_dicts;
+    for (auto& variant : stats.variants) {
+        py::dict variant_dict;
+        variant_dict["name"] = variant.name;
+        variant_dict["status"] = enum_as_integer(variant.summary.status);
+        variant_dict["lower_bound"] = variant.summary.lower_bound;
+        variant_dict["upper_bound"] = variant.summary.upper_bound;
+        variant_dict["num_nodes"] = variant.summary.num_nodes;
+        variant_dict["num_imported_tours"] = variant.num_imported_tours;
+        variant_dict["num_imported_secs"] = variant.num_imported_secs;
+        variant_dict["num_exported_secs"] = variant.num_exported_secs;
+        variant_dict["finished"] = variant.finished;
+        variant_dict["solving_time"] = variant.solving_time;
+        variant_dicts.push_back(variant_dict);
+    }
+    result["variants"] = variant_dicts;
+    result["solving_time"] = stats.solving_time;
+    return result;
+}
+
+/** Lagrangian lower bound and the upper bound it was computed against */
+std::pair<double, double> lagrangianBoundBind(
+    std::vector<std::pair<PCTSPvertex, PCTSPvertex>>& edge_list,
+    std::map<std::pair<PCTSPvertex, PCTSPvertex>, CostNumberType>& cost_dict,
+    std::map<PCTSPvertex, PrizeNumberType>& prize_dict,
+    PrizeNumberType& quota,
+    PCTSPvertex& py_root,
+    double upper_bound = 0.0,
+    int max_iterations = LAGRANGIAN_MAX_ITERATIONS,
+    int log_level_py = PyLoggingLevels::WARNING
+) {
+    PCTSPinitLogging(getBoostLevelFromPyLevel(log_level_py));
+
+    // get renamed graph
+    PCTSPgraph graph;
+    VertexBimap vertex_bimap;
+    auto new_edges = renameEdges(vertex_bimap, edge_list);
+    addEdgesToGraph(graph, new_edges);
+    auto root_vertex = getNewVertex(vertex_bimap, py_root);
+
+    // fill the cost map and prize map using renamed vertices
+    EdgeCostMap cost_map = boost::get(edge_weight, graph);
+    VertexPrizeMap prize_map = boost::get(vertex_distance, graph);
+    fillCostMapFromRenamedMap(graph, cost_map, cost_dict, vertex_bimap);
+    fillRenamedVertexMap(prize_map, prize_dict, vertex_bimap);
+
+    auto bound = lagrangianBound(graph, cost_map, prize_map, quota, root_vertex, upper_bound, max_iterations);
+    BOOST_LOG_TRIVIAL(info) << "Lagrangian lower bound is " << bound.lower_bound << " after " << bound.num_iterations << " iterations.";
+    return {bound.lower_bound, bound.upper_bound};
+}
+
 /** Example of creating a pyscipopt model in CPP then exposing it to python */
 py::object modelFromCpp() {
     SCIP* scip = NULL;
@@ -126,6 +640,19 @@ py::object modelFromCpp() {
 
 // heuristic bindings
 
+/** Nearest neighbour candidate lists of the renamed vertices. Empty if there are no coordinates. */
+CandidateLists getCandidateListsFromCoordinates(
+    PCTSPgraph& graph,
+    VertexBimap& vertex_bimap,
+    std::map<PCTSPvertex, Point2D>& coordinates_dict,
+    int num_candidates
+) {
+    if (coordinates_dict.empty() || num_candidates <= 0) return CandidateLists();
+    std::vector<Point2D> coordinates (boost::num_vertices(graph));
+    fillRenamedVertexMap(coordinates, coordinates_dict, vertex_bimap);
+    return nearestNeighborCandidates(graph, coordinates, num_candidates);
+}
+
 std::vector<PCTSPvertex> collapseBind(
     std::list<std::pair<PCTSPvertex, PCTSPvertex>>& edge_list,
     std::list<PCTSPvertex>& py_tour,
@@ -154,7 +681,9 @@ std::vector<PCTSPvertex> collapseBind(
     fillRenamedVertexMap(prize_map, prize_dict, vertex_bimap);
 
     // run the collapse algorithm and return renamed vertices
-    auto new_tour = collapse(graph, tour, cost_map, prize_map, quota, root_vertex, collapse_shortest_paths);
+    auto new_tour = callWithBestCostMap(graph, cost_map, [&](auto& costs) {
+        return collapse(graph, tour, costs, prize_map, quota, root_vertex, collapse_shortest_paths);
+    });
     return getOldVertices(vertex_bimap, new_tour);
 }
 
@@ -186,7 +715,9 @@ std::vector<PCTSPvertex> pathExtensionBind(
     fillRenamedVertexMap(prize_map, prize_dict, vertex_bimap);
 
     // run the extension algorithm
-    pathExtension(graph, tour, cost_map, prize_map, root_vertex, step_size, path_depth_limit);
+    callWithBestCostMap(graph, cost_map, [&](auto& costs) {
+        pathExtension(graph, tour, costs, prize_map, root_vertex, step_size, path_depth_limit);
+    });
     return getOldVertices(vertex_bimap, tour);
 }
 
@@ -219,7 +750,9 @@ std::vector<PCTSPvertex> pathExtensionUntilPrizeFeasibleBind(
     fillRenamedVertexMap(prize_map, prize_dict, vertex_bimap);
 
     // run the extension algorithm
-    pathExtensionUntilPrizeFeasible(graph, tour, cost_map, prize_map, root_vertex, quota, step_size, path_depth_limit);
+    callWithBestCostMap(graph, cost_map, [&](auto& costs) {
+        pathExtensionUntilPrizeFeasible(graph, tour, costs, prize_map, root_vertex, quota, step_size, path_depth_limit);
+    });
     return getOldVertices(vertex_bimap, tour);
 }
 
@@ -228,7 +761,9 @@ std::vector<PCTSPvertex> extensionUntilPrizeFeasibleBind(
     std::list<PCTSPvertex>& py_tour,
     std::map<std::pair<PCTSPvertex, PCTSPvertex>, CostNumberType>& cost_dict,
     std::map<PCTSPvertex, PrizeNumberType>& prize_dict,
-    PrizeNumberType& quota
+    PrizeNumberType& quota,
+    std::map<PCTSPvertex, Point2D> coordinates_dict = {},
+    int num_candidates = 10
 ) {
     // get renamed graph
     PCTSPgraph graph;
@@ -244,8 +779,12 @@ std::vector<PCTSPvertex> extensionUntilPrizeFeasibleBind(
     fillCostMapFromRenamedMap(graph, cost_map, cost_dict, vertex_bimap);
     fillRenamedVertexMap(prize_map, prize_dict, vertex_bimap);
 
+    auto candidates = getCandidateListsFromCoordinates(graph, vertex_bimap, coordinates_dict, num_candidates);
+
     // run the extension algorithm
-    extensionUntilPrizeFeasible(graph, tour, cost_map, prize_map, quota);
+    callWithBestCostMap(graph, cost_map, [&](auto& costs) {
+        extensionUntilPrizeFeasible(graph, tour, costs, prize_map, quota, candidates);
+    });
     return getOldVertices(vertex_bimap, tour);
 }
 
@@ -259,6 +798,8 @@ std::vector<PCTSPvertex> pathExtensionCollapseBind(
     bool collapse_shortest_paths = false,
     int path_depth_limit = 2,
     int step_size = 1,
+    std::map<PCTSPvertex, Point2D> coordinates_dict = {},
+    int num_candidates = 10,
     int log_level_py = PyLoggingLevels::WARNING
 ) {
     PCTSPinitLogging(getBoostLevelFromPyLevel(log_level_py));
@@ -278,8 +819,102 @@ std::vector<PCTSPvertex> pathExtensionCollapseBind(
     fillCostMapFromRenamedMap(graph, cost_map, cost_dict, vertex_bimap);
     fillRenamedVertexMap(prize_map, prize_dict, vertex_bimap);
 
+    auto candidates = getCandidateListsFromCoordinates(graph, vertex_bimap, coordinates_dict, num_candidates);
+
     // run the extension algorithm
-    auto new_tour = pathExtensionCollapse(graph, tour, cost_map, prize_map, quota, root_vertex, collapse_shortest_paths, path_depth_limit, step_size);
+    auto new_tour = callWithBestCostMap(graph, cost_map, [&](auto& costs) {
+        return pathExtensionCollapse(graph, tour, costs, prize_map, quota, root_vertex, collapse_shortest_paths, path_depth_limit, step_size, candidates);
+    });
+    return getOldVertices(vertex_bimap, new_tour);
+}
+
+std::vector<PCTSPvertex> iteratedLocalSearchBind(
+    std::vector<std::pair<PCTSPvertex, PCTSPvertex>>& edge_list,
+    std::list<PCTSPvertex>& py_tour,
+    std::map<std::pair<PCTSPvertex, PCTSPvertex>, CostNumberType>& cost_dict,
+    std::map<PCTSPvertex, PrizeNumberType>& prize_dict,
+    PCTSPvertex& py_root,
+    PrizeNumberType& quota,
+    bool collapse_shortest_paths = false,
+    int path_depth_limit = 2,
+    int step_size = 1,
+    float time_limit = 60,
+    unsigned int acceptance = IlsAcceptance::SIMULATED_ANNEALING,
+    float acceptance_parameter = 0.05,
+    int max_iterations = -1,
+    unsigned int seed = PCTSP_DEFAULT_SEED,
+    std::map<PCTSPvertex, Point2D> coordinates_dict = {},
+    int num_candidates = 10,
+    int log_level_py = PyLoggingLevels::WARNING
+) {
+    PCTSPinitLogging(getBoostLevelFromPyLevel(log_level_py));
+
+    // get renamed graph
+    PCTSPgraph graph;
+    VertexBimap vertex_bimap;
+    auto new_edges = renameEdges(vertex_bimap, edge_list);
+    addEdgesToGraph(graph, new_edges);
+    auto root_vertex = getNewVertex(vertex_bimap, py_root);
+    auto new_vertices = getNewVertices(vertex_bimap, py_tour);
+    std::list<PCTSPvertex> tour (new_vertices.begin(), new_vertices.end());
+
+    // fill the cost map and prize map using renamed vertices
+    EdgeCostMap cost_map = boost::get(edge_weight, graph);
+    VertexPrizeMap prize_map = boost::get(vertex_distance, graph);
+    fillCostMapFromRenamedMap(graph, cost_map, cost_dict, vertex_bimap);
+    fillRenamedVertexMap(prize_map, prize_dict, vertex_bimap);
+
+    auto candidates = getCandidateListsFromCoordinates(graph, vertex_bimap, coordinates_dict, num_candidates);
+
+    // run iterated local search
+    auto new_tour = callWithBestCostMap(graph, cost_map, [&](auto& costs) {
+        return iteratedLocalSearch(graph, tour, costs, prize_map, quota, root_vertex, collapse_shortest_paths, path_depth_limit, step_size, time_limit, acceptance, acceptance_parameter, max_iterations, seed, candidates);
+    });
+    return getOldVertices(vertex_bimap, new_tour);
+}
+
+std::vector<PCTSPvertex> memeticSearchBind(
+    std::vector<std::pair<PCTSPvertex, PCTSPvertex>>& edge_list,
+    std::list<PCTSPvertex>& py_tour,
+    std::map<std::pair<PCTSPvertex, PCTSPvertex>, CostNumberType>& cost_dict,
+    std::map<PCTSPvertex, PrizeNumberType>& prize_dict,
+    PCTSPvertex& py_root,
+    PrizeNumberType& quota,
+    bool collapse_shortest_paths = false,
+    int path_depth_limit = 2,
+    int step_size = 1,
+    float time_limit = 60,
+    int num_threads = 1,
+    int population_size = 16,
+    int max_generations = -1,
+    unsigned int seed = PCTSP_DEFAULT_SEED,
+    std::map<PCTSPvertex, Point2D> coordinates_dict = {},
+    int num_candidates = 10,
+    int log_level_py = PyLoggingLevels::WARNING
+) {
+    PCTSPinitLogging(getBoostLevelFromPyLevel(log_level_py));
+
+    // get renamed graph
+    PCTSPgraph graph;
+    VertexBimap vertex_bimap;
+    auto new_edges = renameEdges(vertex_bimap, edge_list);
+    addEdgesToGraph(graph, new_edges);
+    auto root_vertex = getNewVertex(vertex_bimap, py_root);
+    auto new_vertices = getNewVertices(vertex_bimap, py_tour);
+    std::list<PCTSPvertex> tour (new_vertices.begin(), new_vertices.end());
+
+    // fill the cost map and prize map using renamed vertices
+    EdgeCostMap cost_map = boost::get(edge_weight, graph);
+    VertexPrizeMap prize_map = boost::get(vertex_distance, graph);
+    fillCostMapFromRenamedMap(graph, cost_map, cost_dict, vertex_bimap);
+    fillRenamedVertexMap(prize_map, prize_dict, vertex_bimap);
+
+    auto candidates = getCandidateListsFromCoordinates(graph, vertex_bimap, coordinates_dict, num_candidates);
+
+    // run the memetic search
+    auto new_tour = callWithBestCostMap(graph, cost_map, [&](auto& costs) {
+        return memeticSearch(graph, tour, costs, prize_map, quota, root_vertex, collapse_shortest_paths, path_depth_limit, step_size, time_limit, num_threads, population_size, max_generations, seed, candidates);
+    });
     return getOldVertices(vertex_bimap, new_tour);
 }
 
@@ -288,6 +923,8 @@ std::vector<PCTSPvertex> extensionUnitaryGainBind(
     std::list<PCTSPvertex>& py_tour,
     std::map<std::pair<PCTSPvertex, PCTSPvertex>, CostNumberType>& cost_dict,
     std::map<PCTSPvertex, PrizeNumberType>& prize_dict,
+    std::map<PCTSPvertex, Point2D> coordinates_dict = {},
+    int num_candidates = 10,
     int log_level_py = PyLoggingLevels::WARNING
 ) {
     PCTSPinitLogging(getBoostLevelFromPyLevel(log_level_py));
@@ -306,8 +943,12 @@ std::vector<PCTSPvertex> extensionUnitaryGainBind(
     fillCostMapFromRenamedMap(graph, cost_map, cost_dict, vertex_bimap);
     fillRenamedVertexMap(prize_map, prize_dict, vertex_bimap);
 
+    auto candidates = getCandidateListsFromCoordinates(graph, vertex_bimap, coordinates_dict, num_candidates);
+
     // run the extension algorithm
-    extensionUnitaryGain(graph, tour, cost_map, prize_map);
+    callWithBestCostMap(graph, cost_map, [&](auto& costs) {
+        extensionUnitaryGain(graph, tour, costs, prize_map, candidates);
+    });
     return getOldVertices(vertex_bimap, tour);
 }
 
@@ -315,11 +956,35 @@ PYBIND11_MODULE(libpypctsp, m) {
     // functions for branch and cut
     m.def("basic_solve_pctsp_bind", &pyBasicSolvePrizeCollectingTSP, "Solve PCTSP with basic branch and cut");
     m.def("solve_pctsp_bind", &pySolvePrizeCollectingTSP, "Solve PCTSP.");
+    m.def("root_relaxation_bind", &solveRootRelaxationBind, "Solve the root LP relaxation of PCTSP.");
+    m.def("quota_sweep_bind", &quotaSweepBind, "Solve PCTSP for a list of quotas reusing one model.");
+    m.def("parallel_solve_bind", &parallelSolveBind, "Solve PCTSP with subtrees on several SCIP instances.");
+    m.def("portfolio_solve_bind", &portfolioSolveBind, "Race PCTSP solver variants that share tours and SECs.");
+    m.def("lagrangian_bound_bind", &lagrangianBoundBind, "Lagrangian lower bound on the cost of a PCTSP tour.");
+    py::class_<SolverPoolBind>(m, "SolverPoolBind", "Pool of SCIP instances with the PCTSP plugins included.")
+        .def(py::init<std::size_t, int, unsigned int, int, bool, double, bool, int, int, float>())
+        .def("get_pool_size", &SolverPoolBind::getPoolSize, "Number of SCIP instances in the pool.")
+        .def("solve", &SolverPoolBind::solve, "Solve one instance with a SCIP instance of the pool.")
+        .def("solve_batch", &SolverPoolBind::solveBatch, "Solve the instances in parallel.");
+    py::class_<SolverSessionBind>(m, "SolverSessionBind", "PCTSP model kept between solves of a changing instance.")
+        .def(py::init<
+            std::vector<std::pair<PCTSPvertex, PCTSPvertex>>&,
+            std::map<std::pair<PCTSPvertex, PCTSPvertex>, CostNumberType>&,
+            std::map<PCTSPvertex, PrizeNumberType>&,
+            PrizeNumberType, PCTSPvertex, int, unsigned int, bool, int, std::string&,
+            bool, double, bool, int, int, float
+        >())
+        .def("update_edge_cost", &SolverSessionBind::updateEdgeCost, "Change the cost of an edge.")
+        .def("update_vertex_prize", &SolverSessionBind::updateVertexPrize, "Change the prize of a vertex.")
+        .def("update_quota", &SolverSessionBind::updateQuota, "Change the quota.")
+        .def("solve", &SolverSessionBind::solve, "Solve with the current costs, prizes and quota.");
 
     // functions for heuristics
     m.def("collapse_bind", &collapseBind, "Collapse heuristic bind.");
     m.def("extension_unitary_gain_bind", &extensionUnitaryGainBind, "Extension heuristic with unitary gain");
     m.def("extension_until_prize_feasible_bind", &extensionUntilPrizeFeasibleBind, "Extension until prize feasible");
+    m.def("iterated_local_search_bind", &iteratedLocalSearchBind, "Iterated local search on top of path extension & collapse.");
+    m.def("memetic_search_bind", &memeticSearchBind, "Memetic search on top of path extension & collapse.");
     m.def("path_extension_bind", &pathExtensionBind, "Path Extension heuristic bind.");
     m.def("path_extension_collapse_bind", &pathExtensionCollapseBind, "Path extension & collapse.");
     m.def("path_extension_until_prize_feasible_bind", &pathExtensionUntilPrizeFeasibleBind, "Path Extension until prize feasible.");
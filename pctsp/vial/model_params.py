@@ -13,6 +13,7 @@ class AlgorithmName(StrEnumMixin, str, Enum):
     disjoint_tours_relaxation = "disjoint_tours_relaxation"
     extension = "extension"
     bfs_extension_collapse = "bfs_extension_collapse"
+    bfs_memetic_path_extension_collapse = "bfs_memetic_path_extension_collapse"
     bfs_path_extension_collapse = "bfs_path_extension_collapse"
     solve_pctsp = "solve_pctsp"
     suurballes_extension_collapse = "suurballes_extension_collapse"
@@ -27,6 +28,7 @@ class LongAlgorithmName(StrEnumMixin, str, Enum):
     extend = "Extension"
     extension = "Extension"
     bfs_extension_collapse = "BFS Extension and Collapse"
+    bfs_memetic_path_extension_collapse = "BFS Memetic Path Extension and Collapse"
     bfs_path_extension_collapse = "BFS Path Extension and Collapse"
     solve_pctsp = "PCTSP Branch and Cut"
     suurballes_extension_collapse = "Suurballe's Extension and Collapse"
@@ -39,6 +41,7 @@ class ShortAlgorithmName(StrEnumMixin, str, Enum):
 
     disjoint_tours_relaxation = "DTR"
     bfs_extension_collapse = "BFS-EC"
+    bfs_memetic_path_extension_collapse = "BFS-MPEC"
     bfs_path_extension_collapse = "BFS-PEC"
     extension = "Ex"
     solve_pctsp = "BC"
@@ -51,6 +54,7 @@ EXACT_ALGORITHMS: List[AlgorithmName] = [AlgorithmName.solve_pctsp]
 HEURISTIC_ALGORITHMS: List[AlgorithmName] = [
     AlgorithmName.extension,
     AlgorithmName.bfs_extension_collapse,
+    AlgorithmName.bfs_memetic_path_extension_collapse,
     AlgorithmName.bfs_path_extension_collapse,
     AlgorithmName.suurballes_extension_collapse,
     AlgorithmName.suurballes_heuristic,
@@ -66,6 +70,8 @@ class BranchingStrategy(IntEnum):
     STRONG = 1
     STRONG_AT_TREE_TOP = 2
     DEFAULT = 4
+    VERTEX = 5
+    CUT_SET = 6
 
 
 # pylint: disable=abstract-method,too-many-instance-attributes
@@ -82,11 +88,18 @@ class ModelParams(BaseModel):
     cost_cover_disjoint_paths: Optional[bool] = None
     cost_cover_shortest_path: Optional[bool] = None
     heuristic: Optional[AlgorithmName] = None
+    lagrangian_fixing: Optional[bool] = None
+    node_selection_memory_limit: Optional[float] = None
+    num_candidates: Optional[int] = None
+    num_threads: Optional[int] = None
     path_depth_limit: Optional[int] = None
     sec_disjoint_tour: Optional[bool] = None
     sec_lp_gap_improvement_threshold: Optional[float] = None
     sec_maxflow_mincut: Optional[bool] = None
+    sec_max_cuts_per_round: Optional[int] = None
     sec_max_tailing_off_iterations: Optional[int] = None
     sec_sepafreq: Optional[int] = None
+    sec_shrink_support_graph: Optional[bool] = None
+    separation_controller: Optional[bool] = None
     step_size: Optional[int] = None
     time_limit: Optional[float] = None
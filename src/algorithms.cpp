@@ -3,6 +3,7 @@
 #include "pctsp/algorithms.hh"
 #include "pctsp/node_selection.hh"
 #include "pctsp/separation.hh"
+#include "pctsp/separation_controller.hh"
 
 struct SCIP_ProbData {
    ProbDataPCTSP*    objprobdata;        /**< user problem data object */
@@ -25,6 +26,50 @@ SCIP_RETCODE addHeuristicVarsToSolver(
     return SCIP_OKAY;
 }
 
+SCIP_RETCODE includeCostLowerBound(SCIP* scip, double lower_bound) {
+    return SCIPincludeObjEventhdlr(scip, new CostLowerBoundEventhdlr(scip, lower_bound), TRUE);
+}
+
+SCIP_RETCODE fixVariablesWithLagrangianBound(
+    SCIP* scip,
+    PCTSPgraph& graph,
+    std::map<PCTSPedge, SCIP_VAR*>& edge_variable_map,
+    LagrangianBound& bound
+) {
+    auto fixed_edges = lagrangianFixedEdges(graph, bound);
+    for (auto edge : fixed_edges) {
+        auto it = edge_variable_map.find(edge);
+        if (it != edge_variable_map.end()) SCIP_CALL(SCIPchgVarUb(scip, it->second, 0.0));
+    }
+    // fixed edges without a variable are never priced
+    EdgePricer* pricer = findEdgePricer(scip);
+    if (pricer != NULL) pricer->removePriceableEdges(fixed_edges);
+    for (PCTSPvertex vertex = 0; vertex < bound.is_vertex_fixed.size(); vertex++) {
+        if (!bound.is_vertex_fixed[vertex]) continue;
+        auto self_loop = boost::edge(vertex, vertex, graph);
+        if (!self_loop.second) continue;
+        auto it = edge_variable_map.find(self_loop.first);
+        if (it != edge_variable_map.end()) SCIP_CALL(SCIPchgVarLb(scip, it->second, 1.0));
+    }
+    return SCIP_OKAY;
+}
+
+SCIP_RETCODE fixVerticesEliminatedByDualAscent(
+    SCIP* scip,
+    PCTSPgraph& graph,
+    std::map<PCTSPedge, SCIP_VAR*>& edge_variable_map,
+    DualAscentBound& bound
+) {
+    for (PCTSPvertex vertex = 0; vertex < bound.is_vertex_eliminated.size(); vertex++) {
+        if (!bound.is_vertex_eliminated[vertex]) continue;
+        auto self_loop = boost::edge(vertex, vertex, graph);
+        if (!self_loop.second) continue;
+        auto it = edge_variable_map.find(self_loop.first);
+        if (it != edge_variable_map.end()) SCIP_CALL(SCIPchgVarUb(scip, it->second, 0.0));
+    }
+    return SCIP_OKAY;
+}
+
 std::vector<std::pair<PCTSPvertex, PCTSPvertex>> solvePrizeCollectingTSP(
     SCIP* scip,
     PCTSPgraph& graph,
@@ -72,11 +117,13 @@ SummaryStats getSummaryStatsFromSCIP(SCIP* scip) {
     auto objeventhdlr = SCIPfindObjEventhdlr(scip, NODE_EVENTHDLR_NAME.c_str());
     unsigned int n_disjoint_sec = 0;
     unsigned int n_flow_sec = 0;
+    unsigned int n_union_find_sec = 0;
     if (objeventhdlr != 0) {
         NodeEventhdlr* node_eventhdlr =  dynamic_cast<NodeEventhdlr*>(objeventhdlr);
         auto node_stats = node_eventhdlr->getNodeStatsVector();
         n_disjoint_sec = numDisjointTourSECs(node_stats);
         n_flow_sec = numMaxflowMincutSECs(node_stats);
+        n_union_find_sec = numUnionFindSECs(node_stats);
     }
 
     // get cost cover event handlers
@@ -109,7 +156,8 @@ SummaryStats getSummaryStatsFromSCIP(SCIP* scip) {
         num_cycle_cover,
         SCIPgetNNodes(scip),
         n_disjoint_sec,
-        n_flow_sec
+        n_flow_sec,
+        n_union_find_sec
     };
     return summary;
 }
@@ -136,7 +184,16 @@ std::vector<std::pair<PCTSPvertex, PCTSPvertex>> solvePrizeCollectingTSP(
     int sec_sepafreq,
     bool simple_rules_only,
     std::filesystem::path solver_dir,
-    float time_limit
+    float time_limit,
+    bool dual_ascent,
+    int pricing_num_neighbors,
+    bool sec_union_find,
+    bool sec_manage_rows,
+    double node_selection_memory_limit,
+    bool separation_controller,
+    int sec_max_cuts_per_round,
+    bool lagrangian_fixing,
+    bool sec_shrink_support_graph
 ) {
     // build filepaths
     std::filesystem::create_directory(solver_dir);
@@ -150,12 +207,68 @@ std::vector<std::pair<PCTSPvertex, PCTSPvertex>> solvePrizeCollectingTSP(
     SCIPcreateMessagehdlrDefault(&handler, false, scip_logs_txt.c_str(), true);
     SCIPsetMessagehdlr(scip, handler);
 
+    // without a heuristic solution, start from the primal-dual tour
+    double primal_dual_lower_bound = 0.0;
+    if (heuristic_edges.size() == 0) {
+        std::list<PCTSPvertex> primal_dual_tour;
+        primal_dual_lower_bound = callWithBestCostMap(graph, cost_map, [&](auto& costs) {
+            return primalDualTour(graph, primal_dual_tour, costs, prize_map, quota, root_vertex);
+        });
+        if (primal_dual_tour.size() > 0) {
+            auto first = primal_dual_tour.begin();
+            auto last = primal_dual_tour.end();
+            heuristic_edges = getEdgesInWalk(graph, first, last);
+            BOOST_LOG_TRIVIAL(info) << "Primal-dual heuristic found a tour of cost " << totalCost(heuristic_edges, cost_map) << ".";
+        }
+    }
+
+    // dual ascent deletes the edges and vertices that cannot be in a tour cheaper than the heuristic
+    double cost_lower_bound = primal_dual_lower_bound;
+    std::optional<DualAscentBound> dual_ascent_bound;
+    if (dual_ascent && heuristic_edges.size() > 0) {
+        dual_ascent_bound = dualAscent(graph, cost_map, prize_map, quota, root_vertex, totalCost(heuristic_edges, cost_map));
+        auto num_removed = removeEliminatedEdges(graph, *dual_ascent_bound);
+        auto num_eliminated_vertices = std::count(dual_ascent_bound->is_vertex_eliminated.begin(), dual_ascent_bound->is_vertex_eliminated.end(), true);
+        BOOST_LOG_TRIVIAL(info) << "Dual ascent lower bound on the cost is " << dual_ascent_bound->lower_bound
+            << ". Removed " << num_removed << " edges from the graph and eliminated "
+            << num_eliminated_vertices << " vertices.";
+        if (std::isfinite(dual_ascent_bound->lower_bound)) cost_lower_bound = std::max(cost_lower_bound, dual_ascent_bound->lower_bound);
+    }
+
+    // the Lagrangian bound fixes variables that cannot be in a tour cheaper than the heuristic
+    std::optional<LagrangianBound> lagrangian_bound;
+    if (lagrangian_fixing && heuristic_edges.size() > 0) {
+        lagrangian_bound = lagrangianBound(graph, cost_map, prize_map, quota, root_vertex, totalCost(heuristic_edges, cost_map));
+        BOOST_LOG_TRIVIAL(info) << "Lagrangian lower bound on the cost is " << lagrangian_bound->lower_bound
+            << " after " << lagrangian_bound->num_iterations << " iterations.";
+    }
+
     // add variables, constraints and the SEC cutting plane
     auto edge_var_map = modelPrizeCollectingTSP(
         scip, graph, heuristic_edges, cost_map, prize_map, quota, root_vertex, name,
         sec_disjoint_tour, sec_lp_gap_improvement_threshold, sec_maxflow_mincut,
-        sec_max_tailing_off_iterations, sec_sepafreq, simple_rules_only
+        sec_max_tailing_off_iterations, sec_sepafreq, simple_rules_only, pricing_num_neighbors
     );
+    auto sec_conshdlr = dynamic_cast<PCTSPconshdlrSubtour*>(SCIPfindObjConshdlr(scip, SEC_CONSHDLR_NAME.c_str()));
+    sec_conshdlr->setUnionFindSeparation(sec_union_find);
+    sec_conshdlr->setManageSECRows(scip, sec_manage_rows);
+    sec_conshdlr->setShrinkSupportGraph(sec_shrink_support_graph);
+    if (sec_max_cuts_per_round >= 0) sec_conshdlr->setCutSelection(sec_max_cuts_per_round);
+    if (dual_ascent_bound) SCIP_CALL_EXC(fixVerticesEliminatedByDualAscent(scip, graph, edge_var_map, *dual_ascent_bound));
+    if (lagrangian_bound && std::isfinite(lagrangian_bound->lower_bound)) {
+        SCIP_CALL_EXC(fixVariablesWithLagrangianBound(scip, graph, edge_var_map, *lagrangian_bound));
+        auto num_fixed_edges = std::count(lagrangian_bound->is_edge_fixed.begin(), lagrangian_bound->is_edge_fixed.end(), true);
+        auto num_fixed_vertices = std::count(lagrangian_bound->is_vertex_fixed.begin(), lagrangian_bound->is_vertex_fixed.end(), true);
+        BOOST_LOG_TRIVIAL(info) << "Lagrangian bound fixed " << num_fixed_edges << " edges to zero and "
+            << num_fixed_vertices << " vertices to be visited.";
+        cost_lower_bound = std::max(cost_lower_bound, lagrangian_bound->lower_bound);
+    }
+
+    // the duals of the primal-dual algorithm, dual ascent and the Lagrangian bound the cost of every feasible tour
+    if (cost_lower_bound > 0) {
+        BOOST_LOG_TRIVIAL(info) << "Lower bound on the cost is " << cost_lower_bound << ".";
+        SCIP_CALL_EXC(includeCostLowerBound(scip, std::ceil(cost_lower_bound - 1e-6)));
+    }
 
     // add the cost cover inequalities when a new solution is found
     // NOTE we assume the heuristic solution is feasible (trust the user)
@@ -196,6 +309,12 @@ std::vector<std::pair<PCTSPvertex, PCTSPvertex>> solvePrizeCollectingTSP(
     // set branching scheme
     setBranchingStrategy(scip, branching_strategy, branching_max_depth);
 
+    // plunge once the tracked memory comes close to the limit in MB
+    if (node_selection_memory_limit > 0) includeMemoryAwareNodeSelection(scip, node_selection_memory_limit);
+
+    // skip separators whose bound improvement per second diminishes
+    if (separation_controller) includeSeparationController(scip);
+
     // time limit
     SCIPsetRealParam(scip, "limits/time", time_limit);
 
@@ -206,6 +325,8 @@ std::vector<std::pair<PCTSPvertex, PCTSPvertex>> solvePrizeCollectingTSP(
     // solve the model
     SCIPsolve(scip);
     BOOST_LOG_TRIVIAL(info) << "SCIP solve has finished.";
+    EdgePricer* pricer = findEdgePricer(scip);
+    if (pricer != NULL) BOOST_LOG_TRIVIAL(info) << "Priced " << pricer->getNumPricedVars() << " edge variables into the model.";
 
     // get the solution
     std::vector<PCTSPedge> solution_edges = std::vector<PCTSPedge>();
@@ -250,6 +371,53 @@ std::map<PCTSPedge, SCIP_VAR*> modelPrizeCollectingTSP(
     bool sec_maxflow_mincut,
     int sec_max_tailing_off_iterations,
     int sec_sepafreq,
+    bool simple_rules_only,
+    int pricing_num_neighbors
+) {
+    std::map<PCTSPedge, SCIP_VAR*> edge_variable_map;
+    modelPrizeCollectingTSP(
+        scip, graph, heuristic_edges, cost_map, prize_map, quota, root_vertex, edge_variable_map, name,
+        sec_disjoint_tour, sec_lp_gap_improvement_threshold, sec_maxflow_mincut,
+        sec_max_tailing_off_iterations, sec_sepafreq, simple_rules_only, pricing_num_neighbors
+    );
+    return edge_variable_map;
+}
+
+SCIP_RETCODE modelPrizeCollectingTSP(
+    SCIP* scip,
+    PCTSPgraph& graph,
+    std::vector<PCTSPedge>& heuristic_edges,
+    EdgeCostMap& cost_map,
+    VertexPrizeMap& prize_map,
+    PrizeNumberType& quota,
+    PCTSPvertex& root_vertex,
+    PCTSPedgeVariableMap& edge_variable_map,
+    std::string& name,
+    bool sec_disjoint_tour,
+    double sec_lp_gap_improvement_threshold,
+    bool sec_maxflow_mincut,
+    int sec_max_tailing_off_iterations,
+    int sec_sepafreq,
+    bool simple_rules_only,
+    int pricing_num_neighbors
+) {
+    SCIP_CALL(includePrizeCollectingTSPPlugins(
+        scip, sec_disjoint_tour, sec_lp_gap_improvement_threshold, sec_maxflow_mincut,
+        sec_max_tailing_off_iterations, sec_sepafreq, simple_rules_only
+    ));
+    return createPrizeCollectingTSPProblem(
+        scip, graph, heuristic_edges, cost_map, prize_map, quota, root_vertex, edge_variable_map, name,
+        pricing_num_neighbors
+    );
+}
+
+SCIP_RETCODE includePrizeCollectingTSPPlugins(
+    SCIP* scip,
+    bool sec_disjoint_tour,
+    double sec_lp_gap_improvement_threshold,
+    bool sec_maxflow_mincut,
+    int sec_max_tailing_off_iterations,
+    int sec_sepafreq,
     bool simple_rules_only
 ) {
     if (simple_rules_only) {
@@ -275,33 +443,59 @@ std::map<PCTSPedge, SCIP_VAR*> modelPrizeCollectingTSP(
         // use the default branching rules
         SCIPincludeDefaultPlugins(scip);
     }
+    auto conshdlr = new PCTSPconshdlrSubtour(
+        scip,
+        sec_disjoint_tour,
+        sec_lp_gap_improvement_threshold,
+        sec_maxflow_mincut,
+        sec_max_tailing_off_iterations,
+        sec_sepafreq
+    );
+    SCIP_CALL(SCIPincludeObjConshdlr(scip, conshdlr, TRUE));
 
+    // turn off presolving
+    SCIP_CALL(SCIPsetIntParam(scip, "presolving/maxrounds", 0));
+    return SCIP_OKAY;
+}
+
+SCIP_RETCODE createPrizeCollectingTSPProblem(
+    SCIP* scip,
+    PCTSPgraph& graph,
+    std::vector<PCTSPedge>& heuristic_edges,
+    EdgeCostMap& cost_map,
+    VertexPrizeMap& prize_map,
+    PrizeNumberType& quota,
+    PCTSPvertex& root_vertex,
+    PCTSPedgeVariableMap& edge_variable_map,
+    std::string& name,
+    int pricing_num_neighbors
+) {
     // add self loops to graph - we assume the input graph is simple
     if (hasSelfLoopsOnAllVertices(graph) == false) {
         addSelfLoopsToGraph(graph);
         assignZeroCostToSelfLoops(graph, cost_map);
     }
 
-    std::map<PCTSPedge, SCIP_VAR*> edge_variable_map;
     std::map<PCTSPedge, PrizeNumberType> weight_map;
     putPrizeOntoEdgeWeights(graph, prize_map, weight_map);
     ProbDataPCTSP* objprobdata = new ProbDataPCTSP(&graph, &root_vertex, &edge_variable_map, &quota);
+    if (isCompleteGraph(graph)) {
+        // O(1) edge lookups when building subtour elimination constraints
+        objprobdata->setDenseCostMap(std::make_unique<PCTSPdenseCostMap>(graph, cost_map));
+    }
 
     SCIPcreateObjProb(scip, name.c_str(), objprobdata, true);
 
-    PCTSPmodelWithoutSECs(scip, graph, cost_map, weight_map, quota, root_vertex, edge_variable_map);
-    auto conshdlr = new PCTSPconshdlrSubtour(
-        scip,
-        sec_disjoint_tour,
-        sec_lp_gap_improvement_threshold,
-        sec_maxflow_mincut,
-        sec_max_tailing_off_iterations,
-        sec_sepafreq
-    );
-    SCIPincludeObjConshdlr(scip, conshdlr, TRUE);
-
-    // turn off presolving
-    SCIPsetIntParam(scip, "presolving/maxrounds", 0);
+    // on complete graphs, start from the nearest neighbour edges and price in the others
+    std::vector<PCTSPedge> core_edges;
+    if (pricing_num_neighbors > 0 && isCompleteGraph(graph)) {
+        core_edges = nearestNeighborCoreEdges(graph, cost_map, pricing_num_neighbors, heuristic_edges);
+        BOOST_LOG_TRIVIAL(info) << "Pricing edges into a core of " << core_edges.size() - boost::num_vertices(graph)
+            << " nearest neighbour and heuristic edges.";
+    }
+    std::map<PCTSPvertex, SCIP_CONS*> degree_conss;
+    PCTSPmodelWithoutSECs(scip, graph, cost_map, weight_map, quota, root_vertex, edge_variable_map, core_edges, &degree_conss);
+    if (core_edges.size() > 0) includeEdgePricer(scip, graph, edge_variable_map, degree_conss);
 
     // add the subtour elimination constraints as cutting planes
     SCIP_CONS* cons;
@@ -321,7 +515,7 @@ std::map<PCTSPedge, SCIP_VAR*> modelPrizeCollectingTSP(
     else {
         BOOST_LOG_TRIVIAL(info) << "No heuristic solution passed to solver.";
     }
-    return edge_variable_map;
+    return SCIP_OKAY;
 }
 
 std::map<PCTSPedge, SCIP_VAR*> modelPrizeCollectingTSP(
@@ -339,7 +533,8 @@ std::map<PCTSPedge, SCIP_VAR*> modelPrizeCollectingTSP(
     bool sec_maxflow_mincut,
     int sec_max_tailing_off_iterations,
     int sec_sepafreq,
-    bool simple_rules_only
+    bool simple_rules_only,
+    int pricing_num_neighbors
 ) {
     // add edges to empty graph
     auto start = edge_list.begin();
@@ -368,6 +563,6 @@ std::map<PCTSPedge, SCIP_VAR*> modelPrizeCollectingTSP(
     return modelPrizeCollectingTSP(
         scip, graph, solution, cost_map, prize_map, quota, root_vertex, name,
         sec_disjoint_tour, sec_lp_gap_improvement_threshold, sec_maxflow_mincut,
-        sec_max_tailing_off_iterations, sec_sepafreq, simple_rules_only
+        sec_max_tailing_off_iterations, sec_sepafreq, simple_rules_only, pricing_num_neighbors
     );
 }
@@ -1,5 +1,7 @@
 #include <iostream>
 #include "pctsp/branching.hh"
+#include "pctsp/subtour_elimination.hh"
+#include "pctsp/vertex_branching.hh"
 #include <scip/scipdefplugins.h>
 
 const std::string BRANCHING_RULE_NAMES::LEAST_INFEASIBLE = "leastinf";
@@ -13,6 +15,8 @@ const unsigned int BranchingStrategy::STRONG = 1;
 const unsigned int BranchingStrategy::STRONG_AT_TREE_TOP = 2;
 const unsigned int BranchingStrategy::PSCOST = 3;
 const unsigned int BranchingStrategy::DEFAULT = 4;
+const unsigned int BranchingStrategy::VERTEX = 5;
+const unsigned int BranchingStrategy::CUT_SET = 6;
 
 
 void includeBranchRules(SCIP* scip) {
@@ -109,6 +113,20 @@ void setStrongAtTreeTopBranchingStrategy(SCIP* scip, int strong_branching_max_de
     SCIPsetBranchruleMaxdepth(scip, strong, strong_branching_max_depth);
 }
 
+void setVertexBranchingStrategy(SCIP* scip) {
+    includeVertexBranchrule(scip);
+    // relpscost branches when every self loop and every edge leaving the root component is integral
+    setRelpscostBranchingStrategy(scip);
+    SCIP_BRANCHRULE* vertex = SCIPfindBranchrule(scip, VERTEX_BRANCHRULE_NAME.c_str());
+    SCIPsetBranchrulePriority(scip, vertex, 200000);
+}
+
+void setCutSetBranchingStrategy(SCIP* scip) {
+    setRelpscostBranchingStrategy(scip);
+    auto objconshdlr = SCIPfindObjConshdlr(scip, SEC_CONSHDLR_NAME.c_str());
+    if (objconshdlr != NULL) dynamic_cast<PCTSPconshdlrSubtour*>(objconshdlr)->setCutSetBranching(true);
+}
+
 void setBranchingStrategy(SCIP* scip, unsigned int strategy, int max_depth) {
     switch (strategy) {
         case BranchingStrategy::RELPSCOST: {
@@ -123,6 +141,14 @@ void setBranchingStrategy(SCIP* scip, unsigned int strategy, int max_depth) {
             setStrongAtTreeTopBranchingStrategy(scip, max_depth);
             break;
         }
+        case BranchingStrategy::VERTEX: {
+            setVertexBranchingStrategy(scip);
+            break;
+        }
+        case BranchingStrategy::CUT_SET: {
+            setCutSetBranchingStrategy(scip);
+            break;
+        }
         default: break; // use existing strategy
     }
 }
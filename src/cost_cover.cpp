@@ -2,6 +2,7 @@
 #include "pctsp/data_structures.hh"
 #include "pctsp/logger.hh"
 #include "pctsp/sciputils.hh"
+#include "pctsp/separation_controller.hh"
 
 SCIP_RETCODE addCoverInequality(
     SCIP* scip,
@@ -77,9 +78,13 @@ SCIP_DECL_EVENTDELETE(CostCoverEventHandler::scip_delete) {
 }
 
 SCIP_DECL_EVENTEXEC(CostCoverEventHandler::scip_exec) {
+    auto controller = findSeparationController(scip);
+    if (controller != NULL && !controller->shouldRun(COST_COVER_SEPARATOR, false)) return SCIP_OKAY;
+    double start = SCIPgetSolvingTime(scip);
     CostNumberType cost_upper_bound = (CostNumberType) SCIPgetUpperbound(scip);
     unsigned int nconss = separateThenAddCostCoverInequalities(scip, _path_distances, cost_upper_bound);
     increaseNumConssAdded(nconss);
+    if (controller != NULL) controller->recordCall(COST_COVER_SEPARATOR, SCIPgetSolvingTime(scip) - start, nconss);
     return SCIP_OKAY;
 }
 
@@ -0,0 +1,72 @@
+/** Select the subtour elimination constraints of a separation round */
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include "pctsp/cut_selection.hh"
+
+double cutParallelism(SECCandidate& first, SECCandidate& second) {
+    std::map<SCIP_VAR*, double> first_coefs;
+    double first_norm = 0;
+    for (std::size_t i = 0; i < first.vars.size(); i++) {
+        first_coefs[first.vars[i]] = first.coefs[i];
+        first_norm += first.coefs[i] * first.coefs[i];
+    }
+    double dot = 0;
+    double second_norm = 0;
+    for (std::size_t i = 0; i < second.vars.size(); i++) {
+        auto it = first_coefs.find(second.vars[i]);
+        if (it != first_coefs.end()) dot += it->second * second.coefs[i];
+        second_norm += second.coefs[i] * second.coefs[i];
+    }
+    if (first_norm == 0 || second_norm == 0) return 0;
+    return dot / std::sqrt(first_norm * second_norm);
+}
+
+std::vector<std::size_t> selectCuts(std::vector<SECCandidate>& candidates, int max_cuts, double max_parallelism) {
+    std::vector<std::size_t> order (candidates.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&candidates](std::size_t i, std::size_t j) {
+        return candidates[i].efficacy > candidates[j].efficacy;
+    });
+    std::vector<std::size_t> selected;
+    for (auto i : order) {
+        if (max_cuts >= 0 && selected.size() >= (std::size_t) max_cuts) break;
+        bool parallel = false;
+        for (auto j : selected) {
+            if (cutParallelism(candidates[i], candidates[j]) > max_parallelism) {
+                parallel = true;
+                break;
+            }
+        }
+        if (!parallel) selected.push_back(i);
+    }
+    return selected;
+}
+
+SECCandidate aggregateSECs(SCIP* scip, SCIP_SOL* sol, std::vector<SECCandidate*>& candidates) {
+    auto& first = *candidates.front();
+    double size = first.vertex_set.size();
+
+    // edges have positive coefficients and self loops negative coefficients in every SEC of S
+    SECCandidate aggregated = {"", {}, {}, first.vertex_set, first.target, true, first.separator, 0, 0};
+    std::map<SCIP_VAR*, std::size_t> var_index;
+    for (auto candidate : candidates) {
+        for (std::size_t i = 0; i < candidate->vars.size(); i++) {
+            auto var = candidate->vars[i];
+            if (var_index.count(var) > 0) continue;
+            var_index[var] = aggregated.vars.size();
+            aggregated.vars.push_back(var);
+            aggregated.coefs.push_back(candidate->coefs[i] > 0 ? 1.0 : -(size - 1) / size);
+        }
+    }
+    double norm = 0;
+    for (std::size_t i = 0; i < aggregated.vars.size(); i++) {
+        aggregated.violation += aggregated.coefs[i] * SCIPgetSolVal(scip, sol, aggregated.vars[i]);
+        norm += aggregated.coefs[i] * aggregated.coefs[i];
+    }
+    aggregated.efficacy = norm > 0 ? aggregated.violation / std::sqrt(norm) : 0;
+    aggregated.name = "AggregatedSubtourElimination_" + joinVariableNames(aggregated.vars);
+    return aggregated;
+}
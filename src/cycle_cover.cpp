@@ -1,4 +1,5 @@
 #include "pctsp/cycle_cover.hh"
+#include "pctsp/separation_controller.hh"
 
 SCIP_RETCODE addCycleCover(
     SCIP* scip,
@@ -90,7 +91,15 @@ SCIP_RETCODE separateCycleCover(SCIP* scip, SCIP_CONSHDLR* conshdlr, SCIP_SOL* s
     auto& root_vertex = *(probdata->getRootVertex());
     auto& quota = *(probdata->getQuota());
     auto prize_map = boost::get(vertex_distance, input_graph);
-    return separateCycleCover(scip, conshdlr, sol, result, input_graph, prize_map, quota, root_vertex, edge_variable_map);
+    auto root_component = getRootComponent(scip, input_graph, root_vertex, edge_variable_map, sol);
+    if (! isPrizeFeasible(prize_map, quota, root_component)) {
+        auto first = root_component.begin();
+        auto last = root_component.end();
+        SCIP_CALL(addCycleCover(scip, conshdlr, input_graph, first, last, edge_variable_map, sol, result));
+        auto objconshdlr = dynamic_cast<CycleCoverConshdlr*>(SCIPgetObjConshdlr(scip, conshdlr));
+        if (objconshdlr != NULL) objconshdlr->keepCycleCover(root_component);
+    }
+    return SCIP_OKAY;
 }
 
 unsigned int getNumCycleCoverCutsAdded(SCIP* scip) {
@@ -108,6 +117,54 @@ unsigned int CycleCoverConshdlr::getNumConssAdded() {
     return _num_conss_added;
 }
 
+void CycleCoverConshdlr::setKeepCycleCovers(bool keep) {
+    keep_cycle_covers = keep;
+}
+
+void CycleCoverConshdlr::keepCycleCover(std::vector<PCTSPvertex> vertex_set) {
+    if (!keep_cycle_covers) return;
+    std::sort(vertex_set.begin(), vertex_set.end());
+    kept_cycle_covers.insert(vertex_set);
+}
+
+std::size_t CycleCoverConshdlr::getNumKeptCycleCovers() {
+    return kept_cycle_covers.size();
+}
+
+SCIP_RETCODE CycleCoverConshdlr::addKeptCycleCoversToProblem(SCIP* scip) {
+    ProbDataPCTSP* probdata = dynamic_cast<ProbDataPCTSP*>(SCIPgetObjProbData(scip));
+    auto& input_graph = *(probdata->getInputGraph());
+    auto& edge_variable_map = *(probdata->getEdgeVariableMap());
+    auto& quota = *(probdata->getQuota());
+    auto prize_map = boost::get(vertex_distance, input_graph);
+    for (auto& vertex_set : kept_cycle_covers) {
+        auto first = vertex_set.begin();
+        auto last = vertex_set.end();
+        bool is_valid = ! isPrizeFeasible(prize_map, quota, first, last);
+        auto in_problem = cycle_covers_in_problem.find(vertex_set);
+        if (is_valid && in_problem == cycle_covers_in_problem.end()) {
+            VarVector vars;
+            std::vector<double> var_coefs;
+            fillCycleCoverVars(scip, input_graph, vertex_set.begin(), vertex_set.end(), edge_variable_map, vars, var_coefs);
+            std::string name = "CycleCover_" + joinVariableNames(vars);
+            SCIP_CONS* cons;
+            SCIP_CALL(SCIPcreateConsLinear(scip, &cons, name.c_str(), vars.size(), vars.data(), var_coefs.data(),
+                                           -SCIPinfinity(scip), -1.0, FALSE, TRUE, TRUE, TRUE, FALSE, FALSE, FALSE,
+                                           FALSE, TRUE, FALSE));
+            SCIP_CALL(SCIPaddCons(scip, cons));
+            SCIP_CALL(SCIPreleaseCons(scip, &cons));
+            cycle_covers_in_problem[vertex_set] = name;
+        }
+        else if (!is_valid && in_problem != cycle_covers_in_problem.end()) {
+            // the vertex set collects the quota now, so a tour may stay inside it
+            SCIP_CONS* cons = SCIPfindOrigCons(scip, in_problem->second.c_str());
+            if (cons != NULL) SCIP_CALL(SCIPdelCons(scip, cons));
+            cycle_covers_in_problem.erase(in_problem);
+        }
+    }
+    return SCIP_OKAY;
+}
+
 SCIP_DECL_CONSCHECK(CycleCoverConshdlr::scip_check) {
     ProbDataPCTSP* probdata = dynamic_cast<ProbDataPCTSP*>(SCIPgetObjProbData(scip));
     if (isCycleCoverViolated(scip, sol, probdata)) {
@@ -143,7 +200,15 @@ SCIP_DECL_CONSLOCK(CycleCoverConshdlr::scip_lock) {
 
 SCIP_DECL_CONSSEPALP(CycleCoverConshdlr::scip_sepalp) {
     SCIP_SOL* sol = NULL;
+    auto controller = findSeparationController(scip);
+    if (controller != NULL && !controller->shouldRun(CYCLE_COVER_SEPARATOR, false)) {
+        *result = SCIP_DIDNOTRUN;
+        return SCIP_OKAY;
+    }
+    double start = SCIPgetSolvingTime(scip);
     SCIP_RETCODE code = separateCycleCover(scip, conshdlr, sol, result);
-    if (*result == SCIP_CUTOFF || *result == SCIP_SEPARATED) _num_conss_added++;
+    bool separated = *result == SCIP_CUTOFF || *result == SCIP_SEPARATED;
+    if (separated) _num_conss_added++;
+    if (controller != NULL) controller->recordCall(CYCLE_COVER_SEPARATOR, SCIPgetSolvingTime(scip) - start, separated);
     return code;
 }
@@ -14,4 +14,12 @@ PCTSPvertex* ProbDataPCTSP::getRootVertex() {
 
 PCTSPedgeVariableMap* ProbDataPCTSP::getEdgeVariableMap() {
     return edge_variable_map_;
-}
\ No newline at end of file
+}
+
+PCTSPdenseCostMap* ProbDataPCTSP::getDenseCostMap() {
+    return dense_cost_map_.get();
+}
+
+void ProbDataPCTSP::setDenseCostMap(std::unique_ptr<PCTSPdenseCostMap> dense_cost_map) {
+    dense_cost_map_ = std::move(dense_cost_map);
+}
@@ -0,0 +1,285 @@
+#include "pctsp/dual_ascent.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+
+namespace {
+
+const double INFINITE_DISTANCE = std::numeric_limits<double>::infinity();
+
+typedef std::pair<double, std::size_t> DistanceAndVertex;
+typedef std::priority_queue<DistanceAndVertex, std::vector<DistanceAndVertex>, std::greater<DistanceAndVertex>> DistanceHeap;
+
+/**
+ * Arcs of the bidirected graph: arc 2e goes from the source of edge e to its
+ * target and arc 2e + 1 goes back. The arcs entering each vertex are stored
+ * contiguously in slots so that raising a cut scans memory in order.
+ */
+class BidirectedGraph {
+public:
+    BidirectedGraph(std::size_t n, const std::vector<DualAscentEdge>& edges) : edges_(edges), in_offset_(n + 1, 0), out_arcs_(n) {
+        for (auto& edge : edges) {
+            if (edge.source == edge.target) continue;
+            in_offset_[edge.source + 1]++;
+            in_offset_[edge.target + 1]++;
+        }
+        for (std::size_t v = 0; v < n; v++) in_offset_[v + 1] += in_offset_[v];
+        in_tail_ = std::vector<std::size_t>(in_offset_[n]);
+        in_arc_ = std::vector<std::size_t>(in_offset_[n]);
+        std::vector<std::size_t> next (in_offset_.begin(), std::prev(in_offset_.end()));
+        for (std::size_t e = 0; e < edges.size(); e++) {
+            if (edges[e].source == edges[e].target) continue;
+            for (std::size_t arc : {2 * e, 2 * e + 1}) {
+                auto slot = next[head(arc)]++;
+                in_tail_[slot] = tail(arc);
+                in_arc_[slot] = arc;
+                out_arcs_[tail(arc)].push_back(arc);
+            }
+        }
+    }
+
+    std::size_t tail(std::size_t arc) const {
+        auto& edge = edges_[arc / 2];
+        return arc % 2 == 0 ? edge.source : edge.target;
+    }
+    std::size_t head(std::size_t arc) const {
+        auto& edge = edges_[arc / 2];
+        return arc % 2 == 0 ? edge.target : edge.source;
+    }
+    std::size_t firstInSlot(std::size_t v) const { return in_offset_[v]; }
+    std::size_t lastInSlot(std::size_t v) const { return in_offset_[v + 1]; }
+    std::size_t tailOfSlot(std::size_t slot) const { return in_tail_[slot]; }
+    std::size_t arcOfSlot(std::size_t slot) const { return in_arc_[slot]; }
+    std::size_t numSlots() const { return in_arc_.size(); }
+    const std::vector<std::size_t>& outArcs(std::size_t v) const { return out_arcs_[v]; }
+
+private:
+    const std::vector<DualAscentEdge>& edges_;
+    std::vector<std::size_t> in_offset_;
+    std::vector<std::size_t> in_tail_;
+    std::vector<std::size_t> in_arc_;
+    std::vector<std::vector<std::size_t>> out_arcs_;
+};
+
+/**
+ * Raise the cuts of every vertex with positive prize in turn. The cuts of v are
+ * the sets of vertices that reach v on tight arcs: a vertex joins the set at
+ * its reduced distance to v, so the cuts are raised until the root would join
+ * or the budget lambda * prize(v) is spent. Reduced costs are indexed by slot.
+ * Returns the sum of the raised duals.
+ */
+double raiseCuts(
+    const BidirectedGraph& bidirected,
+    const std::vector<double>& prizes,
+    const std::vector<std::size_t>& order,
+    std::size_t root,
+    double lambda,
+    std::vector<double>& slot_costs
+) {
+    std::size_t n = prizes.size();
+    std::vector<double> joined (n, INFINITE_DISTANCE);
+    std::vector<bool> is_done (n, false);
+    std::vector<std::size_t> touched;
+    std::vector<std::size_t> members;
+    double total_dual = 0.0;
+    for (auto v : order) {
+        double budget = lambda * prizes[v];
+        if (budget <= 0) continue;
+        DistanceHeap heap;
+        joined[v] = 0.0;
+        touched.push_back(v);
+        heap.push({0.0, v});
+        double raised = budget;
+        while (!heap.empty()) {
+            auto [time, b] = heap.top();
+            heap.pop();
+            if (is_done[b] || time > joined[b]) continue;
+            if (time >= budget) break;
+            if (b == root) {
+                raised = time;
+                break;
+            }
+            is_done[b] = true;
+            members.push_back(b);
+            for (auto slot = bidirected.firstInSlot(b); slot < bidirected.lastInSlot(b); slot++) {
+                auto a = bidirected.tailOfSlot(slot);
+                double candidate = time + slot_costs[slot];
+                // vertices that join after the budget is spent or the root is reached never enter a cut
+                if (is_done[a] || candidate >= joined[a] || candidate >= budget || candidate > joined[root]) continue;
+                if (joined[a] == INFINITE_DISTANCE) touched.push_back(a);
+                joined[a] = candidate;
+                heap.push({candidate, a});
+            }
+        }
+        // an arc is reduced while its head is in the cut and its tail is not
+        for (auto b : members) {
+            for (auto slot = bidirected.firstInSlot(b); slot < bidirected.lastInSlot(b); slot++) {
+                auto a = bidirected.tailOfSlot(slot);
+                double left = is_done[a] ? std::min(joined[a], raised) : raised;
+                if (left > joined[b]) slot_costs[slot] = std::max(0.0, slot_costs[slot] - (left - joined[b]));
+            }
+        }
+        total_dual += raised;
+        for (auto u : touched) {
+            joined[u] = INFINITE_DISTANCE;
+            is_done[u] = false;
+        }
+        touched.clear();
+        members.clear();
+    }
+    return total_dual;
+}
+
+/** Shortest paths in the reduced costs from the root, or to the root if reverse is true */
+std::vector<double> reducedDistances(
+    const BidirectedGraph& bidirected,
+    const std::vector<double>& reduced_costs,
+    std::size_t n,
+    std::size_t root,
+    bool reverse
+) {
+    std::vector<double> distance (n, INFINITE_DISTANCE);
+    DistanceHeap heap;
+    distance[root] = 0.0;
+    heap.push({0.0, root});
+    while (!heap.empty()) {
+        auto [d, u] = heap.top();
+        heap.pop();
+        if (d > distance[u]) continue;
+        auto relax = [&](std::size_t w, std::size_t arc) {
+            double candidate = d + reduced_costs[arc];
+            if (candidate >= distance[w]) return;
+            distance[w] = candidate;
+            heap.push({candidate, w});
+        };
+        if (reverse) {
+            for (auto slot = bidirected.firstInSlot(u); slot < bidirected.lastInSlot(u); slot++)
+                relax(bidirected.tailOfSlot(slot), bidirected.arcOfSlot(slot));
+        }
+        else {
+            for (auto arc : bidirected.outArcs(u)) relax(bidirected.head(arc), arc);
+        }
+    }
+    return distance;
+}
+
+}
+
+DualAscentBound dualAscent(
+    std::size_t n,
+    const std::vector<DualAscentEdge>& edges,
+    const std::vector<double>& prizes,
+    double quota,
+    std::size_t root,
+    double upper_bound,
+    int max_rounds
+) {
+    DualAscentBound bound = {
+        0.0, 0.0, 0, std::vector<double>(), std::vector<double>(n, 0.0), std::vector<double>(n, 0.0),
+        std::vector<bool>(edges.size(), false), std::vector<bool>(n, false)
+    };
+    bound.reduced_costs.reserve(2 * edges.size());
+    for (auto& edge : edges) {
+        bound.reduced_costs.push_back(edge.cost);
+        bound.reduced_costs.push_back(edge.cost);
+    }
+    if (root >= n) return bound;
+    for (auto& edge : edges) {
+        // the cut relaxation needs non-negative costs
+        if (edge.source != edge.target && edge.cost < 0) return bound;
+    }
+
+    // vertices with negative prize are never forced into the tour by the quota
+    double positive_prize = 0.0;
+    double max_prize = 0.0;
+    double min_prize = INFINITE_DISTANCE;
+    std::vector<double> budgets (n, 0.0);
+    for (std::size_t v = 0; v < n; v++) {
+        if (v == root || prizes[v] <= 0) continue;
+        budgets[v] = prizes[v];
+        positive_prize += prizes[v];
+        max_prize = std::max(max_prize, prizes[v]);
+        min_prize = std::min(min_prize, prizes[v]);
+    }
+    // the root is always visited
+    quota -= prizes[root];
+    double prize_slack = positive_prize - quota;
+    if (prize_slack < 0) {
+        bound.lower_bound = INFINITE_DISTANCE;
+        return bound;
+    }
+    if (max_prize == 0) return bound;
+
+    BidirectedGraph bidirected (n, edges);
+    // raise the cuts of the vertices with the largest prizes first
+    std::vector<std::size_t> order;
+    for (std::size_t v = 0; v < n; v++) {
+        if (budgets[v] > 0) order.push_back(v);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t u, std::size_t v) { return budgets[u] > budgets[v]; });
+
+    double min_cost = INFINITE_DISTANCE;
+    double total_cost = 0.0;
+    for (auto& edge : edges) {
+        if (edge.source == edge.target) continue;
+        if (edge.cost > 0) min_cost = std::min(min_cost, edge.cost);
+        total_cost += edge.cost;
+    }
+    if (min_cost == INFINITE_DISTANCE) min_cost = 1.0;
+
+    std::vector<double> costs (bidirected.numSlots());
+    for (std::size_t slot = 0; slot < costs.size(); slot++) costs[slot] = bound.reduced_costs[bidirected.arcOfSlot(slot)];
+    std::vector<double> best_slot_costs = costs;
+    auto evaluate = [&](double lambda) {
+        std::vector<double> slot_costs = costs;
+        double value = raiseCuts(bidirected, budgets, order, root, lambda, slot_costs) - lambda * prize_slack;
+        bound.num_rounds++;
+        if (value > bound.lower_bound) {
+            bound.lower_bound = value;
+            bound.quota_multiplier = lambda;
+            best_slot_costs = std::move(slot_costs);
+        }
+        return value;
+    };
+
+    // double lambda until the bound falls, then refine lambda on a log scale
+    double lambda = min_cost / max_prize;
+    double max_lambda = 2.0 * (total_cost / min_prize + 1.0);
+    double previous = -INFINITE_DISTANCE;
+    while (bound.num_rounds < max_rounds && lambda <= max_lambda) {
+        double value = evaluate(lambda);
+        if (value < previous && bound.lower_bound > 0) break;
+        previous = value;
+        lambda *= 2.0;
+    }
+    double log_step = 0.5;
+    while (bound.num_rounds + 2 <= max_rounds && bound.quota_multiplier > 0) {
+        double centre = bound.quota_multiplier;
+        evaluate(centre * std::pow(2.0, log_step));
+        evaluate(centre * std::pow(2.0, -log_step));
+        log_step /= 2.0;
+    }
+    for (std::size_t slot = 0; slot < best_slot_costs.size(); slot++)
+        bound.reduced_costs[bidirected.arcOfSlot(slot)] = best_slot_costs[slot];
+
+    // reduced cost elimination against the upper bound
+    bound.distances_from_root = reducedDistances(bidirected, bound.reduced_costs, n, root, false);
+    bound.distances_to_root = reducedDistances(bidirected, bound.reduced_costs, n, root, true);
+    double threshold = upper_bound - bound.lower_bound + 1e-6;
+    for (std::size_t v = 0; v < n; v++) {
+        if (v == root) continue;
+        bound.is_vertex_eliminated[v] = bound.distances_from_root[v] + bound.distances_to_root[v] > threshold;
+    }
+    for (std::size_t e = 0; e < edges.size(); e++) {
+        auto u = edges[e].source;
+        auto v = edges[e].target;
+        if (u == v) continue;
+        double forward = bound.distances_from_root[u] + bound.reduced_costs[2 * e] + bound.distances_to_root[v];
+        double backward = bound.distances_from_root[v] + bound.reduced_costs[2 * e + 1] + bound.distances_to_root[u];
+        bound.is_edge_eliminated[e] = bound.is_vertex_eliminated[u] || bound.is_vertex_eliminated[v] || std::min(forward, backward) > threshold;
+    }
+    return bound;
+}
@@ -20,6 +20,7 @@ NodeStats newStatsForNode(SCIP* scip, SCIP_NODE* node) {
       0,
       0,
       0,
+      0,
       parent_id,
       SCIPgetUpperbound(scip)
    };
@@ -41,6 +42,10 @@ std::vector<NodeStats> NodeEventhdlr::getNodeStatsVector() {
     return node_stats_;
 }
 
+std::size_t NodeEventhdlr::getMemoryUsed() {
+    return node_stats_.capacity() * sizeof(NodeStats);
+}
+
 void NodeEventhdlr::addCurrentNode(SCIP* scip) {
     SCIP_NODE* node = SCIPgetCurrentNode(scip);
     NodeStats stats = newStatsForNode(scip, node);
@@ -60,12 +65,19 @@ void NodeEventhdlr::incrementNumSecMaxflowMincut(SCIP* scip, unsigned int n_cuts
     node_stats_[node_index].num_sec_maxflow_mincut += n_cuts;
 }
 
+void NodeEventhdlr::incrementNumSecUnionFind(SCIP* scip, unsigned int n_cuts) {
+    auto node_index = currentNodeId(scip) - 1;
+    node_stats_[node_index].num_sec_union_find += n_cuts;
+}
+
 
 SCIP_DECL_EVENTFREE(NodeEventhdlr::scip_free) {
    return SCIP_OKAY;
 }
 
 SCIP_DECL_EVENTINIT(NodeEventhdlr::scip_init) {
+    // node ids restart when a problem is transformed again or a new problem is created
+    node_stats_.clear();
     return SCIP_OKAY;
 }
 
@@ -119,6 +131,10 @@ std::vector<Bounds> BoundsEventHandler::getBoundsVector() {
     return _bounds_vector;
 }
 
+std::size_t BoundsEventHandler::getMemoryUsed() {
+    return _bounds_vector.capacity() * sizeof(Bounds);
+}
+
 SCIP_DECL_EVENTFREE(BoundsEventHandler::scip_free) {
    return SCIP_OKAY;
 }
@@ -159,3 +175,24 @@ SCIP_DECL_EVENTEXEC(BoundsEventHandler::scip_exec) {
     _last_timestamp = time_point_cast<SubSeconds>(system_clock::now());
     return SCIP_OKAY;
 }
+
+double CostLowerBoundEventhdlr::getLowerBound() {
+    return lower_bound_;
+}
+
+SCIP_DECL_EVENTINITSOL(CostLowerBoundEventhdlr::scip_initsol) {
+    SCIP_CALL( SCIPcatchEvent( scip, SCIP_EVENTTYPE_NODEFOCUSED, eventhdlr, NULL, NULL) );
+    return SCIP_OKAY;
+}
+
+SCIP_DECL_EVENTEXITSOL(CostLowerBoundEventhdlr::scip_exitsol) {
+    SCIP_CALL( SCIPdropEvent( scip, SCIP_EVENTTYPE_NODEFOCUSED, eventhdlr, NULL, -1) );
+    return SCIP_OKAY;
+}
+
+SCIP_DECL_EVENTEXEC(CostLowerBoundEventhdlr::scip_exec) {
+    // the other nodes inherit the bound from the root
+    // node bounds are in the transformed objective, which presolve may scale
+    if (SCIPgetDepth(scip) == 0) SCIP_CALL( SCIPupdateLocalLowerbound(scip, SCIPtransformObj(scip, lower_bound_)) );
+    return SCIP_OKAY;
+}
@@ -1,6 +1,9 @@
 #include "pctsp/heuristic.hh"
 #include <scip/scipdefplugins.h>
 
+const unsigned int IlsAcceptance::SIMULATED_ANNEALING = 0;
+const unsigned int IlsAcceptance::THRESHOLD = 1;
+
 void includeHeuristics(SCIP* scip) {
     // SCIPincludeHeurFeaspump(scip);
     // SCIPincludeHeurDps(scip);
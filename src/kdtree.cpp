@@ -0,0 +1,80 @@
+#include "pctsp/kdtree.hh"
+
+#include <numeric>
+
+double coordinateOnAxis(const Point2D& point, int axis) {
+    return axis == 0 ? point.first : point.second;
+}
+
+double squaredDistance(const Point2D& a, const Point2D& b) {
+    double dx = a.first - b.first;
+    double dy = a.second - b.second;
+    return dx * dx + dy * dy;
+}
+
+KdTree::KdTree(const std::vector<Point2D>& points) : points_(points) {
+    std::vector<std::size_t> indices (points.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    nodes_.reserve(points.size());
+    root_ = build(indices, 0, indices.size(), 0);
+}
+
+int KdTree::build(std::vector<std::size_t>& indices, int first, int last, int depth) {
+    if (first >= last) return -1;
+    int axis = depth % 2;
+    int middle = (first + last) / 2;
+    std::nth_element(indices.begin() + first, indices.begin() + middle, indices.begin() + last,
+        [&](std::size_t a, std::size_t b) {
+            double coordinate_a = coordinateOnAxis(points_[a], axis);
+            double coordinate_b = coordinateOnAxis(points_[b], axis);
+            return coordinate_a < coordinate_b || (coordinate_a == coordinate_b && a < b);
+        }
+    );
+    int node = nodes_.size();
+    nodes_.push_back({indices[middle], axis, -1, -1});
+    int left = build(indices, first, middle, depth + 1);
+    int right = build(indices, middle + 1, last, depth + 1);
+    nodes_[node].left = left;
+    nodes_[node].right = right;
+    return node;
+}
+
+void KdTree::search(
+    int node,
+    const Point2D& query,
+    std::size_t k,
+    std::size_t excluded,
+    std::vector<std::pair<double, std::size_t>>& heap
+) const {
+    if (node < 0) return;
+    auto& current = nodes_[node];
+    auto& point = points_[current.point];
+    if (current.point != excluded) {
+        std::pair<double, std::size_t> entry = {squaredDistance(query, point), current.point};
+        if (heap.size() < k) {
+            heap.push_back(entry);
+            std::push_heap(heap.begin(), heap.end());
+        }
+        else if (entry < heap.front()) {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.back() = entry;
+            std::push_heap(heap.begin(), heap.end());
+        }
+    }
+    // search the side of the splitting line containing the query first
+    double difference = coordinateOnAxis(query, current.axis) - coordinateOnAxis(point, current.axis);
+    int near = difference < 0 ? current.left : current.right;
+    int far = difference < 0 ? current.right : current.left;
+    search(near, query, k, excluded, heap);
+    if (heap.size() < k || difference * difference <= heap.front().first)
+        search(far, query, k, excluded, heap);
+}
+
+std::vector<std::size_t> KdTree::nearest(const Point2D& query, std::size_t k, std::size_t excluded) const {
+    std::vector<std::pair<double, std::size_t>> heap;
+    if (k > 0) search(root_, query, k, excluded, heap);
+    std::sort_heap(heap.begin(), heap.end());
+    std::vector<std::size_t> indices;
+    for (auto& entry : heap) indices.push_back(entry.second);
+    return indices;
+}
@@ -0,0 +1,380 @@
+#include "pctsp/lagrangian.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+
+namespace {
+
+const std::size_t NO_EDGE = std::numeric_limits<std::size_t>::max();
+
+/**
+ * Minimum spanning tree of V + z that contains the fixed edge (root, z), plus
+ * the cheapest other edge whose cycle in the tree passes through the root.
+ * Edge ids below m are real edges, id m + v is the edge (v, z) and id m + root
+ * is the fixed edge.
+ */
+class OneTreeRelaxation {
+public:
+    OneTreeRelaxation(std::size_t n, const std::vector<LagrangianEdge>& edges, std::size_t root)
+        : n_(n), m_(edges.size()), root_(root), edges_(edges) {
+        // scanning a cost matrix for the smallest key is faster than a heap on dense graphs
+        is_dense_ = 4 * m_ * std::log2(n + 2) >= (n + 1) * (n + 1);
+        if (is_dense_) {
+            dense_cost_ = std::vector<double>(n * n, std::numeric_limits<double>::infinity());
+            dense_edge_ = std::vector<std::size_t>(n * n, NO_EDGE);
+            for (std::size_t e = 0; e < m_; e++) {
+                auto u = edges[e].source;
+                auto v = edges[e].target;
+                if (u == v || edges[e].cost >= dense_cost_[u * n + v]) continue;
+                dense_cost_[u * n + v] = dense_cost_[v * n + u] = edges[e].cost;
+                dense_edge_[u * n + v] = dense_edge_[v * n + u] = e;
+            }
+        }
+        else {
+            adjacency_ = std::vector<std::vector<std::pair<std::size_t, std::size_t>>>(n + 1);
+            for (std::size_t e = 0; e < m_; e++) {
+                if (edges[e].source == edges[e].target) continue;
+                adjacency_[edges[e].source].push_back({edges[e].target, e});
+                adjacency_[edges[e].target].push_back({edges[e].source, e});
+            }
+            for (std::size_t v = 0; v < n; v++) {
+                adjacency_[v].push_back({n, m_ + v});
+                adjacency_[n].push_back({v, m_ + v});
+            }
+        }
+        weight_ = std::vector<double>(m_ + n);
+        parent_edge_ = std::vector<std::size_t>(n + 1);
+        parent_ = std::vector<std::size_t>(n + 1);
+        top_ = std::vector<std::size_t>(n + 1);
+    }
+
+    /** Value of the relaxation without the constant terms, or infinity if there is no extra edge */
+    double solve(const std::vector<double>& pi, double mu, const std::vector<double>& prizes) {
+        for (std::size_t e = 0; e < m_; e++) weight_[e] = edges_[e].cost + pi[edges_[e].source] + pi[edges_[e].target];
+        for (std::size_t v = 0; v < n_; v++) weight_[m_ + v] = 2.0 * pi[v] + mu * prizes[v];
+        weight_[m_ + root_] = -std::numeric_limits<double>::infinity();
+        if (is_dense_) densePrim(pi);
+        else prim();
+
+        tree_value_ = 0.0;
+        for (std::size_t u = 0; u <= n_; u++) {
+            if (u != root_ && parent_edge_[u] != m_ + root_) tree_value_ += weight_[parent_edge_[u]];
+        }
+        // the root is on the cycle of an edge iff its ends are below different children of the root
+        for (auto u : order_) top_[u] = u == root_ || parent_[u] == root_ ? u : top_[parent_[u]];
+        extra_edge_ = NO_EDGE;
+        for (std::size_t e = 0; e < m_ + n_; e++) {
+            auto u = e < m_ ? edges_[e].source : e - m_;
+            auto v = e < m_ ? edges_[e].target : n_;
+            if (parent_edge_[u] == e || parent_edge_[v] == e || top_[u] == top_[v]) continue;
+            if (extra_edge_ == NO_EDGE || weight_[e] < weight_[extra_edge_]) extra_edge_ = e;
+        }
+        if (extra_edge_ == NO_EDGE) return std::numeric_limits<double>::infinity();
+        return tree_value_ + weight_[extra_edge_];
+    }
+
+    /** Degree of each vertex in the real edges of the structure */
+    std::vector<int> degrees() const {
+        std::vector<int> degree (n_, 0);
+        auto addEdge = [&](std::size_t e) {
+            if (e >= m_) return;
+            degree[edges_[e].source]++;
+            degree[edges_[e].target]++;
+        };
+        for (std::size_t u = 0; u < n_; u++) {
+            if (u != root_) addEdge(parent_edge_[u]);
+        }
+        addEdge(extra_edge_);
+        return degree;
+    }
+
+    /** True if the edge (v, z) is in the structure, i.e. v is not visited */
+    bool isSkipped(std::size_t v) const {
+        return v != root_ && (parent_edge_[v] == m_ + v || extra_edge_ == m_ + v);
+    }
+
+    bool isInTree(std::size_t e) const {
+        auto& edge = edges_[e];
+        return parent_edge_[edge.source] == e || parent_edge_[edge.target] == e;
+    }
+
+    double weight(std::size_t e) const { return weight_[e]; }
+    double treeValue() const { return tree_value_; }
+    bool isRealRootEdge(std::size_t e) const {
+        return e < m_ && (edges_[e].source == root_ || edges_[e].target == root_);
+    }
+
+    /** Prepare heaviest edge queries on the tree paths by binary lifting */
+    void buildPathIndex() {
+        num_levels_ = 1;
+        while ((std::size_t(1) << num_levels_) <= n_ + 1) num_levels_++;
+        up_ = std::vector<std::vector<std::size_t>>(num_levels_, std::vector<std::size_t>(n_ + 1, root_));
+        heaviest_ = std::vector<std::vector<std::size_t>>(num_levels_, std::vector<std::size_t>(n_ + 1, NO_EDGE));
+        depth_ = std::vector<int>(n_ + 1, 0);
+        for (auto u : order_) {
+            if (u == root_) continue;
+            up_[0][u] = parent_[u];
+            heaviest_[0][u] = parent_edge_[u];
+            depth_[u] = depth_[parent_[u]] + 1;
+        }
+        for (int k = 1; k < num_levels_; k++) {
+            for (std::size_t u = 0; u <= n_; u++) {
+                auto middle = up_[k - 1][u];
+                up_[k][u] = up_[k - 1][middle];
+                heaviest_[k][u] = heavier(heaviest_[k - 1][u], heaviest_[k - 1][middle]);
+            }
+        }
+    }
+
+    /** The heaviest edge on the tree path between u and v, never the fixed edge */
+    std::size_t heaviestOnPath(std::size_t u, std::size_t v) const {
+        std::size_t heaviest = NO_EDGE;
+        if (depth_[u] < depth_[v]) std::swap(u, v);
+        for (int k = num_levels_ - 1; k >= 0; k--) {
+            if (depth_[u] - (1 << k) >= depth_[v]) {
+                heaviest = heavier(heaviest, heaviest_[k][u]);
+                u = up_[k][u];
+            }
+        }
+        if (u == v) return heaviest;
+        for (int k = num_levels_ - 1; k >= 0; k--) {
+            if (up_[k][u] != up_[k][v]) {
+                heaviest = heavier(heavier(heaviest, heaviest_[k][u]), heaviest_[k][v]);
+                u = up_[k][u];
+                v = up_[k][v];
+            }
+        }
+        return heavier(heavier(heaviest, heaviest_[0][u]), heaviest_[0][v]);
+    }
+
+private:
+    std::size_t heavier(std::size_t e, std::size_t f) const {
+        if (e == NO_EDGE || e == m_ + root_) return f == m_ + root_ ? NO_EDGE : f;
+        if (f == NO_EDGE || f == m_ + root_) return e;
+        return weight_[f] > weight_[e] ? f : e;
+    }
+
+    void prim() {
+        std::size_t num_nodes = n_ + 1;
+        std::vector<double> key (num_nodes, std::numeric_limits<double>::infinity());
+        std::vector<bool> in_tree (num_nodes, false);
+        std::fill(parent_edge_.begin(), parent_edge_.end(), NO_EDGE);
+        std::fill(parent_.begin(), parent_.end(), root_);
+        order_.clear();
+        key[root_] = -std::numeric_limits<double>::infinity();
+        typedef std::pair<double, std::size_t> KeyAndNode;
+        std::priority_queue<KeyAndNode, std::vector<KeyAndNode>, std::greater<KeyAndNode>> heap;
+        heap.push({key[root_], root_});
+        while (!heap.empty()) {
+            auto [key_u, u] = heap.top();
+            heap.pop();
+            if (in_tree[u] || key_u > key[u]) continue;
+            in_tree[u] = true;
+            order_.push_back(u);
+            for (auto& [v, e] : adjacency_[u]) {
+                if (in_tree[v] || weight_[e] >= key[v]) continue;
+                key[v] = weight_[e];
+                parent_edge_[v] = e;
+                parent_[v] = u;
+                heap.push({key[v], v});
+            }
+        }
+    }
+
+    /** Prim's algorithm that updates the keys and finds the next vertex in one scan */
+    void densePrim(const std::vector<double>& pi) {
+        std::size_t z = n_;
+        std::vector<double> key (n_ + 1, std::numeric_limits<double>::infinity());
+        std::vector<bool> in_tree (n_ + 1, false);
+        std::fill(parent_edge_.begin(), parent_edge_.end(), NO_EDGE);
+        std::fill(parent_.begin(), parent_.end(), root_);
+        order_.clear();
+        std::size_t u = root_;
+        while (u != NO_EDGE) {
+            in_tree[u] = true;
+            order_.push_back(u);
+            std::size_t next = NO_EDGE;
+            for (std::size_t v = 0; v <= n_; v++) {
+                if (in_tree[v]) continue;
+                double weight;
+                std::size_t e;
+                if (u == z || v == z) {
+                    e = m_ + (u == z ? v : u);
+                    weight = weight_[e];
+                }
+                else {
+                    weight = dense_cost_[u * n_ + v] + pi[u] + pi[v];
+                    e = dense_edge_[u * n_ + v];
+                }
+                if (weight < key[v]) {
+                    key[v] = weight;
+                    parent_edge_[v] = e;
+                    parent_[v] = u;
+                }
+                if (key[v] < std::numeric_limits<double>::infinity() && (next == NO_EDGE || key[v] < key[next])) next = v;
+            }
+            u = next;
+        }
+    }
+
+    std::size_t n_;
+    std::size_t m_;
+    std::size_t root_;
+    const std::vector<LagrangianEdge>& edges_;
+    std::vector<std::vector<std::pair<std::size_t, std::size_t>>> adjacency_;
+    bool is_dense_;
+    std::vector<double> dense_cost_;
+    std::vector<std::size_t> dense_edge_;
+    std::vector<double> weight_;
+    std::vector<std::size_t> parent_edge_;
+    std::vector<std::size_t> parent_;
+    std::vector<std::size_t> order_;
+    std::vector<std::size_t> top_;
+    double tree_value_;
+    std::size_t extra_edge_;
+    int num_levels_;
+    std::vector<std::vector<std::size_t>> up_;
+    std::vector<std::vector<std::size_t>> heaviest_;
+    std::vector<int> depth_;
+};
+
+}
+
+LagrangianBound lagrangianBound(
+    std::size_t n,
+    const std::vector<LagrangianEdge>& edges,
+    const std::vector<double>& prizes,
+    double quota,
+    std::size_t root,
+    double upper_bound,
+    int max_iterations
+) {
+    LagrangianBound bound = {
+        -std::numeric_limits<double>::infinity(), upper_bound, std::vector<double>(n, 0.0), 0.0, 0,
+        std::vector<bool>(edges.size(), false), std::vector<bool>(n, false)
+    };
+    if (root >= n) return bound;
+    double total_prize = 0.0;
+    double largest_prize = 0.0;
+    for (auto prize : prizes) {
+        total_prize += prize;
+        largest_prize = std::max(largest_prize, std::abs(prize));
+    }
+    double prize_slack = total_prize - quota;
+    if (prize_slack < 0) {
+        bound.lower_bound = std::numeric_limits<double>::infinity();
+        return bound;
+    }
+    // the quota is divided by the largest prize so its subgradient has the scale of the degrees
+    std::vector<double> scaled_prizes (prizes);
+    if (largest_prize > 0) {
+        for (auto& prize : scaled_prizes) prize /= largest_prize;
+        prize_slack /= largest_prize;
+    }
+
+    // every tour has two edges at the root
+    int root_degree = 0;
+    for (auto& edge : edges) root_degree += edge.source != edge.target && (edge.source == root || edge.target == root);
+    if (root_degree < 2) {
+        bound.lower_bound = std::numeric_limits<double>::infinity();
+        return bound;
+    }
+
+    OneTreeRelaxation relaxation (n, edges, root);
+    std::vector<double> pi (n, 0.0);
+    double mu = 0.0;
+    auto lagrangianValue = [&]() {
+        double value = relaxation.solve(pi, mu, scaled_prizes);
+        for (auto pi_v : pi) value -= 2.0 * pi_v;
+        return value - mu * prize_slack;
+    };
+
+    // subgradient ascent, halving the step factor when the bound stalls
+    double theta = 2.0;
+    int patience = std::max(10, std::min(100, (int) n / 4));
+    int num_stalled = 0;
+    std::vector<double> subgradient (n);
+    for (; bound.num_iterations < max_iterations && theta > 1e-6; bound.num_iterations++) {
+        double value = lagrangianValue();
+        if (std::isinf(value)) {
+            // no edge closes a cycle through the root, so there is no tour
+            bound.lower_bound = value;
+            return bound;
+        }
+        if (value > bound.lower_bound + 1e-9) {
+            bound.lower_bound = value;
+            bound.vertex_multipliers = pi;
+            bound.quota_multiplier = mu;
+            num_stalled = 0;
+        }
+        else if (++num_stalled >= patience) {
+            theta /= 2.0;
+            num_stalled = 0;
+        }
+        if (bound.lower_bound >= upper_bound - 1e-9) break;
+
+        auto degree = relaxation.degrees();
+        double norm = 0.0;
+        double skipped_prize = 0.0;
+        for (std::size_t v = 0; v < n; v++) {
+            bool is_skipped = relaxation.isSkipped(v);
+            if (is_skipped) skipped_prize += scaled_prizes[v];
+            subgradient[v] = degree[v] + 2 * is_skipped - 2;
+            norm += subgradient[v] * subgradient[v];
+        }
+        double quota_subgradient = skipped_prize - prize_slack;
+        if (mu > 0 || quota_subgradient > 0) norm += quota_subgradient * quota_subgradient;
+        // the structure is a prize feasible tour, so the bound is optimal
+        if (norm == 0.0) break;
+
+        double step = theta * (upper_bound - value) / norm;
+        for (std::size_t v = 0; v < n; v++) pi[v] += step * subgradient[v];
+        mu = std::max(0.0, mu + step * quota_subgradient);
+    }
+
+    // reduced cost fixing at the best multipliers
+    pi = bound.vertex_multipliers;
+    mu = bound.quota_multiplier;
+    double value = lagrangianValue();
+    if (std::isinf(value)) return bound;
+    relaxation.buildPathIndex();
+    // the cheapest root edges bound the edge a structure adds to its spanning tree
+    std::size_t cheapest_root_edge = NO_EDGE;
+    double cheapest = std::numeric_limits<double>::infinity();
+    double second_cheapest = std::numeric_limits<double>::infinity();
+    for (std::size_t e = 0; e < edges.size(); e++) {
+        if (!relaxation.isRealRootEdge(e) || edges[e].source == edges[e].target) continue;
+        double weight = relaxation.weight(e);
+        if (weight < cheapest) {
+            second_cheapest = cheapest;
+            cheapest = weight;
+            cheapest_root_edge = e;
+        }
+        else if (weight < second_cheapest) second_cheapest = weight;
+    }
+    // a structure is a spanning tree plus a root edge: if the tree contains the edge,
+    // it costs at least the spanning tree forced to contain the edge plus another root edge
+    double tree_value = relaxation.treeValue() - mu * prize_slack;
+    for (auto pi_v : pi) tree_value -= 2.0 * pi_v;
+    auto boundWithTreeEdge = [&](std::size_t u, std::size_t v, double weight, std::size_t e) {
+        auto heaviest = relaxation.heaviestOnPath(u, v);
+        if (heaviest == NO_EDGE) return value;
+        double root_weight = e == cheapest_root_edge ? second_cheapest : cheapest;
+        return std::max(value, tree_value + weight - relaxation.weight(heaviest) + root_weight);
+    };
+    for (std::size_t e = 0; e < edges.size(); e++) {
+        if (edges[e].source == edges[e].target || relaxation.isInTree(e)) continue;
+        double with_edge = boundWithTreeEdge(edges[e].source, edges[e].target, relaxation.weight(e), e);
+        // or the edge is the root edge added to the tree
+        if (relaxation.isRealRootEdge(e))
+            with_edge = std::min(with_edge, std::max(value, tree_value + relaxation.weight(e)));
+        bound.is_edge_fixed[e] = with_edge > upper_bound + 1e-6;
+    }
+    for (std::size_t v = 0; v < n; v++) {
+        if (v == root || relaxation.isSkipped(v)) continue;
+        bound.is_vertex_fixed[v] = boundWithTreeEdge(v, n, relaxation.weight(edges.size() + v), edges.size() + v) > upper_bound + 1e-6;
+    }
+    return bound;
+}
@@ -0,0 +1,209 @@
+#include "pctsp/neighborhood.hh"
+
+#include <algorithm>
+#include <set>
+
+const unsigned int NeighborhoodRepresentation::AUTO = 0;
+const unsigned int NeighborhoodRepresentation::SORTED_ADJACENCY = 1;
+const unsigned int NeighborhoodRepresentation::BITSET = 2;
+
+VertexBitset::VertexBitset(std::size_t n) : n_(n), words_((n + 63) / 64, 0) {}
+
+void VertexBitset::set(std::size_t u) {
+    words_[u / 64] |= std::uint64_t(1) << (u % 64);
+}
+
+void VertexBitset::reset(std::size_t u) {
+    words_[u / 64] &= ~(std::uint64_t(1) << (u % 64));
+}
+
+bool VertexBitset::test(std::size_t u) const {
+    return (words_[u / 64] >> (u % 64)) & 1;
+}
+
+void VertexBitset::clear() {
+    std::fill(words_.begin(), words_.end(), 0);
+}
+
+std::size_t VertexBitset::size() const {
+    return n_;
+}
+
+const std::vector<std::uint64_t>& VertexBitset::words() const {
+    return words_;
+}
+
+void NeighborhoodIndex::build(std::vector<std::vector<std::size_t>>& adjacency, unsigned int representation) {
+    n_ = adjacency.size();
+    std::size_t degree_sum = 0;
+    for (auto& neighbors : adjacency) {
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+        degree_sum += neighbors.size();
+    }
+    if (representation == NeighborhoodRepresentation::AUTO)
+        uses_bitsets_ = n_ > 0 && degree_sum * 64 >= n_ * n_;
+    else
+        uses_bitsets_ = representation == NeighborhoodRepresentation::BITSET;
+
+    if (uses_bitsets_) {
+        adjacency_bitsets_ = std::vector<VertexBitset>(n_, VertexBitset(n_));
+        for (std::size_t u = 0; u < n_; u++)
+            for (auto v : adjacency[u]) adjacency_bitsets_[u].set(v);
+        // the bitsets replace the arrays, which would otherwise double the memory
+        sorted_adjacency_.clear();
+    }
+    else sorted_adjacency_ = std::move(adjacency);
+}
+
+NeighborhoodIndex NeighborhoodIndex::fromCandidateLists(const CandidateLists& candidates, unsigned int representation) {
+    std::vector<std::vector<std::size_t>> adjacency (candidates.size());
+    for (std::size_t u = 0; u < candidates.size(); u++) {
+        for (auto v : candidates[u]) {
+            if (u == v) continue;
+            adjacency[u].push_back(v);
+            adjacency[v].push_back(u);
+        }
+    }
+    NeighborhoodIndex neighborhood;
+    neighborhood.build(adjacency, representation);
+    return neighborhood;
+}
+
+bool NeighborhoodIndex::usesBitsets() const {
+    return uses_bitsets_;
+}
+
+std::size_t NeighborhoodIndex::numVertices() const {
+    return n_;
+}
+
+NeighborRange NeighborhoodIndex::neighbors(std::size_t u) const {
+    if (!uses_bitsets_) {
+        auto& u_list = sorted_adjacency_[u];
+        return NeighborRange(NeighborIterator(u_list.data()), NeighborIterator(u_list.data() + u_list.size()));
+    }
+    auto& u_words = adjacency_bitsets_[u].words();
+    return NeighborRange(
+        NeighborIterator(u_words.data(), u_words.size(), 0),
+        NeighborIterator(u_words.data(), u_words.size(), u_words.size())
+    );
+}
+
+std::vector<std::size_t> NeighborhoodIndex::commonNeighborsNotIn(
+    std::size_t u,
+    std::size_t v,
+    const VertexBitset& excluded
+) const {
+    std::vector<std::size_t> common;
+    if (uses_bitsets_) {
+        auto& u_words = adjacency_bitsets_[u].words();
+        auto& v_words = adjacency_bitsets_[v].words();
+        auto& x_words = excluded.words();
+        for (std::size_t w = 0; w < u_words.size(); w++) {
+            std::uint64_t bits = u_words[w] & v_words[w] & ~x_words[w];
+            while (bits) {
+                common.push_back(w * 64 + __builtin_ctzll(bits));
+                bits &= bits - 1;
+            }
+        }
+        return common;
+    }
+    // gallop through the longer array for each vertex of the shorter array
+    auto& short_list = sorted_adjacency_[u].size() <= sorted_adjacency_[v].size() ? sorted_adjacency_[u] : sorted_adjacency_[v];
+    auto& long_list = sorted_adjacency_[u].size() <= sorted_adjacency_[v].size() ? sorted_adjacency_[v] : sorted_adjacency_[u];
+    auto low = long_list.begin();
+    for (auto x : short_list) {
+        if (excluded.test(x)) continue;
+        std::size_t step = 1;
+        auto high = low;
+        while (high != long_list.end() && *high < x) {
+            low = high;
+            high = (std::size_t) std::distance(high, long_list.end()) > step ? high + step : long_list.end();
+            step *= 2;
+        }
+        low = std::lower_bound(low, high, x);
+        if (low == long_list.end()) break;
+        if (*low == x) common.push_back(x);
+    }
+    return common;
+}
+
+ExternalPathIndex::ExternalPathIndex(
+    const NeighborhoodIndex& neighborhood,
+    const VertexBitset& in_tour,
+    int path_depth_limit
+) : neighborhood_(neighborhood),
+    in_tour_(in_tour),
+    path_depth_limit_(path_depth_limit),
+    radius_((path_depth_limit + 1) / 2),
+    trees_(neighborhood.numVertices()),
+    sources_touching_(neighborhood.numVertices()),
+    num_searches_(0) {}
+
+ExternalPathIndex::SearchTree& ExternalPathIndex::searchTree(std::size_t source) {
+    auto& tree = trees_[source];
+    if (tree.is_valid) return tree;
+    tree.vertices = {source};
+    tree.parent_and_depth.clear();
+    tree.parent_and_depth[source] = {source, 0};
+    sources_touching_[source].insert(source);
+    for (std::size_t q = 0; q < tree.vertices.size(); q++) {
+        auto u = tree.vertices[q];
+        int depth = tree.parent_and_depth[u].second;
+        if (depth == radius_) continue;
+        for (auto w : neighborhood_.neighbors(u)) {
+            if (tree.parent_and_depth.count(w) > 0) continue;
+            // tour vertices block the search but the tree depends on them
+            sources_touching_[w].insert(source);
+            if (in_tour_.test(w)) continue;
+            tree.parent_and_depth[w] = {u, depth + 1};
+            tree.vertices.push_back(w);
+        }
+    }
+    tree.is_valid = true;
+    num_searches_++;
+    return tree;
+}
+
+std::vector<std::vector<std::size_t>> ExternalPathIndex::externalPaths(std::size_t u, std::size_t v) {
+    std::vector<std::vector<std::size_t>> paths;
+    if (u == v || path_depth_limit_ < 2) return paths;
+    auto& u_tree = searchTree(u);
+    auto& v_tree = searchTree(v);
+    std::set<std::vector<std::size_t>> seen;
+    for (std::size_t q = 1; q < u_tree.vertices.size(); q++) {
+        auto meet = u_tree.vertices[q];
+        auto v_it = v_tree.parent_and_depth.find(meet);
+        if (v_it == v_tree.parent_and_depth.end()) continue;
+        if (u_tree.parent_and_depth[meet].second + v_it->second.second > path_depth_limit_) continue;
+
+        // walk back to u, then forward to v
+        std::vector<std::size_t> path = {meet};
+        for (auto w = meet; w != u;) {
+            w = u_tree.parent_and_depth[w].first;
+            path.push_back(w);
+        }
+        std::reverse(path.begin(), path.end());
+        for (auto w = meet; w != v;) {
+            w = v_tree.parent_and_depth[w].first;
+            path.push_back(w);
+        }
+        // the two tree paths may cross before the meeting vertex
+        std::vector<std::size_t> sorted_path (path);
+        std::sort(sorted_path.begin(), sorted_path.end());
+        if (std::adjacent_find(sorted_path.begin(), sorted_path.end()) != sorted_path.end()) continue;
+        if (seen.insert(path).second) paths.push_back(path);
+    }
+    return paths;
+}
+
+void ExternalPathIndex::invalidate(std::size_t u) {
+    trees_[u].is_valid = false;
+    for (auto source : sources_touching_[u]) trees_[source].is_valid = false;
+    sources_touching_[u].clear();
+}
+
+std::size_t ExternalPathIndex::numSearches() const {
+    return num_searches_;
+}
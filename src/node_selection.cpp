@@ -1,8 +1,80 @@
 #include <scip/scipdefplugins.h>
+#include "pctsp/event_handlers.hh"
+#include "pctsp/logger.hh"
 #include "pctsp/node_selection.hh"
 
 void includeNodeSelection(SCIP* scip) {
     SCIPincludeNodeselBreadthfirst(scip);
     SCIPincludeNodeselDfs(scip);
     SCIPincludeNodeselEstimate(scip);
-}
\ No newline at end of file
+}
+
+double MemoryAwareNodesel::getTrackedMemory(SCIP* scip) {
+    double memory_used = SCIPgetMemUsed(scip);
+    auto node_eventhdlr = dynamic_cast<NodeEventhdlr*>(SCIPfindObjEventhdlr(scip, NODE_EVENTHDLR_NAME.c_str()));
+    if (node_eventhdlr != NULL) memory_used += node_eventhdlr->getMemoryUsed();
+    auto bounds_handler = dynamic_cast<BoundsEventHandler*>(SCIPfindObjEventhdlr(scip, BOUNDS_EVENTHDLR_NAME.c_str()));
+    if (bounds_handler != NULL) memory_used += bounds_handler->getMemoryUsed();
+    return memory_used / 1048576.0;
+}
+
+bool MemoryAwareNodesel::isPlunging() {
+    return plunging;
+}
+
+std::vector<NodeSelectionSwitch> MemoryAwareNodesel::getSwitches() {
+    return switches;
+}
+
+void MemoryAwareNodesel::updateMode(double memory_used, long long node_number) {
+    bool start = !plunging && memory_used > switch_fraction * memory_limit;
+    bool stop = plunging && memory_used < switch_back_fraction * memory_limit;
+    if (!start && !stop) return;
+    plunging = start;
+    switches.push_back({node_number, memory_used, plunging});
+    BOOST_LOG_TRIVIAL(info) << "Node selection " << (plunging ? "plunges" : "returns to best estimate search")
+                            << " after " << std::to_string(node_number) << " nodes with "
+                            << std::to_string(memory_used) << " MB of " << std::to_string(memory_limit) << " MB in use.";
+}
+
+SCIP_DECL_NODESELINITSOL(MemoryAwareNodesel::scip_initsol) {
+    plunging = false;
+    switches.clear();
+    return SCIP_OKAY;
+}
+
+SCIP_DECL_NODESELSELECT(MemoryAwareNodesel::scip_select) {
+    updateMode(getTrackedMemory(scip), SCIPgetNNodes(scip));
+    *selnode = NULL;
+    if (plunging) {
+        *selnode = SCIPgetPrioChild(scip);
+        if (*selnode == NULL) *selnode = SCIPgetPrioSibling(scip);
+        if (*selnode == NULL) *selnode = SCIPgetBestLeaf(scip);
+    }
+    else {
+        *selnode = SCIPgetBestNode(scip);
+    }
+    return SCIP_OKAY;
+}
+
+SCIP_DECL_NODESELCOMP(MemoryAwareNodesel::scip_comp) {
+    double estimate1 = SCIPnodeGetEstimate(node1);
+    double estimate2 = SCIPnodeGetEstimate(node2);
+    if (SCIPisLT(scip, estimate1, estimate2)) return -1;
+    if (SCIPisGT(scip, estimate1, estimate2)) return +1;
+    double lower_bound1 = SCIPnodeGetLowerbound(node1);
+    double lower_bound2 = SCIPnodeGetLowerbound(node2);
+    if (SCIPisLT(scip, lower_bound1, lower_bound2)) return -1;
+    if (SCIPisGT(scip, lower_bound1, lower_bound2)) return +1;
+    return 0;
+}
+
+SCIP_RETCODE includeMemoryAwareNodeSelection(
+    SCIP* scip,
+    double memory_limit,
+    double switch_fraction,
+    double switch_back_fraction
+) {
+    auto nodesel = new MemoryAwareNodesel(scip, memory_limit, switch_fraction, switch_back_fraction);
+    return SCIPincludeObjNodesel(scip, nodesel, TRUE);
+}
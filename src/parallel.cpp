@@ -0,0 +1,565 @@
+/** Branch and bound over subtrees of the PCTSP search tree on several SCIP instances */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <set>
+#include <thread>
+
+#include "pctsp/parallel.hh"
+#include "pctsp/algorithms.hh"
+#include "pctsp/exception.hh"
+
+SharedIncumbent::SharedIncumbent() : cost(std::numeric_limits<double>::infinity()) {}
+
+bool SharedIncumbent::offer(double tour_cost, std::vector<PCTSPedge>& tour_edges) {
+    std::lock_guard<std::mutex> lock (mutex);
+    if (tour_cost >= cost) return false;
+    cost = tour_cost;
+    edges = tour_edges;
+    return true;
+}
+
+double SharedIncumbent::getCost() {
+    std::lock_guard<std::mutex> lock (mutex);
+    return cost;
+}
+
+std::vector<PCTSPedge> SharedIncumbent::getEdges() {
+    std::lock_guard<std::mutex> lock (mutex);
+    return edges;
+}
+
+bool SharedSECPool::add(std::string name, SharedSEC& sec) {
+    std::lock_guard<std::mutex> lock (mutex);
+    if (!secs.emplace(name, sec).second) return false;
+    names.push_back(name);
+    return true;
+}
+
+std::map<std::string, SharedSEC> SharedSECPool::getSECs() {
+    std::lock_guard<std::mutex> lock (mutex);
+    return secs;
+}
+
+std::vector<std::pair<std::string, SharedSEC>> SharedSECPool::getSECsAddedAfter(std::size_t num_seen) {
+    std::lock_guard<std::mutex> lock (mutex);
+    std::vector<std::pair<std::string, SharedSEC>> new_secs;
+    for (std::size_t i = num_seen; i < names.size(); i++) new_secs.emplace_back(names[i], secs[names[i]]);
+    return new_secs;
+}
+
+std::size_t SharedSECPool::size() {
+    std::lock_guard<std::mutex> lock (mutex);
+    return secs.size();
+}
+
+WorkStealingQueue::WorkStealingQueue(std::size_t num_workers)
+    : deques(std::max(num_workers, (std::size_t) 1)), num_busy_workers(0), num_stolen(0), stopped(false) {}
+
+void WorkStealingQueue::push(std::size_t worker, SubtreeTask& task) {
+    {
+        std::lock_guard<std::mutex> lock (mutex);
+        deques[worker].push_back(task);
+    }
+    work_changed.notify_all();
+}
+
+bool WorkStealingQueue::pop(std::size_t worker, SubtreeTask& task) {
+    std::unique_lock<std::mutex> lock (mutex);
+    while (!stopped) {
+        if (!deques[worker].empty()) {
+            task = deques[worker].back();
+            deques[worker].pop_back();
+            num_busy_workers++;
+            return true;
+        }
+        for (std::size_t i = 1; i < deques.size(); i++) {
+            auto& victim = deques[(worker + i) % deques.size()];
+            if (!victim.empty()) {
+                task = victim.front();
+                victim.pop_front();
+                num_busy_workers++;
+                num_stolen++;
+                return true;
+            }
+        }
+        if (num_busy_workers == 0) return false;
+        work_changed.wait(lock);
+    }
+    return false;
+}
+
+void WorkStealingQueue::finish() {
+    {
+        std::lock_guard<std::mutex> lock (mutex);
+        num_busy_workers--;
+    }
+    work_changed.notify_all();
+}
+
+void WorkStealingQueue::stop() {
+    {
+        std::lock_guard<std::mutex> lock (mutex);
+        stopped = true;
+    }
+    work_changed.notify_all();
+}
+
+std::vector<SubtreeTask> WorkStealingQueue::drain() {
+    std::lock_guard<std::mutex> lock (mutex);
+    std::vector<SubtreeTask> tasks;
+    for (auto& deque : deques) {
+        tasks.insert(tasks.end(), deque.begin(), deque.end());
+        deque.clear();
+    }
+    return tasks;
+}
+
+std::size_t WorkStealingQueue::getNumStolen() {
+    std::lock_guard<std::mutex> lock (mutex);
+    return num_stolen;
+}
+
+namespace {
+
+const std::string SUBTREE_EVENTHDLR_NAME = "pctsp_subtree_handler";
+const SCIP_EVENTTYPE SUBTREE_EVENTS = SCIP_EVENTTYPE_BESTSOLFOUND | SCIP_EVENTTYPE_NODESOLVED | SCIP_EVENTTYPE_LPSOLVED;
+
+/**
+ * @brief Publish new tours of a subtree to the shared incumbent, add the
+ * tours of other subtrees as solutions and record the values of the self
+ * loops in the last LP of the root node of the subtree.
+ *
+ * The objective limit cannot change while solving, so a cheaper tour of
+ * another subtree prunes the subtree as a solution. Tours that violate the
+ * vertex fixings of the subtree, or the bounds found by presolving, are not
+ * solutions of the subtree and are skipped.
+ */
+class SubtreeEventhdlr : public scip::ObjEventhdlr {
+private:
+    SharedIncumbent* shared_incumbent;  // NULL if tours are not shared while solving
+    std::vector<double> root_vertex_values;
+
+    SCIP_RETCODE importTour(SCIP* scip, PCTSPgraph& graph, PCTSPedgeVariableMap& edge_variable_map) {
+        double incumbent_cost = shared_incumbent->getCost();
+        if (!SCIPisLT(scip, incumbent_cost, SCIPgetPrimalbound(scip))) return SCIP_OKAY;
+        auto edges = shared_incumbent->getEdges();
+        auto first = edges.begin();
+        auto last = edges.end();
+        auto vertices = getVerticesOfEdges(graph, first, last);
+        auto self_loops = getSelfLoops(graph, vertices);
+        edges.insert(edges.end(), self_loops.begin(), self_loops.end());
+        std::set<PCTSPedge> tour_edges (edges.begin(), edges.end());
+        for (auto& [edge, var] : edge_variable_map) {
+            SCIP_VAR* transvar;
+            SCIP_CALL(SCIPgetTransformedVar(scip, var, &transvar));
+            if (transvar == NULL) continue;
+            double value = tour_edges.count(edge) > 0 ? 1.0 : 0.0;
+            if (SCIPisLT(scip, value, SCIPvarGetLbGlobal(transvar)) || SCIPisGT(scip, value, SCIPvarGetUbGlobal(transvar)))
+                return SCIP_OKAY;
+        }
+        VarVector vars = getEdgeVariables(scip, graph, edge_variable_map, edges);
+        SCIP_SOL* sol;
+        SCIP_CALL(SCIPcreateSol(scip, &sol, NULL));
+        for (SCIP_VAR* var : vars) SCIP_CALL(SCIPsetSolVal(scip, sol, var, 1.0));
+        SCIP_Bool stored;
+        SCIP_CALL(SCIPtrySolFree(scip, &sol, FALSE, FALSE, FALSE, FALSE, FALSE, &stored));
+        return SCIP_OKAY;
+    }
+
+public:
+    SubtreeEventhdlr(SCIP* scip)
+        : ObjEventhdlr(scip, SUBTREE_EVENTHDLR_NAME.c_str(), "event handler sharing tours between subtrees of the PCTSP"),
+          shared_incumbent(NULL) {}
+
+    void setSharedIncumbent(SharedIncumbent* incumbent) {
+        shared_incumbent = incumbent;
+    }
+
+    std::vector<double>& getRootVertexValues() {
+        return root_vertex_values;
+    }
+
+    virtual SCIP_DECL_EVENTINITSOL(scip_initsol) {
+        root_vertex_values.clear();
+        SCIP_CALL(SCIPcatchEvent(scip, SUBTREE_EVENTS, eventhdlr, NULL, NULL));
+        return SCIP_OKAY;
+    }
+
+    virtual SCIP_DECL_EVENTEXITSOL(scip_exitsol) {
+        SCIP_CALL(SCIPdropEvent(scip, SUBTREE_EVENTS, eventhdlr, NULL, -1));
+        return SCIP_OKAY;
+    }
+
+    virtual SCIP_DECL_EVENTEXEC(scip_exec) {
+        ProbDataPCTSP* probdata = dynamic_cast<ProbDataPCTSP*>(SCIPgetObjProbData(scip));
+        PCTSPgraph& graph = *probdata->getInputGraph();
+        PCTSPedgeVariableMap& edge_variable_map = *probdata->getEdgeVariableMap();
+        SCIP_EVENTTYPE event_type = SCIPeventGetType(event);
+
+        if ((event_type & SCIP_EVENTTYPE_LPSOLVED) && SCIPgetDepth(scip) == 0) {
+            root_vertex_values.resize(boost::num_vertices(graph));
+            for (auto vertex : boost::make_iterator_range(boost::vertices(graph))) {
+                auto self_loop = boost::edge(vertex, vertex, graph).first;
+                root_vertex_values[vertex] = SCIPgetSolVal(scip, NULL, edge_variable_map[self_loop]);
+            }
+        }
+        if (shared_incumbent == NULL) return SCIP_OKAY;
+        if (event_type & SCIP_EVENTTYPE_BESTSOLFOUND) {
+            SCIP_SOL* sol = SCIPeventGetSol(event);
+            auto edges = getSolutionEdges(scip, graph, sol, edge_variable_map);
+            shared_incumbent->offer(SCIPgetSolOrigObj(scip, sol), edges);
+        }
+        else if (event_type & SCIP_EVENTTYPE_NODESOLVED) {
+            // prune with the tours found by other subtrees
+            SCIP_CALL(importTour(scip, graph, edge_variable_map));
+        }
+        return SCIP_OKAY;
+    }
+};
+
+/** The instance shared by every subtree */
+struct SubtreeInstance {
+    PCTSPgraph& graph;
+    EdgeCostMap& cost_map;
+    VertexPrizeMap& prize_map;
+    PrizeNumberType quota;
+    PCTSPvertex root_vertex;
+    long long node_limit;
+    std::string name;
+};
+
+struct SubtreeResult {
+    SCIP_RETCODE retcode;                   // return code of SCIPsolve
+    SCIP_Status status;
+    double lower_bound;
+    double cost;                            // infinite if no tour is cheaper than the objective limit
+    std::vector<PCTSPedge> edges;
+    std::vector<double> root_vertex_values;
+    SummaryStats summary;
+    std::map<std::string, SharedSEC> secs;  // SECs separated in the subtree
+};
+
+SCIP* createWorkerEnvironment(
+    int branching_max_depth,
+    unsigned int branching_strategy,
+    bool sec_disjoint_tour,
+    double sec_lp_gap_improvement_threshold,
+    bool sec_maxflow_mincut,
+    int sec_max_tailing_off_iterations,
+    int sec_sepafreq
+) {
+    SCIP* scip = NULL;
+    SCIPcreate(&scip);
+    SCIPsetMessagehdlrQuiet(scip, TRUE);
+    includePrizeCollectingTSPPlugins(
+        scip, sec_disjoint_tour, sec_lp_gap_improvement_threshold, sec_maxflow_mincut,
+        sec_max_tailing_off_iterations, sec_sepafreq
+    );
+    auto sec_conshdlr = dynamic_cast<PCTSPconshdlrSubtour*>(SCIPfindObjConshdlr(scip, SEC_CONSHDLR_NAME.c_str()));
+    sec_conshdlr->setKeepSECs(true);
+    NodeEventhdlr* node_eventhdlr = new NodeEventhdlr(scip);
+    SCIPincludeObjEventhdlr(scip, node_eventhdlr, TRUE);
+    SubtreeEventhdlr* subtree_eventhdlr = new SubtreeEventhdlr(scip);
+    SCIPincludeObjEventhdlr(scip, subtree_eventhdlr, TRUE);
+    setBranchingStrategy(scip, branching_strategy, branching_max_depth);
+    // every worker uses the same seeds so that deterministic runs repeat
+    setBranchingRandomSeeds(scip);
+    return scip;
+}
+
+/** Build the model of the subtree in the worker, solve it and free the problem */
+SubtreeResult solveSubtree(
+    SCIP* scip,
+    SubtreeInstance& instance,
+    SubtreeTask& task,
+    double objective_limit,
+    std::map<std::string, SharedSEC>& pooled_secs,
+    SharedIncumbent* shared_incumbent,
+    double time_limit
+) {
+    auto subtree_eventhdlr = dynamic_cast<SubtreeEventhdlr*>(SCIPfindObjEventhdlr(scip, SUBTREE_EVENTHDLR_NAME.c_str()));
+    subtree_eventhdlr->setSharedIncumbent(shared_incumbent);
+
+    // the problem data points to these until the problem is freed
+    PrizeNumberType quota = instance.quota;
+    PCTSPvertex root_vertex = instance.root_vertex;
+    std::string name = instance.name;
+    PCTSPedgeVariableMap edge_variable_map;
+    std::vector<PCTSPedge> heuristic_edges;
+    createPrizeCollectingTSPProblem(
+        scip, instance.graph, heuristic_edges, instance.cost_map, instance.prize_map, quota, root_vertex,
+        edge_variable_map, name
+    );
+    for (auto& [vertex, visited] : task.fixings) {
+        SCIP_VAR* var = edge_variable_map[boost::edge(vertex, vertex, instance.graph).first];
+        if (visited) SCIPchgVarLb(scip, var, 1.0);
+        else SCIPchgVarUb(scip, var, 0.0);
+    }
+    for (auto& [sec_name, sec] : pooled_secs) {
+        VarVector vars = getEdgeVariables(scip, instance.graph, edge_variable_map, sec.edges);
+        SCIP_CONS* cons;
+        SCIPcreateConsLinear(scip, &cons, sec_name.c_str(), vars.size(), vars.data(), sec.coefs.data(),
+                             -SCIPinfinity(scip), 0.0, FALSE, TRUE, TRUE, TRUE, FALSE, FALSE, FALSE,
+                             FALSE, TRUE, FALSE);
+        SCIPaddCons(scip, cons);
+        SCIPreleaseCons(scip, &cons);
+    }
+    if (!SCIPisInfinity(scip, objective_limit)) SCIPsetObjlimit(scip, objective_limit);
+    SCIPsetLongintParam(scip, "limits/nodes", task.splittable ? instance.node_limit : -1);
+    SCIPsetRealParam(scip, "limits/time", std::max(time_limit, 0.0));
+    SubtreeResult result;
+    result.retcode = SCIPsolve(scip);
+    result.status = SCIPgetStatus(scip);
+    result.lower_bound = std::max(task.lower_bound, SCIPgetDualbound(scip));
+    result.cost = std::numeric_limits<double>::infinity();
+    if (SCIPgetNSols(scip) > 0) {
+        SCIP_SOL* sol = SCIPgetBestSol(scip);
+        result.cost = SCIPgetSolOrigObj(scip, sol);
+        result.edges = getSolutionEdges(scip, instance.graph, sol, edge_variable_map);
+    }
+    result.root_vertex_values = subtree_eventhdlr->getRootVertexValues();
+    result.summary = getSummaryStatsFromSCIP(scip);
+
+    // SECs refer to the variables of this problem, so store them by edge
+    std::map<SCIP_VAR*, PCTSPedge> variable_edge_map;
+    for (auto& [edge, var] : edge_variable_map) variable_edge_map[var] = edge;
+    auto sec_conshdlr = dynamic_cast<PCTSPconshdlrSubtour*>(SCIPfindObjConshdlr(scip, SEC_CONSHDLR_NAME.c_str()));
+    for (auto& [sec_name, sec] : sec_conshdlr->getKeptSECs()) {
+        auto& [vars, var_coefs] = sec;
+        SharedSEC shared_sec;
+        for (auto var : vars) shared_sec.edges.push_back(variable_edge_map[var]);
+        shared_sec.coefs = var_coefs;
+        result.secs.emplace(sec_name, shared_sec);
+    }
+    sec_conshdlr->clearKeptSECs();
+    SCIPfreeProb(scip);
+    return result;
+}
+
+/** A subtree without tours cheaper than the objective limit is infeasible */
+bool isSubtreeClosed(SCIP_Status status) {
+    return status == SCIP_STATUS_OPTIMAL || status == SCIP_STATUS_INFEASIBLE;
+}
+
+/**
+ * @brief Children of a subtree that hit the node limit: every combination of
+ * visiting the unfixed vertices whose self loops are the most fractional in
+ * the root LP of the subtree. Ties are broken by the vertex id.
+ */
+std::vector<SubtreeTask> splitSubtree(
+    SubtreeTask& task,
+    SubtreeResult& result,
+    PCTSPvertex root_vertex,
+    std::size_t num_branching_vertices
+) {
+    std::vector<bool> is_fixed (result.root_vertex_values.size(), false);
+    for (auto& [vertex, visited] : task.fixings) is_fixed[vertex] = true;
+    std::vector<PCTSPvertex> candidates;
+    for (PCTSPvertex vertex = 0; vertex < result.root_vertex_values.size(); vertex++) {
+        if (vertex != root_vertex && !is_fixed[vertex]) candidates.push_back(vertex);
+    }
+    auto& values = result.root_vertex_values;
+    std::stable_sort(candidates.begin(), candidates.end(), [&values](PCTSPvertex u, PCTSPvertex v) {
+        return std::abs(values[u] - 0.5) < std::abs(values[v] - 0.5);
+    });
+    if (candidates.size() > num_branching_vertices) candidates.resize(num_branching_vertices);
+
+    std::vector<SubtreeTask> children;
+    if (candidates.size() == 0) {
+        // every vertex is fixed, so solve the subtree to the end
+        children.push_back({task.fixings, result.lower_bound, false});
+        return children;
+    }
+    for (std::size_t mask = 0; mask < ((std::size_t) 1 << candidates.size()); mask++) {
+        SubtreeTask child = {task.fixings, result.lower_bound, true};
+        for (std::size_t i = 0; i < candidates.size(); i++) {
+            child.fixings.emplace_back(candidates[i], (mask >> i) & 1);
+        }
+        children.push_back(child);
+    }
+    return children;
+}
+
+}
+
+ParallelSolveStats solvePrizeCollectingTSPParallel(
+    PCTSPgraph& graph,
+    std::vector<PCTSPedge>& heuristic_edges,
+    EdgeCostMap& cost_map,
+    VertexPrizeMap& prize_map,
+    PrizeNumberType quota,
+    PCTSPvertex root_vertex,
+    std::size_t num_workers,
+    bool deterministic,
+    long long subtree_node_limit,
+    int branching_max_depth,
+    unsigned int branching_strategy,
+    bool sec_disjoint_tour,
+    double sec_lp_gap_improvement_threshold,
+    bool sec_maxflow_mincut,
+    int sec_max_tailing_off_iterations,
+    int sec_sepafreq,
+    float time_limit,
+    std::string name
+) {
+    auto start_time = std::chrono::steady_clock::now();
+    auto remainingTime = [&]() {
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+        return time_limit - elapsed.count();
+    };
+    if (num_workers == 0) num_workers = 1;
+
+    SharedIncumbent incumbent;
+    std::vector<PCTSPedge> starting_edges = heuristic_edges;
+    if (starting_edges.size() == 0) {
+        starting_edges = warmStartEdges(graph, cost_map, prize_map, quota, root_vertex, std::list<PCTSPvertex>());
+    }
+    if (starting_edges.size() > 0) incumbent.offer(totalCost(starting_edges, cost_map), starting_edges);
+
+    // workers read the graph at the same time, so add the self loops first
+    if (hasSelfLoopsOnAllVertices(graph) == false) {
+        addSelfLoopsToGraph(graph);
+        assignZeroCostToSelfLoops(graph, cost_map);
+    }
+    std::vector<SCIP*> environments;
+    for (std::size_t i = 0; i < num_workers; i++) {
+        environments.push_back(createWorkerEnvironment(
+            branching_max_depth, branching_strategy, sec_disjoint_tour, sec_lp_gap_improvement_threshold,
+            sec_maxflow_mincut, sec_max_tailing_off_iterations, sec_sepafreq
+        ));
+    }
+    SubtreeInstance instance = {graph, cost_map, prize_map, quota, root_vertex, subtree_node_limit, name};
+    SharedSECPool sec_pool;
+    std::size_t root_branching_vertices = (std::size_t) std::ceil(std::log2((double) num_workers));
+    root_branching_vertices = std::max(root_branching_vertices, (std::size_t) 1);
+
+    // results of every subtree and the subtrees left open
+    SummaryStats summary = {};
+    unsigned int num_subtrees = 0;
+    std::vector<double> open_bounds;
+    std::mutex results_mutex;
+    SCIP_RETCODE failed_retcode = SCIP_OKAY;   // first error of a worker
+    auto mergeResult = [&](SubtreeTask& task, SubtreeResult& result, bool is_root) {
+        if (result.retcode != SCIP_OKAY) {
+            if (failed_retcode == SCIP_OKAY) failed_retcode = result.retcode;
+            return std::vector<SubtreeTask>();
+        }
+        num_subtrees++;
+        summary.num_nodes += result.summary.num_nodes;
+        summary.num_sec_disjoint_tour += result.summary.num_sec_disjoint_tour;
+        summary.num_sec_maxflow_mincut += result.summary.num_sec_maxflow_mincut;
+        summary.num_sec_union_find += result.summary.num_sec_union_find;
+        summary.num_cycle_cover += result.summary.num_cycle_cover;
+        summary.num_cost_cover_disjoint_paths += result.summary.num_cost_cover_disjoint_paths;
+        summary.num_cost_cover_shortest_paths += result.summary.num_cost_cover_shortest_paths;
+        for (auto& [sec_name, sec] : result.secs) sec_pool.add(sec_name, sec);
+        if (result.cost < std::numeric_limits<double>::infinity()) incumbent.offer(result.cost, result.edges);
+        std::vector<SubtreeTask> children;
+        if (result.status == SCIP_STATUS_NODELIMIT) {
+            children = splitSubtree(task, result, root_vertex, is_root ? root_branching_vertices : 1);
+        }
+        else if (!isSubtreeClosed(result.status)) {
+            open_bounds.push_back(result.lower_bound);
+        }
+        return children;
+    };
+
+    SubtreeTask root_task = {{}, -std::numeric_limits<double>::infinity(), true};
+    std::size_t num_stolen_subtrees = 0;
+    if (deterministic) {
+        // rounds of subtrees that only see the incumbent and SECs of the previous rounds
+        std::deque<SubtreeTask> tasks = {root_task};
+        bool is_root = true;
+        while (tasks.size() > 0 && remainingTime() > 0 && failed_retcode == SCIP_OKAY) {
+            double objective_limit = incumbent.getCost();
+            auto pooled_secs = sec_pool.getSECs();
+            std::vector<SubtreeTask> round;
+            while (tasks.size() > 0 && round.size() < num_workers) {
+                if (tasks.front().lower_bound < objective_limit) round.push_back(tasks.front());
+                tasks.pop_front();
+            }
+            std::vector<SubtreeResult> results (round.size());
+            std::vector<std::thread> threads;
+            for (std::size_t i = 0; i < round.size(); i++) {
+                threads.emplace_back([&, i]() {
+                    results[i] = solveSubtree(
+                        environments[i], instance, round[i], objective_limit, pooled_secs, NULL, remainingTime()
+                    );
+                });
+            }
+            for (auto& thread : threads) thread.join();
+            for (std::size_t i = 0; i < round.size(); i++) {
+                auto children = mergeResult(round[i], results[i], is_root);
+                tasks.insert(tasks.end(), children.begin(), children.end());
+            }
+            is_root = false;
+        }
+        for (auto& task : tasks) open_bounds.push_back(task.lower_bound);
+    }
+    else {
+        WorkStealingQueue queue (num_workers);
+        queue.push(0, root_task);
+        auto work = [&](std::size_t worker) {
+            SubtreeTask task;
+            while (queue.pop(worker, task)) {
+                double objective_limit = incumbent.getCost();
+                if (task.lower_bound >= objective_limit) {
+                    queue.finish();
+                    continue;
+                }
+                if (remainingTime() <= 0) {
+                    {
+                        std::lock_guard<std::mutex> lock (results_mutex);
+                        open_bounds.push_back(task.lower_bound);
+                    }
+                    queue.finish();
+                    queue.stop();
+                    break;
+                }
+                auto pooled_secs = sec_pool.getSECs();
+                auto result = solveSubtree(
+                    environments[worker], instance, task, objective_limit, pooled_secs, &incumbent, remainingTime()
+                );
+                std::vector<SubtreeTask> children;
+                {
+                    std::lock_guard<std::mutex> lock (results_mutex);
+                    children = mergeResult(task, result, task.fixings.size() == 0);
+                }
+                for (auto& child : children) queue.push(worker, child);
+                queue.finish();
+                if (result.retcode != SCIP_OKAY) {
+                    queue.stop();
+                    break;
+                }
+            }
+        };
+        std::vector<std::thread> threads;
+        for (std::size_t worker = 0; worker < num_workers; worker++) threads.emplace_back(work, worker);
+        for (auto& thread : threads) thread.join();
+        for (auto& task : queue.drain()) open_bounds.push_back(task.lower_bound);
+        num_stolen_subtrees = queue.getNumStolen();
+    }
+    for (SCIP* scip : environments) SCIPfree(&scip);
+    if (failed_retcode != SCIP_OKAY) throw SubtreeSolveError(failed_retcode);
+
+    double upper_bound = incumbent.getCost();
+    double lower_bound = upper_bound;
+    for (double bound : open_bounds) lower_bound = std::min(lower_bound, bound);
+    if (open_bounds.size() > 0) summary.status = SCIP_STATUS_TIMELIMIT;
+    else if (upper_bound < std::numeric_limits<double>::infinity()) summary.status = SCIP_STATUS_OPTIMAL;
+    else summary.status = SCIP_STATUS_INFEASIBLE;
+    summary.lower_bound = lower_bound;
+    summary.upper_bound = upper_bound;
+
+    std::chrono::duration<double> solving_time = std::chrono::steady_clock::now() - start_time;
+    ParallelSolveStats stats = {
+        summary, incumbent.getEdges(), num_subtrees, (unsigned int) num_stolen_subtrees, sec_pool.size(),
+        solving_time.count()
+    };
+    BOOST_LOG_TRIVIAL(info) << "Parallel solve closed " << num_subtrees << " subtrees on " << num_workers
+        << " workers with " << stats.num_shared_secs << " shared SECs. Best tour costs " << upper_bound << ".";
+    return stats;
+}
@@ -0,0 +1,127 @@
+/** A pool of SCIP instances with the PCTSP plugins included */
+
+#include <atomic>
+#include <thread>
+
+#include "pctsp/pool.hh"
+#include "pctsp/algorithms.hh"
+
+SolverPool::SolverPool(
+    std::size_t pool_size,
+    int branching_max_depth,
+    unsigned int branching_strategy,
+    bool sec_disjoint_tour,
+    double sec_lp_gap_improvement_threshold,
+    bool sec_maxflow_mincut,
+    int sec_max_tailing_off_iterations,
+    int sec_sepafreq,
+    float time_limit
+) : time_limit(time_limit)
+{
+    if (pool_size == 0) pool_size = 1;
+    for (std::size_t i = 0; i < pool_size; i++) {
+        SCIP* scip = NULL;
+        SCIPcreate(&scip);
+        SCIPsetMessagehdlrQuiet(scip, TRUE);
+        includePrizeCollectingTSPPlugins(
+            scip, sec_disjoint_tour, sec_lp_gap_improvement_threshold, sec_maxflow_mincut,
+            sec_max_tailing_off_iterations, sec_sepafreq
+        );
+        NodeEventhdlr* node_eventhdlr = new NodeEventhdlr(scip);
+        SCIPincludeObjEventhdlr(scip, node_eventhdlr, TRUE);
+        // branching priorities and parameters are kept after SCIPfreeProb
+        setBranchingStrategy(scip, branching_strategy, branching_max_depth);
+        setBranchingRandomSeeds(scip);
+        SCIPsetRealParam(scip, "limits/time", time_limit);
+        environments.push_back(scip);
+    }
+    free_environments = environments;
+}
+
+SolverPool::~SolverPool() {
+    for (SCIP* scip : environments) SCIPfree(&scip);
+}
+
+std::size_t SolverPool::getPoolSize() {
+    return environments.size();
+}
+
+std::size_t SolverPool::getNumFreeEnvironments() {
+    std::lock_guard<std::mutex> lock (environments_mutex);
+    return free_environments.size();
+}
+
+SCIP* SolverPool::acquireEnvironment() {
+    std::unique_lock<std::mutex> lock (environments_mutex);
+    environment_released.wait(lock, [this] { return free_environments.size() > 0; });
+    SCIP* scip = free_environments.back();
+    free_environments.pop_back();
+    return scip;
+}
+
+void SolverPool::releaseEnvironment(SCIP* scip) {
+    {
+        std::lock_guard<std::mutex> lock (environments_mutex);
+        free_environments.push_back(scip);
+    }
+    environment_released.notify_one();
+}
+
+PoolSolveResult SolverPool::solve(
+    PCTSPgraph& graph,
+    EdgeCostMap& cost_map,
+    VertexPrizeMap& prize_map,
+    PrizeNumberType quota,
+    PCTSPvertex root_vertex,
+    std::vector<PCTSPedge>& heuristic_edges,
+    std::string name
+) {
+    // small instances are dominated by setup, so start from the cheap primal-dual tour
+    std::vector<PCTSPedge> starting_edges = heuristic_edges;
+    if (starting_edges.size() == 0) {
+        starting_edges = warmStartEdges(graph, cost_map, prize_map, quota, root_vertex, std::list<PCTSPvertex>());
+    }
+
+    SCIP* scip = acquireEnvironment();
+    // the problem data points to the quota, root vertex and variable map until the problem is freed
+    PCTSPedgeVariableMap edge_variable_map;
+    createPrizeCollectingTSPProblem(
+        scip, graph, starting_edges, cost_map, prize_map, quota, root_vertex, edge_variable_map, name
+    );
+    SCIPsolve(scip);
+
+    PoolSolveResult result = {getSummaryStatsFromSCIP(scip), std::vector<PCTSPedge>(), SCIPgetSolvingTime(scip)};
+    if (SCIPgetNSols(scip) > 0) {
+        SCIP_SOL* sol = SCIPgetBestSol(scip);
+        result.solution_edges = getSolutionEdges(scip, graph, sol, edge_variable_map);
+    }
+    SCIPfreeProb(scip);
+    releaseEnvironment(scip);
+    return result;
+}
+
+std::vector<PoolSolveResult> SolverPool::solveBatch(
+    std::vector<PCTSPgraph>& graphs,
+    std::vector<PrizeNumberType>& quotas,
+    std::vector<PCTSPvertex>& root_vertices,
+    std::string name
+) {
+    std::vector<PoolSolveResult> results (graphs.size());
+    std::atomic<std::size_t> next_instance (0);
+    auto solveInstances = [&]() {
+        for (std::size_t i = next_instance++; i < graphs.size(); i = next_instance++) {
+            auto& graph = graphs[i];
+            EdgeCostMap cost_map = boost::get(edge_weight, graph);
+            VertexPrizeMap prize_map = boost::get(vertex_distance, graph);
+            std::vector<PCTSPedge> heuristic_edges;
+            results[i] = solve(
+                graph, cost_map, prize_map, quotas[i], root_vertices[i], heuristic_edges, name + "-" + std::to_string(i)
+            );
+        }
+    };
+    std::size_t num_threads = std::min(environments.size(), graphs.size());
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < num_threads; t++) threads.emplace_back(solveInstances);
+    for (auto& thread : threads) thread.join();
+    return results;
+}
@@ -0,0 +1,270 @@
+/** Race differently configured solvers on the same instance of the prize collecting TSP */
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <set>
+#include <thread>
+
+#include "pctsp/portfolio.hh"
+#include "pctsp/algorithms.hh"
+#include "pctsp/exception.hh"
+
+std::vector<SolverVariant> defaultSolverVariants() {
+    return {
+        {"relpscost", -1, BranchingStrategy::RELPSCOST, true, 0.01, true, -1, 1},
+        {"strong", -1, BranchingStrategy::STRONG, true, 0.01, true, -1, 1},
+        {"strong-at-tree-top", 5, BranchingStrategy::STRONG_AT_TREE_TOP, true, 0.01, true, -1, 1},
+        {"relpscost-maxflow-tailing-off", -1, BranchingStrategy::RELPSCOST, false, 0.01, true, 5, 5},
+    };
+}
+
+namespace {
+
+const std::string PORTFOLIO_EVENTHDLR_NAME = "pctsp_portfolio_handler";
+const SCIP_EVENTTYPE PORTFOLIO_EVENTS = SCIP_EVENTTYPE_BESTSOLFOUND | SCIP_EVENTTYPE_NODESOLVED;
+
+/**
+ * @brief Exchange tours and SECs with the other variants after every node and
+ * stop once another variant has finished.
+ */
+class PortfolioEventhdlr : public scip::ObjEventhdlr {
+private:
+    SharedIncumbent& shared_incumbent;
+    SharedSECPool& sec_pool;
+    std::atomic<bool>& portfolio_finished;
+    std::size_t num_seen_secs;
+    std::set<std::string> exported_secs;  // already in the LP of this variant
+
+    /** Put the SECs separated since the last node in the shared pool */
+    void exportSECs(SCIP* scip, PCTSPedgeVariableMap& edge_variable_map) {
+        auto sec_conshdlr = dynamic_cast<PCTSPconshdlrSubtour*>(SCIPfindObjConshdlr(scip, SEC_CONSHDLR_NAME.c_str()));
+        auto& kept_secs = sec_conshdlr->getKeptSECs();
+        if (kept_secs.size() == 0) return;
+        std::map<SCIP_VAR*, PCTSPedge> variable_edge_map;
+        for (auto& [edge, var] : edge_variable_map) variable_edge_map[var] = edge;
+        for (auto& [name, sec] : kept_secs) {
+            auto& [vars, var_coefs] = sec;
+            SharedSEC shared_sec;
+            for (auto var : vars) shared_sec.edges.push_back(variable_edge_map[var]);
+            shared_sec.coefs = var_coefs;
+            exported_secs.insert(name);
+            if (sec_pool.add(name, shared_sec)) num_exported_secs++;
+        }
+        sec_conshdlr->clearKeptSECs();
+    }
+
+    /** Add the SECs of other variants to the global cut pool */
+    SCIP_RETCODE importSECs(SCIP* scip, PCTSPgraph& graph, PCTSPedgeVariableMap& edge_variable_map) {
+        auto new_secs = sec_pool.getSECsAddedAfter(num_seen_secs);
+        num_seen_secs += new_secs.size();
+        SCIP_CONSHDLR* conshdlr = SCIPfindConshdlr(scip, SEC_CONSHDLR_NAME.c_str());
+        for (auto& [name, sec] : new_secs) {
+            if (exported_secs.count(name) > 0) continue;
+            VarVector vars = getEdgeVariables(scip, graph, edge_variable_map, sec.edges);
+            SCIP_ROW* row;
+            SCIP_CALL(SCIPcreateEmptyRowConshdlr(scip, &row, conshdlr, name.c_str(), -SCIPinfinity(scip), 0.0, FALSE, FALSE, TRUE));
+            SCIP_CALL(SCIPcacheRowExtensions(scip, row));
+            for (std::size_t i = 0; i < vars.size(); i++) {
+                SCIP_VAR* transvar;
+                SCIP_CALL(SCIPgetTransformedVar(scip, vars[i], &transvar));
+                SCIP_CALL(SCIPaddVarToRow(scip, row, transvar, sec.coefs[i]));
+            }
+            SCIP_CALL(SCIPflushRowExtensions(scip, row));
+            SCIP_CALL(SCIPaddPoolCut(scip, row));
+            SCIP_CALL(SCIPreleaseRow(scip, &row));
+            num_imported_secs++;
+        }
+        return SCIP_OKAY;
+    }
+
+    /** Add the shared incumbent as a solution if it is cheaper than the best solution */
+    SCIP_RETCODE importTour(SCIP* scip, PCTSPgraph& graph, PCTSPedgeVariableMap& edge_variable_map) {
+        double incumbent_cost = shared_incumbent.getCost();
+        if (!SCIPisLT(scip, incumbent_cost, SCIPgetPrimalbound(scip))) return SCIP_OKAY;
+        auto edges = shared_incumbent.getEdges();
+        auto first = edges.begin();
+        auto last = edges.end();
+        auto vertices = getVerticesOfEdges(graph, first, last);
+        auto self_loops = getSelfLoops(graph, vertices);
+        edges.insert(edges.end(), self_loops.begin(), self_loops.end());
+        VarVector vars = getEdgeVariables(scip, graph, edge_variable_map, edges);
+        SCIP_SOL* sol;
+        SCIP_CALL(SCIPcreateSol(scip, &sol, NULL));
+        for (SCIP_VAR* var : vars) SCIP_CALL(SCIPsetSolVal(scip, sol, var, 1.0));
+        SCIP_Bool stored;
+        SCIP_CALL(SCIPtrySolFree(scip, &sol, FALSE, FALSE, FALSE, FALSE, FALSE, &stored));
+        if (stored) num_imported_tours++;
+        return SCIP_OKAY;
+    }
+
+public:
+    unsigned int num_imported_tours;
+    unsigned int num_imported_secs;
+    unsigned int num_exported_secs;
+
+    PortfolioEventhdlr(
+        SCIP* scip,
+        SharedIncumbent& shared_incumbent,
+        SharedSECPool& sec_pool,
+        std::atomic<bool>& portfolio_finished
+    ) : ObjEventhdlr(scip, PORTFOLIO_EVENTHDLR_NAME.c_str(), "event handler exchanging tours and SECs between variants of the PCTSP"),
+        shared_incumbent(shared_incumbent), sec_pool(sec_pool), portfolio_finished(portfolio_finished),
+        num_seen_secs(0), num_imported_tours(0), num_imported_secs(0), num_exported_secs(0) {}
+
+    virtual SCIP_DECL_EVENTINITSOL(scip_initsol) {
+        SCIP_CALL(SCIPcatchEvent(scip, PORTFOLIO_EVENTS, eventhdlr, NULL, NULL));
+        return SCIP_OKAY;
+    }
+
+    virtual SCIP_DECL_EVENTEXITSOL(scip_exitsol) {
+        SCIP_CALL(SCIPdropEvent(scip, PORTFOLIO_EVENTS, eventhdlr, NULL, -1));
+        return SCIP_OKAY;
+    }
+
+    virtual SCIP_DECL_EVENTEXEC(scip_exec) {
+        ProbDataPCTSP* probdata = dynamic_cast<ProbDataPCTSP*>(SCIPgetObjProbData(scip));
+        PCTSPgraph& graph = *probdata->getInputGraph();
+        PCTSPedgeVariableMap& edge_variable_map = *probdata->getEdgeVariableMap();
+
+        if (SCIPeventGetType(event) & SCIP_EVENTTYPE_BESTSOLFOUND) {
+            SCIP_SOL* sol = SCIPeventGetSol(event);
+            auto edges = getSolutionEdges(scip, graph, sol, edge_variable_map);
+            shared_incumbent.offer(SCIPgetSolOrigObj(scip, sol), edges);
+            return SCIP_OKAY;
+        }
+        if (portfolio_finished) {
+            SCIP_CALL(SCIPinterruptSolve(scip));
+            return SCIP_OKAY;
+        }
+        exportSECs(scip, edge_variable_map);
+        SCIP_CALL(importSECs(scip, graph, edge_variable_map));
+        SCIP_CALL(importTour(scip, graph, edge_variable_map));
+        return SCIP_OKAY;
+    }
+};
+
+}
+
+PortfolioSolveStats solvePrizeCollectingTSPPortfolio(
+    PCTSPgraph& graph,
+    std::vector<PCTSPedge>& heuristic_edges,
+    EdgeCostMap& cost_map,
+    VertexPrizeMap& prize_map,
+    PrizeNumberType quota,
+    PCTSPvertex root_vertex,
+    std::vector<SolverVariant>& variants,
+    float time_limit,
+    std::string name
+) {
+    auto start_time = std::chrono::steady_clock::now();
+    SharedIncumbent incumbent;
+    std::vector<PCTSPedge> starting_edges = heuristic_edges;
+    if (starting_edges.size() == 0) {
+        starting_edges = warmStartEdges(graph, cost_map, prize_map, quota, root_vertex, std::list<PCTSPvertex>());
+    }
+    if (starting_edges.size() > 0) incumbent.offer(totalCost(starting_edges, cost_map), starting_edges);
+
+    // variants read the graph at the same time, so add the self loops first
+    if (hasSelfLoopsOnAllVertices(graph) == false) {
+        addSelfLoopsToGraph(graph);
+        assignZeroCostToSelfLoops(graph, cost_map);
+    }
+    SharedSECPool sec_pool;
+    std::atomic<bool> portfolio_finished (false);
+    std::atomic<int> winner (-1);
+    std::vector<VariantStats> variant_stats (variants.size());
+    std::vector<SCIP_RETCODE> retcodes (variants.size(), SCIP_OKAY);
+
+    auto solveVariant = [&](std::size_t index) {
+        auto& variant = variants[index];
+        SCIP* scip = NULL;
+        SCIPcreate(&scip);
+        SCIPsetMessagehdlrQuiet(scip, TRUE);
+        includePrizeCollectingTSPPlugins(
+            scip, variant.sec_disjoint_tour, variant.sec_lp_gap_improvement_threshold, variant.sec_maxflow_mincut,
+            variant.sec_max_tailing_off_iterations, variant.sec_sepafreq
+        );
+        auto sec_conshdlr = dynamic_cast<PCTSPconshdlrSubtour*>(SCIPfindObjConshdlr(scip, SEC_CONSHDLR_NAME.c_str()));
+        sec_conshdlr->setKeepSECs(true);
+        NodeEventhdlr* node_eventhdlr = new NodeEventhdlr(scip);
+        SCIPincludeObjEventhdlr(scip, node_eventhdlr, TRUE);
+        auto portfolio_eventhdlr = new PortfolioEventhdlr(scip, incumbent, sec_pool, portfolio_finished);
+        SCIPincludeObjEventhdlr(scip, portfolio_eventhdlr, TRUE);
+        setBranchingStrategy(scip, variant.branching_strategy, variant.branching_max_depth);
+        setBranchingRandomSeeds(scip);
+        SCIPsetRealParam(scip, "limits/time", time_limit);
+
+        // the problem data points to these until SCIP is freed
+        PrizeNumberType variant_quota = quota;
+        PCTSPvertex variant_root = root_vertex;
+        std::string variant_name = name + "-" + variant.name;
+        PCTSPedgeVariableMap edge_variable_map;
+        std::vector<PCTSPedge> variant_heuristic_edges = incumbent.getEdges();
+        createPrizeCollectingTSPProblem(
+            scip, graph, variant_heuristic_edges, cost_map, prize_map, variant_quota, variant_root,
+            edge_variable_map, variant_name
+        );
+        retcodes[index] = SCIPsolve(scip);
+        if (retcodes[index] != SCIP_OKAY) {
+            // stop the other variants, the error is thrown once every thread has joined
+            portfolio_finished = true;
+            variant_stats[index] = {variant.name, {}, 0, 0, 0, false, SCIPgetSolvingTime(scip)};
+            SCIPfree(&scip);
+            return;
+        }
+
+        auto status = SCIPgetStatus(scip);
+        bool finished = status == SCIP_STATUS_OPTIMAL || status == SCIP_STATUS_INFEASIBLE;
+        if (finished) {
+            int no_winner = -1;
+            winner.compare_exchange_strong(no_winner, (int) index);
+            portfolio_finished = true;
+        }
+        if (SCIPgetNSols(scip) > 0) {
+            SCIP_SOL* sol = SCIPgetBestSol(scip);
+            auto edges = getSolutionEdges(scip, graph, sol, edge_variable_map);
+            incumbent.offer(SCIPgetSolOrigObj(scip, sol), edges);
+        }
+        variant_stats[index] = {
+            variant.name, getSummaryStatsFromSCIP(scip), portfolio_eventhdlr->num_imported_tours,
+            portfolio_eventhdlr->num_imported_secs, portfolio_eventhdlr->num_exported_secs, finished,
+            SCIPgetSolvingTime(scip)
+        };
+        SCIPfree(&scip);
+    };
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < variants.size(); i++) threads.emplace_back(solveVariant, i);
+    for (auto& thread : threads) thread.join();
+    for (std::size_t i = 0; i < variants.size(); i++) {
+        if (retcodes[i] != SCIP_OKAY) throw VariantSolveError(variants[i].name, retcodes[i]);
+    }
+
+    // every variant solves the same problem, so any dual bound is valid
+    PortfolioSolveStats stats;
+    stats.winner = winner;
+    stats.solution_edges = incumbent.getEdges();
+    double upper_bound = incumbent.getCost();
+    double lower_bound = -std::numeric_limits<double>::infinity();
+    int best_bound_variant = -1;
+    for (std::size_t i = 0; i < variant_stats.size(); i++) {
+        if (variant_stats[i].summary.lower_bound > lower_bound) {
+            lower_bound = variant_stats[i].summary.lower_bound;
+            best_bound_variant = i;
+        }
+    }
+    int reported = stats.winner >= 0 ? stats.winner : best_bound_variant;
+    stats.summary = {};
+    if (reported >= 0) stats.summary = variant_stats[reported].summary;
+    if (stats.winner < 0) stats.summary.status = SCIP_STATUS_TIMELIMIT;
+    stats.summary.lower_bound = std::min(lower_bound, upper_bound);
+    stats.summary.upper_bound = upper_bound;
+    stats.variants = variant_stats;
+    std::chrono::duration<double> solving_time = std::chrono::steady_clock::now() - start_time;
+    stats.solving_time = solving_time.count();
+
+    std::string winner_name = stats.winner >= 0 ? variants[stats.winner].name : "none";
+    BOOST_LOG_TRIVIAL(info) << "Portfolio of " << variants.size() << " variants finished with winner "
+        << winner_name << " and a tour of cost " << upper_bound << ".";
+    return stats;
+}
@@ -0,0 +1,200 @@
+#include "pctsp/pricing.hh"
+#include "pctsp/data_structures.hh"
+
+std::vector<PCTSPedge> getEdgesWithoutVariables(PCTSPgraph& graph, PCTSPedgeVariableMap& edge_variable_map) {
+    std::vector<PCTSPedge> edges;
+    for (auto edge : boost::make_iterator_range(boost::edges(graph))) {
+        if (boost::source(edge, graph) != boost::target(edge, graph) && edge_variable_map.count(edge) == 0)
+            edges.push_back(edge);
+    }
+    return edges;
+}
+
+void EdgePricer::removePriceableEdges(std::vector<PCTSPedge>& edges) {
+    std::set<PCTSPedge> removed (edges.begin(), edges.end());
+    auto last = std::remove_if(priceable_edges_.begin(), priceable_edges_.end(), [&](PCTSPedge& edge) {
+        return removed.count(edge) > 0;
+    });
+    priceable_edges_.erase(last, priceable_edges_.end());
+}
+
+void EdgePricer::addInducedEdgesRow(SCIP_ROW* row, std::vector<PCTSPvertex>& vertex_set) {
+    std::vector<PCTSPvertex> sorted_vertex_set (vertex_set.begin(), vertex_set.end());
+    std::sort(sorted_vertex_set.begin(), sorted_vertex_set.end());
+    for (auto vertex : sorted_vertex_set) {
+        if (vertex >= rows_of_vertex_.size()) rows_of_vertex_.resize(vertex + 1);
+        rows_of_vertex_[vertex].push_back(induced_rows_.size());
+    }
+    induced_rows_.push_back({row, sorted_vertex_set});
+}
+
+std::vector<std::size_t> EdgePricer::rowsContainingEdge(PCTSPvertex u, PCTSPvertex v) {
+    std::vector<std::size_t> rows;
+    if (u >= rows_of_vertex_.size() || v >= rows_of_vertex_.size()) return rows;
+    // scan the rows of the endpoint that is in fewer rows
+    if (rows_of_vertex_[u].size() > rows_of_vertex_[v].size()) std::swap(u, v);
+    for (auto r : rows_of_vertex_[u]) {
+        auto& vertex_set = induced_rows_[r].second;
+        if (std::binary_search(vertex_set.begin(), vertex_set.end(), v)) rows.push_back(r);
+    }
+    return rows;
+}
+
+unsigned int EdgePricer::getNumPricedVars() {
+    return num_priced_vars_;
+}
+
+SCIP_DECL_PRICERINIT(EdgePricer::scip_init) {
+    ProbDataPCTSP* probdata = dynamic_cast<ProbDataPCTSP*>(SCIPgetObjProbData(scip));
+    auto& graph = *(probdata->getInputGraph());
+    degree_conss_ = std::vector<SCIP_CONS*>(boost::num_vertices(graph), NULL);
+    for (auto& [vertex, cons] : orig_degree_conss_) {
+        SCIP_CALL(SCIPgetTransformedCons(scip, cons, &degree_conss_[vertex]));
+    }
+    rows_of_vertex_ = std::vector<std::vector<std::size_t>>(boost::num_vertices(graph));
+    return SCIP_OKAY;
+}
+
+SCIP_DECL_PRICEREXITSOL(EdgePricer::scip_exitsol) {
+    for (auto& [row, vertex_set] : induced_rows_) {
+        SCIP_CALL(SCIPreleaseRow(scip, &row));
+    }
+    induced_rows_.clear();
+    rows_of_vertex_.clear();
+    return SCIP_OKAY;
+}
+
+SCIP_DECL_PRICERREDCOST(EdgePricer::scip_redcost) {
+    return priceEdges(scip, false, result);
+}
+
+SCIP_DECL_PRICERFARKAS(EdgePricer::scip_farkas) {
+    return priceEdges(scip, true, result);
+}
+
+SCIP_RETCODE EdgePricer::priceEdges(SCIP* scip, bool farkas, SCIP_RESULT* result) {
+    ProbDataPCTSP* probdata = dynamic_cast<ProbDataPCTSP*>(SCIPgetObjProbData(scip));
+    auto& graph = *(probdata->getInputGraph());
+    auto cost_map = boost::get(edge_weight, graph);
+    auto consDual = [&](SCIP_CONS* cons) {
+        if (cons == NULL) return 0.0;
+        return farkas ? SCIPgetDualfarkasLinear(scip, cons) : SCIPgetDualsolLinear(scip, cons);
+    };
+    std::vector<double> degree_duals (degree_conss_.size());
+    for (std::size_t vertex = 0; vertex < degree_conss_.size(); vertex++) degree_duals[vertex] = consDual(degree_conss_[vertex]);
+
+    // duals of the rows over x(E(S)), and how much they could lower a reduced cost
+    std::vector<double> row_duals (induced_rows_.size());
+    double max_row_decrease = 0.0;
+    for (std::size_t r = 0; r < induced_rows_.size(); r++) {
+        auto row = induced_rows_[r].first;
+        row_duals[r] = farkas ? SCIProwGetDualfarkas(row) : SCIProwGetDualsol(row);
+        max_row_decrease += std::max(0.0, row_duals[r]);
+    }
+
+    // in Farkas pricing the objective is ignored
+    std::vector<std::pair<double, std::size_t>> negative_edges;
+    for (std::size_t i = 0; i < priceable_edges_.size(); i++) {
+        auto edge = priceable_edges_[i];
+        auto u = boost::source(edge, graph);
+        auto v = boost::target(edge, graph);
+        double cost = cost_map[edge];
+        double reduced_cost = (farkas ? 0.0 : cost) - degree_duals[u] - degree_duals[v];
+        if (!SCIPisDualfeasNegative(scip, reduced_cost - max_row_decrease)) continue;
+        for (auto r : rowsContainingEdge(u, v)) reduced_cost -= row_duals[r];
+        if (SCIPisDualfeasNegative(scip, reduced_cost)) negative_edges.push_back({reduced_cost, i});
+    }
+    std::sort(negative_edges.begin(), negative_edges.end());
+    if (negative_edges.size() > boost::num_vertices(graph)) negative_edges.resize(boost::num_vertices(graph));
+
+    // add the edges and stop pricing them
+    std::vector<std::size_t> priced_indices;
+    for (auto& [reduced_cost, i] : negative_edges) {
+        SCIP_CALL(addEdgeVariable(scip, priceable_edges_[i]));
+        priced_indices.push_back(i);
+    }
+    std::sort(priced_indices.rbegin(), priced_indices.rend());
+    for (auto i : priced_indices) {
+        priceable_edges_[i] = priceable_edges_.back();
+        priceable_edges_.pop_back();
+    }
+    *result = SCIP_SUCCESS;
+    return SCIP_OKAY;
+}
+
+SCIP_RETCODE EdgePricer::addEdgeVariable(SCIP* scip, PCTSPedge edge) {
+    ProbDataPCTSP* probdata = dynamic_cast<ProbDataPCTSP*>(SCIPgetObjProbData(scip));
+    auto& graph = *(probdata->getInputGraph());
+    auto& edge_variable_map = *(probdata->getEdgeVariableMap());
+    auto cost_map = boost::get(edge_weight, graph);
+    auto u = boost::source(edge, graph);
+    auto v = boost::target(edge, graph);
+
+    SCIP_VAR* edge_variable;
+    SCIP_CALL(SCIPcreateVar(scip, &edge_variable, NULL, 0.0, 1.0, cost_map[edge], SCIP_VARTYPE_BINARY,
+        FALSE, TRUE, NULL, NULL, NULL, NULL, NULL));
+    SCIP_CALL(SCIPaddPricedVar(scip, edge_variable, 1.0));
+    for (auto vertex : {u, v}) {
+        if (degree_conss_[vertex] != NULL) SCIP_CALL(SCIPaddCoefLinear(scip, degree_conss_[vertex], edge_variable, 1.0));
+    }
+    for (auto r : rowsContainingEdge(u, v)) {
+        SCIP_CALL(SCIPaddVarToRow(scip, induced_rows_[r].first, edge_variable, 1.0));
+    }
+    edge_variable_map[edge] = edge_variable;
+    num_priced_vars_++;
+    SCIP_CALL(SCIPreleaseVar(scip, &edge_variable));
+    return SCIP_OKAY;
+}
+
+EdgePricer* findEdgePricer(SCIP* scip) {
+    auto objpricer = SCIPfindObjPricer(scip, EDGE_PRICER_NAME.c_str());
+    if (objpricer == 0) return NULL;
+    return dynamic_cast<EdgePricer*>(objpricer);
+}
+
+SCIP_RETCODE includeEdgePricer(
+    SCIP* scip,
+    PCTSPgraph& graph,
+    PCTSPedgeVariableMap& edge_variable_map,
+    std::map<PCTSPvertex, SCIP_CONS*>& degree_conss
+) {
+    auto priceable_edges = getEdgesWithoutVariables(graph, edge_variable_map);
+    EdgePricer* pricer = new EdgePricer(scip, priceable_edges, degree_conss);
+    SCIP_CALL(SCIPincludeObjPricer(scip, pricer, TRUE));
+    SCIP_CALL(SCIPactivatePricer(scip, SCIPfindPricer(scip, EDGE_PRICER_NAME.c_str())));
+
+    // dual reductions assume that every variable is already in the model
+    SCIP_CALL(SCIPsetBoolParam(scip, "misc/allowstrongdualreds", FALSE));
+    SCIP_CALL(SCIPsetBoolParam(scip, "misc/allowweakdualreds", FALSE));
+    return SCIP_OKAY;
+}
+
+SCIP_RETCODE addInducedEdgesRow(
+    SCIP* scip,
+    SCIP_CONSHDLR* conshdlr,
+    SCIP_RESULT* result,
+    SCIP_SOL* sol,
+    VarVector& vars,
+    std::vector<double>& var_coefs,
+    double& lhs,
+    double& rhs,
+    std::string& name,
+    std::vector<PCTSPvertex>& vertex_set,
+    SCIP_ROW** added_row
+) {
+    EdgePricer* pricer = findEdgePricer(scip);
+    if (pricer == NULL) return addRow(scip, conshdlr, result, sol, vars, var_coefs, lhs, rhs, name, false, added_row);
+
+    // the pricer keeps the row if it was added to the LP
+    SCIP_ROW* row = NULL;
+    SCIP_CALL(addRow(scip, conshdlr, result, sol, vars, var_coefs, lhs, rhs, name, true, &row));
+    if (row != NULL) {
+        pricer->addInducedEdgesRow(row, vertex_set);
+        // the caller keeps the row too
+        if (added_row != NULL) {
+            SCIP_CALL(SCIPcaptureRow(scip, row));
+            *added_row = row;
+        }
+    }
+    return SCIP_OKAY;
+}
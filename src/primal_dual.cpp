@@ -0,0 +1,270 @@
+#include "pctsp/primal_dual.hh"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+const int WARM_START_STEP_SIZE = 1;
+const int WARM_START_PATH_DEPTH_LIMIT = 2;
+
+/** An edge becoming tight or a component running out of penalty */
+struct PrimalDualEvent {
+    double time;
+    unsigned int index;     // edge index or component representative
+    unsigned int version_a; // versions of the components when the event was pushed
+    unsigned int version_b;
+    bool is_edge;
+
+    bool operator>(const PrimalDualEvent& other) const {
+        if (time != other.time) return time > other.time;
+        // deactivations before merges at the same time
+        if (is_edge != other.is_edge) return is_edge;
+        return index > other.index;
+    }
+};
+
+struct PrimalDualComponent {
+    bool is_active;
+    bool contains_root;
+    double penalty;      // total penalty of the vertices in the component
+    double spent;        // sum of duals of the sets inside the component
+    double growth;       // total growth of the component up to last_time
+    double last_time;
+    unsigned int version;
+    std::vector<std::size_t> members;
+};
+
+}
+
+PrimalDualTree goemansWilliamsonTree(
+    std::size_t n,
+    const std::vector<PrimalDualEdge>& edges,
+    const std::vector<double>& penalties,
+    std::size_t root
+) {
+    PrimalDualTree tree = {{}, 0.0};
+    if (root >= n) return tree;
+
+    // incident edges of every vertex
+    std::vector<std::vector<std::size_t>> incident (n);
+    for (std::size_t e = 0; e < edges.size(); e++) {
+        if (edges[e].source == edges[e].target) continue;
+        incident[edges[e].source].push_back(e);
+        incident[edges[e].target].push_back(e);
+    }
+
+    // union find: the load of v is base[v] plus the growth of its component
+    std::vector<std::size_t> parent (n);
+    std::vector<double> base (n, 0.0);
+    std::vector<PrimalDualComponent> components (n);
+    for (std::size_t v = 0; v < n; v++) {
+        parent[v] = v;
+        bool is_root = v == root;
+        components[v] = {!is_root && penalties[v] > 0, is_root, is_root ? 0.0 : penalties[v], 0.0, 0.0, 0.0, 0, {v}};
+    }
+    auto find = [&](std::size_t v) {
+        while (parent[v] != v) {
+            parent[v] = parent[parent[v]];
+            v = parent[v];
+        }
+        return v;
+    };
+    double now = 0.0;
+    auto settle = [&](std::size_t c) {
+        auto& component = components[c];
+        if (component.is_active) {
+            double delta = now - component.last_time;
+            component.growth += delta;
+            component.spent += delta;
+            tree.dual_objective += delta;
+        }
+        component.last_time = now;
+    };
+    auto load = [&](std::size_t v, std::size_t c) {
+        auto& component = components[c];
+        double growth = component.growth + (component.is_active ? now - component.last_time : 0.0);
+        return base[v] + growth;
+    };
+
+    // binary min-heap of events, built in linear time from the first events
+    std::vector<PrimalDualEvent> events;
+    bool is_heap = false;
+    auto pushEvent = [&](PrimalDualEvent event) {
+        events.push_back(event);
+        if (is_heap) std::push_heap(events.begin(), events.end(), std::greater<PrimalDualEvent>());
+    };
+    auto pushEdge = [&](std::size_t e) {
+        auto a = find(edges[e].source);
+        auto b = find(edges[e].target);
+        if (a == b) return;
+        int rate = components[a].is_active + components[b].is_active;
+        if (rate == 0) return;
+        double slack = edges[e].cost - load(edges[e].source, a) - load(edges[e].target, b);
+        pushEvent({now + std::max(0.0, slack) / rate, (unsigned int) e, components[a].version, components[b].version, true});
+    };
+    auto pushDeactivation = [&](std::size_t c) {
+        auto& component = components[c];
+        if (!component.is_active) return;
+        double remaining = component.penalty - component.spent - (now - component.last_time);
+        pushEvent({now + std::max(0.0, remaining), (unsigned int) c, component.version, component.version, false});
+    };
+    for (std::size_t v = 0; v < n; v++) pushDeactivation(v);
+    for (std::size_t e = 0; e < edges.size(); e++) pushEdge(e);
+    std::make_heap(events.begin(), events.end(), std::greater<PrimalDualEvent>());
+    is_heap = true;
+
+    std::size_t num_active = 0;
+    for (std::size_t v = 0; v < n; v++) num_active += components[v].is_active;
+    std::vector<std::size_t> forest;
+    // once every component is inactive the remaining events are stale
+    while (!events.empty() && num_active > 0) {
+        std::pop_heap(events.begin(), events.end(), std::greater<PrimalDualEvent>());
+        auto event = events.back();
+        events.pop_back();
+        if (!event.is_edge) {
+            auto& component = components[event.index];
+            if (parent[event.index] != event.index || component.version != event.version_a || !component.is_active) continue;
+            now = event.time;
+            settle(event.index);
+            component.is_active = false;
+            component.version++;
+            num_active--;
+            continue;
+        }
+        auto& edge = edges[event.index];
+        auto a = find(edge.source);
+        auto b = find(edge.target);
+        if (a == b) continue;
+        if (components[a].version != event.version_a || components[b].version != event.version_b) {
+            // the rate of the edge changed since the event was pushed
+            pushEdge(event.index);
+            continue;
+        }
+        now = event.time;
+        settle(a);
+        settle(b);
+        forest.push_back(event.index);
+
+        // merge the smaller component into the larger one
+        if (components[a].members.size() < components[b].members.size()) std::swap(a, b);
+        auto& large = components[a];
+        auto& small = components[b];
+        // vertices of an inactive side start growing again if the merged component is active
+        std::vector<std::size_t> woken;
+        if (!small.is_active) woken.insert(woken.end(), small.members.begin(), small.members.end());
+        if (!large.is_active) woken.insert(woken.end(), large.members.begin(), large.members.end());
+        for (auto v : small.members) {
+            base[v] += small.growth - large.growth;
+            large.members.push_back(v);
+        }
+        parent[b] = a;
+        large.penalty += small.penalty;
+        large.spent += small.spent;
+        large.contains_root = large.contains_root || small.contains_root;
+        num_active -= large.is_active + small.is_active;
+        large.is_active = !large.contains_root && large.penalty - large.spent > 0;
+        num_active += large.is_active;
+        large.version++;
+        small.version++;
+        small.members.clear();
+        small.members.shrink_to_fit();
+
+        if (large.is_active) {
+            pushDeactivation(a);
+            // the edges of woken vertices have no event or an event that is too late
+            for (auto v : woken) {
+                for (auto e : incident[v]) pushEdge(e);
+            }
+        }
+    }
+
+    // keep the edges of the forest inside the component of the root
+    auto root_component = find(root);
+    for (auto e : forest) {
+        if (find(edges[e].source) == root_component) tree.edges.push_back(e);
+    }
+    return tree;
+}
+
+std::vector<std::size_t> strongPruning(
+    std::size_t n,
+    const std::vector<PrimalDualEdge>& edges,
+    const std::vector<std::size_t>& tree_edges,
+    const std::vector<double>& penalties,
+    std::size_t root
+) {
+    std::vector<std::vector<std::size_t>> incident (n);
+    for (auto e : tree_edges) {
+        incident[edges[e].source].push_back(e);
+        incident[edges[e].target].push_back(e);
+    }
+    // order the vertices of the tree from the root so children come after parents
+    std::vector<std::size_t> order = {root};
+    std::vector<std::size_t> parent_edge (n, std::numeric_limits<std::size_t>::max());
+    std::vector<bool> visited (n, false);
+    visited[root] = true;
+    for (std::size_t q = 0; q < order.size(); q++) {
+        auto u = order[q];
+        for (auto e : incident[u]) {
+            auto v = edges[e].source == u ? edges[e].target : edges[e].source;
+            if (visited[v]) continue;
+            visited[v] = true;
+            parent_edge[v] = e;
+            order.push_back(v);
+        }
+    }
+    // net worth of the subtree below each vertex, leaves first
+    std::vector<double> net_worth (n, 0.0);
+    for (auto it = order.rbegin(); it != order.rend(); it++) {
+        auto v = *it;
+        if (v != root) net_worth[v] += penalties[v];
+        if (v == root) continue;
+        auto e = parent_edge[v];
+        auto u = edges[e].source == v ? edges[e].target : edges[e].source;
+        net_worth[u] += std::max(0.0, net_worth[v] - edges[e].cost);
+    }
+    // keep the subtrees that are worth more than the edge joining them
+    std::vector<bool> is_kept (n, false);
+    is_kept[root] = true;
+    std::vector<std::size_t> pruned_edges;
+    for (auto v : order) {
+        if (v == root) continue;
+        auto e = parent_edge[v];
+        auto u = edges[e].source == v ? edges[e].target : edges[e].source;
+        if (is_kept[u] && net_worth[v] - edges[e].cost > 0) {
+            is_kept[v] = true;
+            pruned_edges.push_back(e);
+        }
+    }
+    return pruned_edges;
+}
+
+std::vector<PCTSPedge> warmStartEdges(
+    PCTSPgraph& graph,
+    EdgeCostMap& cost_map,
+    VertexPrizeMap& prize_map,
+    PrizeNumberType quota,
+    PCTSPvertex& root_vertex,
+    std::list<PCTSPvertex> tour
+) {
+    if (tour.size() > WARM_START_STEP_SIZE + 2) {
+        int step_size = WARM_START_STEP_SIZE;
+        int path_depth_limit = WARM_START_PATH_DEPTH_LIMIT;
+        pathExtensionUntilPrizeFeasible(graph, tour, cost_map, prize_map, root_vertex, quota, step_size, path_depth_limit);
+        if (totalPrizeOfTour(prize_map, tour) >= quota) {
+            // the costs may have changed since the tour was found
+            twoOpt(graph, tour, cost_map, boost::num_vertices(graph));
+            auto first = tour.begin();
+            auto last = tour.end();
+            return getEdgesInWalk(graph, first, last);
+        }
+    }
+    std::list<PCTSPvertex> primal_dual_tour;
+    callWithBestCostMap(graph, cost_map, [&](auto& costs) {
+        return primalDualTour(graph, primal_dual_tour, costs, prize_map, quota, root_vertex);
+    });
+    auto first = primal_dual_tour.begin();
+    auto last = primal_dual_tour.end();
+    return getEdgesInWalk(graph, first, last);
+}
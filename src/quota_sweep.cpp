@@ -0,0 +1,82 @@
+/** Solve the prize collecting TSP for a sorted list of quotas */
+
+#include "pctsp/quota_sweep.hh"
+#include "pctsp/algorithms.hh"
+
+std::vector<QuotaSweepPoint> solveQuotaSweep(
+    SCIP* scip,
+    PCTSPgraph& graph,
+    EdgeCostMap& cost_map,
+    VertexPrizeMap& prize_map,
+    std::vector<PrizeNumberType>& quotas,
+    PCTSPvertex& root_vertex,
+    int branching_max_depth,
+    unsigned int branching_strategy,
+    std::string name,
+    bool sec_disjoint_tour,
+    double sec_lp_gap_improvement_threshold,
+    bool sec_maxflow_mincut,
+    int sec_max_tailing_off_iterations,
+    int sec_sepafreq,
+    float time_limit
+) {
+    std::vector<QuotaSweepPoint> frontier;
+    if (quotas.size() == 0) return frontier;
+    std::vector<PrizeNumberType> sorted_quotas (quotas.begin(), quotas.end());
+    std::sort(sorted_quotas.begin(), sorted_quotas.end());
+    SCIPsetMessagehdlrQuiet(scip, TRUE);
+
+    // the problem data points to the quota, so it changes in place between solves
+    PrizeNumberType quota = sorted_quotas.front();
+    std::list<PCTSPvertex> best_tour;
+    auto heuristic_edges = warmStartEdges(graph, cost_map, prize_map, quota, root_vertex, best_tour);
+    auto edge_var_map = modelPrizeCollectingTSP(
+        scip, graph, heuristic_edges, cost_map, prize_map, quota, root_vertex, name,
+        sec_disjoint_tour, sec_lp_gap_improvement_threshold, sec_maxflow_mincut,
+        sec_max_tailing_off_iterations, sec_sepafreq
+    );
+    auto sec_conshdlr = dynamic_cast<PCTSPconshdlrSubtour*>(SCIPfindObjConshdlr(scip, SEC_CONSHDLR_NAME.c_str()));
+    sec_conshdlr->setKeepSECs(true);
+    setBranchingStrategy(scip, branching_strategy, branching_max_depth);
+    setBranchingRandomSeeds(scip);
+
+    for (std::size_t i = 0; i < sorted_quotas.size(); i++) {
+        if (i > 0) {
+            // only the prize constraint depends on the quota
+            SCIPfreeTransform(scip);
+            quota = sorted_quotas[i];
+            SCIPchgRhsLinear(scip, SCIPfindOrigCons(scip, PRIZE_CONS_NAME.c_str()), -quota);
+            sec_conshdlr->addKeptSECsToProblem(scip);
+            heuristic_edges = warmStartEdges(graph, cost_map, prize_map, quota, root_vertex, best_tour);
+            if (heuristic_edges.size() > 0) {
+                auto first = heuristic_edges.begin();
+                auto last = heuristic_edges.end();
+                SCIP_HEUR* heur = NULL;
+                addHeuristicEdgesToSolver(scip, graph, heur, edge_var_map, first, last);
+            }
+        }
+        unsigned int num_kept_secs = sec_conshdlr->getNumKeptSECs();
+        SCIPsetRealParam(scip, "limits/time", SCIPgetSolvingTime(scip) + time_limit);
+        double start_time = SCIPgetSolvingTime(scip);
+        SCIPsolve(scip);
+
+        QuotaSweepPoint point = {
+            quota, SCIPgetStatus(scip), SCIPgetDualbound(scip), SCIPgetPrimalbound(scip), 0,
+            std::vector<PCTSPedge>(), num_kept_secs, SCIPgetSolvingTime(scip) - start_time
+        };
+        best_tour.clear();
+        if (SCIPgetNSols(scip) > 0) {
+            SCIP_SOL* sol = SCIPgetBestSol(scip);
+            point.solution_edges = getSolutionEdges(scip, graph, sol, edge_var_map);
+            auto vertices = getSolutionVertices(scip, graph, sol, edge_var_map);
+            point.prize = totalPrize(prize_map, vertices);
+            best_tour = tourFromCycleEdges(graph, point.solution_edges, root_vertex);
+        }
+        BOOST_LOG_TRIVIAL(info) << "Quota " << quota << " has a tour of cost " << point.upper_bound
+            << " and a lower bound of " << point.lower_bound << ". Started with " << num_kept_secs << " SECs.";
+        frontier.push_back(point);
+    }
+    // the problem data points to the quota and edge variables of this call
+    SCIPfreeProb(scip);
+    return frontier;
+}
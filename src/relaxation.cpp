@@ -0,0 +1,120 @@
+/** Root LP relaxation of the prize collecting TSP */
+
+#include "pctsp/relaxation.hh"
+#include "pctsp/algorithms.hh"
+
+RelaxationStats solveRootRelaxation(
+    SCIP* scip,
+    PCTSPgraph& graph,
+    std::vector<PCTSPedge>& heuristic_edges,
+    EdgeCostMap& cost_map,
+    VertexPrizeMap& prize_map,
+    PrizeNumberType& quota,
+    PCTSPvertex& root_vertex,
+    bool cost_cover_disjoint_paths,
+    bool cost_cover_shortest_path,
+    bool cycle_cover,
+    std::vector<int> disjoint_paths_distances,
+    bool sec_disjoint_tour,
+    double sec_lp_gap_improvement_threshold,
+    bool sec_maxflow_mincut,
+    int sec_max_tailing_off_iterations,
+    float time_limit,
+    bool sec_union_find
+) {
+    // the cutting plane loop only needs the LP, the constraints, a branching rule to stop at
+    // and a node selector, without which SCIP refuses to solve
+    // SCIP_CALL_EXC throws since the stats are returned rather than a SCIP_RETCODE
+    SCIP_CALL_EXC(SCIPincludeConshdlrLinear(scip));
+    SCIP_CALL_EXC(SCIPincludeConshdlrIntegral(scip));
+    SCIP_CALL_EXC(SCIPincludeBranchruleMostinf(scip));
+    SCIP_CALL_EXC(SCIPincludeNodeselDfs(scip));
+    SCIPsetMessagehdlrQuiet(scip, TRUE);
+
+    // add self loops to graph - we assume the input graph is simple
+    if (hasSelfLoopsOnAllVertices(graph) == false) {
+        addSelfLoopsToGraph(graph);
+        assignZeroCostToSelfLoops(graph, cost_map);
+    }
+
+    std::map<PCTSPedge, SCIP_VAR*> edge_variable_map;
+    std::map<PCTSPedge, PrizeNumberType> weight_map;
+    putPrizeOntoEdgeWeights(graph, prize_map, weight_map);
+    ProbDataPCTSP* objprobdata = new ProbDataPCTSP(&graph, &root_vertex, &edge_variable_map, &quota);
+    if (isCompleteGraph(graph)) {
+        objprobdata->setDenseCostMap(std::make_unique<PCTSPdenseCostMap>(graph, cost_map));
+    }
+    SCIP_CALL_EXC(SCIPcreateObjProb(scip, "pctsp-root-relaxation", objprobdata, true));
+    SCIP_CALL_EXC(PCTSPmodelWithoutSECs(scip, graph, cost_map, weight_map, quota, root_vertex, edge_variable_map));
+
+    // separate SECs at the root only
+    auto conshdlr = new PCTSPconshdlrSubtour(
+        scip,
+        sec_disjoint_tour,
+        sec_lp_gap_improvement_threshold,
+        sec_maxflow_mincut,
+        sec_max_tailing_off_iterations,
+        1
+    );
+    conshdlr->setUnionFindSeparation(sec_union_find);
+    SCIP_CALL_EXC(SCIPincludeObjConshdlr(scip, conshdlr, TRUE));
+    SCIP_CONS* cons;
+    std::string cons_name("subtour-constraint");
+    SCIP_CALL_EXC(PCTSPcreateBasicConsSubtour(scip, &cons, cons_name, graph, root_vertex));
+    SCIP_CALL_EXC(SCIPaddCons(scip, cons));
+    SCIP_CALL_EXC(SCIPreleaseCons(scip, &cons));
+
+    // cost cover inequalities of the heuristic upper bound
+    auto cost_upper_bound = totalCost(heuristic_edges, cost_map);
+    unsigned int nconss_disjoint_paths = 0;
+    unsigned int nconss_shortest_paths = 0;
+    if (cost_cover_disjoint_paths) {
+        SCIP_CALL_EXC(includeDisjointPathsCostCover(scip, disjoint_paths_distances));
+        if (cost_upper_bound > 0) {
+            auto path_distances = getDisjointPathsCostCoverEventHandler(scip)->getPathDistances();
+            nconss_disjoint_paths = separateThenAddCostCoverInequalities(scip, path_distances, cost_upper_bound);
+        }
+    }
+    if (cost_cover_shortest_path) {
+        SCIP_CALL_EXC(includeShortestPathCostCover(scip, graph, cost_map, root_vertex));
+        if (cost_upper_bound > 0) {
+            auto path_distances = getShortestPathCostCoverEventHandler(scip)->getPathDistances();
+            nconss_shortest_paths = separateThenAddCostCoverInequalities(scip, path_distances, cost_upper_bound);
+        }
+    }
+    if (cycle_cover) {
+        SCIP_CALL_EXC(SCIPincludeObjConshdlr(scip, new CycleCoverConshdlr(scip), true));
+        SCIP_CONS* cycle_cover_cons;
+        SCIP_CALL_EXC(createBasicCycleCoverCons(scip, &cycle_cover_cons));
+        SCIP_CALL_EXC(SCIPaddCons(scip, cycle_cover_cons));
+        SCIP_CALL_EXC(SCIPreleaseCons(scip, &cycle_cover_cons));
+    }
+    // counts the SECs added at each node
+    SCIP_CALL_EXC(SCIPincludeObjEventhdlr(scip, new NodeEventhdlr(scip), TRUE));
+
+    SCIP_CALL_EXC(SCIPsetIntParam(scip, "presolving/maxrounds", 0));
+    SCIP_CALL_EXC(SCIPsetLongintParam(scip, "limits/nodes", 1));
+    SCIP_CALL_EXC(SCIPsetRealParam(scip, "limits/time", time_limit));
+    SCIP_CALL_EXC(SCIPsolve(scip));
+
+    auto summary = getSummaryStatsFromSCIP(scip);
+    RelaxationStats stats = {
+        SCIPgetStatus(scip),
+        SCIPgetDualboundRoot(scip),
+        nconss_disjoint_paths + summary.num_cost_cover_disjoint_paths,
+        nconss_shortest_paths + summary.num_cost_cover_shortest_paths,
+        summary.num_cycle_cover,
+        summary.num_sec_disjoint_tour,
+        summary.num_sec_maxflow_mincut,
+        summary.num_sec_union_find,
+        SCIPgetNSepaRounds(scip),
+        SCIPgetNLPIterations(scip),
+        SCIPgetSolvingTime(scip)
+    };
+    BOOST_LOG_TRIVIAL(info) << "Root relaxation bound is " << stats.lower_bound << " after "
+        << stats.num_separation_rounds << " separation rounds in " << stats.solving_time << " seconds.";
+
+    // the problem data points to the edge variables of this call
+    SCIP_CALL_EXC(SCIPfreeProb(scip));
+    return stats;
+}
@@ -34,7 +34,9 @@ SCIP_RETCODE addRow(
     std::vector<double>& var_coefs,
     double& lhs,
     double& rhs,
-    std::string& name
+    std::string& name,
+    bool modifiable,
+    SCIP_ROW** added_row
 ) {
     auto nvars = var_vector.size();
     double* vals = var_coefs.data();
@@ -49,7 +51,7 @@ SCIP_RETCODE addRow(
     }
 
     SCIP_ROW* row;
-    SCIP_CALL(SCIPcreateEmptyRowConshdlr(scip, &row, conshdlr, name.c_str(), lhs, rhs, false, false, true));
+    SCIP_CALL(SCIPcreateEmptyRowConshdlr(scip, &row, conshdlr, name.c_str(), lhs, rhs, false, modifiable, true));
     SCIP_CALL(SCIPcacheRowExtensions(scip, row));
 
     for (int i = 0; i < nvars; i++) {
@@ -65,6 +67,11 @@ SCIP_RETCODE addRow(
             *result = SCIP_CUTOFF;
         else
             *result = SCIP_SEPARATED;
+        // the caller keeps the row, e.g. to add priced variables to it
+        if (added_row != NULL) {
+            SCIP_CALL(SCIPcaptureRow(scip, row));
+            *added_row = row;
+        }
     } 
     SCIP_CALL(SCIPreleaseRow(scip, &row));
 
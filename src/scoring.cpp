@@ -0,0 +1,287 @@
+#include "pctsp/scoring.hh"
+
+#include <limits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define PCTSP_SCORING_X86 1
+#include <immintrin.h>
+#else
+#define PCTSP_SCORING_X86 0
+#endif
+
+const unsigned int ScoringKernel::AUTO = 0;
+const unsigned int ScoringKernel::SCALAR = 1;
+const unsigned int ScoringKernel::SSE41 = 2;
+const unsigned int ScoringKernel::AVX2 = 3;
+
+unsigned int bestScoringKernel() {
+#if PCTSP_SCORING_X86
+    static const unsigned int best_kernel = __builtin_cpu_supports("avx2") ? ScoringKernel::AVX2
+        : __builtin_cpu_supports("sse4.1") ? ScoringKernel::SSE41
+        : ScoringKernel::SCALAR;
+    return best_kernel;
+#else
+    return ScoringKernel::SCALAR;
+#endif
+}
+
+bool isScoringKernelSupported(unsigned int kernel) {
+    if (kernel == ScoringKernel::AUTO || kernel == ScoringKernel::SCALAR) return true;
+    return kernel <= bestScoringKernel();
+}
+
+// Scalar kernels. The vector kernels hand their remainder to these.
+
+ExtensionVertex argmaxUnitaryGainScalar(
+    PrizeNumberType prize_v,
+    const CostNumberType* cost_to_tour,
+    const int* is_adjacent,
+    const CostNumberType* tour_cost,
+    int first,
+    int n,
+    ExtensionVertex best
+) {
+    for (int i = first; i < n; i++) {
+        if (is_adjacent[i] && is_adjacent[i + 1]) {
+            float gain = (float) prize_v / (float) (cost_to_tour[i] + cost_to_tour[i + 1] - tour_cost[i]);
+            if (gain > best.value) {
+                best.value = gain;
+                best.index = i;
+            }
+        }
+    }
+    return best;
+}
+
+ExtensionVertex argminUnitaryLossScalar(
+    const CostNumberType* external_cost,
+    const PrizeNumberType* external_prize,
+    CostNumberType internal_cost,
+    PrizeNumberType internal_prize,
+    int first,
+    int n,
+    ExtensionVertex best
+) {
+    for (int i = first; i < n; i++) {
+        PrizeNumberType prize_diff = external_prize[i] - internal_prize;
+        if (prize_diff > 0) {
+            float loss = (float) (external_cost[i] - internal_cost) / (float) prize_diff;
+            if (loss < best.value || best.index < 0) {
+                best.value = loss;
+                best.index = i;
+            }
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Reduce the best value and index of each lane: the largest (or smallest)
+ * value wins and ties go to the smallest index. Lanes with index -1 are ignored.
+ */
+ExtensionVertex reduceLanes(const float* values, const int* indices, int num_lanes, bool maximize) {
+    ExtensionVertex best = {-1, 0.0};
+    for (int lane = 0; lane < num_lanes; lane++) {
+        if (indices[lane] < 0) continue;
+        bool is_better = maximize ? values[lane] > best.value : values[lane] < best.value;
+        bool is_tie = values[lane] == best.value && indices[lane] < best.index;
+        if (best.index < 0 || is_better || is_tie) {
+            best.value = values[lane];
+            best.index = indices[lane];
+        }
+    }
+    return best;
+}
+
+#if PCTSP_SCORING_X86
+
+__attribute__((target("avx2")))
+ExtensionVertex argmaxUnitaryGainAVX2(
+    PrizeNumberType prize_v,
+    const CostNumberType* cost_to_tour,
+    const int* is_adjacent,
+    const CostNumberType* tour_cost,
+    int n
+) {
+    const __m256 prize = _mm256_set1_ps((float) prize_v);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i step = _mm256_set1_epi32(8);
+    __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256 best_value = _mm256_setzero_ps();
+    __m256i best_index = _mm256_set1_epi32(-1);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i cost_uv = _mm256_loadu_si256((const __m256i*) (cost_to_tour + i));
+        __m256i cost_vw = _mm256_loadu_si256((const __m256i*) (cost_to_tour + i + 1));
+        __m256i cost_uw = _mm256_loadu_si256((const __m256i*) (tour_cost + i));
+        __m256i not_adjacent = _mm256_or_si256(
+            _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*) (is_adjacent + i)), zero),
+            _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*) (is_adjacent + i + 1)), zero)
+        );
+        __m256 denominator = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_add_epi32(cost_uv, cost_vw), cost_uw));
+        __m256 gain = _mm256_div_ps(prize, denominator);
+        __m256 is_better = _mm256_andnot_ps(_mm256_castsi256_ps(not_adjacent), _mm256_cmp_ps(gain, best_value, _CMP_GT_OQ));
+        best_value = _mm256_blendv_ps(best_value, gain, is_better);
+        best_index = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(best_index), _mm256_castsi256_ps(index), is_better));
+        index = _mm256_add_epi32(index, step);
+    }
+    float values[8];
+    int indices[8];
+    _mm256_storeu_ps(values, best_value);
+    _mm256_storeu_si256((__m256i*) indices, best_index);
+    auto best = reduceLanes(values, indices, 8, true);
+    return argmaxUnitaryGainScalar(prize_v, cost_to_tour, is_adjacent, tour_cost, i, n, best);
+}
+
+__attribute__((target("sse4.1")))
+ExtensionVertex argmaxUnitaryGainSSE41(
+    PrizeNumberType prize_v,
+    const CostNumberType* cost_to_tour,
+    const int* is_adjacent,
+    const CostNumberType* tour_cost,
+    int n
+) {
+    const __m128 prize = _mm_set1_ps((float) prize_v);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i step = _mm_set1_epi32(4);
+    __m128i index = _mm_setr_epi32(0, 1, 2, 3);
+    __m128 best_value = _mm_setzero_ps();
+    __m128i best_index = _mm_set1_epi32(-1);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i cost_uv = _mm_loadu_si128((const __m128i*) (cost_to_tour + i));
+        __m128i cost_vw = _mm_loadu_si128((const __m128i*) (cost_to_tour + i + 1));
+        __m128i cost_uw = _mm_loadu_si128((const __m128i*) (tour_cost + i));
+        __m128i not_adjacent = _mm_or_si128(
+            _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*) (is_adjacent + i)), zero),
+            _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*) (is_adjacent + i + 1)), zero)
+        );
+        __m128 denominator = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_add_epi32(cost_uv, cost_vw), cost_uw));
+        __m128 gain = _mm_div_ps(prize, denominator);
+        __m128 is_better = _mm_andnot_ps(_mm_castsi128_ps(not_adjacent), _mm_cmpgt_ps(gain, best_value));
+        best_value = _mm_blendv_ps(best_value, gain, is_better);
+        best_index = _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(best_index), _mm_castsi128_ps(index), is_better));
+        index = _mm_add_epi32(index, step);
+    }
+    float values[4];
+    int indices[4];
+    _mm_storeu_ps(values, best_value);
+    _mm_storeu_si128((__m128i*) indices, best_index);
+    auto best = reduceLanes(values, indices, 4, true);
+    return argmaxUnitaryGainScalar(prize_v, cost_to_tour, is_adjacent, tour_cost, i, n, best);
+}
+
+__attribute__((target("avx2")))
+ExtensionVertex argminUnitaryLossAVX2(
+    const CostNumberType* external_cost,
+    const PrizeNumberType* external_prize,
+    CostNumberType internal_cost,
+    PrizeNumberType internal_prize,
+    int n
+) {
+    const __m256i cost_in = _mm256_set1_epi32(internal_cost);
+    const __m256i prize_in = _mm256_set1_epi32(internal_prize);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i step = _mm256_set1_epi32(8);
+    __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256 best_value = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    __m256i best_index = _mm256_set1_epi32(-1);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i cost_diff = _mm256_sub_epi32(_mm256_loadu_si256((const __m256i*) (external_cost + i)), cost_in);
+        __m256i prize_diff = _mm256_sub_epi32(_mm256_loadu_si256((const __m256i*) (external_prize + i)), prize_in);
+        __m256 is_candidate = _mm256_castsi256_ps(_mm256_cmpgt_epi32(prize_diff, zero));
+        __m256 loss = _mm256_div_ps(_mm256_cvtepi32_ps(cost_diff), _mm256_cvtepi32_ps(prize_diff));
+        __m256 is_better = _mm256_and_ps(is_candidate, _mm256_cmp_ps(loss, best_value, _CMP_LT_OQ));
+        best_value = _mm256_blendv_ps(best_value, loss, is_better);
+        best_index = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(best_index), _mm256_castsi256_ps(index), is_better));
+        index = _mm256_add_epi32(index, step);
+    }
+    float values[8];
+    int indices[8];
+    _mm256_storeu_ps(values, best_value);
+    _mm256_storeu_si256((__m256i*) indices, best_index);
+    auto best = reduceLanes(values, indices, 8, false);
+    return argminUnitaryLossScalar(external_cost, external_prize, internal_cost, internal_prize, i, n, best);
+}
+
+__attribute__((target("sse4.1")))
+ExtensionVertex argminUnitaryLossSSE41(
+    const CostNumberType* external_cost,
+    const PrizeNumberType* external_prize,
+    CostNumberType internal_cost,
+    PrizeNumberType internal_prize,
+    int n
+) {
+    const __m128i cost_in = _mm_set1_epi32(internal_cost);
+    const __m128i prize_in = _mm_set1_epi32(internal_prize);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i step = _mm_set1_epi32(4);
+    __m128i index = _mm_setr_epi32(0, 1, 2, 3);
+    __m128 best_value = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    __m128i best_index = _mm_set1_epi32(-1);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i cost_diff = _mm_sub_epi32(_mm_loadu_si128((const __m128i*) (external_cost + i)), cost_in);
+        __m128i prize_diff = _mm_sub_epi32(_mm_loadu_si128((const __m128i*) (external_prize + i)), prize_in);
+        __m128 is_candidate = _mm_castsi128_ps(_mm_cmpgt_epi32(prize_diff, zero));
+        __m128 loss = _mm_div_ps(_mm_cvtepi32_ps(cost_diff), _mm_cvtepi32_ps(prize_diff));
+        __m128 is_better = _mm_and_ps(is_candidate, _mm_cmplt_ps(loss, best_value));
+        best_value = _mm_blendv_ps(best_value, loss, is_better);
+        best_index = _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(best_index), _mm_castsi128_ps(index), is_better));
+        index = _mm_add_epi32(index, step);
+    }
+    float values[4];
+    int indices[4];
+    _mm_storeu_ps(values, best_value);
+    _mm_storeu_si128((__m128i*) indices, best_index);
+    auto best = reduceLanes(values, indices, 4, false);
+    return argminUnitaryLossScalar(external_cost, external_prize, internal_cost, internal_prize, i, n, best);
+}
+
+#endif
+
+/** Resolve AUTO and unsupported kernels */
+unsigned int resolveScoringKernel(unsigned int kernel) {
+    if (kernel == ScoringKernel::AUTO) return bestScoringKernel();
+    if (!isScoringKernelSupported(kernel)) return ScoringKernel::SCALAR;
+    return kernel;
+}
+
+ExtensionVertex argmaxUnitaryGain(
+    PrizeNumberType prize_v,
+    const CostNumberType* cost_to_tour,
+    const int* is_adjacent,
+    const CostNumberType* tour_cost,
+    int n,
+    unsigned int kernel
+) {
+    kernel = resolveScoringKernel(kernel);
+#if PCTSP_SCORING_X86
+    if (kernel == ScoringKernel::AVX2)
+        return argmaxUnitaryGainAVX2(prize_v, cost_to_tour, is_adjacent, tour_cost, n);
+    if (kernel == ScoringKernel::SSE41)
+        return argmaxUnitaryGainSSE41(prize_v, cost_to_tour, is_adjacent, tour_cost, n);
+#endif
+    ExtensionVertex best = {-1, 0.0};
+    return argmaxUnitaryGainScalar(prize_v, cost_to_tour, is_adjacent, tour_cost, 0, n, best);
+}
+
+ExtensionVertex argminUnitaryLoss(
+    const CostNumberType* external_cost,
+    const PrizeNumberType* external_prize,
+    CostNumberType internal_cost,
+    PrizeNumberType internal_prize,
+    int n,
+    unsigned int kernel
+) {
+    kernel = resolveScoringKernel(kernel);
+#if PCTSP_SCORING_X86
+    if (kernel == ScoringKernel::AVX2)
+        return argminUnitaryLossAVX2(external_cost, external_prize, internal_cost, internal_prize, n);
+    if (kernel == ScoringKernel::SSE41)
+        return argminUnitaryLossSSE41(external_cost, external_prize, internal_cost, internal_prize, n);
+#endif
+    ExtensionVertex best = {-1, 0.0};
+    return argminUnitaryLossScalar(external_cost, external_prize, internal_cost, internal_prize, 0, n, best);
+}
@@ -0,0 +1,128 @@
+/** Lifecycle of the subtour elimination rows of the LP */
+
+#include <algorithm>
+#include "pctsp/sec_pool.hh"
+
+SECRowPool::SECRowPool() {
+    num_rows_added = 0;
+    num_readded = 0;
+    num_dominated = 0;
+    num_maxflow_skipped = 0;
+}
+
+SCIP_RETCODE SECRowPool::addRow(SCIP* scip, SCIP_ROW* row, std::vector<PCTSPvertex>& vertex_set, PCTSPvertex target) {
+    std::string name = SCIProwGetName(row);
+    if (rows.count(name) > 0) return SCIP_OKAY;
+    std::vector<PCTSPvertex> sorted_vertex_set (vertex_set.begin(), vertex_set.end());
+    std::sort(sorted_vertex_set.begin(), sorted_vertex_set.end());
+    SCIP_CALL(SCIPcaptureRow(scip, row));
+    rows[name] = {row, sorted_vertex_set, target, 0, false};
+    names_by_target[target].push_back(name);
+    num_rows_added++;
+    return SCIP_OKAY;
+}
+
+void SECRowPool::ageRows(SCIP* scip) {
+    for (auto& [name, sec_row] : rows) {
+        if (sec_row.pooled) continue;
+        if (!SCIProwIsInLP(sec_row.row)) {
+            sec_row.pooled = true;
+            sec_row.age = 0;
+        }
+        else if (SCIPisFeasPositive(scip, SCIPgetRowLPFeasibility(scip, sec_row.row))) sec_row.age++;
+        else sec_row.age = 0;
+    }
+}
+
+SCIP_RETCODE SECRowPool::separate(SCIP* scip, SCIP_SOL* sol, SCIP_RESULT* result, int& num_rows_added) {
+    for (auto& [name, sec_row] : rows) {
+        if (!sec_row.pooled || !SCIPisFeasNegative(scip, SCIPgetRowSolFeasibility(scip, sec_row.row, sol))) continue;
+        SCIP_Bool infeasible;
+        SCIP_CALL(SCIPaddRow(scip, sec_row.row, false, &infeasible));
+        if (infeasible) *result = SCIP_CUTOFF;
+        else if (*result != SCIP_CUTOFF) *result = SCIP_SEPARATED;
+        sec_row.pooled = false;
+        num_rows_added++;
+        num_readded++;
+    }
+    return SCIP_OKAY;
+}
+
+SCIP_RETCODE SECRowPool::findDominatingRow(
+    SCIP* scip,
+    SCIP_SOL* sol,
+    SCIP_RESULT* result,
+    std::vector<PCTSPvertex>& vertex_set,
+    PCTSPvertex target,
+    double violation,
+    bool& dominated
+) {
+    dominated = false;
+    auto it = names_by_target.find(target);
+    if (it == names_by_target.end()) return SCIP_OKAY;
+    std::vector<PCTSPvertex> sorted_vertex_set (vertex_set.begin(), vertex_set.end());
+    std::sort(sorted_vertex_set.begin(), sorted_vertex_set.end());
+    for (auto& name : it->second) {
+        auto& sec_row = rows[name];
+        auto& other = sec_row.vertex_set;
+        bool nested = std::includes(other.begin(), other.end(), sorted_vertex_set.begin(), sorted_vertex_set.end())
+            || std::includes(sorted_vertex_set.begin(), sorted_vertex_set.end(), other.begin(), other.end());
+        if (!nested || SCIPisFeasLT(scip, -SCIPgetRowSolFeasibility(scip, sec_row.row, sol), violation)) continue;
+        if (sec_row.pooled) {
+            SCIP_Bool infeasible;
+            SCIP_CALL(SCIPaddRow(scip, sec_row.row, false, &infeasible));
+            if (infeasible) *result = SCIP_CUTOFF;
+            else if (*result != SCIP_CUTOFF) *result = SCIP_SEPARATED;
+            sec_row.pooled = false;
+            num_readded++;
+        }
+        dominated = true;
+        num_dominated++;
+        return SCIP_OKAY;
+    }
+    return SCIP_OKAY;
+}
+
+void SECRowPool::recordSkippedMaxflow() {
+    num_maxflow_skipped++;
+}
+
+SECPoolStats SECRowPool::getStats() {
+    std::size_t num_pooled = 0;
+    std::size_t num_slack = 0;
+    for (auto& [name, sec_row] : rows) {
+        if (sec_row.pooled) num_pooled++;
+        else if (sec_row.age > 0) num_slack++;
+    }
+    return {num_rows_added, num_pooled, num_slack, num_readded, num_dominated, num_maxflow_skipped};
+}
+
+SCIP_RETCODE SECRowPool::clear(SCIP* scip) {
+    for (auto& [name, sec_row] : rows) {
+        SCIP_CALL(SCIPreleaseRow(scip, &sec_row.row));
+    }
+    rows.clear();
+    names_by_target.clear();
+    return SCIP_OKAY;
+}
+
+SCIP_DECL_EVENTINITSOL(SECPoolEventhdlr::scip_initsol) {
+    SCIP_CALL( SCIPcatchEvent( scip, SCIP_EVENTTYPE_LPSOLVED, eventhdlr, NULL, NULL) );
+    return SCIP_OKAY;
+}
+
+SCIP_DECL_EVENTEXITSOL(SECPoolEventhdlr::scip_exitsol) {
+    SCIP_CALL( SCIPdropEvent( scip, SCIP_EVENTTYPE_LPSOLVED, eventhdlr, NULL, -1) );
+    return SCIP_OKAY;
+}
+
+SCIP_DECL_EVENTEXEC(SECPoolEventhdlr::scip_exec) {
+    // the slack of the rows is only known for an optimal LP
+    if (SCIPgetLPSolstat(scip) == SCIP_LPSOLSTAT_OPTIMAL) pool_.ageRows(scip);
+    return SCIP_OKAY;
+}
+
+SCIP_RETCODE includeSECPoolEventhdlr(SCIP* scip, SECRowPool& pool) {
+    if (SCIPfindObjEventhdlr(scip, SEC_POOL_EVENTHDLR_NAME.c_str()) != NULL) return SCIP_OKAY;
+    return SCIPincludeObjEventhdlr(scip, new SECPoolEventhdlr(scip, pool), TRUE);
+}
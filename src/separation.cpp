@@ -3,7 +3,10 @@
 #include <boost/graph/stoer_wagner_min_cut.hpp>
 #include <boost/property_map/property_map.hpp>
 #include <boost/typeof/typeof.hpp>
+#include <cmath>
 #include <iostream>
+#include <numeric>
+#include <set>
 #include <scip/scipdefplugins.h>
 
 void includeSeparation(SCIP* scip) {
@@ -83,16 +86,170 @@ CapacityVector getCapacityVectorFromSol(
     for (auto const& edge : edges) {
         SCIP_VAR* var = edge_variable_map[edge];
         double value = (double)SCIPgetSolVal(scip, sol, var);   // value is less than or equal to 2
-        CapacityType int_value;
-        if (SCIPisZero(scip, value))
-            int_value = 0;
-        else if (SCIPisZero(scip, value - 1.0))
-            int_value = FLOW_FLOAT_MULTIPLIER;
-        else if (SCIPisZero(scip, value - 2.0))
-            int_value = FLOW_FLOAT_MULTIPLIER * 2;
-        else
-            int_value = (CapacityType)(((double)FLOW_FLOAT_MULTIPLIER) * value);
-        capacity.push_back(int_value);
+        capacity.push_back(capacityFromValue(scip, value));
     }
     return capacity;
 }
+
+CapacityType capacityFromValue(SCIP* scip, double value) {
+    if (SCIPisZero(scip, value))
+        return 0;
+    else if (SCIPisZero(scip, value - 1.0))
+        return FLOW_FLOAT_MULTIPLIER;
+    else if (SCIPisZero(scip, value - 2.0))
+        return FLOW_FLOAT_MULTIPLIER * 2;
+    return (CapacityType)(((double)FLOW_FLOAT_MULTIPLIER) * value);
+}
+
+std::vector<ViolatedVertexSet> unionFindViolatedSets(
+    std::size_t num_vertices,
+    VertexPairVector& edges,
+    std::vector<double>& edge_values,
+    std::vector<double>& vertex_values,
+    PCTSPvertex root_vertex,
+    double tolerance
+) {
+    // every vertex starts as its own component
+    std::vector<PCTSPvertex> parent (num_vertices);
+    std::iota(parent.begin(), parent.end(), 0);
+    std::vector<std::vector<PCTSPvertex>> members (num_vertices);
+    std::vector<double> inner_value (num_vertices, 0.0);   // x(E(S))
+    std::vector<double> vertex_sum (vertex_values.begin(), vertex_values.end());  // y(S)
+    std::vector<std::size_t> size_returned (num_vertices, 0);
+    for (PCTSPvertex vertex = 0; vertex < num_vertices; vertex++) members[vertex] = {vertex};
+    auto find = [&parent](PCTSPvertex vertex) {
+        while (parent[vertex] != vertex) {
+            parent[vertex] = parent[parent[vertex]];
+            vertex = parent[vertex];
+        }
+        return vertex;
+    };
+
+    std::vector<std::size_t> order (edges.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&edge_values](std::size_t i, std::size_t j) {
+        return edge_values[i] > edge_values[j];
+    });
+    std::vector<ViolatedVertexSet> violated_sets;
+    std::size_t first = 0;
+    while (first < order.size()) {
+        // merge every edge with the same LP value
+        std::set<PCTSPvertex> changed;
+        std::size_t last = first;
+        while (last < order.size() && edge_values[order[last]] == edge_values[order[first]]) {
+            auto& edge = edges[order[last]];
+            auto u = find(edge.first);
+            auto v = find(edge.second);
+            if (u != v) {
+                // the larger component absorbs the smaller
+                if (members[u].size() < members[v].size()) std::swap(u, v);
+                parent[v] = u;
+                members[u].insert(members[u].end(), members[v].begin(), members[v].end());
+                members[v].clear();
+                inner_value[u] += inner_value[v];
+                vertex_sum[u] += vertex_sum[v];
+                changed.erase(v);
+            }
+            inner_value[u] += edge_values[order[last]];
+            changed.insert(u);
+            last++;
+        }
+        first = last;
+
+        for (auto component : changed) {
+            auto& vertex_set = members[component];
+            if (vertex_set.size() < 2 || vertex_set.size() == size_returned[component]) continue;
+            if (find(root_vertex) == component) continue;
+            ViolatedVertexSet violated = {{}, {}};
+            for (auto target : vertex_set) {
+                if (inner_value[component] - vertex_sum[component] + vertex_values[target] > tolerance)
+                    violated.targets.push_back(target);
+            }
+            if (violated.targets.size() == 0) continue;
+            violated.vertex_set = vertex_set;
+            std::sort(violated.vertex_set.begin(), violated.vertex_set.end());
+            std::sort(violated.targets.begin(), violated.targets.end());
+            violated_sets.push_back(violated);
+            size_returned[component] = vertex_set.size();
+        }
+    }
+    return violated_sets;
+}
+
+ShrunkSupportGraph shrinkSupportGraph(
+    VertexPairVector& edges,
+    std::vector<double>& edge_values,
+    std::vector<double>& vertex_values,
+    PCTSPvertex root_vertex,
+    double tolerance
+) {
+    std::vector<PCTSPvertex> parent (vertex_values.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](PCTSPvertex vertex) {
+        while (parent[vertex] != vertex) {
+            parent[vertex] = parent[parent[vertex]];
+            vertex = parent[vertex];
+        }
+        return vertex;
+    };
+    auto merge = [&](PCTSPvertex u, PCTSPvertex v) {
+        parent[find(v)] = find(u);
+    };
+    auto isOne = [tolerance](double value) { return value >= 1.0 - tolerance; };
+
+    // edges with value one between vertices with value one, away from the root:
+    // the SECs depend on their target, so a target merged with the root is lost
+    for (std::size_t i = 0; i < edges.size(); i++) {
+        auto [u, v] = edges[i];
+        if (u == root_vertex || v == root_vertex) continue;
+        if (isOne(edge_values[i]) && isOne(vertex_values[u]) && isOne(vertex_values[v]) && find(u) != find(v))
+            merge(u, v);
+    }
+    std::map<PCTSPvertex, std::size_t> set_size;
+    for (auto& [u, v] : edges) {
+        set_size[u] = 0;
+        set_size[v] = 0;
+    }
+
+    // merge original vertices of degree two with equal values on both sides
+    std::map<VertexPair, double> shrunk_values;
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        shrunk_values.clear();
+        for (std::size_t i = 0; i < edges.size(); i++) {
+            auto u = find(edges[i].first);
+            auto v = find(edges[i].second);
+            if (u == v) continue;
+            shrunk_values[{std::min(u, v), std::max(u, v)}] += edge_values[i];
+        }
+        for (auto& [vertex, size] : set_size) size = 0;
+        for (auto& [vertex, size] : set_size) set_size[find(vertex)]++;
+        std::map<PCTSPvertex, std::vector<std::pair<PCTSPvertex, double>>> neighbours;
+        for (auto& [pair, value] : shrunk_values) {
+            neighbours[pair.first].push_back({pair.second, value});
+            neighbours[pair.second].push_back({pair.first, value});
+        }
+        // a merge changes the neighbours of w, so they wait for the next pass
+        std::set<PCTSPvertex> touched;
+        for (auto& [w, adjacent] : neighbours) {
+            if (w == root_vertex || set_size[w] != 1 || adjacent.size() != 2) continue;
+            if (std::abs(adjacent[0].second - adjacent[1].second) > tolerance) continue;
+            auto a = adjacent[0].first;
+            auto b = adjacent[1].first;
+            if (a == root_vertex) std::swap(a, b);
+            if (touched.count(w) + touched.count(a) + touched.count(b) > 0) continue;
+            merge(a, w);
+            touched.insert({w, a, b});
+            merged = true;
+        }
+    }
+
+    ShrunkSupportGraph shrunk;
+    for (auto& [pair, value] : shrunk_values) {
+        shrunk.edges.push_back(pair);
+        shrunk.edge_values.push_back(value);
+    }
+    for (auto& [vertex, size] : set_size) shrunk.members[find(vertex)].push_back(vertex);
+    return shrunk;
+}
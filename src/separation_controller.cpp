@@ -0,0 +1,112 @@
+/** Adapt the effort spent on each separator to the bound improvement it buys */
+
+#include <algorithm>
+#include "pctsp/separation_controller.hh"
+
+double SeparationController::getReturn(const std::string& separator) {
+    double time = 0;
+    double bound_improvement = 0;
+    for (auto& round : windows[separator]) {
+        time += round.time;
+        bound_improvement += round.bound_improvement;
+    }
+    return bound_improvement / std::max(time, 1e-6);
+}
+
+bool SeparationController::shouldRun(const std::string& separator, bool fallback) {
+    if (fallback || windows[separator].size() < window_size) {
+        skips_since_run[separator] = 0;
+        return true;
+    }
+    double best_return = 0;
+    for (auto& [name, window] : windows) {
+        if (window.size() > 0) best_return = std::max(best_return, getReturn(name));
+    }
+    bool diminishing = getReturn(separator) < min_relative_return * best_return;
+    bool probe = probe_frequency > 0 && skips_since_run[separator] + 1 >= probe_frequency;
+    if (!diminishing || probe) {
+        if (diminishing) stats[separator].num_probes++;
+        skips_since_run[separator] = 0;
+        return true;
+    }
+    skips_since_run[separator]++;
+    stats[separator].num_skipped++;
+    return false;
+}
+
+void SeparationController::recordCall(const std::string& separator, double time, unsigned int num_cuts) {
+    auto& separator_stats = stats[separator];
+    separator_stats.num_calls++;
+    separator_stats.num_cuts += num_cuts;
+    separator_stats.time += time;
+    pending.push_back({separator, time, num_cuts});
+}
+
+void SeparationController::recordRound(const std::string& separator, double time, double bound_improvement) {
+    auto& window = windows[separator];
+    window.push_back({time, bound_improvement});
+    if (window.size() > window_size) window.pop_front();
+    stats[separator].bound_improvement += bound_improvement;
+}
+
+SeparatorStats SeparationController::getSeparatorStats(const std::string& separator) {
+    auto it = stats.find(separator);
+    if (it == stats.end()) return {0, 0, 0, 0, 0, 0};
+    return it->second;
+}
+
+SCIP_DECL_EVENTINITSOL(SeparationController::scip_initsol) {
+    windows.clear();
+    stats.clear();
+    skips_since_run.clear();
+    pending.clear();
+    last_lp_node = -1;
+    SCIP_CALL( SCIPcatchEvent( scip, SCIP_EVENTTYPE_LPSOLVED, eventhdlr, NULL, NULL) );
+    return SCIP_OKAY;
+}
+
+SCIP_DECL_EVENTEXITSOL(SeparationController::scip_exitsol) {
+    SCIP_CALL( SCIPdropEvent( scip, SCIP_EVENTTYPE_LPSOLVED, eventhdlr, NULL, -1) );
+    return SCIP_OKAY;
+}
+
+SCIP_DECL_EVENTEXEC(SeparationController::scip_exec) {
+    if (SCIPgetLPSolstat(scip) != SCIP_LPSOLSTAT_OPTIMAL) {
+        // the calls since the last LP cannot be compared with the next LP
+        pending.clear();
+        last_lp_node = -1;
+        return SCIP_OKAY;
+    }
+    auto node_number = SCIPnodeGetNumber(SCIPgetCurrentNode(scip));
+    double lp_bound = SCIPgetLPObjval(scip);
+    if (node_number == last_lp_node && pending.size() > 0) {
+        double bound_improvement = std::max(lp_bound - last_lp_bound, 0.0);
+        unsigned int num_cuts = 0;
+        for (auto& call : pending) num_cuts += call.num_cuts;
+        for (auto& call : pending) {
+            double share = num_cuts > 0 ? bound_improvement * call.num_cuts / num_cuts : 0.0;
+            recordRound(call.separator, call.time, share);
+        }
+    }
+    pending.clear();
+    last_lp_node = node_number;
+    last_lp_bound = lp_bound;
+    return SCIP_OKAY;
+}
+
+SeparationController* findSeparationController(SCIP* scip) {
+    auto objeventhdlr = SCIPfindObjEventhdlr(scip, SEPARATION_CONTROLLER_NAME.c_str());
+    if (objeventhdlr == NULL) return NULL;
+    return dynamic_cast<SeparationController*>(objeventhdlr);
+}
+
+SCIP_RETCODE includeSeparationController(
+    SCIP* scip,
+    std::size_t window_size,
+    double min_relative_return,
+    unsigned int probe_frequency
+) {
+    if (findSeparationController(scip) != NULL) return SCIP_OKAY;
+    auto controller = new SeparationController(scip, window_size, min_relative_return, probe_frequency);
+    return SCIPincludeObjEventhdlr(scip, controller, TRUE);
+}
@@ -0,0 +1,171 @@
+/** Re-solve the prize collecting TSP after small changes to the costs and prizes */
+
+#include "pctsp/session.hh"
+#include "pctsp/algorithms.hh"
+
+SolverSession::SolverSession(
+    PCTSPgraph& input_graph,
+    EdgeCostMap& input_cost_map,
+    VertexPrizeMap& input_prize_map,
+    PrizeNumberType quota,
+    PCTSPvertex root_vertex,
+    int branching_max_depth,
+    unsigned int branching_strategy,
+    bool cycle_cover,
+    std::string name,
+    bool sec_disjoint_tour,
+    double sec_lp_gap_improvement_threshold,
+    bool sec_maxflow_mincut,
+    int sec_max_tailing_off_iterations,
+    int sec_sepafreq,
+    float time_limit
+) : graph(boost::num_vertices(input_graph)), quota(quota), root_vertex(root_vertex), cycle_cover(cycle_cover),
+    time_limit(time_limit)
+{
+    // the session owns its costs and prizes so that updates never touch the input
+    cost_map = boost::get(edge_weight, graph);
+    prize_map = boost::get(vertex_distance, graph);
+    for (auto vertex : boost::make_iterator_range(boost::vertices(input_graph))) {
+        prize_map[vertex] = input_prize_map[vertex];
+    }
+    for (auto edge : boost::make_iterator_range(boost::edges(input_graph))) {
+        auto u = boost::source(edge, input_graph);
+        auto v = boost::target(edge, input_graph);
+        auto new_edge = boost::add_edge(u, v, graph).first;
+        cost_map[new_edge] = input_cost_map[edge];
+    }
+
+    scip = NULL;
+    SCIPcreate(&scip);
+    SCIPsetMessagehdlrQuiet(scip, TRUE);
+
+    // the first solve starts from the primal-dual tour, see solve
+    std::vector<PCTSPedge> heuristic_edges;
+    modelPrizeCollectingTSP(
+        scip, graph, heuristic_edges, cost_map, prize_map, this->quota, this->root_vertex, edge_variable_map, name,
+        sec_disjoint_tour, sec_lp_gap_improvement_threshold, sec_maxflow_mincut,
+        sec_max_tailing_off_iterations, sec_sepafreq
+    );
+    auto sec_conshdlr = dynamic_cast<PCTSPconshdlrSubtour*>(SCIPfindObjConshdlr(scip, SEC_CONSHDLR_NAME.c_str()));
+    sec_conshdlr->setKeepSECs(true);
+    if (cycle_cover) {
+        auto cycle_cover_conshdlr = new CycleCoverConshdlr(scip);
+        cycle_cover_conshdlr->setKeepCycleCovers(true);
+        SCIPincludeObjConshdlr(scip, cycle_cover_conshdlr, TRUE);
+        SCIP_CONS* cycle_cover_cons;
+        createBasicCycleCoverCons(scip, &cycle_cover_cons);
+        SCIPaddCons(scip, cycle_cover_cons);
+        SCIPreleaseCons(scip, &cycle_cover_cons);
+    }
+    NodeEventhdlr* node_eventhdlr = new NodeEventhdlr(scip);
+    SCIPincludeObjEventhdlr(scip, node_eventhdlr, TRUE);
+    setBranchingStrategy(scip, branching_strategy, branching_max_depth);
+    setBranchingRandomSeeds(scip);
+}
+
+SolverSession::~SolverSession() {
+    // the problem data points to the members, so free the problem first
+    SCIPfree(&scip);
+}
+
+void SolverSession::freeTransform() {
+    if (SCIPgetStage(scip) > SCIP_STAGE_PROBLEM) SCIPfreeTransform(scip);
+}
+
+PCTSPedge SolverSession::getEdge(PCTSPvertex u, PCTSPvertex v) {
+    auto n_vertices = boost::num_vertices(graph);
+    if (u >= n_vertices) throw VertexNotFoundException(std::to_string(u));
+    if (v >= n_vertices) throw VertexNotFoundException(std::to_string(v));
+    auto edge = boost::edge(u, v, graph);
+    if (!edge.second) throw EdgeNotFoundException(std::to_string(u), std::to_string(v));
+    return edge.first;
+}
+
+void SolverSession::updateEdgeCost(PCTSPvertex u, PCTSPvertex v, CostNumberType cost) {
+    auto edge = getEdge(u, v);
+    freeTransform();
+    cost_map[edge] = cost;
+    SCIPchgVarObj(scip, edge_variable_map[edge], cost);
+    ProbDataPCTSP* probdata = dynamic_cast<ProbDataPCTSP*>(SCIPgetObjProbData(scip));
+    auto dense_cost_map = probdata->getDenseCostMap();
+    if (dense_cost_map != NULL) dense_cost_map->setCost(u, v, cost);
+}
+
+void SolverSession::updateVertexPrize(PCTSPvertex vertex, PrizeNumberType prize) {
+    auto self_loop = getEdge(vertex, vertex);
+    freeTransform();
+    prize_map[vertex] = prize;
+    SCIP_CONS* prize_cons = SCIPfindOrigCons(scip, PRIZE_CONS_NAME.c_str());
+    SCIPchgCoefLinear(scip, prize_cons, edge_variable_map[self_loop], -prize);
+}
+
+void SolverSession::updateQuota(PrizeNumberType new_quota) {
+    freeTransform();
+    // the problem data points to the quota
+    quota = new_quota;
+    SCIPchgRhsLinear(scip, SCIPfindOrigCons(scip, PRIZE_CONS_NAME.c_str()), -quota);
+}
+
+SessionSolveStats SolverSession::solve() {
+    freeTransform();
+    auto sec_conshdlr = dynamic_cast<PCTSPconshdlrSubtour*>(SCIPfindObjConshdlr(scip, SEC_CONSHDLR_NAME.c_str()));
+    sec_conshdlr->addKeptSECsToProblem(scip);
+    std::size_t num_kept_secs = sec_conshdlr->getNumKeptSECs();
+    std::size_t num_kept_cycle_covers = 0;
+    if (cycle_cover) {
+        auto cycle_cover_conshdlr = dynamic_cast<CycleCoverConshdlr*>(SCIPfindObjConshdlr(scip, CYCLE_COVER_NAME.c_str()));
+        cycle_cover_conshdlr->addKeptCycleCoversToProblem(scip);
+        num_kept_cycle_covers = cycle_cover_conshdlr->getNumKeptCycleCovers();
+    }
+
+    // repair the previous best tour for the new costs, prizes and quota
+    auto heuristic_edges = warmStartEdges(graph, cost_map, prize_map, quota, root_vertex, best_tour);
+    double warm_start_cost = SCIPinfinity(scip);
+    if (heuristic_edges.size() > 0) {
+        warm_start_cost = totalCost(heuristic_edges, cost_map);
+        auto first = heuristic_edges.begin();
+        auto last = heuristic_edges.end();
+        SCIP_HEUR* heur = NULL;
+        addHeuristicEdgesToSolver(scip, graph, heur, edge_variable_map, first, last);
+    }
+
+    SCIPsetRealParam(scip, "limits/time", SCIPgetSolvingTime(scip) + time_limit);
+    double start_time = SCIPgetSolvingTime(scip);
+    SCIPsolve(scip);
+
+    SessionSolveStats stats = {
+        getSummaryStatsFromSCIP(scip), 0, std::vector<PCTSPedge>(), warm_start_cost,
+        num_kept_secs, num_kept_cycle_covers, SCIPgetSolvingTime(scip) - start_time
+    };
+    best_tour.clear();
+    if (SCIPgetNSols(scip) > 0) {
+        SCIP_SOL* sol = SCIPgetBestSol(scip);
+        stats.solution_edges = getSolutionEdges(scip, graph, sol, edge_variable_map);
+        auto vertices = getSolutionVertices(scip, graph, sol, edge_variable_map);
+        stats.prize = totalPrize(prize_map, vertices);
+        best_tour = tourFromCycleEdges(graph, stats.solution_edges, root_vertex);
+    }
+    BOOST_LOG_TRIVIAL(info) << "Session solve found a tour of cost " << stats.summary.upper_bound
+        << " from a warm start of cost " << warm_start_cost << " with " << num_kept_secs << " kept SECs.";
+    return stats;
+}
+
+PCTSPgraph& SolverSession::getGraph() {
+    return graph;
+}
+
+EdgeCostMap& SolverSession::getCostMap() {
+    return cost_map;
+}
+
+VertexPrizeMap& SolverSession::getPrizeMap() {
+    return prize_map;
+}
+
+PrizeNumberType SolverSession::getQuota() {
+    return quota;
+}
+
+SCIP* SolverSession::getSCIP() {
+    return scip;
+}
@@ -74,8 +74,7 @@ void logSolutionEdges(
     SCIP_SOL* sol,
     PCTSPedgeVariableMap& edge_variable_map
 ) {
-    for (auto edge : boost::make_iterator_range(boost::edges(graph))) {
-        auto var = edge_variable_map[edge];
+    for (auto const& [edge, var] : edge_variable_map) {
         auto value = SCIPgetSolVal(scip, sol, var);
         if (!(SCIPisZero(scip, value)) && (value > 0)) {
             auto source = boost::source(edge, graph);
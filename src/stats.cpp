@@ -16,6 +16,7 @@ void writeSummaryStatsToYaml(SummaryStats& summary, std::filesystem::path& filen
         node["num_nodes"] = summary.num_nodes;
         node["num_sec_disjoint_tour"] = summary.num_sec_disjoint_tour;
         node["num_sec_maxflow_mincut"] = summary.num_sec_maxflow_mincut;
+        node["num_sec_union_find"] = summary.num_sec_union_find;
         std::ofstream fout(filename.string());
         fout << node;
     }
@@ -37,7 +38,9 @@ SummaryStats readSummaryStatsFromYaml(std::filesystem::path& filename) {
         stats_yaml["num_cycle_cover"].as<unsigned int>(),
         stats_yaml["num_nodes"].as<long long>(),
         stats_yaml["num_sec_disjoint_tour"].as<unsigned int>(),
-        stats_yaml["num_sec_maxflow_mincut"].as<unsigned int>()
+        stats_yaml["num_sec_maxflow_mincut"].as<unsigned int>(),
+        // files written before union-find separation have no count
+        stats_yaml["num_sec_union_find"].as<unsigned int>(0)
     };
     return summary;
 }
@@ -58,6 +61,14 @@ unsigned int numMaxflowMincutSECs(std::vector<NodeStats>& node_stats) {
     return total;
 }
 
+unsigned int numUnionFindSECs(std::vector<NodeStats>& node_stats) {
+    unsigned int total = 0;
+    for (NodeStats& stat : node_stats) {
+        total += stat.num_sec_union_find;
+    }
+    return total;
+}
+
 void writeNodeStatsToCSV(std::vector<NodeStats>& node_stats, std::filesystem::path& file_path) {
     if (std::filesystem::exists(file_path.parent_path())) {
         std::ofstream csv_file(file_path.string());
@@ -73,6 +84,7 @@ void writeNodeStatsRow(NodeStats& node_stats, std::ofstream& csv_file) {
     csv_file << node_stats.node_id << ",";
     csv_file << node_stats.num_sec_disjoint_tour << ",";
     csv_file << node_stats.num_sec_maxflow_mincut << ",";
+    csv_file << node_stats.num_sec_union_find << ",";
     csv_file << node_stats.num_cost_cover_disjoint_paths << ",";
     csv_file << node_stats.num_cost_cover_shortest_paths << ",";
     csv_file << node_stats.num_cost_cover_steiner_tree << ",";
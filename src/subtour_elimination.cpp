@@ -6,6 +6,9 @@
 #include "pctsp/exception.hh"
 #include "pctsp/logger.hh"
 #include "pctsp/event_handlers.hh"
+#include "pctsp/pricing.hh"
+#include "pctsp/separation_controller.hh"
+#include <cmath>
 #include <boost/graph/push_relabel_max_flow.hpp>
 #include <boost/property_map/property_map.hpp>
 #include <boost/graph/strong_components.hpp>
@@ -69,7 +72,16 @@ SCIP_RETCODE addSubtourEliminationConstraint(
     }
 
     // get the set of edges contained in the subgraph induced over the vertex set
-    std::vector<PCTSPedge> edge_vector = getEdgesInducedByVertices(graph, vertex_set);
+    // models built without the PCTSP problem data have no dense cost map
+    ProbDataPCTSP* probdata = NULL;
+    if (SCIPgetProbData(scip) != NULL) probdata = dynamic_cast<ProbDataPCTSP*>(SCIPgetObjProbData(scip));
+    PCTSPdenseCostMap* dense_cost_map = probdata != NULL ? probdata->getDenseCostMap() : NULL;
+    std::vector<PCTSPedge> edge_vector;
+    if (dense_cost_map != NULL)
+        edge_vector = getEdgesInducedByVertices(graph, *dense_cost_map, vertex_set);
+    else
+        edge_vector = getEdgesInducedByVertices(graph, vertex_set);
+    edge_vector = filterEdgesWithVariables(edge_vector, edge_variable_map);
     VarVector edge_variables = getEdgeVariables(scip, graph, edge_variable_map, edge_vector);
 
     // get vertex variables
@@ -102,10 +114,56 @@ SCIP_RETCODE addSubtourEliminationConstraint(
     std::string cons_name = "SubtourElimination_" + joinVariableNames(all_vars);
     BOOST_LOG_TRIVIAL(debug) << std::to_string(edge_variables.size()) << " edge variables and " << std::to_string(vertex_variables.size()) << " vertex variables added to new subtour elimination constraint.";
 
+    // the SECs of a round are selected once every separator ran
+    auto objconshdlr = dynamic_cast<PCTSPconshdlrSubtour*>(SCIPgetObjConshdlr(scip, conshdlr));
+    if (objconshdlr != NULL && objconshdlr->isCollectingSECs()) {
+        objconshdlr->collectSEC(scip, sol, cons_name, all_vars, var_coefs, vertex_set, target_vertex);
+        return SCIP_OKAY;
+    }
+    return addSubtourEliminationRow(scip, conshdlr, vertex_set, target_vertex, all_vars, var_coefs, cons_name, sol, result);
+}
+
+SCIP_RETCODE addSubtourEliminationRow(
+    SCIP* scip,
+    SCIP_CONSHDLR* conshdlr,
+    std::vector<PCTSPvertex>& vertex_set,
+    PCTSPvertex target_vertex,
+    VarVector& all_vars,
+    std::vector<double>& var_coefs,
+    std::string& cons_name,
+    SCIP_SOL* sol,
+    SCIP_RESULT* result
+) {
+    auto objconshdlr = dynamic_cast<PCTSPconshdlrSubtour*>(SCIPgetObjConshdlr(scip, conshdlr));
+
     // create the subtour elimination constraint
     double lhs = -SCIPinfinity(scip);
     double rhs = 0;
-    return addRow(scip, conshdlr, result, sol, all_vars, var_coefs, lhs, rhs, cons_name);
+    SCIP_ROW* row = NULL;
+    if (objconshdlr == NULL || !objconshdlr->isManagingSECRows()) {
+        SCIP_CALL(addInducedEdgesRow(scip, conshdlr, result, sol, all_vars, var_coefs, lhs, rhs, cons_name, vertex_set, &row));
+        if (row != NULL) {
+            // the SEC stays valid when the quota changes
+            if (objconshdlr != NULL) objconshdlr->keepSEC(cons_name, all_vars, var_coefs);
+            SCIP_CALL(SCIPreleaseRow(scip, &row));
+        }
+        return SCIP_OKAY;
+    }
+
+    // skip the SEC if a nested SEC of the pool with the same target is violated as much
+    double violation = -rhs;
+    for (std::size_t i = 0; i < all_vars.size(); i++) violation += var_coefs[i] * SCIPgetSolVal(scip, sol, all_vars[i]);
+    auto& sec_row_pool = objconshdlr->getSECRowPool();
+    bool dominated;
+    SCIP_CALL(sec_row_pool.findDominatingRow(scip, sol, result, vertex_set, target_vertex, violation, dominated));
+    if (dominated) return SCIP_OKAY;
+    SCIP_CALL(addInducedEdgesRow(scip, conshdlr, result, sol, all_vars, var_coefs, lhs, rhs, cons_name, vertex_set, &row));
+    if (row != NULL) {
+        objconshdlr->keepSEC(cons_name, all_vars, var_coefs);
+        SCIP_CALL(sec_row_pool.addRow(scip, row, vertex_set, target_vertex));
+        SCIP_CALL(SCIPreleaseRow(scip, &row));
+    }
+    return SCIP_OKAY;
 }
  
 SCIP_RETCODE PCTSPcreateConsSubtour(
@@ -167,6 +225,275 @@ SCIP_RETCODE PCTSPcreateBasicConsSubtour(
     return SCIP_OKAY;
 }
 
+void PCTSPconshdlrSubtour::setKeepSECs(bool keep) {
+    keep_secs = keep;
+}
+
+void PCTSPconshdlrSubtour::keepSEC(std::string& name, VarVector& vars, std::vector<double>& var_coefs) {
+    if (!keep_secs || secs_added_to_problem.count(name) > 0) return;
+    kept_secs.emplace(name, std::make_pair(vars, var_coefs));
+}
+
+std::size_t PCTSPconshdlrSubtour::getNumKeptSECs() {
+    return kept_secs.size() + secs_added_to_problem.size();
+}
+
+std::map<std::string, std::pair<VarVector, std::vector<double>>>& PCTSPconshdlrSubtour::getKeptSECs() {
+    return kept_secs;
+}
+
+void PCTSPconshdlrSubtour::clearKeptSECs() {
+    kept_secs.clear();
+    secs_added_to_problem.clear();
+}
+
+SCIP_RETCODE PCTSPconshdlrSubtour::addKeptSECsToProblem(SCIP* scip) {
+    for (auto& [name, sec] : kept_secs) {
+        auto& [vars, var_coefs] = sec;
+        SCIP_CONS* cons;
+        SCIP_CALL(SCIPcreateConsLinear(scip, &cons, name.c_str(), vars.size(), vars.data(), var_coefs.data(),
+                                       -SCIPinfinity(scip), 0.0, FALSE, TRUE, TRUE, TRUE, FALSE, FALSE, FALSE,
+                                       FALSE, TRUE, FALSE));
+        SCIP_CALL(SCIPaddCons(scip, cons));
+        SCIP_CALL(SCIPreleaseCons(scip, &cons));
+        secs_added_to_problem.insert(name);
+    }
+    kept_secs.clear();
+    return SCIP_OKAY;
+}
+
+void PCTSPconshdlrSubtour::setCutSetBranching(bool branch_on_cut_sets) {
+    cutset_branching = branch_on_cut_sets;
+}
+
+void PCTSPconshdlrSubtour::recordNearViolatedSet(SCIP* scip, std::vector<PCTSPvertex>& vertex_set) {
+    if (!cutset_branching || vertex_set.size() == 0) return;
+    auto node_number = SCIPnodeGetNumber(SCIPgetCurrentNode(scip));
+    if (node_number != near_violated_sets_node) {
+        near_violated_sets.clear();
+        near_violated_sets_node = node_number;
+    }
+    near_violated_sets.push_back(vertex_set);
+}
+
+unsigned int PCTSPconshdlrSubtour::getNumCutSetBranchings() {
+    return num_cutset_branchings;
+}
+
+void PCTSPconshdlrSubtour::setCutSelection(int max_cuts_per_round, double max_parallelism) {
+    // a round that adds no SEC would end the cutting plane loop at a fractional LP
+    sec_max_cuts_per_round = max_cuts_per_round == 0 ? 1 : max_cuts_per_round;
+    sec_max_parallelism = max_parallelism;
+}
+
+bool PCTSPconshdlrSubtour::isSelectingCuts() {
+    return sec_max_cuts_per_round >= 0;
+}
+
+unsigned int PCTSPconshdlrSubtour::getNumAggregatedSECs() {
+    return num_aggregated_secs;
+}
+
+void PCTSPconshdlrSubtour::startCollectingSECs(const std::string& separator) {
+    collecting_secs = true;
+    sec_candidate_separator = separator;
+}
+
+bool PCTSPconshdlrSubtour::isCollectingSECs() {
+    return collecting_secs;
+}
+
+void PCTSPconshdlrSubtour::collectSEC(
+    SCIP* scip,
+    SCIP_SOL* sol,
+    std::string& name,
+    VarVector& vars,
+    std::vector<double>& var_coefs,
+    std::vector<PCTSPvertex>& vertex_set,
+    PCTSPvertex target
+) {
+    double violation = 0;
+    double norm = 0;
+    for (std::size_t i = 0; i < vars.size(); i++) {
+        violation += var_coefs[i] * SCIPgetSolVal(scip, sol, vars[i]);
+        norm += var_coefs[i] * var_coefs[i];
+    }
+    if (!SCIPisFeasPositive(scip, violation)) return;
+    std::vector<PCTSPvertex> sorted_vertex_set (vertex_set.begin(), vertex_set.end());
+    std::sort(sorted_vertex_set.begin(), sorted_vertex_set.end());
+    sec_candidates.push_back(
+        {name, vars, var_coefs, sorted_vertex_set, target, false, sec_candidate_separator, violation, violation / std::sqrt(norm)}
+    );
+}
+
+SCIP_RETCODE PCTSPconshdlrSubtour::addSelectedSECs(
+    SCIP* scip,
+    SCIP_CONSHDLR* conshdlr,
+    SCIP_SOL* sol,
+    SCIP_RESULT* result,
+    std::map<std::string, int>& num_selected
+) {
+    collecting_secs = false;
+    ProbDataPCTSP* probdata = dynamic_cast<ProbDataPCTSP*>(SCIPgetObjProbData(scip));
+    auto& root_vertex = *probdata->getRootVertex();
+
+    // propose the aggregated SEC of every set without the root that has several targets
+    std::map<std::vector<PCTSPvertex>, std::vector<SECCandidate*>> candidates_by_set;
+    for (auto& candidate : sec_candidates) {
+        if (!std::binary_search(candidate.vertex_set.begin(), candidate.vertex_set.end(), root_vertex))
+            candidates_by_set[candidate.vertex_set].push_back(&candidate);
+    }
+    std::vector<SECCandidate> aggregated_candidates;
+    for (auto& [vertex_set, candidates] : candidates_by_set) {
+        if (candidates.size() < 2) continue;
+        auto aggregated = aggregateSECs(scip, sol, candidates);
+        // pool the aggregated rows under the root, which is never the target of a SEC without the root
+        aggregated.target = root_vertex;
+        if (SCIPisFeasPositive(scip, aggregated.violation)) aggregated_candidates.push_back(aggregated);
+    }
+    sec_candidates.insert(sec_candidates.end(), aggregated_candidates.begin(), aggregated_candidates.end());
+
+    for (auto i : selectCuts(sec_candidates, sec_max_cuts_per_round, sec_max_parallelism)) {
+        auto& candidate = sec_candidates[i];
+        SCIP_CALL(addSubtourEliminationRow(
+            scip, conshdlr, candidate.vertex_set, candidate.target, candidate.vars, candidate.coefs, candidate.name, sol, result
+        ));
+        num_selected[candidate.separator]++;
+        if (candidate.aggregated) num_aggregated_secs++;
+    }
+    sec_candidates.clear();
+    return SCIP_OKAY;
+}
+
+void PCTSPconshdlrSubtour::setUnionFindSeparation(bool separate) {
+    sec_union_find = separate;
+}
+
+bool PCTSPconshdlrSubtour::isSeparatingUnionFind() {
+    return sec_union_find;
+}
+
+void PCTSPconshdlrSubtour::setShrinkSupportGraph(bool shrink) {
+    shrink_support_graph = shrink;
+}
+
+bool PCTSPconshdlrSubtour::isShrinkingSupportGraph() {
+    return shrink_support_graph;
+}
+
+void PCTSPconshdlrSubtour::recordMergedVertices(unsigned int num_merged) {
+    num_merged_vertices += num_merged;
+}
+
+unsigned int PCTSPconshdlrSubtour::getNumMergedVertices() {
+    return num_merged_vertices;
+}
+
+SCIP_RETCODE PCTSPconshdlrSubtour::setManageSECRows(SCIP* scip, bool manage, int max_age) {
+    manage_sec_rows = manage;
+    if (manage) {
+        SCIP_CALL(SCIPsetIntParam(scip, "lp/rowagelimit", max_age));
+        SCIP_CALL(includeSECPoolEventhdlr(scip, sec_row_pool));
+    }
+    return SCIP_OKAY;
+}
+
+bool PCTSPconshdlrSubtour::isManagingSECRows() {
+    return manage_sec_rows;
+}
+
+SECRowPool& PCTSPconshdlrSubtour::getSECRowPool() {
+    return sec_row_pool;
+}
+
+SCIP_RETCODE PCTSPconshdlrSubtour::branchOnCutSet(SCIP* scip, SCIP_RESULT* result) {
+    *result = SCIP_DIDNOTRUN;
+    // the cut of S would miss the edges priced at the children
+    if (SCIPgetNActivePricers(scip) > 0) return SCIP_OKAY;
+
+    ProbDataPCTSP* probdata = dynamic_cast<ProbDataPCTSP*>(SCIPgetObjProbData(scip));
+    auto& graph = *probdata->getInputGraph();
+    auto& edge_variable_map = *probdata->getEdgeVariableMap();
+    auto& root_vertex = *probdata->getRootVertex();
+
+    std::vector<std::vector<PCTSPvertex>> candidates;
+    if (near_violated_sets_node == SCIPnodeGetNumber(SCIPgetCurrentNode(scip)))
+        candidates = near_violated_sets;
+
+    // components of the support graph without the root are not entered by the LP
+    auto support_graph = filterGraphByPositiveEdgeVars(scip, graph, NULL, edge_variable_map);
+    std::vector< int > component(boost::num_vertices(support_graph));
+    int n_components = boost::connected_components(support_graph, &component[0]);
+    auto component_vectors = getConnectedComponentsVectors(support_graph, n_components, component);
+    int root_component_id = component[boost::get(vertex_index, support_graph)[root_vertex]];
+    for (int component_id = 0; component_id < n_components; component_id++) {
+        if (component_id != root_component_id) candidates.push_back(component_vectors[component_id]);
+    }
+
+    // the best set is cut off the furthest in both children
+    int best_set = -1;
+    double best_score = SCIPfeastol(scip);
+    std::vector<bool> in_set (boost::num_vertices(graph), false);
+    for (std::size_t i = 0; i < candidates.size(); i++) {
+        for (auto vertex : candidates[i]) in_set[vertex] = true;
+        if (!in_set[root_vertex]) {
+            double cut_value = 0;
+            double vertex_value = 0;
+            for (auto& [edge, var] : edge_variable_map) {
+                auto u = boost::source(edge, graph);
+                auto v = boost::target(edge, graph);
+                if (u == v && in_set[u]) vertex_value += SCIPgetSolVal(scip, NULL, var);
+                else if (in_set[u] != in_set[v]) cut_value += SCIPgetSolVal(scip, NULL, var);
+            }
+            double score = std::min(cut_value + vertex_value, 2.0 - cut_value);
+            if (score > best_score) {
+                best_set = i;
+                best_score = score;
+            }
+        }
+        for (auto vertex : candidates[i]) in_set[vertex] = false;
+    }
+    if (best_set < 0) return SCIP_OKAY;
+
+    auto& vertex_set = candidates[best_set];
+    for (auto vertex : vertex_set) in_set[vertex] = true;
+    std::vector<PCTSPedge> cut_edges;
+    for (auto& [edge, var] : edge_variable_map) {
+        auto u = boost::source(edge, graph);
+        auto v = boost::target(edge, graph);
+        if (u != v && in_set[u] != in_set[v]) cut_edges.push_back(edge);
+    }
+    auto self_loops = getSelfLoops(graph, vertex_set);
+    VarVector cut_vars = getEdgeVariables(scip, graph, edge_variable_map, cut_edges);
+    VarVector vertex_vars = getEdgeVariables(scip, graph, edge_variable_map, self_loops);
+    SCIP_CALL(SCIPgetTransformedVars(scip, cut_vars.size(), cut_vars.data(), cut_vars.data()));
+    SCIP_CALL(SCIPgetTransformedVars(scip, vertex_vars.size(), vertex_vars.data(), vertex_vars.data()));
+
+    // the tour visits S and crosses its cut at least twice
+    double estimate = SCIPgetLocalTransEstimate(scip);
+    SCIP_NODE* visit_child;
+    SCIP_CALL(SCIPcreateChild(scip, &visit_child, 1.0, estimate));
+    std::vector<double> cut_coefs (cut_vars.size(), 1.0);
+    std::string cons_name = "CutSetBranching_" + std::to_string(SCIPnodeGetNumber(visit_child));
+    SCIP_CONS* cons;
+    SCIP_CALL(SCIPcreateConsLinear(scip, &cons, cons_name.c_str(), cut_vars.size(), cut_vars.data(), cut_coefs.data(),
+                                   2.0, SCIPinfinity(scip), TRUE, TRUE, TRUE, TRUE, TRUE, TRUE, FALSE, FALSE,
+                                   FALSE, TRUE));
+    SCIP_CALL(SCIPaddConsNode(scip, visit_child, cons, NULL));
+    SCIP_CALL(SCIPreleaseCons(scip, &cons));
+
+    // the tour does not enter S
+    SCIP_NODE* avoid_child;
+    SCIP_CALL(SCIPcreateChild(scip, &avoid_child, 0.0, estimate));
+    for (auto var : cut_vars) SCIP_CALL(SCIPchgVarUbNode(scip, avoid_child, var, 0.0));
+    for (auto var : vertex_vars) SCIP_CALL(SCIPchgVarUbNode(scip, avoid_child, var, 0.0));
+
+    BOOST_LOG_TRIVIAL(debug) << "Branched on the cut of " << std::to_string(vertex_set.size()) << " vertices with " << std::to_string(cut_vars.size()) << " edges.";
+    num_cutset_branchings++;
+    *result = SCIP_BRANCHED;
+    return SCIP_OKAY;
+}
+
 SCIP_DECL_CONSCHECK(PCTSPconshdlrSubtour::scip_check)
 {
     auto nvars = SCIPgetNVars(scip);
@@ -205,19 +532,18 @@ SCIP_DECL_CONSENFOLP(PCTSPconshdlrSubtour::scip_enfolp) {
         *result = SCIP_FEASIBLE;
     }
     else {
-        SCIP_NODE* node = SCIPgetCurrentNode(scip);
-        double gap = SCIPcomputeGap(SCIPepsilon(scip), SCIPinfinity(scip), SCIPgetPrimalbound(scip), SCIPnodeGetLowerbound(node));
-        int node_id = SCIPnodeGetNumber(node);
-        if (node_id >= node_rolling_lp_gap.size()) {
-            auto new_size = node_id + 1;
-            node_rolling_lp_gap.resize(new_size);
-        }
-        pushIntoRollingLpGapList(node_rolling_lp_gap[node_id], gap, sec_max_tailing_off_iterations);
-        if (isNodeTailingOff(node_rolling_lp_gap[node_id], sec_lp_gap_improvement_threshold, sec_max_tailing_off_iterations)
+        // with cut-set branching, the gaps of the separation rounds of the node were kept by sepalp
+        double gap = recordLpGap(scip);
+        SCIP_Longint node_id = rolling_lp_gap_node;
+        if (isNodeTailingOff(rolling_lp_gap, sec_lp_gap_improvement_threshold, sec_max_tailing_off_iterations)
             && (SCIPgetLPSolstat(scip) == SCIP_LPSOLSTAT_UNBOUNDEDRAY || SCIPgetLPSolstat(scip) == SCIP_LPSOLSTAT_OPTIMAL)) {
             // resolve the infeasibility by branching
             BOOST_LOG_TRIVIAL(debug)<< "BRANCHING in enfolp: Node " << std::to_string(node_id) << " found to be tailing off. Gap is " << std::to_string(gap) << ". Threshold is " << std::to_string(sec_lp_gap_improvement_threshold) << std::endl;
-            SCIPbranchLP(scip, result);
+            *result = SCIP_DIDNOTRUN;
+            if (cutset_branching) SCIP_CALL(branchOnCutSet(scip, result));
+            if (*result != SCIP_BRANCHED) SCIP_CALL(SCIPbranchLP(scip, result));
+            // an integral LP has no branching candidates
+            if (*result != SCIP_BRANCHED) *result = SCIP_INFEASIBLE;
         }
         else {
             // resolve the infeasibility by adding a subtour elimination constraint
@@ -294,14 +620,90 @@ bool isNodeTailingOff(
 }
 
 
+double PCTSPconshdlrSubtour::recordLpGap(SCIP* scip) {
+    SCIP_NODE* node = SCIPgetCurrentNode(scip);
+    double gap = SCIPcomputeGap(SCIPepsilon(scip), SCIPinfinity(scip), SCIPgetPrimalbound(scip), SCIPnodeGetLowerbound(node));
+    SCIP_Longint node_id = SCIPnodeGetNumber(node);
+    // a node is processed in one go, so only the gaps of the current node are kept
+    if (node_id != rolling_lp_gap_node) {
+        rolling_lp_gap.clear();
+        rolling_lp_gap_node = node_id;
+    }
+    // enforcement after the last separation round sees the same LP
+    else if (SCIPgetNLPs(scip) == rolling_lp_gap_lp) return gap;
+    rolling_lp_gap_lp = SCIPgetNLPs(scip);
+    pushIntoRollingLpGapList(rolling_lp_gap, gap, sec_max_tailing_off_iterations);
+    return gap;
+}
+
 SCIP_DECL_CONSSEPALP(PCTSPconshdlrSubtour::scip_sepalp) {
     *result = SCIP_DIDNOTFIND;
-    SCIP_CALL(PCTSPseparateSubtour(scip, conshdlr, conss, nconss, nusefulconss, NULL, result, sec_disjoint_tour, sec_maxflow_mincut));
+    // only cut-set branching counts the separation rounds towards tailing off
+    if (cutset_branching) recordLpGap(scip);
+    SCIP_CALL(PCTSPseparateSubtour(scip, conshdlr, conss, nconss, nusefulconss, NULL, result, sec_disjoint_tour, sec_maxflow_mincut, sec_union_find));
+    return SCIP_OKAY;
+}
+
+SCIP_DECL_CONSINITSOL(PCTSPconshdlrSubtour::scip_initsol) {
+    // node ids restart at every solve, so forget the LP gaps of the last solve
+    rolling_lp_gap.clear();
+    rolling_lp_gap_node = -1;
+    rolling_lp_gap_lp = -1;
+    near_violated_sets.clear();
+    near_violated_sets_node = -1;
+    num_cutset_branchings = 0;
+    num_aggregated_secs = 0;
+    num_merged_vertices = 0;
+    return SCIP_OKAY;
+}
+
+SCIP_DECL_CONSEXITSOL(PCTSPconshdlrSubtour::scip_exitsol) {
+    // the rows belong to the transformed problem
+    SCIP_CALL(sec_row_pool.clear(scip));
     return SCIP_OKAY;
 }
 
 SCIP_DECL_CONSSEPASOL(PCTSPconshdlrSubtour::scip_sepasol) {
-    SCIP_CALL(PCTSPseparateSubtour(scip, conshdlr, conss, nconss, nusefulconss, sol, result, sec_disjoint_tour, sec_maxflow_mincut));
+    SCIP_CALL(PCTSPseparateSubtour(scip, conshdlr, conss, nconss, nusefulconss, sol, result, sec_disjoint_tour, sec_maxflow_mincut, sec_union_find));
+    return SCIP_OKAY;
+}
+
+SCIP_RETCODE PCTSPseparateUnionFind(
+    SCIP* scip,
+    SCIP_CONSHDLR* conshdlr,
+    PCTSPgraph& input_graph,
+    PCTSPedgeVariableMap& edge_variable_map,
+    PCTSPvertex& root_vertex,
+    SCIP_SOL* sol,
+    SCIP_RESULT* result,
+    int& num_conss_added
+) {
+    // LP values of the self loops and of the other support edges
+    std::vector<double> vertex_values (boost::num_vertices(input_graph), 0.0);
+    VertexPairVector edges;
+    std::vector<double> edge_values;
+    for (auto& [edge, var] : edge_variable_map) {
+        double value = SCIPgetSolVal(scip, sol, var);
+        auto u = boost::source(edge, input_graph);
+        auto v = boost::target(edge, input_graph);
+        if (u == v)
+            vertex_values[u] = value;
+        else if (SCIPisFeasPositive(scip, value)) {
+            edges.push_back({u, v});
+            edge_values.push_back(value);
+        }
+    }
+    auto violated_sets = unionFindViolatedSets(
+        boost::num_vertices(input_graph), edges, edge_values, vertex_values, root_vertex, SCIPfeastol(scip)
+    );
+    for (auto& violated : violated_sets) {
+        for (auto target_vertex : violated.targets) {
+            SCIP_CALL(addSubtourEliminationConstraint(
+                scip, conshdlr, input_graph, violated.vertex_set, edge_variable_map, root_vertex, target_vertex, sol, result
+            ));
+            num_conss_added ++;
+        }
+    }
     return SCIP_OKAY;
 }
 
@@ -340,6 +742,43 @@ SCIP_RETCODE PCTSPseparateMaxflowMincut(
             root_edge_vector.push_back(pair);
         }
     }
+    // flows run on the shrunk support graph and cuts are expanded to the merged vertices
+    auto objconshdlr = dynamic_cast<PCTSPconshdlrSubtour*>(SCIPgetObjConshdlr(scip, conshdlr));
+    std::map<PCTSPvertex, std::vector<PCTSPvertex>> members;
+    if (objconshdlr != NULL && objconshdlr->isShrinkingSupportGraph()) {
+        std::vector<double> vertex_values (boost::num_vertices(input_graph), 0.0);
+        for (auto vertex : root_component) {
+            auto [self_loop, found] = boost::edge(vertex, vertex, input_graph);
+            if (found && edge_variable_map.count(self_loop) > 0)
+                vertex_values[vertex] = SCIPgetSolVal(scip, sol, edge_variable_map[self_loop]);
+        }
+        VertexPairVector edges;
+        std::vector<double> edge_values;
+        for (auto pair : root_edge_vector) {
+            auto [edge, found] = boost::edge(pair.first, pair.second, input_graph);
+            if (pair.first == pair.second || !found || edge_variable_map.count(edge) == 0) continue;
+            edges.push_back(pair);
+            edge_values.push_back(SCIPgetSolVal(scip, sol, edge_variable_map[edge]));
+        }
+        auto shrunk = shrinkSupportGraph(edges, edge_values, vertex_values, root_vertex, SCIPfeastol(scip));
+        root_edge_vector = shrunk.edges;
+        capacity_vector.clear();
+        for (double value : shrunk.edge_values) capacity_vector.push_back(capacityFromValue(scip, value));
+        members = shrunk.members;
+        for (auto& [representative, merged] : members) objconshdlr->recordMergedVertices(merged.size() - 1);
+        // the root component has no support edges
+        if (root_edge_vector.size() == 0) return SCIP_OKAY;
+    }
+    auto expand = [&members](std::vector<PCTSPvertex> vertices) {
+        if (members.size() == 0) return vertices;
+        std::vector<PCTSPvertex> expanded;
+        for (auto vertex : vertices) {
+            auto it = members.find(vertex);
+            if (it == members.end()) expanded.push_back(vertex);
+            else expanded.insert(expanded.end(), it->second.begin(), it->second.end());
+        }
+        return expanded;
+    };
     // create mapping from input vertices to support vertices (they will be renamed)
     typedef boost::graph_traits<DirectedCapacityGraph>::vertex_descriptor SupportVertex;
     boost::bimap<SupportVertex, PCTSPvertex> lookup;
@@ -380,6 +819,7 @@ SCIP_RETCODE PCTSPseparateMaxflowMincut(
         added_sec[support_root] = true;
     else
         BOOST_LOG_TRIVIAL(debug) << "Num vertices in support graph is zero.";
+    // near-violated cuts of the LP are candidates for branching on cut sets
     for (auto target : boost::make_iterator_range(boost::vertices(support_graph))) {
         if (!added_sec[target]) {
             // reset the residual capacity
@@ -388,24 +828,29 @@ SCIP_RETCODE PCTSPseparateMaxflowMincut(
             }
             auto flow = boost::push_relabel_max_flow(support_graph, support_root, target, capacity_property, residual_capacity, reverse_edges, vindex);
 
+            if (sol == NULL && objconshdlr != NULL && flow < (2 + CUTSET_BRANCHING_NEAR_VIOLATION) * FLOW_FLOAT_MULTIPLIER) {
+                auto unreachable = getUnreachableVertices(support_graph, support_root, residual_capacity);
+                auto near_violated_set = expand(getOldVertices(lookup, unreachable));
+                objconshdlr->recordNearViolatedSet(scip, near_violated_set);
+            }
             if (flow < 2 * FLOW_FLOAT_MULTIPLIER) {
                 // traverse the residual graph from the root
                 // all vertices that are reachable on edges that have some flow are on one side of the cut
                 // all edges that are not reachable by the flow are on the other side of the cut
                 std::vector<PCTSPvertex> input_vertices;
                 auto unreachable = getUnreachableVertices(support_graph, support_root, residual_capacity);
-                if (unreachable.size() >= 3) {   // do not add SEC for small groups of vertices
+                auto unreachable_vertices = expand(getOldVertices(lookup, unreachable));
+                if (unreachable_vertices.size() >= 3) {   // do not add SEC for small groups of vertices
                     // the component not containing the root violates the subtour elimination constraint
-                    BOOST_LOG_TRIVIAL(debug) << std::to_string(unreachable.size()) << " vertices are unreachable from root of the residual graph.";
-                    input_vertices = getOldVertices(lookup, unreachable);
+                    BOOST_LOG_TRIVIAL(debug) << std::to_string(unreachable_vertices.size()) << " vertices are unreachable from root of the residual graph.";
+                    input_vertices = unreachable_vertices;
                 }
                 else {  // unreachable size is less than 3
                     auto reachable = getReachableVertices(support_graph, support_root, residual_capacity);
-                    input_vertices = getOldVertices(lookup, reachable);
+                    input_vertices = expand(getOldVertices(lookup, reachable));
                 }
-                for (auto &unreachable_vertex: unreachable) {
+                for (auto &input_target_vertex: unreachable_vertices) {
                     // for each unreachable vertex add a subtour elimination constraint
-                    auto input_target_vertex = getOldVertex(lookup, unreachable_vertex);
                     SCIP_CALL(addSubtourEliminationConstraint(
                         scip,
                         conshdlr,
@@ -418,9 +863,9 @@ SCIP_RETCODE PCTSPseparateMaxflowMincut(
                         result
                     ));
                     num_conss_added ++;
-                    // mark the unreachable target vertex to remember we have already added a SEC
-                    added_sec[getNewVertex(lookup, input_target_vertex)] = true;
                 }
+                // mark the unreachable target vertices to remember we have already added a SEC
+                for (auto& unreachable_vertex : unreachable) added_sec[unreachable_vertex] = true;
             }
         }
     }
@@ -436,7 +881,8 @@ SCIP_RETCODE PCTSPseparateSubtour(
     SCIP_SOL* sol,                /**< primal solution that should be separated */
     SCIP_RESULT* result,              /**< pointer to store the result of the separation call */
     bool sec_disjoint_tour,
-    bool sec_maxflow_mincut
+    bool sec_maxflow_mincut,
+    bool sec_union_find
 ) {
     // load the constraint handler data
     ProbDataPCTSP* probdata = dynamic_cast<ProbDataPCTSP*>(SCIPgetObjProbData(scip));
@@ -460,26 +906,67 @@ SCIP_RETCODE PCTSPseparateSubtour(
         node_eventhdlr_ready = true;
     }
 
-    if (sec_disjoint_tour) {
+    // pooled SECs that the LP violates are added before any SEC is separated
+    auto objconshdlr = dynamic_cast<PCTSPconshdlrSubtour*>(SCIPgetObjConshdlr(scip, conshdlr));
+    int num_pooled_secs_added = 0;
+    if (sol == NULL && objconshdlr != NULL && objconshdlr->isManagingSECRows()) {
+        SCIP_CALL(objconshdlr->getSECRowPool().separate(scip, sol, result, num_pooled_secs_added));
+    }
 
-        int num_disjoint_tour_secs_added = 0;
+    // only LP separation is throttled
+    SeparationController* controller = sol == NULL ? findSeparationController(scip) : NULL;
+    bool selecting_cuts = objconshdlr != NULL && objconshdlr->isSelectingCuts();
+    int num_disjoint_tour_secs_added = 0;
+    if (sec_disjoint_tour && (controller == NULL || controller->shouldRun(DISJOINT_TOUR_SEPARATOR, !sec_maxflow_mincut))) {
+        double start = SCIPgetSolvingTime(scip);
+        if (selecting_cuts) objconshdlr->startCollectingSECs(DISJOINT_TOUR_SEPARATOR);
         PCTSPseparateDisjointTour(
             scip, conshdlr, input_graph, edge_variable_map, root_vertex, component_vectors, sol, result, root_component_id, num_disjoint_tour_secs_added
         );
-        if (node_eventhdlr_ready) node_eventhdlr->incrementNumSecDisjointTour(scip, num_disjoint_tour_secs_added);
+        if (controller != NULL) controller->recordCall(DISJOINT_TOUR_SEPARATOR, SCIPgetSolvingTime(scip) - start, num_disjoint_tour_secs_added);
+    }
+    // the components of the support graph are the last sets merged by union-find,
+    // so union-find only runs when disjoint tour separation found nothing
+    int num_union_find_secs_added = 0;
+    if (sec_union_find && num_disjoint_tour_secs_added == 0 && (controller == NULL || controller->shouldRun(UNION_FIND_SEPARATOR, !sec_maxflow_mincut))) {
+        double start = SCIPgetSolvingTime(scip);
+        if (selecting_cuts) objconshdlr->startCollectingSECs(UNION_FIND_SEPARATOR);
+        SCIP_CALL(PCTSPseparateUnionFind(
+            scip, conshdlr, input_graph, edge_variable_map, root_vertex, sol, result, num_union_find_secs_added
+        ));
+        if (controller != NULL) controller->recordCall(UNION_FIND_SEPARATOR, SCIPgetSolvingTime(scip) - start, num_union_find_secs_added);
     }
-    if (sec_maxflow_mincut)
+    // max flow always runs when the pool, disjoint tour and union-find separation found nothing
+    int num_maxflow_mincut_secs_added = 0;
+    if (sec_maxflow_mincut && num_pooled_secs_added > 0) objconshdlr->getSECRowPool().recordSkippedMaxflow();
+    bool heuristics_found_secs = num_disjoint_tour_secs_added > 0 || num_union_find_secs_added > 0;
+    if (sec_maxflow_mincut && num_pooled_secs_added == 0 && num_union_find_secs_added == 0
+        && (controller == NULL || controller->shouldRun(MAXFLOW_MINCUT_SEPARATOR, !heuristics_found_secs)))
     {
+        double start = SCIPgetSolvingTime(scip);
+        if (selecting_cuts) objconshdlr->startCollectingSECs(MAXFLOW_MINCUT_SEPARATOR);
         // create a set from the root component vector
         std::set<PCTSPvertex> root_component;
         std::copy(component_vectors[root_component_id].begin(), component_vectors[root_component_id].end(), std::inserter(root_component, root_component.begin()));
     
         // separate SEC using maxflow mincut
-        int num_maxflow_mincut_secs_added = 0;
         PCTSPseparateMaxflowMincut(
             scip, conshdlr, input_graph, edge_variable_map, root_vertex, sol, result, root_component, num_maxflow_mincut_secs_added
         );
-        if (node_eventhdlr_ready) node_eventhdlr->incrementNumSecMaxflowMincut(scip, num_maxflow_mincut_secs_added);
+        if (controller != NULL) controller->recordCall(MAXFLOW_MINCUT_SEPARATOR, SCIPgetSolvingTime(scip) - start, num_maxflow_mincut_secs_added);
+    }
+    // count the selected SECs rather than the proposed SECs
+    if (selecting_cuts) {
+        std::map<std::string, int> num_selected;
+        SCIP_CALL(objconshdlr->addSelectedSECs(scip, conshdlr, sol, result, num_selected));
+        num_disjoint_tour_secs_added = num_selected[DISJOINT_TOUR_SEPARATOR];
+        num_maxflow_mincut_secs_added = num_selected[MAXFLOW_MINCUT_SEPARATOR];
+        num_union_find_secs_added = num_selected[UNION_FIND_SEPARATOR];
+    }
+    if (node_eventhdlr_ready) {
+        node_eventhdlr->incrementNumSecDisjointTour(scip, num_disjoint_tour_secs_added);
+        node_eventhdlr->incrementNumSecMaxflowMincut(scip, num_maxflow_mincut_secs_added);
+        node_eventhdlr->incrementNumSecUnionFind(scip, num_union_find_secs_added);
     }
     return SCIP_OKAY;
 }
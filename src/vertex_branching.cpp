@@ -0,0 +1,206 @@
+/** Branching on the vertices of the prize collecting TSP */
+
+#include <algorithm>
+#include <limits>
+#include <boost/graph/dijkstra_shortest_paths.hpp>
+
+#include "pctsp/vertex_branching.hh"
+#include "pctsp/data_structures.hh"
+
+double vertexBranchingScore(
+    double lp_value,
+    double relative_prize,
+    double relative_distance,
+    double pseudo_cost_down,
+    double pseudo_cost_up
+) {
+    double down_gain = std::max(lp_value * pseudo_cost_down, 1e-6);
+    double up_gain = std::max((1.0 - lp_value) * pseudo_cost_up, 1e-6);
+    return down_gain * up_gain * (1.0 + relative_prize) * (1.0 + relative_distance);
+}
+
+VertexPseudoCost VertexBranchrule::getVertexPseudoCost(PCTSPvertex vertex) {
+    if (vertex >= pseudo_costs_.size()) return {0, 0, 0, 0};
+    return pseudo_costs_[vertex];
+}
+
+double VertexBranchrule::getPseudoCost(PCTSPvertex vertex, bool up) {
+    auto& pseudo_cost = pseudo_costs_[vertex];
+    if (up && pseudo_cost.num_up > 0) return pseudo_cost.up_gain_sum / pseudo_cost.num_up;
+    if (!up && pseudo_cost.num_down > 0) return pseudo_cost.down_gain_sum / pseudo_cost.num_down;
+
+    // vertices that were never branched on use the average of the others
+    double gain_sum = 0;
+    unsigned int num_gains = 0;
+    for (auto& other : pseudo_costs_) {
+        gain_sum += up ? other.up_gain_sum : other.down_gain_sum;
+        num_gains += up ? other.num_up : other.num_down;
+    }
+    if (num_gains == 0) return 1.0;
+    return gain_sum / num_gains;
+}
+
+void VertexBranchrule::resetPseudoCosts(std::size_t num_vertices) {
+    pseudo_costs_.assign(num_vertices, {0, 0, 0, 0});
+    child_branchings_.clear();
+}
+
+void VertexBranchrule::recordChildBranching(SCIP_Longint node_number, VertexBranching branching) {
+    child_branchings_[node_number] = branching;
+}
+
+void VertexBranchrule::updatePseudoCost(SCIP_Longint node_number, double lp_bound) {
+    auto it = child_branchings_.find(node_number);
+    if (it == child_branchings_.end()) return;
+    auto& branching = it->second;
+    double gain = std::max(lp_bound - branching.parent_bound, 0.0) / branching.change;
+    auto& pseudo_cost = pseudo_costs_[branching.vertex];
+    if (branching.up) {
+        pseudo_cost.up_gain_sum += gain;
+        pseudo_cost.num_up++;
+    }
+    else {
+        pseudo_cost.down_gain_sum += gain;
+        pseudo_cost.num_down++;
+    }
+    child_branchings_.erase(it);
+}
+
+SCIP_DECL_BRANCHINITSOL(VertexBranchrule::scip_initsol) {
+    ProbDataPCTSP* probdata = dynamic_cast<ProbDataPCTSP*>(SCIPgetObjProbData(scip));
+    PCTSPgraph& graph = *probdata->getInputGraph();
+    PCTSPvertex root_vertex = *probdata->getRootVertex();
+    auto n_vertices = boost::num_vertices(graph);
+
+    // prizes and distances from the root relative to the largest of the graph
+    auto prize_map = boost::get(vertex_distance, graph);
+    std::vector<CostNumberType> distances (n_vertices);
+    auto vindex = boost::get(boost::vertex_index, graph);
+    boost::dijkstra_shortest_paths(
+        graph, root_vertex, boost::distance_map(boost::make_iterator_property_map(distances.begin(), vindex))
+    );
+    PrizeNumberType max_prize = 0;
+    CostNumberType max_distance = 0;
+    for (auto vertex : boost::make_iterator_range(boost::vertices(graph))) {
+        max_prize = std::max(max_prize, prize_map[vertex]);
+        if (distances[vertex] < std::numeric_limits<CostNumberType>::max()) {
+            max_distance = std::max(max_distance, distances[vertex]);
+        }
+    }
+    relative_prizes_.assign(n_vertices, 0.0);
+    relative_distances_.assign(n_vertices, 1.0);
+    for (auto vertex : boost::make_iterator_range(boost::vertices(graph))) {
+        if (max_prize > 0) relative_prizes_[vertex] = (double) prize_map[vertex] / max_prize;
+        if (max_distance > 0 && distances[vertex] <= max_distance) {
+            relative_distances_[vertex] = (double) distances[vertex] / max_distance;
+        }
+    }
+
+    var_edges_.clear();
+    for (auto& [edge, var] : *probdata->getEdgeVariableMap()) {
+        SCIP_VAR* transvar;
+        SCIP_CALL(SCIPgetTransformedVar(scip, var, &transvar));
+        if (transvar != NULL) var_edges_[transvar] = edge;
+    }
+    resetPseudoCosts(n_vertices);
+    return SCIP_OKAY;
+}
+
+SCIP_DECL_BRANCHEXECLP(VertexBranchrule::scip_execlp) {
+    ProbDataPCTSP* probdata = dynamic_cast<ProbDataPCTSP*>(SCIPgetObjProbData(scip));
+    PCTSPgraph& graph = *probdata->getInputGraph();
+    PCTSPvertex root_vertex = *probdata->getRootVertex();
+    updatePseudoCost(SCIPnodeGetNumber(SCIPgetCurrentNode(scip)), SCIPgetLPObjval(scip));
+
+    SCIP_VAR** cands;
+    SCIP_Real* cands_sol;
+    int n_cands;
+    SCIP_CALL(SCIPgetLPBranchCands(scip, &cands, &cands_sol, NULL, &n_cands, NULL, NULL));
+
+    int best_cand = -1;
+    PCTSPvertex best_vertex = 0;
+    double best_score = -1;
+    for (int i = 0; i < n_cands; i++) {
+        auto it = var_edges_.find(cands[i]);
+        if (it == var_edges_.end()) continue;
+        auto vertex = boost::source(it->second, graph);
+        if (vertex != boost::target(it->second, graph) || vertex == root_vertex) continue;
+        double score = vertexBranchingScore(
+            cands_sol[i], relative_prizes_[vertex], relative_distances_[vertex],
+            getPseudoCost(vertex, false), getPseudoCost(vertex, true)
+        );
+        if (score > best_score || (score == best_score && vertex < best_vertex)) {
+            best_cand = i;
+            best_vertex = vertex;
+            best_score = score;
+        }
+    }
+    if (best_cand < 0) return branchOnRootComponentEdge(scip, result);
+
+    SCIP_NODE* down_child;
+    SCIP_NODE* eq_child;
+    SCIP_NODE* up_child;
+    SCIP_CALL(SCIPbranchVar(scip, cands[best_cand], &down_child, &eq_child, &up_child));
+    double bound = SCIPgetLPObjval(scip);
+    double lp_value = cands_sol[best_cand];
+    if (down_child != NULL) recordChildBranching(SCIPnodeGetNumber(down_child), {best_vertex, false, bound, lp_value});
+    if (up_child != NULL) recordChildBranching(SCIPnodeGetNumber(up_child), {best_vertex, true, bound, 1.0 - lp_value});
+    *result = SCIP_BRANCHED;
+    return SCIP_OKAY;
+}
+
+SCIP_RETCODE VertexBranchrule::branchOnRootComponentEdge(SCIP* scip, SCIP_RESULT* result) {
+    ProbDataPCTSP* probdata = dynamic_cast<ProbDataPCTSP*>(SCIPgetObjProbData(scip));
+    PCTSPgraph& graph = *probdata->getInputGraph();
+    PCTSPvertex root_vertex = *probdata->getRootVertex();
+    PCTSPedgeVariableMap& edge_variable_map = *probdata->getEdgeVariableMap();
+
+    // vertices reached from the root by edges with LP value one
+    std::vector<bool> in_component (boost::num_vertices(graph), false);
+    std::vector<PCTSPvertex> stack = {root_vertex};
+    in_component[root_vertex] = true;
+    while (stack.size() > 0) {
+        auto u = stack.back();
+        stack.pop_back();
+        for (auto edge : boost::make_iterator_range(boost::out_edges(u, graph))) {
+            auto v = boost::target(edge, graph);
+            if (in_component[v] || edge_variable_map.count(edge) == 0) continue;
+            if (SCIPisFeasEQ(scip, SCIPgetSolVal(scip, NULL, edge_variable_map[edge]), 1.0)) {
+                in_component[v] = true;
+                stack.push_back(v);
+            }
+        }
+    }
+
+    SCIP_VAR** cands;
+    SCIP_Real* cands_sol;
+    int n_cands;
+    SCIP_CALL(SCIPgetLPBranchCands(scip, &cands, &cands_sol, NULL, &n_cands, NULL, NULL));
+    int best_cand = -1;
+    double best_fractionality = -1;
+    for (int i = 0; i < n_cands; i++) {
+        auto it = var_edges_.find(cands[i]);
+        if (it == var_edges_.end()) continue;
+        auto u = boost::source(it->second, graph);
+        auto v = boost::target(it->second, graph);
+        if (in_component[u] == in_component[v]) continue;
+        double fractionality = std::min(cands_sol[i], 1.0 - cands_sol[i]);
+        if (fractionality > best_fractionality || (fractionality == best_fractionality
+            && SCIPvarGetObj(cands[i]) > SCIPvarGetObj(cands[best_cand]))) {
+            best_cand = i;
+            best_fractionality = fractionality;
+        }
+    }
+    if (best_cand < 0) {
+        *result = SCIP_DIDNOTRUN;
+        return SCIP_OKAY;
+    }
+    SCIP_CALL(SCIPbranchVar(scip, cands[best_cand], NULL, NULL, NULL));
+    *result = SCIP_BRANCHED;
+    return SCIP_OKAY;
+}
+
+SCIP_RETCODE includeVertexBranchrule(SCIP* scip) {
+    if (SCIPfindBranchrule(scip, VERTEX_BRANCHRULE_NAME.c_str()) != NULL) return SCIP_OKAY;
+    return SCIPincludeObjBranchrule(scip, new VertexBranchrule(scip), TRUE);
+}
@@ -205,6 +205,38 @@ TEST_P(AlgorithmsFixture, testModelPrizeCollectingTSP) {
     EXPECT_EQ(SCIPgetNVars(scip), boost::num_edges(graph));
 }
 
+/** Run the model with an optional lower bound on the cost and return the optimal cost */
+double solveWithCostLowerBound(PCTSPgraph& graph, EdgeCostMap& cost_map, VertexPrizeMap& prize_map, int quota, PCTSPvertex root_vertex, double lower_bound) {
+    SCIP* scip = NULL;
+    SCIPcreate(&scip);
+    std::vector<PCTSPedge> heuristic_edges;
+    std::string name = "testCostLowerBound";
+    modelPrizeCollectingTSP(scip, graph, heuristic_edges, cost_map, prize_map, quota, root_vertex, name);
+    SCIPsetMessagehdlrQuiet(scip, TRUE);
+    if (lower_bound > 0) includeCostLowerBound(scip, lower_bound);
+    SCIPsolve(scip);
+    EXPECT_EQ(SCIPgetStatus(scip), SCIP_STATUS_OPTIMAL);
+    // every cost is a multiple of ten, so presolve scales the objective
+    EXPECT_NE(SCIPgetTransObjscale(scip), 1.0);
+    double optimal_cost = SCIPgetNSols(scip) > 0 ? SCIPgetPrimalbound(scip) : -1.0;
+    SCIPfree(&scip);
+    return optimal_cost;
+}
+
+TEST_P(AlgorithmsFixture, testCostLowerBoundWithScaledObjective) {
+    auto graph = getGraph();
+    auto quota = getQuota();
+    auto root_vertex = getRootVertex();
+    auto cost_map = getCostMap(graph);
+    auto prize_map = getPrizeMap(graph);
+    for (auto edge : boost::make_iterator_range(boost::edges(graph))) cost_map[edge] *= 10;
+
+    // a bound equal to the optimal cost must not cut off the optimal tour
+    double optimal_cost = solveWithCostLowerBound(graph, cost_map, prize_map, quota, root_vertex, 0.0);
+    EXPECT_GT(optimal_cost, 0.0);
+    EXPECT_DOUBLE_EQ(solveWithCostLowerBound(graph, cost_map, prize_map, quota, root_vertex, optimal_cost), optimal_cost);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     TestAlgorithms,
     AlgorithmsFixture,
@@ -15,7 +15,19 @@ from tspwplib import (
     total_prize_of_tour,
     walk_from_edge_list,
 )
-from pctsp.algorithms import random_tour_complete_graph, solve_pctsp, SummaryStats
+from pctsp.algorithms import (
+    lagrangian_bound,
+    parallel_solve,
+    portfolio_solve,
+    quota_sweep,
+    random_tour_complete_graph,
+    root_relaxation,
+    solve_pctsp,
+    SolverPool,
+    SolverSession,
+    SolverVariant,
+    SummaryStats,
+)
 from pctsp.constants import PCTSP_SUMMARY_STATS_YAML
 from pctsp.preprocessing import vertex_disjoint_cost_map
 from pctsp.suurballe import suurballe_shortest_vertex_disjoint_paths
@@ -56,6 +68,308 @@ def test_pctsp_on_suurballes_graph(
     assert model.getStatus() == "optimal"
 
 
+def test_pctsp_dual_ascent_on_suurballes_graph(
+    suurballes_undirected_graph, root, logger_dir, time_limit
+):
+    """Test the solver finds the optimal tour after dual ascent removes edges"""
+    quota = 6
+    name = "test_pctsp_dual_ascent_on_suurballes_graph"
+    model = Model(problemName=name, createscip=True, defaultPlugins=False)
+    edge_list = solve_pctsp(
+        model,
+        suurballes_undirected_graph,
+        [],
+        quota,
+        root,
+        dual_ascent=True,
+        name=name,
+        solver_dir=logger_dir,
+        time_limit=time_limit,
+    )
+    ordered_edges = reorder_edge_list_from_root(order_edge_list(edge_list), root)
+    optimal_tour = walk_from_edge_list(ordered_edges)
+    assert is_pctsp_yes_instance(
+        suurballes_undirected_graph, quota, root, ordered_edges
+    )
+    assert total_cost_networkx(suurballes_undirected_graph, optimal_tour) == 20
+    assert (
+        model.getNVars()
+        <= suurballes_undirected_graph.number_of_edges()
+        + suurballes_undirected_graph.number_of_nodes()
+    )
+    assert model.getStatus() == "optimal"
+
+
+def test_pctsp_lagrangian_fixing_on_suurballes_graph(
+    suurballes_undirected_graph, root, logger_dir, time_limit
+):
+    """Test the solver finds the optimal tour after the Lagrangian bound fixes variables"""
+    quota = 6
+    name = "test_pctsp_lagrangian_fixing_on_suurballes_graph"
+    model = Model(problemName=name, createscip=True, defaultPlugins=False)
+    edge_list = solve_pctsp(
+        model,
+        suurballes_undirected_graph,
+        [],
+        quota,
+        root,
+        lagrangian_fixing=True,
+        name=name,
+        solver_dir=logger_dir,
+        time_limit=time_limit,
+    )
+    ordered_edges = reorder_edge_list_from_root(order_edge_list(edge_list), root)
+    optimal_tour = walk_from_edge_list(ordered_edges)
+    assert total_cost_networkx(suurballes_undirected_graph, optimal_tour) == 20
+    assert model.getStatus() == "optimal"
+
+
+def test_pctsp_managed_sec_rows_on_suurballes_graph(
+    suurballes_undirected_graph, root, logger_dir, time_limit
+):
+    """Test the solver finds the optimal tour when SEC rows are pooled"""
+    quota = 6
+    name = "test_pctsp_managed_sec_rows_on_suurballes_graph"
+    model = Model(problemName=name, createscip=True, defaultPlugins=False)
+    edge_list = solve_pctsp(
+        model,
+        suurballes_undirected_graph,
+        [],
+        quota,
+        root,
+        name=name,
+        sec_manage_rows=True,
+        solver_dir=logger_dir,
+        time_limit=time_limit,
+    )
+    ordered_edges = reorder_edge_list_from_root(order_edge_list(edge_list), root)
+    optimal_tour = walk_from_edge_list(ordered_edges)
+    assert total_cost_networkx(suurballes_undirected_graph, optimal_tour) == 20
+    assert model.getStatus() == "optimal"
+
+
+def test_pctsp_memory_aware_node_selection_on_suurballes_graph(
+    suurballes_undirected_graph, root, logger_dir, time_limit
+):
+    """Test the solver finds the optimal tour when node selection plunges from the start"""
+    quota = 6
+    name = "test_pctsp_memory_aware_node_selection_on_suurballes_graph"
+    model = Model(problemName=name, createscip=True, defaultPlugins=False)
+    edge_list = solve_pctsp(
+        model,
+        suurballes_undirected_graph,
+        [],
+        quota,
+        root,
+        name=name,
+        node_selection_memory_limit=1e-6,
+        solver_dir=logger_dir,
+        time_limit=time_limit,
+    )
+    ordered_edges = reorder_edge_list_from_root(order_edge_list(edge_list), root)
+    optimal_tour = walk_from_edge_list(ordered_edges)
+    assert total_cost_networkx(suurballes_undirected_graph, optimal_tour) == 20
+    assert model.getStatus() == "optimal"
+
+
+def test_pctsp_separation_controller_on_suurballes_graph(
+    suurballes_undirected_graph, root, logger_dir, time_limit
+):
+    """Test the solver finds the optimal tour when separators are throttled"""
+    quota = 6
+    name = "test_pctsp_separation_controller_on_suurballes_graph"
+    model = Model(problemName=name, createscip=True, defaultPlugins=False)
+    edge_list = solve_pctsp(
+        model,
+        suurballes_undirected_graph,
+        [],
+        quota,
+        root,
+        name=name,
+        separation_controller=True,
+        solver_dir=logger_dir,
+        time_limit=time_limit,
+    )
+    ordered_edges = reorder_edge_list_from_root(order_edge_list(edge_list), root)
+    optimal_tour = walk_from_edge_list(ordered_edges)
+    assert total_cost_networkx(suurballes_undirected_graph, optimal_tour) == 20
+    assert model.getStatus() == "optimal"
+
+
+def test_pctsp_cut_selection_on_suurballes_graph(
+    suurballes_undirected_graph, root, logger_dir, time_limit
+):
+    """Test the solver finds the optimal tour when one SEC is added per round"""
+    quota = 6
+    name = "test_pctsp_cut_selection_on_suurballes_graph"
+    model = Model(problemName=name, createscip=True, defaultPlugins=False)
+    edge_list = solve_pctsp(
+        model,
+        suurballes_undirected_graph,
+        [],
+        quota,
+        root,
+        name=name,
+        sec_max_cuts_per_round=1,
+        solver_dir=logger_dir,
+        time_limit=time_limit,
+    )
+    ordered_edges = reorder_edge_list_from_root(order_edge_list(edge_list), root)
+    optimal_tour = walk_from_edge_list(ordered_edges)
+    assert total_cost_networkx(suurballes_undirected_graph, optimal_tour) == 20
+    assert model.getStatus() == "optimal"
+
+
+def test_pctsp_shrink_support_graph_on_suurballes_graph(
+    suurballes_undirected_graph, root, logger_dir, time_limit
+):
+    """Test the solver finds the optimal tour when max flow runs on the shrunk support graph"""
+    quota = 6
+    name = "test_pctsp_shrink_support_graph_on_suurballes_graph"
+    model = Model(problemName=name, createscip=True, defaultPlugins=False)
+    edge_list = solve_pctsp(
+        model,
+        suurballes_undirected_graph,
+        [],
+        quota,
+        root,
+        name=name,
+        sec_shrink_support_graph=True,
+        solver_dir=logger_dir,
+        time_limit=time_limit,
+    )
+    ordered_edges = reorder_edge_list_from_root(order_edge_list(edge_list), root)
+    optimal_tour = walk_from_edge_list(ordered_edges)
+    assert total_cost_networkx(suurballes_undirected_graph, optimal_tour) == 20
+    assert model.getStatus() == "optimal"
+
+
+def test_lagrangian_bound_on_suurballes_graph(suurballes_undirected_graph, root):
+    """Test the Lagrangian bound is below the optimal cost of the small sparse graph"""
+    quota = 6
+    lower_bound, upper_bound = lagrangian_bound(
+        suurballes_undirected_graph, quota, root
+    )
+    assert 0 <= lower_bound <= 20
+    assert upper_bound >= 20
+    lower_bound, upper_bound = lagrangian_bound(
+        suurballes_undirected_graph, quota, root, upper_bound=20
+    )
+    assert lower_bound <= 20
+    assert upper_bound == 20
+
+
+def test_quota_sweep_on_suurballes_graph(suurballes_undirected_graph, root, time_limit):
+    """Test the quota sweep finds a tour for every quota with non-decreasing cost"""
+    quotas = [6, 4]
+    frontier = quota_sweep(
+        suurballes_undirected_graph, quotas, root, time_limit=time_limit
+    )
+    assert [point.quota for point in frontier] == sorted(quotas)
+    for point in frontier:
+        assert point.prize >= point.quota
+        assert len(point.edge_list) > 0
+    assert frontier[-1].upper_bound == 20
+    costs = [point.upper_bound for point in frontier]
+    assert costs == sorted(costs)
+
+
+def test_solver_session_on_suurballes_graph(suurballes_undirected_graph, root, time_limit):
+    """Test a solver session re-solves the small sparse graph after updates"""
+    session = SolverSession(suurballes_undirected_graph, 6, root, time_limit=time_limit)
+    result = session.solve()
+    assert result.upper_bound == 20
+    assert result.prize >= result.quota
+    assert result.num_kept_secs == 0
+
+    # a cheaper tour collects the smaller quota
+    session.update_quota(4)
+    result = session.solve()
+    assert result.quota == 4
+    assert result.upper_bound <= 20
+
+    # making an edge of the optimal tour more expensive cannot make the optimum cheaper
+    session.update_quota(6)
+    first_solve = session.solve()
+    u, v = first_solve.edge_list[0]
+    cost = suurballes_undirected_graph.edges[u, v]["cost"]
+    session.update_edge_cost(u, v, cost + 5)
+    result = session.solve()
+    assert 20 <= result.upper_bound <= 25
+    assert result.warm_start_cost >= result.upper_bound
+
+
+def test_solver_pool_on_suurballes_graph(suurballes_undirected_graph, root, time_limit):
+    """Test a solver pool solves repeated and batched instances of the small sparse graph"""
+    pool = SolverPool(pool_size=2, time_limit=time_limit)
+    assert pool.pool_size == 2
+    for _ in range(3):
+        result = pool.solve(suurballes_undirected_graph, 6, root)
+        assert result.upper_bound == 20
+        assert len(result.edge_list) > 0
+    instances = [(suurballes_undirected_graph, quota, root) for quota in [6, 4, 6]]
+    results = pool.solve_batch(instances)
+    assert len(results) == len(instances)
+    assert results[0].upper_bound == results[2].upper_bound == 20
+    assert results[1].upper_bound <= 20
+
+
+def test_parallel_solve_on_suurballes_graph(suurballes_undirected_graph, root, time_limit):
+    """Test solving subtrees on several workers finds the optimal tour of the small sparse graph"""
+    quota = 6
+    result = parallel_solve(
+        suurballes_undirected_graph, quota, root, 2, subtree_node_limit=1, time_limit=time_limit
+    )
+    assert result.upper_bound == result.lower_bound == 20
+    assert result.num_subtrees >= 1
+    first = parallel_solve(
+        suurballes_undirected_graph, quota, root, 2, deterministic=True, subtree_node_limit=1
+    )
+    second = parallel_solve(
+        suurballes_undirected_graph, quota, root, 2, deterministic=True, subtree_node_limit=1
+    )
+    assert first.upper_bound == second.upper_bound == 20
+    assert first.edge_list == second.edge_list
+    assert first.num_nodes == second.num_nodes
+
+
+def test_portfolio_solve_on_suurballes_graph(suurballes_undirected_graph, root, time_limit):
+    """Test racing solver variants finds the optimal tour of the small sparse graph"""
+    quota = 6
+    result = portfolio_solve(suurballes_undirected_graph, quota, root, time_limit=time_limit)
+    assert result.upper_bound == result.lower_bound == 20
+    assert result.winner is not None
+    assert len(result.variants) == 4
+    variants = [
+        SolverVariant(name="strong", branching_strategy=1),
+        SolverVariant(name="no-disjoint-tour", sec_disjoint_tour=False),
+    ]
+    result = portfolio_solve(
+        suurballes_undirected_graph, quota, root, variants=variants, time_limit=time_limit
+    )
+    assert result.upper_bound == 20
+    assert [variant.name for variant in result.variants] == ["strong", "no-disjoint-tour"]
+    assert any(variant.finished for variant in result.variants)
+
+
+def test_root_relaxation_on_suurballes_graph(suurballes_undirected_graph, root):
+    """Test the root relaxation is below the optimal cost of the small sparse graph"""
+    quota = 6
+    stats = root_relaxation(suurballes_undirected_graph, quota, root)
+    assert 0 <= stats.lower_bound <= 20
+    assert stats.num_lp_iterations > 0
+    assert stats.solving_time >= 0
+    assert stats.num_cycle_cover == 0
+
+
+def test_root_relaxation_with_union_find(suurballes_undirected_graph, root):
+    """Test union-find SEC separation gives a valid root bound and counts its SECs"""
+    quota = 6
+    stats = root_relaxation(suurballes_undirected_graph, quota, root, sec_union_find=True)
+    assert 0 <= stats.lower_bound <= 20
+    assert stats.num_sec_union_find >= 0
+
+
 def test_pctsp_on_tspwplib(sparse_tspwplib_graph, root, logger_dir, time_limit):
     """Test the branch and cut algorithm on a small, undirected sparse graph"""
     quota = 30
@@ -115,6 +429,28 @@ def test_pctsp_with_heuristic(tspwplib_graph, root, logger_dir, time_limit):
     )
 
 
+def test_pctsp_pricing_on_tspwplib(tspwplib_graph, root, logger_dir, time_limit):
+    """Test the solver prices edges into a core of nearest neighbours"""
+    quota = int(sum(nx.get_node_attributes(tspwplib_graph, "prize").values()) * 0.1)
+    name = "test_pctsp_pricing_on_tspwplib" + str(tspwplib_graph.graph["name"])
+    model = Model(problemName=name, createscip=True, defaultPlugins=False)
+    edge_list = solve_pctsp(
+        model,
+        tspwplib_graph,
+        [],
+        quota,
+        root,
+        name=name,
+        pricing_num_neighbors=5,
+        solver_dir=logger_dir,
+        time_limit=time_limit,
+    )
+    assert len(edge_list) > 0
+    ordered_edges = reorder_edge_list_from_root(order_edge_list(edge_list), root)
+    assert is_pctsp_yes_instance(tspwplib_graph, quota, root, ordered_edges)
+    assert model.getStatus() in ("optimal", "timelimit")
+
+
 def test_pctsp_cost_cover_shortest_path(
     tspwplib_graph,
     root,
@@ -249,6 +585,7 @@ def test_cycle_cover_grid8(grid8, root, logger_dir):
     ordered_edges = reorder_edge_list_from_root(order_edge_list(edge_list), root)
     assert summary.num_sec_disjoint_tour == 0
     assert summary.num_sec_maxflow_mincut == 0
+    assert summary.num_sec_union_find == 0
     assert summary.num_cycle_cover == 1
     assert is_pctsp_yes_instance(grid8, quota, root, ordered_edges)
     assert model.getStatus() == "optimal"
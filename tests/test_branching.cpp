@@ -1,4 +1,7 @@
+#include "pctsp/algorithms.hh"
 #include "pctsp/branching.hh"
+#include "pctsp/subtour_elimination.hh"
+#include "pctsp/vertex_branching.hh"
 #include "fixtures.hh"
 #include <objscip/objscip.h>
 #include <objscip/objscipdefplugins.h>
@@ -29,3 +32,247 @@ TEST(TestBranching, testSetBranchingStrategy) {
     EXPECT_EQ(SCIPbranchruleGetPriority(relpscost), 3000);
     SCIPfree(&scip);
 }
+
+TEST(TestBranching, testSetVertexBranchingStrategy) {
+    SCIP* scip = NULL;
+    SCIPcreate(&scip);
+    SCIPincludeDefaultPlugins(scip);
+    setBranchingStrategy(scip, BranchingStrategy::VERTEX, -1);
+    SCIP_BRANCHRULE* vertex = SCIPfindBranchrule(scip, VERTEX_BRANCHRULE_NAME.c_str());
+    SCIP_BRANCHRULE* relpscost = findRelPsCostBranchingRule(scip);
+    ASSERT_NE(vertex, nullptr);
+    EXPECT_GT(SCIPbranchruleGetPriority(vertex), SCIPbranchruleGetPriority(relpscost));
+    SCIPfree(&scip);
+}
+
+TEST(TestBranching, testSetCutSetBranchingStrategy) {
+    SCIP* scip = NULL;
+    SCIPcreate(&scip);
+    includePrizeCollectingTSPPlugins(scip, true, 0.1, true, 2, 1);
+    setBranchingStrategy(scip, BranchingStrategy::CUT_SET, -1);
+    SCIP_BRANCHRULE* relpscost = findRelPsCostBranchingRule(scip);
+    EXPECT_EQ(SCIPbranchruleGetPriority(relpscost), 100000);
+    SCIPfree(&scip);
+}
+
+TEST(TestBranching, testVertexBranchingScore) {
+    // the most fractional self loop has the largest score when nothing else differs
+    EXPECT_GT(vertexBranchingScore(0.5, 0, 0, 1, 1), vertexBranchingScore(0.9, 0, 0, 1, 1));
+    // valuable and remote vertices come first
+    EXPECT_GT(vertexBranchingScore(0.5, 1, 0, 1, 1), vertexBranchingScore(0.5, 0.5, 0, 1, 1));
+    EXPECT_GT(vertexBranchingScore(0.5, 0, 1, 1, 1), vertexBranchingScore(0.5, 0, 0.5, 1, 1));
+    // large pseudo costs win over fractionality
+    EXPECT_GT(vertexBranchingScore(0.9, 0, 0, 10, 10), vertexBranchingScore(0.5, 0, 0, 1, 1));
+}
+
+TEST(TestBranching, testVertexPseudoCosts) {
+    SCIP* scip = NULL;
+    SCIPcreate(&scip);
+    {
+        // the rule frees its name with SCIP, so it goes out of scope first
+        VertexBranchrule rule (scip);
+        rule.resetPseudoCosts(4);
+        // without measurements every pseudo cost is one
+        EXPECT_DOUBLE_EQ(rule.getPseudoCost(1, true), 1.0);
+
+        // the up child of vertex 1 raised the bound from 10 to 12 for a change of 0.5
+        rule.recordChildBranching(2, {1, true, 10.0, 0.5});
+        rule.recordChildBranching(3, {1, false, 10.0, 0.5});
+        rule.updatePseudoCost(2, 12.0);
+        auto pseudo_cost = rule.getVertexPseudoCost(1);
+        EXPECT_EQ(pseudo_cost.num_up, 1);
+        EXPECT_DOUBLE_EQ(pseudo_cost.up_gain_sum, 4.0);
+        EXPECT_EQ(pseudo_cost.num_down, 0);
+        EXPECT_DOUBLE_EQ(rule.getPseudoCost(1, true), 4.0);
+
+        // a node is measured once and unknown nodes are ignored
+        rule.updatePseudoCost(2, 20.0);
+        rule.updatePseudoCost(7, 20.0);
+        EXPECT_EQ(rule.getVertexPseudoCost(1).num_up, 1);
+
+        // a bound that went down counts as no gain
+        rule.updatePseudoCost(3, 9.0);
+        EXPECT_EQ(rule.getVertexPseudoCost(1).num_down, 1);
+        EXPECT_DOUBLE_EQ(rule.getPseudoCost(1, false), 0.0);
+
+        // vertices that were never branched on use the average of the others
+        EXPECT_DOUBLE_EQ(rule.getPseudoCost(2, true), 4.0);
+        EXPECT_DOUBLE_EQ(rule.getPseudoCost(2, false), 0.0);
+    }
+    SCIPfree(&scip);
+}
+
+/** Solve with a branching strategy, without presolving and propagation that fix self loops */
+void solveWithBranchingStrategy(
+    SCIP* scip,
+    PCTSPgraph& graph,
+    std::vector<std::pair<int, int>>& edges,
+    std::vector<CostNumberType>& costs,
+    std::vector<PrizeNumberType>& prizes,
+    PrizeNumberType quota,
+    BranchingStrategy strategy,
+    int sec_max_tailing_off_iterations = -1
+) {
+    for (auto& [u, v] : edges) boost::add_edge(u, v, graph);
+    auto cost_map = boost::get(edge_weight, graph);
+    for (std::size_t i = 0; i < edges.size(); i++) {
+        cost_map[boost::edge(edges[i].first, edges[i].second, graph).first] = costs[i];
+    }
+    auto prize_map = boost::get(vertex_distance, graph);
+    for (std::size_t vertex = 0; vertex < prizes.size(); vertex++) prize_map[vertex] = prizes[vertex];
+    PCTSPvertex root_vertex = 0;
+    std::vector<PCTSPedge> heuristic_edges;
+    std::string name = "test-branching-strategy";
+    modelPrizeCollectingTSP(
+        scip, graph, heuristic_edges, cost_map, prize_map, quota, root_vertex, name,
+        true, 0.01, true, sec_max_tailing_off_iterations
+    );
+    setBranchingStrategy(scip, strategy, -1);
+    SCIPsetIntParam(scip, "presolving/maxrounds", 0);
+    SCIPsetIntParam(scip, "propagating/maxrounds", 0);
+    SCIPsetIntParam(scip, "propagating/maxroundsroot", 0);
+    SCIPsolve(scip);
+}
+
+TEST(TestBranching, testVertexBranchingBranchesOnSelfLoops) {
+    // the root, 1 and 2 form a cheap triangle, the valuable vertices 3 and 4 are expensive
+    // the quota needs y_3 + y_4 >= 1.1 in the LP and both vertices in a tour
+    std::vector<std::pair<int, int>> edges = {{0, 1}, {0, 2}, {0, 3}, {0, 4}, {1, 2}, {1, 3}, {1, 4}, {2, 3}, {2, 4}, {3, 4}};
+    std::vector<CostNumberType> costs = {1, 1, 10, 10, 1, 10, 10, 10, 10, 10};
+    std::vector<PrizeNumberType> prizes = {0, 1, 1, 10, 10};
+    PCTSPgraph graph;
+    SCIP* scip = NULL;
+    SCIPcreate(&scip);
+    solveWithBranchingStrategy(scip, graph, edges, costs, prizes, 13, BranchingStrategy::VERTEX);
+    EXPECT_EQ(SCIPgetStatus(scip), SCIP_STATUS_OPTIMAL);
+    EXPECT_DOUBLE_EQ(SCIPgetPrimalbound(scip), 30);
+
+    SCIP_BRANCHRULE* branchrule = SCIPfindBranchrule(scip, VERTEX_BRANCHRULE_NAME.c_str());
+    EXPECT_GT(SCIPbranchruleGetNChildren(branchrule), 0);
+    // the children of a self loop branching measured the pseudo costs
+    auto rule = dynamic_cast<VertexBranchrule*>(SCIPfindObjBranchrule(scip, VERTEX_BRANCHRULE_NAME.c_str()));
+    ASSERT_NE(rule, nullptr);
+    unsigned int num_measurements = 0;
+    for (PCTSPvertex vertex = 1; vertex < 5; vertex++) {
+        auto pseudo_cost = rule->getVertexPseudoCost(vertex);
+        num_measurements += pseudo_cost.num_down + pseudo_cost.num_up;
+    }
+    EXPECT_GT(num_measurements, 0);
+    SCIPfree(&scip);
+}
+
+TEST(TestBranching, testVertexBranchingOnRootComponentEdge) {
+    // the prism of two triangles: the quota visits every vertex, so the self loops are integral
+    // the LP takes the cheap rungs at one and the triangle edges at one half
+    std::vector<std::pair<int, int>> edges = {{0, 1}, {1, 2}, {0, 2}, {3, 4}, {4, 5}, {3, 5}, {0, 3}, {1, 4}, {2, 5}};
+    std::vector<CostNumberType> costs = {10, 10, 10, 10, 10, 10, 1, 1, 1};
+    std::vector<PrizeNumberType> prizes = {0, 1, 1, 1, 1, 1};
+    PCTSPgraph graph;
+    SCIP* scip = NULL;
+    SCIPcreate(&scip);
+    solveWithBranchingStrategy(scip, graph, edges, costs, prizes, 5, BranchingStrategy::VERTEX);
+    EXPECT_EQ(SCIPgetStatus(scip), SCIP_STATUS_OPTIMAL);
+    EXPECT_DOUBLE_EQ(SCIPgetPrimalbound(scip), 42);
+
+    // only the edges leaving the root component {0, 3} can be branched on by the rule
+    SCIP_BRANCHRULE* branchrule = SCIPfindBranchrule(scip, VERTEX_BRANCHRULE_NAME.c_str());
+    EXPECT_GT(SCIPbranchruleGetNChildren(branchrule), 0);
+    auto rule = dynamic_cast<VertexBranchrule*>(SCIPfindObjBranchrule(scip, VERTEX_BRANCHRULE_NAME.c_str()));
+    for (PCTSPvertex vertex = 1; vertex < 6; vertex++) {
+        auto pseudo_cost = rule->getVertexPseudoCost(vertex);
+        EXPECT_EQ(pseudo_cost.num_down + pseudo_cost.num_up, 0);
+    }
+    SCIPfree(&scip);
+}
+
+TEST(TestBranching, testCutSetBranchingWhenTailingOff) {
+    // the LP of the root has y_3 + y_4 >= 1.1, so a min cut around 3 or 4 is fractional
+    std::vector<std::pair<int, int>> edges = {{0, 1}, {0, 2}, {0, 3}, {0, 4}, {1, 2}, {1, 3}, {1, 4}, {2, 3}, {2, 4}, {3, 4}};
+    std::vector<CostNumberType> costs = {1, 1, 10, 10, 1, 10, 10, 10, 10, 10};
+    std::vector<PrizeNumberType> prizes = {0, 1, 1, 10, 10};
+    PCTSPgraph graph;
+    SCIP* scip = NULL;
+    SCIPcreate(&scip);
+    // the last separation round of a node does not change the LP, so every node tails off
+    solveWithBranchingStrategy(scip, graph, edges, costs, prizes, 13, BranchingStrategy::CUT_SET, 2);
+    EXPECT_EQ(SCIPgetStatus(scip), SCIP_STATUS_OPTIMAL);
+    EXPECT_DOUBLE_EQ(SCIPgetPrimalbound(scip), 30);
+    auto sec_conshdlr = dynamic_cast<PCTSPconshdlrSubtour*>(SCIPfindObjConshdlr(scip, SEC_CONSHDLR_NAME.c_str()));
+    ASSERT_NE(sec_conshdlr, nullptr);
+    auto num_cutset_branchings = sec_conshdlr->getNumCutSetBranchings();
+    EXPECT_GT(num_cutset_branchings, 0);
+
+    // solving again counts the branchings of the new solve only
+    SCIPfreeTransform(scip);
+    SCIPsolve(scip);
+    EXPECT_EQ(SCIPgetStatus(scip), SCIP_STATUS_OPTIMAL);
+    EXPECT_EQ(sec_conshdlr->getNumCutSetBranchings(), num_cutset_branchings);
+    SCIPfree(&scip);
+}
+
+typedef GraphFixture VertexBranchingFixture;
+
+TEST_P(VertexBranchingFixture, testVertexBranchingFindsOptimalTour) {
+    auto quota = getQuota();
+    auto root_vertex = getRootVertex();
+    std::filesystem::path log_dir = ".logs";
+    std::vector<PCTSPedge> heuristic_edges;
+    std::vector<double> optimal_costs;
+    for (auto strategy : {BranchingStrategy::RELPSCOST, BranchingStrategy::VERTEX}) {
+        auto graph = getGraph();
+        auto cost_map = getCostMap(graph);
+        auto prize_map = getPrizeMap(graph);
+        std::string name = "test-vertex-branching";
+        SCIP* scip = NULL;
+        SCIPcreate(&scip);
+        solvePrizeCollectingTSP(
+            scip, graph, heuristic_edges, cost_map, prize_map, quota, root_vertex,
+            -1, strategy, false, false, false, {}, name,
+            true, 0.01, true, -1, 1, true, log_dir, 60
+        );
+        EXPECT_EQ(SCIPgetStatus(scip), SCIP_STATUS_OPTIMAL);
+        optimal_costs.push_back(SCIPgetPrimalbound(scip));
+        SCIPfree(&scip);
+    }
+    EXPECT_DOUBLE_EQ(optimal_costs[0], optimal_costs[1]);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TestBranching,
+    VertexBranchingFixture,
+    ::testing::Values(GraphType::COMPLETE4, GraphType::COMPLETE5, GraphType::COMPLETE25, GraphType::GRID8, GraphType::SUURBALLE)
+);
+
+typedef GraphFixture CutSetBranchingFixture;
+
+TEST_P(CutSetBranchingFixture, testCutSetBranchingFindsOptimalTour) {
+    auto quota = getQuota();
+    auto root_vertex = getRootVertex();
+    std::filesystem::path log_dir = ".logs";
+    std::vector<PCTSPedge> heuristic_edges;
+    std::vector<double> optimal_costs;
+    for (auto strategy : {BranchingStrategy::RELPSCOST, BranchingStrategy::CUT_SET}) {
+        auto graph = getGraph();
+        auto cost_map = getCostMap(graph);
+        auto prize_map = getPrizeMap(graph);
+        std::string name = "test-cut-set-branching";
+        SCIP* scip = NULL;
+        SCIPcreate(&scip);
+        // branch after two rounds of SECs that improve the gap by less than 0.1
+        solvePrizeCollectingTSP(
+            scip, graph, heuristic_edges, cost_map, prize_map, quota, root_vertex,
+            -1, strategy, false, false, false, {}, name,
+            true, 0.1, true, 2, 1, true, log_dir, 60
+        );
+        EXPECT_EQ(SCIPgetStatus(scip), SCIP_STATUS_OPTIMAL);
+        optimal_costs.push_back(SCIPgetPrimalbound(scip));
+        SCIPfree(&scip);
+    }
+    EXPECT_DOUBLE_EQ(optimal_costs[0], optimal_costs[1]);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TestBranching,
+    CutSetBranchingFixture,
+    ::testing::Values(GraphType::COMPLETE4, GraphType::COMPLETE5, GraphType::COMPLETE25, GraphType::GRID8, GraphType::SUURBALLE)
+);
@@ -9,6 +9,7 @@ from tspwplib import (
     walk_from_edge_list,
 )
 from pctsp.algorithms import solve_pctsp
+from pctsp.vial import BranchingStrategy
 
 
 def test_strong_branching_at_tree_top(
@@ -74,3 +75,51 @@ def test_avoid_tailing_off(sparse_tspwplib_graph, root, logger_dir):
     assert total_cost_networkx(tspwplib_graph, optimal_tour) > 0
     assert model.getStage() == SCIP_STAGE.SOLVED
     assert model.getStatus() == "optimal"
+
+
+def test_vertex_branching(sparse_tspwplib_graph, root, logger_dir, time_limit):
+    """Test branching on vertices first finds an optimal tour"""
+    quota = 30
+    name = "test_vertex_branching"
+    model = Model(problemName=name, createscip=True, defaultPlugins=False)
+    tspwplib_graph = sparse_tspwplib_graph
+    edge_list = solve_pctsp(
+        model,
+        tspwplib_graph,
+        [],
+        quota,
+        root,
+        branching_strategy=BranchingStrategy.VERTEX,
+        name=name,
+        solver_dir=logger_dir,
+        time_limit=time_limit,
+    )
+    ordered_edges = reorder_edge_list_from_root(order_edge_list(edge_list), root)
+    assert len(edge_list) > 0
+    assert is_pctsp_yes_instance(tspwplib_graph, quota, root, ordered_edges)
+    assert model.getStatus() == "optimal"
+
+
+def test_cut_set_branching(sparse_tspwplib_graph, root, logger_dir, time_limit):
+    """Test branching on cut sets when tailing off finds an optimal tour"""
+    quota = 30
+    name = "test_cut_set_branching"
+    model = Model(problemName=name, createscip=True, defaultPlugins=False)
+    tspwplib_graph = sparse_tspwplib_graph
+    edge_list = solve_pctsp(
+        model,
+        tspwplib_graph,
+        [],
+        quota,
+        root,
+        branching_strategy=BranchingStrategy.CUT_SET,
+        name=name,
+        sec_lp_gap_improvement_threshold=0.1,
+        sec_max_tailing_off_iterations=2,
+        solver_dir=logger_dir,
+        time_limit=time_limit,
+    )
+    ordered_edges = reorder_edge_list_from_root(order_edge_list(edge_list), root)
+    assert len(edge_list) > 0
+    assert is_pctsp_yes_instance(tspwplib_graph, quota, root, ordered_edges)
+    assert model.getStatus() == "optimal"
@@ -35,8 +35,15 @@ TEST_P(SuurballeGraphFixture, testAddDegreeTwoConstraint) {
     SCIPcreateProbBasic(scip_model, "test-add-degree-two-constraint");
 
     PCTSPaddEdgeVariables(scip_model, graph, cost_map, edge_variable_map);
-    PCTSPaddDegreeTwoConstraint(scip_model, graph, edge_variable_map);
+    std::map<PCTSPvertex, SCIP_CONS*> degree_conss;
+    PCTSPaddDegreeTwoConstraint(scip_model, graph, edge_variable_map, false, &degree_conss);
     EXPECT_EQ(SCIPgetNConss(scip_model), boost::num_vertices(graph));
+
+    // every vertex maps to its own degree constraint
+    EXPECT_EQ(degree_conss.size(), boost::num_vertices(graph));
+    std::set<SCIP_CONS*> distinct_conss;
+    for (auto& [vertex, cons] : degree_conss) distinct_conss.insert(cons);
+    EXPECT_EQ(distinct_conss.size(), boost::num_vertices(graph));
 }
 
 INSTANTIATE_TEST_SUITE_P(TestConstraint, SuurballeGraphFixture,
@@ -0,0 +1,130 @@
+#include "pctsp/algorithms.hh"
+#include "pctsp/cut_selection.hh"
+#include "pctsp/event_handlers.hh"
+#include "pctsp/subtour_elimination.hh"
+#include "fixtures.hh"
+#include <objscip/objscip.h>
+
+// variables are only compared by address when selecting cuts
+SCIP_VAR* fakeVar(std::vector<int>& storage, int index) {
+    return reinterpret_cast<SCIP_VAR*>(&storage[index]);
+}
+
+SECCandidate fakeCandidate(std::vector<int>& storage, std::vector<int> indices, std::vector<double> coefs, double efficacy) {
+    VarVector vars;
+    for (int index : indices) vars.push_back(fakeVar(storage, index));
+    return {"sec", vars, coefs, {}, 0, false, "separator", efficacy, efficacy};
+}
+
+TEST(TestCutSelection, testCutParallelism) {
+    std::vector<int> storage (4);
+    auto first = fakeCandidate(storage, {0, 1}, {1, 1}, 1);
+    auto same = fakeCandidate(storage, {1, 0}, {2, 2}, 1);
+    auto orthogonal = fakeCandidate(storage, {2, 3}, {1, -1}, 1);
+    auto overlapping = fakeCandidate(storage, {0, 2}, {1, 1}, 1);
+    EXPECT_DOUBLE_EQ(cutParallelism(first, same), 1.0);
+    EXPECT_DOUBLE_EQ(cutParallelism(first, orthogonal), 0.0);
+    EXPECT_DOUBLE_EQ(cutParallelism(first, overlapping), 0.5);
+}
+
+TEST(TestCutSelection, testSelectCuts) {
+    std::vector<int> storage (4);
+    std::vector<SECCandidate> candidates = {
+        fakeCandidate(storage, {0, 2}, {1, 1}, 0.5),
+        fakeCandidate(storage, {0, 1}, {1, 1}, 2.0),
+        fakeCandidate(storage, {1, 0}, {1, 1}, 1.0),   // parallel to the most efficacious
+        fakeCandidate(storage, {2, 3}, {1, 1}, 1.5),
+    };
+    EXPECT_EQ(selectCuts(candidates, -1, 0.8), std::vector<std::size_t>({1, 3, 0}));
+    EXPECT_EQ(selectCuts(candidates, 2, 0.8), std::vector<std::size_t>({1, 3}));
+    EXPECT_EQ(selectCuts(candidates, -1, 1.0), std::vector<std::size_t>({1, 3, 2, 0}));
+}
+
+typedef GraphFixture CutSelectionFixture;
+
+TEST_P(CutSelectionFixture, testCutSelectionFindsOptimalTour) {
+    auto quota = getQuota();
+    auto root_vertex = getRootVertex();
+    std::vector<double> optimal_costs;
+    for (int max_cuts : {-1, 1, 2}) {
+        auto graph = getGraph();
+        auto cost_map = getCostMap(graph);
+        auto prize_map = getPrizeMap(graph);
+        std::vector<PCTSPedge> heuristic_edges;
+        std::string name = "test-cut-selection";
+        SCIP* scip = NULL;
+        SCIPcreate(&scip);
+        modelPrizeCollectingTSP(scip, graph, heuristic_edges, cost_map, prize_map, quota, root_vertex, name);
+        auto sec_conshdlr = dynamic_cast<PCTSPconshdlrSubtour*>(SCIPfindObjConshdlr(scip, SEC_CONSHDLR_NAME.c_str()));
+        sec_conshdlr->setCutSelection(max_cuts, 0.8);
+        EXPECT_EQ(sec_conshdlr->isSelectingCuts(), max_cuts >= 0);
+        SCIPsolve(scip);
+        EXPECT_EQ(SCIPgetStatus(scip), SCIP_STATUS_OPTIMAL);
+        EXPECT_FALSE(sec_conshdlr->isCollectingSECs());
+        optimal_costs.push_back(SCIPgetPrimalbound(scip));
+        SCIPfree(&scip);
+    }
+    EXPECT_DOUBLE_EQ(optimal_costs[0], optimal_costs[1]);
+    EXPECT_DOUBLE_EQ(optimal_costs[0], optimal_costs[2]);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TestCutSelection,
+    CutSelectionFixture,
+    ::testing::Values(GraphType::COMPLETE4, GraphType::COMPLETE5, GraphType::COMPLETE25, GraphType::GRID8, GraphType::SUURBALLE)
+);
+
+TEST(TestCutSelection, testCutSelectionLimitsSECsPerRound) {
+    // eight triangles of cost one, joined in pairs at cost 3, in quads at cost 9 and at cost 27 otherwise
+    // the first LP is a triangle on every vertex, so disjoint tour separation finds three SECs per triangle
+    int num_vertices = 24;
+    std::vector<unsigned int> num_secs;
+    std::vector<unsigned int> num_sepa_calls;
+    for (int max_cuts : {-1, 1}) {
+        PCTSPgraph graph;
+        for (int u = 0; u < num_vertices; u++) {
+            for (int v = u + 1; v < num_vertices; v++) boost::add_edge(u, v, graph);
+        }
+        auto cost_map = boost::get(edge_weight, graph);
+        for (auto edge : boost::make_iterator_range(boost::edges(graph))) {
+            auto u = boost::source(edge, graph);
+            auto v = boost::target(edge, graph);
+            int cost = 27;
+            if (u / 3 == v / 3) cost = 1;
+            else if (u / 6 == v / 6) cost = 3;
+            else if (u / 12 == v / 12) cost = 9;
+            cost_map[edge] = cost;
+        }
+        auto prize_map = boost::get(vertex_distance, graph);
+        for (int vertex = 0; vertex < num_vertices; vertex++) prize_map[vertex] = vertex == 0 ? 0 : 1;
+        PrizeNumberType quota = num_vertices - 1;
+        PCTSPvertex root_vertex = 0;
+        std::vector<PCTSPedge> heuristic_edges;
+        std::string name = "test-cut-selection-limit";
+        SCIP* scip = NULL;
+        SCIPcreate(&scip);
+        modelPrizeCollectingTSP(scip, graph, heuristic_edges, cost_map, prize_map, quota, root_vertex, name);
+        SCIPincludeObjEventhdlr(scip, new NodeEventhdlr(scip), TRUE);
+        auto sec_conshdlr = dynamic_cast<PCTSPconshdlrSubtour*>(SCIPfindObjConshdlr(scip, SEC_CONSHDLR_NAME.c_str()));
+        sec_conshdlr->setCutSelection(max_cuts, 0.8);
+        SCIPsolve(scip);
+        EXPECT_EQ(SCIPgetStatus(scip), SCIP_STATUS_OPTIMAL);
+
+        auto node_eventhdlr = dynamic_cast<NodeEventhdlr*>(SCIPfindObjEventhdlr(scip, NODE_EVENTHDLR_NAME.c_str()));
+        auto node_stats = node_eventhdlr->getNodeStatsVector();
+        num_secs.push_back(numDisjointTourSECs(node_stats) + numMaxflowMincutSECs(node_stats) + numUnionFindSECs(node_stats));
+        num_sepa_calls.push_back(SCIPconshdlrGetNSepaCalls(SCIPfindConshdlr(scip, SEC_CONSHDLR_NAME.c_str())));
+        if (max_cuts < 0) {
+            EXPECT_EQ(sec_conshdlr->getNumAggregatedSECs(), 0);
+        }
+        else {
+            // the aggregated SEC of a triangle is more efficacious than a SEC of one target
+            EXPECT_GT(sec_conshdlr->getNumAggregatedSECs(), 0);
+        }
+        SCIPfree(&scip);
+    }
+    // without a limit the first round alone adds a SEC for every vertex outside the root triangle
+    EXPECT_GT(num_secs[0], num_sepa_calls[0]);
+    EXPECT_GT(num_secs[1], 0);
+    EXPECT_LE(num_secs[1], num_sepa_calls[1]);
+}
@@ -0,0 +1,95 @@
+/** Test the dense cost matrix gives the same answers as the adjacency list */
+
+#include "pctsp/dense_graph.hh"
+#include "pctsp/heuristic.hh"
+#include "fixtures.hh"
+#include <gtest/gtest.h>
+
+typedef GraphFixture DenseGraphFixture;
+
+TEST_P(DenseGraphFixture, testIsCompleteGraph) {
+    auto graph = getGraph();
+    bool expected = GetParam() == GraphType::COMPLETE4
+        || GetParam() == GraphType::COMPLETE5
+        || GetParam() == GraphType::COMPLETE25;
+    EXPECT_EQ(isCompleteGraph(graph), expected);
+}
+
+TEST_P(DenseGraphFixture, testDenseCostMapLookups) {
+    auto graph = getGraph();
+    auto cost_map = getCostMap(graph);
+    PCTSPdenseCostMap dense_cost_map (graph, cost_map);
+    for (auto edge : boost::make_iterator_range(boost::edges(graph))) {
+        auto u = boost::source(edge, graph);
+        auto v = boost::target(edge, graph);
+        EXPECT_EQ(dense_cost_map[edge], cost_map[edge]);
+        EXPECT_EQ(get(dense_cost_map, edge), cost_map[edge]);
+        EXPECT_EQ(dense_cost_map.cost(u, v), cost_map[edge]);
+        EXPECT_EQ(dense_cost_map.cost(v, u), cost_map[edge]);
+        EXPECT_EQ(dense_cost_map.getEdge(v, u), edge);
+    }
+    for (auto u : boost::make_iterator_range(boost::vertices(graph))) {
+        for (auto v : boost::make_iterator_range(boost::vertices(graph))) {
+            EXPECT_EQ(hasEdge(graph, dense_cost_map, u, v), hasEdge(graph, cost_map, u, v));
+            EXPECT_EQ(costOfVertexPair(graph, dense_cost_map, u, v), costOfVertexPair(graph, cost_map, u, v));
+        }
+    }
+}
+
+TEST_P(DenseGraphFixture, testDenseEdgesInducedByVertices) {
+    auto graph = getGraph();
+    auto cost_map = getCostMap(graph);
+    PCTSPdenseCostMap dense_cost_map (graph, cost_map);
+    std::vector<PCTSPvertex> vertices;
+    for (auto u : boost::make_iterator_range(boost::vertices(graph))) {
+        if (u % 2 == 0) vertices.push_back(u);
+    }
+    auto expected = getEdgesInducedByVertices(graph, vertices);
+    auto actual = getEdgesInducedByVertices(graph, dense_cost_map, vertices);
+    EXPECT_EQ(actual, expected);
+}
+
+TEST_P(DenseGraphFixture, testDenseAdjacentVertices) {
+    auto graph = getGraph();
+    auto cost_map = getCostMap(graph);
+    PCTSPdenseCostMap dense_cost_map (graph, cost_map);
+    for (auto u : boost::make_iterator_range(boost::vertices(graph))) {
+        auto dense_range = adjacentVertices(graph, dense_cost_map, u);
+        auto sparse_range = adjacentVertices(graph, cost_map, u);
+        std::vector<PCTSPvertex> dense_neighbors (dense_range.begin(), dense_range.end());
+        std::vector<PCTSPvertex> neighbors (sparse_range.begin(), sparse_range.end());
+        std::sort(neighbors.begin(), neighbors.end());
+        EXPECT_EQ(dense_neighbors, neighbors);
+    }
+}
+
+TEST_P(DenseGraphFixture, testDenseTotalCost) {
+    auto graph = getGraph();
+    auto cost_map = getCostMap(graph);
+    PCTSPdenseCostMap dense_cost_map (graph, cost_map);
+    auto tour = getPrizeFeasibleTour();
+    EXPECT_EQ(totalCost(graph, tour, dense_cost_map), totalCost(graph, tour, cost_map));
+}
+
+TEST_P(DenseGraphFixture, testDensePathExtensionCollapse) {
+    auto graph = getGraph();
+    auto cost_map = getCostMap(graph);
+    auto prize_map = getPrizeMap(graph);
+    auto root = getRootVertex();
+    auto quota = getQuota();
+    auto small_tour = getSmallTour();
+    PCTSPdenseCostMap dense_cost_map (graph, cost_map);
+    bool collapse_shortest_paths = true;
+    int path_depth_limit = 2;
+    int step_size = 1;
+
+    auto expected = pathExtensionCollapse(graph, small_tour, cost_map, prize_map, quota, root, collapse_shortest_paths, path_depth_limit, step_size);
+    auto actual = pathExtensionCollapse(graph, small_tour, dense_cost_map, prize_map, quota, root, collapse_shortest_paths, path_depth_limit, step_size);
+    EXPECT_EQ(actual, expected);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TestDenseGraph,
+    DenseGraphFixture,
+    ::testing::Values(GraphType::COMPLETE4, GraphType::COMPLETE5, GraphType::COMPLETE25, GraphType::GRID8, GraphType::SUURBALLE)
+);
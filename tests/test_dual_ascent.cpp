@@ -0,0 +1,130 @@
+/** Test the dual ascent lower bound and edge elimination */
+
+#include "pctsp/dual_ascent.hh"
+#include "pctsp/primal_dual.hh"
+#include "fixtures.hh"
+#include <gtest/gtest.h>
+#include <random>
+
+typedef GraphFixture DualAscentFixture;
+
+TEST(TestDualAscent, testBoundAndEliminationAgainstBruteForce) {
+    std::mt19937 generator (5);
+    std::uniform_int_distribution<int> value (0, 10);
+    std::size_t n = 7;
+    int num_eliminated = 0;
+    for (int trial = 0; trial < 40; trial++) {
+        // a cost of -1 marks a missing edge
+        std::vector<std::vector<double>> cost (n, std::vector<double>(n, -1.0));
+        std::vector<DualAscentEdge> edges;
+        for (std::size_t u = 0; u < n; u++) {
+            for (std::size_t v = u + 1; v < n; v++) {
+                if (value(generator) >= 8) continue;
+                cost[u][v] = cost[v][u] = value(generator) + 1;
+                edges.push_back({u, v, cost[u][v]});
+            }
+        }
+        std::vector<double> prizes (n);
+        for (auto& prize : prizes) prize = value(generator);
+        double quota = value(generator) * 3;
+
+        // brute force the optimal tours
+        double optimal = std::numeric_limits<double>::infinity();
+        std::vector<std::vector<std::size_t>> optimal_tours;
+        for (unsigned int subset = 0; subset < (1u << (n - 1)); subset++) {
+            std::vector<std::size_t> vertices;
+            double prize = prizes[0];
+            for (std::size_t v = 1; v < n; v++) {
+                if ((subset >> (v - 1)) & 1) {
+                    vertices.push_back(v);
+                    prize += prizes[v];
+                }
+            }
+            if (vertices.size() < 2 || prize < quota) continue;
+            do {
+                std::vector<std::size_t> tour = {0};
+                tour.insert(tour.end(), vertices.begin(), vertices.end());
+                tour.push_back(0);
+                double total = 0.0;
+                for (std::size_t i = 0; i + 1 < tour.size() && total >= 0; i++) {
+                    total = cost[tour[i]][tour[i + 1]] < 0 ? -1.0 : total + cost[tour[i]][tour[i + 1]];
+                }
+                if (total < 0 || total > optimal) continue;
+                if (total < optimal) optimal_tours.clear();
+                optimal = total;
+                optimal_tours.push_back(tour);
+            } while (std::next_permutation(vertices.begin(), vertices.end()));
+        }
+        if (optimal_tours.empty()) continue;
+
+        auto bound = dualAscent(n, edges, prizes, quota, 0, optimal);
+        EXPECT_LE(bound.lower_bound, optimal + 1e-6);
+        EXPECT_GT(bound.num_rounds, 0);
+        for (auto reduced_cost : bound.reduced_costs) EXPECT_GE(reduced_cost, 0.0);
+        num_eliminated += std::count(bound.is_edge_eliminated.begin(), bound.is_edge_eliminated.end(), true);
+
+        // no optimal tour uses an eliminated edge or visits an eliminated vertex
+        for (auto& tour : optimal_tours) {
+            for (std::size_t i = 0; i + 1 < tour.size(); i++) {
+                EXPECT_FALSE(bound.is_vertex_eliminated[tour[i]]);
+                for (std::size_t e = 0; e < edges.size(); e++) {
+                    bool is_edge = (edges[e].source == tour[i] && edges[e].target == tour[i + 1])
+                        || (edges[e].source == tour[i + 1] && edges[e].target == tour[i]);
+                    EXPECT_FALSE(is_edge && bound.is_edge_eliminated[e]);
+                }
+            }
+        }
+    }
+    EXPECT_GT(num_eliminated, 0);
+}
+
+TEST(TestDualAscent, testPathToRoot) {
+    // the only tour visits vertex 1 and 2, and vertex 3 is too expensive
+    std::vector<DualAscentEdge> edges = {{0, 1, 2.0}, {1, 2, 2.0}, {2, 0, 2.0}, {2, 3, 50.0}};
+    std::vector<double> prizes = {0.0, 5.0, 5.0, 1.0};
+    auto bound = dualAscent(4, edges, prizes, 10.0, 0, 6.0);
+    EXPECT_GT(bound.lower_bound, 0.0);
+    EXPECT_LE(bound.lower_bound, 6.0 + 1e-6);
+    EXPECT_TRUE(bound.is_vertex_eliminated[3]);
+    EXPECT_EQ(bound.is_edge_eliminated, std::vector<bool>({false, false, false, true}));
+}
+
+TEST_P(DualAscentFixture, testDualAscent) {
+    auto graph = getGraph();
+    auto cost_map = getCostMap(graph);
+    auto prize_map = getPrizeMap(graph);
+    auto quota = getQuota();
+    auto root = getRootVertex();
+    std::list<PCTSPvertex> tour;
+    primalDualTour(graph, tour, cost_map, prize_map, quota, root);
+    ASSERT_GT(tour.size(), 3);
+    auto first = tour.begin();
+    auto last = tour.end();
+    auto tour_edges = getEdgesInWalk(graph, first, last);
+    double upper_bound = totalCost(tour_edges, cost_map);
+
+    auto bound = dualAscent(graph, cost_map, prize_map, quota, root, upper_bound);
+    EXPECT_GE(bound.lower_bound, 0.0);
+    EXPECT_LE(bound.lower_bound, upper_bound + 1e-6);
+    for (auto vertex : tour) EXPECT_FALSE(bound.is_vertex_eliminated[vertex]);
+
+    // the tour of the upper bound is still in the reduced graph
+    auto num_edges = boost::num_edges(graph);
+    auto num_removed = removeEliminatedEdges(graph, bound);
+    EXPECT_EQ(boost::num_edges(graph), num_edges - num_removed);
+    for (auto it = tour.begin(); std::next(it) != tour.end(); it++) {
+        EXPECT_TRUE(boost::edge(*it, *std::next(it), graph).second);
+    }
+    // an eliminated vertex keeps no edge except its self loop
+    for (auto vertex : boost::make_iterator_range(boost::vertices(graph))) {
+        if (!bound.is_vertex_eliminated[vertex]) continue;
+        for (auto neighbor : boost::make_iterator_range(boost::adjacent_vertices(vertex, graph)))
+            EXPECT_EQ(neighbor, vertex);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TestDualAscent,
+    DualAscentFixture,
+    ::testing::Values(GraphType::COMPLETE4, GraphType::COMPLETE5, GraphType::COMPLETE25, GraphType::GRID8, GraphType::SUURBALLE)
+);
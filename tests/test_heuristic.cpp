@@ -4,6 +4,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <iostream>
+#include <set>
 #include <typeinfo>
 
 #include "fixtures.hh"
@@ -452,6 +453,106 @@ TEST_P(HeuristicFixture, testPathExtensionCollapse) {
     }
 }
 
+TEST_P(HeuristicFixture, testTwoOpt) {
+    auto graph = getGraph();
+    auto cost_map = getCostMap(graph);
+    auto root = getRootVertex();
+    auto tour = getPrizeFeasibleTour();
+    auto cost_before = totalCost(graph, tour, cost_map);
+    auto size_before = tour.size();
+    twoOpt(graph, tour, cost_map, 10);
+    EXPECT_LE(totalCost(graph, tour, cost_map), cost_before);
+    EXPECT_EQ(tour.size(), size_before);
+    EXPECT_TRUE(isTourInGraph(graph, tour));
+    EXPECT_EQ(tour.front(), root);
+    EXPECT_EQ(tour.back(), root);
+}
+
+TEST_P(HeuristicFixture, testDoubleBridgeMove) {
+    auto graph = getGraph();
+    auto tour = getPrizeFeasibleTour();
+    auto root = getRootVertex();
+    std::mt19937 generator (PCTSP_DEFAULT_SEED);
+    std::list<PCTSPvertex> perturbed (tour);
+    bool moved = doubleBridgeMove(graph, perturbed, generator);
+    EXPECT_EQ(perturbed.size(), tour.size());
+    EXPECT_TRUE(isTourInGraph(graph, perturbed));
+    EXPECT_EQ(perturbed.front(), root);
+    EXPECT_EQ(perturbed.back(), root);
+    if (!moved) {
+        EXPECT_EQ(perturbed, tour);
+    }
+}
+
+TEST_P(HeuristicFixture, testIteratedLocalSearch) {
+    auto graph = getGraph();
+    auto cost_map = getCostMap(graph);
+    auto prize_map = getPrizeMap(graph);
+    auto root = getRootVertex();
+    auto small_tour = getSmallTour();
+    auto quota = getQuota();
+    bool collapse_shortest_paths = true;
+    int path_depth_limit = boost::num_vertices(graph);
+    int step_size = 1;
+    float time_limit = 10;
+    int max_iterations = 20;
+
+    auto pec_tour = pathExtensionCollapse(graph, small_tour, cost_map, prize_map, quota, root, collapse_shortest_paths, path_depth_limit, step_size);
+    for (auto acceptance : {IlsAcceptance::SIMULATED_ANNEALING, IlsAcceptance::THRESHOLD}) {
+        auto tour = iteratedLocalSearch(graph, small_tour, cost_map, prize_map, quota, root, collapse_shortest_paths, path_depth_limit, step_size, time_limit, acceptance, 0.05, max_iterations);
+        EXPECT_GE(totalPrizeOfTour(prize_map, tour), quota);
+        EXPECT_TRUE(isTourInGraph(graph, tour));
+        EXPECT_EQ(tour.front(), root);
+        EXPECT_EQ(tour.back(), root);
+        EXPECT_LE(totalCost(graph, tour, cost_map), totalCost(graph, pec_tour, cost_map));
+    }
+}
+
+TEST_P(HeuristicFixture, testTourCrossover) {
+    auto graph = getGraph();
+    auto root = getRootVertex();
+    auto parent_a = getSmallTour();
+    auto parent_b = getPrizeFeasibleTour();
+    std::mt19937 generator (PCTSP_DEFAULT_SEED);
+    for (int i = 0; i < 10; i++) {
+        auto child = tourCrossover(graph, parent_a, parent_b, generator);
+        EXPECT_TRUE(isTourInGraph(graph, child));
+        EXPECT_EQ(child.front(), root);
+        EXPECT_EQ(child.back(), root);
+        std::set<PCTSPvertex> unique_vertices (child.begin(), child.end());
+        EXPECT_EQ(unique_vertices.size(), child.size() - 1);
+    }
+}
+
+TEST_P(HeuristicFixture, testMemeticSearch) {
+    auto graph = getGraph();
+    auto cost_map = getCostMap(graph);
+    auto prize_map = getPrizeMap(graph);
+    auto root = getRootVertex();
+    auto small_tour = getSmallTour();
+    auto quota = getQuota();
+    bool collapse_shortest_paths = true;
+    int path_depth_limit = boost::num_vertices(graph);
+    int step_size = 1;
+    float time_limit = 10;
+    int population_size = 6;
+    int max_generations = 5;
+
+    auto pec_tour = pathExtensionCollapse(graph, small_tour, cost_map, prize_map, quota, root, collapse_shortest_paths, path_depth_limit, step_size);
+    std::vector<std::list<PCTSPvertex>> tours;
+    for (int num_threads : {1, 3}) {
+        auto tour = memeticSearch(graph, small_tour, cost_map, prize_map, quota, root, collapse_shortest_paths, path_depth_limit, step_size, time_limit, num_threads, population_size, max_generations);
+        EXPECT_GE(totalPrizeOfTour(prize_map, tour), quota);
+        EXPECT_TRUE(isTourInGraph(graph, tour));
+        EXPECT_EQ(tour.front(), root);
+        EXPECT_EQ(tour.back(), root);
+        EXPECT_LE(totalCost(graph, tour, cost_map), totalCost(graph, pec_tour, cost_map));
+        tours.push_back(tour);
+    }
+    // the number of threads does not change the result
+    EXPECT_EQ(tours[0], tours[1]);
+}
+
 INSTANTIATE_TEST_SUITE_P(TestExtensionCollapse, CompleteGraphParameterizedFixture,
     ::testing::Values(GraphType::COMPLETE4, GraphType::COMPLETE5)
 );
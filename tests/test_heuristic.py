@@ -18,6 +18,9 @@ from pctsp.algorithms import (
     collapse,
     extension_until_prize_feasible,
     find_cycle_from_bfs,
+    IlsAcceptance,
+    iterated_local_search,
+    memetic_search,
     path_extension_collapse,
     path_extension_until_prize_feasible,
     random_tour_complete_graph,
@@ -172,6 +175,89 @@ def test_pec_tspwplib(tspwplib_graph, root, step_size):
         assert extended_tour.count(u) < 2 or u == root
 
 
+@pytest.mark.parametrize(
+    "acceptance", [IlsAcceptance.SIMULATED_ANNEALING, IlsAcceptance.THRESHOLD]
+)
+def test_iterated_local_search(tspwplib_graph, root, acceptance):
+    """Test iterated local search finds a tour no worse than extension & collapse"""
+    quota = 20
+    n = tspwplib_graph.number_of_nodes()
+    tour = [0, 1, 2, n - 1, n - 2, 0]
+    pec_tour = path_extension_collapse(
+        tspwplib_graph, tour, root, quota, collapse_shortest_paths=True
+    )
+    ils_tour = iterated_local_search(
+        tspwplib_graph,
+        tour,
+        root,
+        quota,
+        collapse_shortest_paths=True,
+        time_limit=5.0,
+        acceptance=acceptance,
+        max_iterations=20,
+    )
+    prize_map = nx.get_node_attributes(tspwplib_graph, VertexFunctionName.prize.value)
+    assert total_prize_of_tour(prize_map, ils_tour) >= quota
+    assert ils_tour[0] == ils_tour[len(ils_tour) - 1] == root
+    assert is_simple_cycle(tspwplib_graph, ils_tour)
+    assert total_cost_networkx(tspwplib_graph, ils_tour) <= total_cost_networkx(
+        tspwplib_graph, pec_tour
+    )
+
+
+@pytest.mark.parametrize("num_threads", [1, 2])
+def test_memetic_search(tspwplib_graph, root, num_threads):
+    """Test memetic search finds a tour no worse than extension & collapse"""
+    quota = 20
+    n = tspwplib_graph.number_of_nodes()
+    tour = [0, 1, 2, n - 1, n - 2, 0]
+    pec_tour = path_extension_collapse(
+        tspwplib_graph, tour, root, quota, collapse_shortest_paths=True
+    )
+    memetic_tour = memetic_search(
+        tspwplib_graph,
+        tour,
+        root,
+        quota,
+        collapse_shortest_paths=True,
+        time_limit=5.0,
+        num_threads=num_threads,
+        population_size=6,
+        max_generations=5,
+    )
+    prize_map = nx.get_node_attributes(tspwplib_graph, VertexFunctionName.prize.value)
+    assert total_prize_of_tour(prize_map, memetic_tour) >= quota
+    assert memetic_tour[0] == memetic_tour[len(memetic_tour) - 1] == root
+    assert is_simple_cycle(tspwplib_graph, memetic_tour)
+    assert total_cost_networkx(tspwplib_graph, memetic_tour) <= total_cost_networkx(
+        tspwplib_graph, pec_tour
+    )
+
+
+@pytest.mark.parametrize("num_candidates", [0, 3, 10])
+def test_path_extension_collapse_with_coordinates(
+    tspwplib_graph, root, num_candidates
+):
+    """Test path extension & collapse with nearest neighbour candidate lists"""
+    quota = 20
+    n = tspwplib_graph.number_of_nodes()
+    tour = [0, 1, 2, n - 1, n - 2, 0]
+    coordinates = {u: (float(u % 7), float(u // 7)) for u in tspwplib_graph.nodes()}
+    new_tour = path_extension_collapse(
+        tspwplib_graph,
+        tour,
+        root,
+        quota,
+        collapse_shortest_paths=True,
+        coordinates=coordinates,
+        num_candidates=num_candidates,
+    )
+    prize_map = nx.get_node_attributes(tspwplib_graph, VertexFunctionName.prize.value)
+    assert total_prize_of_tour(prize_map, new_tour) >= quota
+    assert new_tour[0] == new_tour[len(new_tour) - 1] == root
+    assert is_simple_cycle(tspwplib_graph, new_tour)
+
+
 def test_random_tour_complete_graph(tspwplib_graph, root):
     """Test random tours on complete graphs"""
     prize_dict = nx.get_node_attributes(tspwplib_graph, VertexFunctionName.prize.value)
@@ -0,0 +1,126 @@
+/** Test the k-d tree and the nearest neighbour candidate lists */
+
+#include "pctsp/heuristic.hh"
+#include "pctsp/kdtree.hh"
+#include "fixtures.hh"
+#include <gtest/gtest.h>
+#include <random>
+
+typedef GraphFixture KdTreeFixture;
+
+std::vector<Point2D> randomCoordinates(std::size_t n, unsigned int seed = 1) {
+    std::mt19937 generator (seed);
+    // integer coordinates give ties in distance
+    std::uniform_int_distribution<int> coordinate (0, 10);
+    std::vector<Point2D> points (n);
+    for (auto& point : points) point = {coordinate(generator), coordinate(generator)};
+    return points;
+}
+
+TEST(TestKdTree, testNearestAgreesWithBruteForce) {
+    auto points = randomCoordinates(200);
+    KdTree tree (points);
+    for (std::size_t query = 0; query < points.size(); query += 7) {
+        std::vector<std::pair<double, std::size_t>> brute_force;
+        for (std::size_t i = 0; i < points.size(); i++) {
+            if (i != query) brute_force.push_back({squaredDistance(points[query], points[i]), i});
+        }
+        std::sort(brute_force.begin(), brute_force.end());
+        for (std::size_t k : {0, 1, 5, 16, 199, 500}) {
+            std::vector<std::size_t> expected;
+            for (std::size_t i = 0; i < std::min(k, brute_force.size()); i++) expected.push_back(brute_force[i].second);
+            EXPECT_EQ(tree.nearest(points[query], k, query), expected);
+        }
+    }
+}
+
+TEST_P(KdTreeFixture, testNearestNeighborCandidates) {
+    auto graph = getGraph();
+    auto n = boost::num_vertices(graph);
+    auto points = randomCoordinates(n);
+    for (std::size_t k : {1, 3, 8}) {
+        auto candidates = nearestNeighborCandidates(graph, points, k);
+        ASSERT_EQ(candidates.size(), n);
+        for (std::size_t u = 0; u < n; u++) {
+            EXPECT_EQ(candidates[u].size(), std::min(k, (std::size_t) boost::out_degree(u, graph)));
+            double previous = 0.0;
+            for (auto v : candidates[u]) {
+                EXPECT_TRUE(boost::edge(u, v, graph).second);
+                EXPECT_GE(squaredDistance(points[u], points[v]), previous);
+                previous = squaredDistance(points[u], points[v]);
+            }
+            // every neighbour that is not a candidate is at least as far as the last candidate
+            for (auto v : boost::make_iterator_range(boost::adjacent_vertices(u, graph))) {
+                if (std::find(candidates[u].begin(), candidates[u].end(), v) == candidates[u].end()) {
+                    EXPECT_GE(squaredDistance(points[u], points[v]), previous);
+                }
+            }
+        }
+    }
+}
+
+TEST_P(KdTreeFixture, testExtensionWithAllNeighborsAsCandidates) {
+    auto graph = getGraph();
+    auto cost_map = getCostMap(graph);
+    auto prize_map = getPrizeMap(graph);
+    auto quota = getQuota();
+    auto root = getRootVertex();
+    auto n = boost::num_vertices(graph);
+    auto candidates = nearestNeighborCandidates(graph, randomCoordinates(n), n);
+
+    // candidate lists that contain every neighbour do not change the heuristics
+    auto expected = getSmallTour();
+    auto actual = getSmallTour();
+    extensionUntilPrizeFeasible(graph, expected, cost_map, prize_map, quota);
+    extensionUntilPrizeFeasible(graph, actual, cost_map, prize_map, quota, candidates);
+    EXPECT_EQ(actual, expected);
+
+    auto small_tour = getSmallTour();
+    bool collapse_shortest_paths = false;
+    int path_depth_limit = 2;
+    int step_size = 1;
+    EXPECT_EQ(
+        pathExtensionCollapse(graph, small_tour, cost_map, prize_map, quota, root, collapse_shortest_paths, path_depth_limit, step_size, candidates),
+        pathExtensionCollapse(graph, small_tour, cost_map, prize_map, quota, root, collapse_shortest_paths, path_depth_limit, step_size)
+    );
+}
+
+TEST_P(KdTreeFixture, testHeuristicsWithNearestCandidates) {
+    auto graph = getGraph();
+    auto cost_map = getCostMap(graph);
+    auto prize_map = getPrizeMap(graph);
+    auto quota = getQuota();
+    auto root = getRootVertex();
+    auto candidates = nearestNeighborCandidates(graph, randomCoordinates(boost::num_vertices(graph)), 3);
+
+    auto tour = getSmallTour();
+    extensionUnitaryGain(graph, tour, cost_map, prize_map, candidates);
+    auto small_tour = getSmallTour();
+    EXPECT_GE(totalPrizeOfTour(prize_map, tour), totalPrizeOfTour(prize_map, small_tour));
+
+    bool collapse_shortest_paths = true;
+    int path_depth_limit = 2;
+    int step_size = 1;
+    tour = pathExtensionCollapse(graph, small_tour, cost_map, prize_map, quota, root, collapse_shortest_paths, path_depth_limit, step_size, candidates);
+    if (tour.size() > 0) {
+        EXPECT_GE(totalPrizeOfTour(prize_map, tour), quota);
+        EXPECT_TRUE(isTourInGraph(graph, tour));
+    }
+
+    tour = getPrizeFeasibleTour();
+    if (tour.back() != root) tour.push_back(root);
+    auto cost_before = totalCost(graph, tour, cost_map);
+    auto size_before = tour.size();
+    twoOpt(graph, tour, cost_map, candidates, 10);
+    EXPECT_LE(totalCost(graph, tour, cost_map), cost_before);
+    EXPECT_EQ(tour.size(), size_before);
+    EXPECT_TRUE(isTourInGraph(graph, tour));
+    EXPECT_EQ(tour.front(), root);
+    EXPECT_EQ(tour.back(), root);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TestKdTree,
+    KdTreeFixture,
+    ::testing::Values(GraphType::COMPLETE4, GraphType::COMPLETE5, GraphType::COMPLETE25, GraphType::GRID8, GraphType::SUURBALLE)
+);
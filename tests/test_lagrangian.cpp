@@ -0,0 +1,137 @@
+/** Test the Lagrangian lower bound and reduced cost fixing */
+
+#include "pctsp/lagrangian.hh"
+#include "fixtures.hh"
+#include <gtest/gtest.h>
+#include <random>
+
+typedef GraphFixture LagrangianFixture;
+
+/** Prize feasible tours of a small graph given by their vertices in order from the root */
+std::vector<std::vector<std::size_t>> allFeasibleTours(
+    std::size_t n,
+    std::vector<std::vector<double>>& cost,
+    std::vector<double>& prizes,
+    double quota
+) {
+    std::vector<std::vector<std::size_t>> tours;
+    for (unsigned int subset = 0; subset < (1u << (n - 1)); subset++) {
+        std::vector<std::size_t> vertices;
+        double prize = prizes[0];
+        for (std::size_t v = 1; v < n; v++) {
+            if ((subset >> (v - 1)) & 1) {
+                vertices.push_back(v);
+                prize += prizes[v];
+            }
+        }
+        if (vertices.size() < 2 || prize < quota) continue;
+        do {
+            bool is_tour = vertices.front() < vertices.back();
+            std::size_t previous = 0;
+            for (auto v : vertices) {
+                is_tour = is_tour && cost[previous][v] >= 0;
+                previous = v;
+            }
+            if (is_tour && cost[previous][0] >= 0) tours.push_back(vertices);
+        } while (std::next_permutation(vertices.begin(), vertices.end()));
+    }
+    return tours;
+}
+
+TEST(TestLagrangian, testBoundAndFixingAgainstBruteForce) {
+    std::mt19937 generator (3);
+    std::uniform_int_distribution<int> value (0, 10);
+    std::size_t n = 7;
+    for (int trial = 0; trial < 30; trial++) {
+        // a cost of -1 marks a missing edge
+        std::vector<std::vector<double>> cost (n, std::vector<double>(n, -1.0));
+        std::vector<LagrangianEdge> edges;
+        for (std::size_t u = 0; u < n; u++) {
+            for (std::size_t v = u + 1; v < n; v++) {
+                if (value(generator) >= 9) continue;
+                cost[u][v] = cost[v][u] = value(generator) + 1;
+                edges.push_back({u, v, cost[u][v]});
+            }
+        }
+        std::vector<double> prizes (n);
+        for (auto& prize : prizes) prize = value(generator);
+        double quota = value(generator) * 2;
+        auto tours = allFeasibleTours(n, cost, prizes, quota);
+        if (tours.empty()) continue;
+
+        auto tourCost = [&](std::vector<std::size_t>& tour) {
+            double total = cost[0][tour.front()] + cost[tour.back()][0];
+            for (std::size_t i = 0; i + 1 < tour.size(); i++) total += cost[tour[i]][tour[i + 1]];
+            return total;
+        };
+        double optimal = std::numeric_limits<double>::infinity();
+        for (auto& tour : tours) optimal = std::min(optimal, tourCost(tour));
+
+        auto bound = lagrangianBound(n, edges, prizes, quota, 0, optimal);
+        EXPECT_LE(bound.lower_bound, optimal + 1e-6);
+        EXPECT_GT(bound.num_iterations, 0);
+
+        // no optimal tour uses a fixed edge or skips a fixed vertex
+        for (auto& tour : tours) {
+            if (tourCost(tour) > optimal) continue;
+            std::vector<bool> visited (n, false);
+            visited[0] = true;
+            for (auto v : tour) visited[v] = true;
+            for (std::size_t v = 0; v < n; v++) EXPECT_FALSE(bound.is_vertex_fixed[v] && !visited[v]);
+            std::size_t previous = 0;
+            tour.push_back(0);
+            for (auto v : tour) {
+                for (std::size_t e = 0; e < edges.size(); e++) {
+                    bool is_edge = (edges[e].source == previous && edges[e].target == v) || (edges[e].source == v && edges[e].target == previous);
+                    EXPECT_FALSE(is_edge && bound.is_edge_fixed[e]);
+                }
+                previous = v;
+            }
+        }
+    }
+}
+
+TEST(TestLagrangian, testRootWithOneEdge) {
+    std::vector<LagrangianEdge> edges = {{0, 1, 1.0}, {1, 2, 1.0}, {2, 3, 1.0}, {3, 1, 1.0}};
+    std::vector<double> prizes = {1.0, 1.0, 1.0, 1.0};
+    auto bound = lagrangianBound(4, edges, prizes, 2.0, 0, 10.0);
+    EXPECT_EQ(bound.lower_bound, std::numeric_limits<double>::infinity());
+}
+
+TEST_P(LagrangianFixture, testLagrangianBound) {
+    auto graph = getGraph();
+    auto cost_map = getCostMap(graph);
+    auto prize_map = getPrizeMap(graph);
+    auto quota = getQuota();
+    auto root = getRootVertex();
+    std::list<PCTSPvertex> tour;
+    primalDualTour(graph, tour, cost_map, prize_map, quota, root);
+    ASSERT_GT(tour.size(), 3);
+    auto first = tour.begin();
+    auto last = tour.end();
+    auto tour_edges = getEdgesInWalk(graph, first, last);
+    double upper_bound = totalCost(tour_edges, cost_map);
+
+    auto bound = lagrangianBound(graph, cost_map, prize_map, quota, root);
+    EXPECT_EQ(bound.upper_bound, upper_bound);
+    EXPECT_GE(bound.lower_bound, 0.0);
+    EXPECT_LE(bound.lower_bound, upper_bound + 1e-6);
+    EXPECT_LE(bound.num_iterations, LAGRANGIAN_MAX_ITERATIONS);
+
+    // the tour of the upper bound stays feasible after fixing
+    auto fixed_edges = lagrangianFixedEdges(graph, bound);
+    for (auto edge : tour_edges) {
+        EXPECT_EQ(std::find(fixed_edges.begin(), fixed_edges.end(), edge), fixed_edges.end());
+    }
+    for (auto vertex : boost::make_iterator_range(boost::vertices(graph))) {
+        if (bound.is_vertex_fixed[vertex]) {
+            EXPECT_NE(std::find(tour.begin(), tour.end(), vertex), tour.end());
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TestLagrangian,
+    LagrangianFixture,
+    ::testing::Values(GraphType::COMPLETE4, GraphType::COMPLETE5, GraphType::COMPLETE25, GraphType::GRID8, GraphType::SUURBALLE)
+);
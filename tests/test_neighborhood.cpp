@@ -0,0 +1,194 @@
+/** Test the neighbourhood index agrees with the adjacency list and the external path index finds valid paths */
+
+#include "pctsp/heuristic.hh"
+#include "pctsp/neighborhood.hh"
+#include "fixtures.hh"
+#include <gtest/gtest.h>
+
+typedef GraphFixture NeighborhoodFixture;
+
+TEST(TestVertexBitset, testSetResetTest) {
+    VertexBitset bitset (130);
+    EXPECT_EQ(bitset.size(), 130);
+    EXPECT_EQ(bitset.words().size(), 3);
+    bitset.set(0);
+    bitset.set(64);
+    bitset.set(129);
+    EXPECT_TRUE(bitset.test(0));
+    EXPECT_TRUE(bitset.test(64));
+    EXPECT_TRUE(bitset.test(129));
+    EXPECT_FALSE(bitset.test(1));
+    bitset.reset(64);
+    EXPECT_FALSE(bitset.test(64));
+    bitset.clear();
+    EXPECT_FALSE(bitset.test(0));
+    EXPECT_FALSE(bitset.test(129));
+}
+
+TEST_P(NeighborhoodFixture, testAutoRepresentation) {
+    auto graph = getGraph();
+    NeighborhoodIndex neighborhood (graph);
+    if (isCompleteGraph(graph)) {
+        EXPECT_TRUE(neighborhood.usesBitsets());
+    }
+}
+
+TEST_P(NeighborhoodFixture, testNeighborsMatchAcrossRepresentations) {
+    auto graph = getGraph();
+    NeighborhoodIndex sorted (graph, NeighborhoodRepresentation::SORTED_ADJACENCY);
+    NeighborhoodIndex bitset (graph, NeighborhoodRepresentation::BITSET);
+    for (std::size_t u = 0; u < sorted.numVertices(); u++) {
+        auto sorted_range = sorted.neighbors(u);
+        auto bitset_range = bitset.neighbors(u);
+        std::vector<std::size_t> sorted_neighbors (sorted_range.begin(), sorted_range.end());
+        std::vector<std::size_t> bitset_neighbors (bitset_range.begin(), bitset_range.end());
+        EXPECT_EQ(sorted_neighbors, bitset_neighbors);
+        EXPECT_TRUE(std::is_sorted(bitset_neighbors.begin(), bitset_neighbors.end()));
+    }
+}
+
+TEST(TestNeighborhoodIndex, testAutoRepresentationOfSparseGraph) {
+    // a long path is too sparse for bitsets
+    PCTSPgraph graph (1000);
+    for (int u = 0; u + 1 < 1000; u++) boost::add_edge(u, u + 1, graph);
+    NeighborhoodIndex neighborhood (graph);
+    EXPECT_FALSE(neighborhood.usesBitsets());
+    VertexBitset excluded (1000);
+    EXPECT_EQ(neighborhood.commonNeighborsNotIn(3, 5, excluded), std::vector<std::size_t>({4}));
+    excluded.set(4);
+    EXPECT_TRUE(neighborhood.commonNeighborsNotIn(3, 5, excluded).empty());
+}
+
+TEST_P(NeighborhoodFixture, testCommonNeighborsNotIn) {
+    auto graph = getGraph();
+    NeighborhoodIndex sorted_index (graph, NeighborhoodRepresentation::SORTED_ADJACENCY);
+    NeighborhoodIndex bitset_index (graph, NeighborhoodRepresentation::BITSET);
+    EXPECT_FALSE(sorted_index.usesBitsets());
+    EXPECT_TRUE(bitset_index.usesBitsets());
+
+    // exclude the vertices of a tour
+    auto tour = getSmallTour();
+    auto in_tour = vertexBitsetOfTour(graph, tour);
+    for (auto u : boost::make_iterator_range(boost::vertices(graph))) {
+        for (auto v : boost::make_iterator_range(boost::vertices(graph))) {
+            std::vector<std::size_t> expected;
+            for (auto w : neighborIntersection(graph, u, v)) {
+                if (!in_tour.test(w)) expected.push_back(w);
+            }
+            std::sort(expected.begin(), expected.end());
+            EXPECT_EQ(sorted_index.commonNeighborsNotIn(u, v, in_tour), expected);
+            EXPECT_EQ(bitset_index.commonNeighborsNotIn(u, v, in_tour), expected);
+        }
+    }
+}
+
+TEST_P(NeighborhoodFixture, testSwapPathsInTourUpdatesBitset) {
+    auto graph = getGraph();
+    auto tour = getSmallTour();
+    auto in_tour = vertexBitsetOfTour(graph, tour);
+    std::list<PCTSPvertex> new_path;
+    new_path.push_back(*tour.begin());
+    for (auto u : boost::make_iterator_range(boost::vertices(graph))) {
+        if (!in_tour.test(u)) {
+            new_path.push_back(u);
+            break;
+        }
+    }
+    new_path.push_back(*std::next(tour.begin()));
+    int first = 0;
+    int last = 1;
+    swapPathsInTour(tour, new_path, first, last, in_tour);
+    auto expected = vertexBitsetOfTour(graph, tour);
+    EXPECT_EQ(in_tour.words(), expected.words());
+}
+
+/** Length of the shortest path from u to v with no internal vertex in the tour, or -1 */
+int shortestExternalPathLength(NeighborhoodIndex& neighborhood, VertexBitset& in_tour, std::size_t u, std::size_t v) {
+    std::vector<int> distance (neighborhood.numVertices(), -1);
+    std::vector<std::size_t> queue = {u};
+    distance[u] = 0;
+    for (std::size_t q = 0; q < queue.size(); q++) {
+        for (auto w : neighborhood.neighbors(queue[q])) {
+            if (w == v && distance[queue[q]] > 0) return distance[queue[q]] + 1;
+            if (distance[w] >= 0 || in_tour.test(w)) continue;
+            distance[w] = distance[queue[q]] + 1;
+            queue.push_back(w);
+        }
+    }
+    return -1;
+}
+
+void expectValidExternalPaths(NeighborhoodIndex& neighborhood, VertexBitset& in_tour, ExternalPathIndex& index, std::list<PCTSPvertex>& tour, int k) {
+    for (auto u : tour) {
+        for (auto v : tour) {
+            if (u == v) continue;
+            auto paths = index.externalPaths(u, v);
+            for (auto& path : paths) {
+                EXPECT_EQ(path.front(), u);
+                EXPECT_EQ(path.back(), v);
+                EXPECT_GE(path.size(), 3);
+                EXPECT_LE(path.size(), k + 1);
+                for (std::size_t i = 1; i + 1 < path.size(); i++) EXPECT_FALSE(in_tour.test(path[i]));
+                for (std::size_t i = 0; i + 1 < path.size(); i++) {
+                    auto neighbors = neighborhood.neighbors(path[i]);
+                    EXPECT_TRUE(std::binary_search(neighbors.begin(), neighbors.end(), path[i + 1]));
+                }
+                std::sort(path.begin(), path.end());
+                EXPECT_EQ(std::adjacent_find(path.begin(), path.end()), path.end());
+            }
+            // a path is found whenever the shortest external path is short enough
+            int length = shortestExternalPathLength(neighborhood, in_tour, u, v);
+            EXPECT_EQ(paths.size() > 0, length >= 2 && length <= k);
+        }
+    }
+}
+
+TEST_P(NeighborhoodFixture, testExternalPaths) {
+    auto graph = getGraph();
+    auto tour = getSmallTour();
+    NeighborhoodIndex neighborhood (graph);
+    auto in_tour = vertexBitsetOfTour(graph, tour);
+    for (int k : {2, 3, 4}) {
+        ExternalPathIndex index (neighborhood, in_tour, k);
+        expectValidExternalPaths(neighborhood, in_tour, index, tour, k);
+    }
+}
+
+TEST_P(NeighborhoodFixture, testExternalPathsAfterSwap) {
+    auto graph = getGraph();
+    auto tour = getSmallTour();
+    int k = 3;
+    NeighborhoodIndex neighborhood (graph);
+    auto in_tour = vertexBitsetOfTour(graph, tour);
+    ExternalPathIndex index (neighborhood, in_tour, k);
+
+    // search trees are memoised
+    auto first = *tour.begin();
+    auto second = *std::next(tour.begin());
+    auto paths = index.externalPaths(first, second);
+    auto num_searches = index.numSearches();
+    EXPECT_EQ(index.externalPaths(first, second), paths);
+    EXPECT_EQ(index.numSearches(), num_searches);
+
+    // extend the tour with an external path and check against a fresh index
+    if (paths.empty()) return;
+    std::list<PCTSPvertex> new_path (paths.front().begin(), paths.front().end());
+    int first_index = 0;
+    int last_index = 1;
+    swapPathsInTour(tour, new_path, first_index, last_index, in_tour, index);
+    EXPECT_EQ(in_tour.words(), vertexBitsetOfTour(graph, tour).words());
+    ExternalPathIndex fresh_index (neighborhood, in_tour, k);
+    for (auto u : tour) {
+        for (auto v : tour) {
+            if (u != v) {
+                EXPECT_EQ(index.externalPaths(u, v), fresh_index.externalPaths(u, v));
+            }
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TestNeighborhood,
+    NeighborhoodFixture,
+    ::testing::Values(GraphType::COMPLETE4, GraphType::COMPLETE5, GraphType::COMPLETE25, GraphType::GRID8, GraphType::SUURBALLE)
+);
@@ -0,0 +1,92 @@
+#include "pctsp/algorithms.hh"
+#include "pctsp/node_selection.hh"
+#include "fixtures.hh"
+#include <objscip/objscip.h>
+
+typedef GraphFixture NodeSelectionFixture;
+
+TEST_P(NodeSelectionFixture, testMemoryAwareNodeSelection) {
+    auto quota = getQuota();
+    auto root_vertex = getRootVertex();
+    std::filesystem::path log_dir = ".logs";
+    std::vector<PCTSPedge> heuristic_edges;
+    std::vector<double> optimal_costs;
+    // a limit of one byte makes the selector plunge from the first node
+    for (double memory_limit : {1e12, 1e-6}) {
+        auto graph = getGraph();
+        auto cost_map = getCostMap(graph);
+        auto prize_map = getPrizeMap(graph);
+        std::string name = "test-memory-aware-node-selection";
+        SCIP* scip = NULL;
+        SCIPcreate(&scip);
+        solvePrizeCollectingTSP(
+            scip, graph, heuristic_edges, cost_map, prize_map, quota, root_vertex,
+            -1, BranchingStrategy::RELPSCOST, false, false, false, {}, name,
+            true, 0.01, true, -1, 1, true, log_dir, 60, false, 0, false, false, memory_limit
+        );
+        EXPECT_EQ(SCIPgetStatus(scip), SCIP_STATUS_OPTIMAL);
+        optimal_costs.push_back(SCIPgetPrimalbound(scip));
+
+        auto nodesel = dynamic_cast<MemoryAwareNodesel*>(SCIPfindObjNodesel(scip, MEMORY_NODESEL_NAME.c_str()));
+        ASSERT_NE(nodesel, nullptr);
+        EXPECT_GT(nodesel->getTrackedMemory(scip), 0);
+        auto switches = nodesel->getSwitches();
+        if (memory_limit > 1) {
+            EXPECT_EQ(switches.size(), 0);
+            EXPECT_FALSE(nodesel->isPlunging());
+        }
+        else {
+            // the root is selected by the node selector too
+            ASSERT_EQ(switches.size(), 1);
+            EXPECT_TRUE(switches[0].plunging);
+            EXPECT_EQ(switches[0].node_number, 0);
+            EXPECT_TRUE(nodesel->isPlunging());
+        }
+        SCIPfree(&scip);
+    }
+    EXPECT_DOUBLE_EQ(optimal_costs[0], optimal_costs[1]);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TestNodeSelection,
+    NodeSelectionFixture,
+    ::testing::Values(GraphType::COMPLETE4, GraphType::COMPLETE5, GraphType::COMPLETE25, GraphType::GRID8, GraphType::SUURBALLE)
+);
+
+TEST(TestNodeSelection, testUpdateMode) {
+    SCIP* scip = NULL;
+    SCIPcreate(&scip);
+    {
+        // the selector frees its name with SCIP, so it goes out of scope first
+        MemoryAwareNodesel nodesel (scip, 100, 0.8, 0.6);
+        // plunge above 80 MB and stop below 60 MB
+        nodesel.updateMode(50, 1);
+        nodesel.updateMode(80, 2);
+        EXPECT_FALSE(nodesel.isPlunging());
+        nodesel.updateMode(81, 3);
+        EXPECT_TRUE(nodesel.isPlunging());
+        // between the fractions the mode is kept in both directions
+        nodesel.updateMode(70, 4);
+        nodesel.updateMode(90, 5);
+        nodesel.updateMode(60, 6);
+        EXPECT_TRUE(nodesel.isPlunging());
+        nodesel.updateMode(59, 7);
+        EXPECT_FALSE(nodesel.isPlunging());
+        nodesel.updateMode(70, 8);
+        EXPECT_FALSE(nodesel.isPlunging());
+        nodesel.updateMode(95, 9);
+        EXPECT_TRUE(nodesel.isPlunging());
+
+        auto switches = nodesel.getSwitches();
+        ASSERT_EQ(switches.size(), 3);
+        EXPECT_EQ(switches[0].node_number, 3);
+        EXPECT_DOUBLE_EQ(switches[0].memory_used, 81);
+        EXPECT_TRUE(switches[0].plunging);
+        EXPECT_EQ(switches[1].node_number, 7);
+        EXPECT_DOUBLE_EQ(switches[1].memory_used, 59);
+        EXPECT_FALSE(switches[1].plunging);
+        EXPECT_EQ(switches[2].node_number, 9);
+        EXPECT_TRUE(switches[2].plunging);
+    }
+    SCIPfree(&scip);
+}
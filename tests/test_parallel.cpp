@@ -0,0 +1,114 @@
+/** Test solving subtrees of the search tree on several SCIP instances */
+
+#include "fixtures.hh"
+#include "pctsp/algorithms.hh"
+#include "pctsp/parallel.hh"
+
+typedef GraphFixture ParallelFixture;
+
+TEST(TestParallel, testWorkStealingQueue) {
+    WorkStealingQueue queue (2);
+    SubtreeTask first = {{{1, true}}, 0, true};
+    SubtreeTask second = {{{1, false}}, 0, true};
+    queue.push(0, first);
+    queue.push(0, second);
+
+    // the owner takes the newest subtree and the thief the oldest
+    SubtreeTask task;
+    EXPECT_TRUE(queue.pop(0, task));
+    EXPECT_FALSE(task.fixings.front().second);
+    EXPECT_TRUE(queue.pop(1, task));
+    EXPECT_TRUE(task.fixings.front().second);
+    EXPECT_EQ(queue.getNumStolen(), 1);
+    queue.finish();
+    queue.finish();
+    EXPECT_FALSE(queue.pop(0, task));
+}
+
+TEST_P(ParallelFixture, testSolvePrizeCollectingTSPParallel) {
+    auto quota = getQuota();
+    auto root_vertex = getRootVertex();
+    std::filesystem::path log_dir = ".logs";
+
+    auto exact_graph = getGraph();
+    auto exact_cost_map = getCostMap(exact_graph);
+    auto exact_prize_map = getPrizeMap(exact_graph);
+    std::vector<PCTSPedge> heuristic_edges;
+    std::string name = "test-parallel";
+    SCIP* scip = NULL;
+    SCIPcreate(&scip);
+    solvePrizeCollectingTSP(
+        scip, exact_graph, heuristic_edges, exact_cost_map, exact_prize_map, quota, root_vertex,
+        -1, BranchingStrategy::RELPSCOST, false, false, false, {}, name,
+        true, 0.01, true, -1, 1, true, log_dir, 60
+    );
+    double optimal_cost = SCIPgetPrimalbound(scip);
+    SCIPfree(&scip);
+
+    // a node limit of one splits every subtree that is not solved at its root
+    auto graph = getGraph();
+    auto cost_map = getCostMap(graph);
+    auto prize_map = getPrizeMap(graph);
+    auto stats = solvePrizeCollectingTSPParallel(
+        graph, heuristic_edges, cost_map, prize_map, quota, root_vertex, 4, false, 1
+    );
+    EXPECT_EQ(stats.summary.status, SCIP_STATUS_OPTIMAL);
+    EXPECT_DOUBLE_EQ(stats.summary.upper_bound, optimal_cost);
+    EXPECT_DOUBLE_EQ(stats.summary.lower_bound, optimal_cost);
+    EXPECT_EQ(totalCost(stats.solution_edges, cost_map), optimal_cost);
+    EXPECT_GE(stats.num_subtrees, 1);
+    // the pool holds the distinct SECs that the subtrees separated
+    auto num_secs = stats.summary.num_sec_disjoint_tour + stats.summary.num_sec_maxflow_mincut + stats.summary.num_sec_union_find;
+    EXPECT_EQ(stats.num_shared_secs > 0, num_secs > 0);
+    EXPECT_LE(stats.num_shared_secs, num_secs);
+
+    // deterministic runs repeat
+    auto first = solvePrizeCollectingTSPParallel(
+        graph, heuristic_edges, cost_map, prize_map, quota, root_vertex, 4, true, 1
+    );
+    auto second = solvePrizeCollectingTSPParallel(
+        graph, heuristic_edges, cost_map, prize_map, quota, root_vertex, 4, true, 1
+    );
+    EXPECT_EQ(first.summary.status, SCIP_STATUS_OPTIMAL);
+    EXPECT_DOUBLE_EQ(first.summary.upper_bound, optimal_cost);
+    EXPECT_EQ(first.solution_edges, second.solution_edges);
+    EXPECT_EQ(first.summary.num_nodes, second.summary.num_nodes);
+    EXPECT_EQ(first.num_subtrees, second.num_subtrees);
+    EXPECT_EQ(first.num_shared_secs, second.num_shared_secs);
+}
+
+TEST(TestParallel, testRootSubtreeIsSplit) {
+    // the prism of two triangles: every vertex is visited and the LP takes the cheap rungs
+    // at one and the triangle edges at one half for a cost of 33, but every tour costs 42
+    PCTSPgraph graph;
+    std::vector<std::pair<int, int>> edges = {{0, 1}, {1, 2}, {0, 2}, {3, 4}, {4, 5}, {3, 5}, {0, 3}, {1, 4}, {2, 5}};
+    std::vector<CostNumberType> costs = {10, 10, 10, 10, 10, 10, 1, 1, 1};
+    for (auto& [u, v] : edges) boost::add_edge(u, v, graph);
+    auto cost_map = boost::get(edge_weight, graph);
+    for (std::size_t i = 0; i < edges.size(); i++) {
+        cost_map[boost::edge(edges[i].first, edges[i].second, graph).first] = costs[i];
+    }
+    auto prize_map = boost::get(vertex_distance, graph);
+    for (PCTSPvertex vertex = 0; vertex < 6; vertex++) prize_map[vertex] = vertex == 0 ? 0 : 1;
+    std::vector<PCTSPedge> heuristic_edges;
+
+    // the root subtree stops after its root node and is split on two vertices for four workers
+    auto stats = solvePrizeCollectingTSPParallel(
+        graph, heuristic_edges, cost_map, prize_map, 5, 0, 4, true, 1
+    );
+    EXPECT_EQ(stats.summary.status, SCIP_STATUS_OPTIMAL);
+    EXPECT_DOUBLE_EQ(stats.summary.upper_bound, 42);
+    EXPECT_DOUBLE_EQ(stats.summary.lower_bound, 42);
+    EXPECT_GT(stats.num_subtrees, 1);
+    EXPECT_GT(stats.summary.num_nodes, 1);
+    // the root LP violates no SEC, so the shared SECs come from the branches of later subtrees
+    auto num_secs = stats.summary.num_sec_disjoint_tour + stats.summary.num_sec_maxflow_mincut;
+    EXPECT_EQ(stats.num_shared_secs > 0, num_secs > 0);
+    EXPECT_LE(stats.num_shared_secs, num_secs);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TestParallel,
+    ParallelFixture,
+    ::testing::Values(GraphType::COMPLETE4, GraphType::COMPLETE5, GraphType::COMPLETE25, GraphType::GRID8, GraphType::SUURBALLE)
+);
@@ -0,0 +1,67 @@
+/** Test solving instances with a pool of SCIP instances */
+
+#include "fixtures.hh"
+#include "pctsp/algorithms.hh"
+#include "pctsp/pool.hh"
+
+typedef GraphFixture PoolFixture;
+
+TEST_P(PoolFixture, testSolverPool) {
+    auto quota = getQuota();
+    auto root_vertex = getRootVertex();
+    std::filesystem::path log_dir = ".logs";
+
+    auto exact_graph = getGraph();
+    auto exact_cost_map = getCostMap(exact_graph);
+    auto exact_prize_map = getPrizeMap(exact_graph);
+    std::vector<PCTSPedge> heuristic_edges;
+    std::string name = "test-pool";
+    SCIP* scip = NULL;
+    SCIPcreate(&scip);
+    solvePrizeCollectingTSP(
+        scip, exact_graph, heuristic_edges, exact_cost_map, exact_prize_map, quota, root_vertex,
+        -1, BranchingStrategy::RELPSCOST, false, false, false, {}, name,
+        true, 0.01, true, -1, 1, true, log_dir, 60
+    );
+    double optimal_cost = SCIPgetPrimalbound(scip);
+    SCIPfree(&scip);
+
+    // every solve reuses a SCIP instance of the pool
+    SolverPool pool (2);
+    EXPECT_EQ(pool.getPoolSize(), 2);
+    for (int i = 0; i < 3; i++) {
+        auto graph = getGraph();
+        auto cost_map = getCostMap(graph);
+        auto prize_map = getPrizeMap(graph);
+        auto result = pool.solve(graph, cost_map, prize_map, quota, root_vertex, heuristic_edges);
+        EXPECT_EQ(result.summary.status, SCIP_STATUS_OPTIMAL);
+        EXPECT_DOUBLE_EQ(result.summary.upper_bound, optimal_cost);
+        EXPECT_EQ(totalCost(result.solution_edges, cost_map), optimal_cost);
+        EXPECT_EQ(pool.getNumFreeEnvironments(), 2);
+    }
+
+    // a batch is solved in parallel and returned in order
+    std::vector<PCTSPgraph> graphs;
+    std::vector<PrizeNumberType> quotas;
+    std::vector<PCTSPvertex> root_vertices;
+    for (int i = 0; i < 5; i++) {
+        graphs.push_back(getGraph());
+        getCostMap(graphs.back());
+        getPrizeMap(graphs.back());
+        quotas.push_back(quota);
+        root_vertices.push_back(root_vertex);
+    }
+    auto results = pool.solveBatch(graphs, quotas, root_vertices);
+    ASSERT_EQ(results.size(), graphs.size());
+    for (auto& result : results) {
+        EXPECT_EQ(result.summary.status, SCIP_STATUS_OPTIMAL);
+        EXPECT_DOUBLE_EQ(result.summary.upper_bound, optimal_cost);
+    }
+    EXPECT_EQ(pool.getNumFreeEnvironments(), 2);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TestPool,
+    PoolFixture,
+    ::testing::Values(GraphType::COMPLETE4, GraphType::COMPLETE5, GraphType::COMPLETE25, GraphType::GRID8, GraphType::SUURBALLE)
+);
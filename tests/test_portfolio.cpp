@@ -0,0 +1,79 @@
+/** Test racing solver variants that share tours and SECs */
+
+#include "fixtures.hh"
+#include "pctsp/algorithms.hh"
+#include "pctsp/portfolio.hh"
+
+typedef GraphFixture PortfolioFixture;
+
+TEST_P(PortfolioFixture, testSolvePrizeCollectingTSPPortfolio) {
+    auto quota = getQuota();
+    auto root_vertex = getRootVertex();
+    std::filesystem::path log_dir = ".logs";
+
+    auto exact_graph = getGraph();
+    auto exact_cost_map = getCostMap(exact_graph);
+    auto exact_prize_map = getPrizeMap(exact_graph);
+    std::vector<PCTSPedge> heuristic_edges;
+    std::string name = "test-portfolio";
+    SCIP* scip = NULL;
+    SCIPcreate(&scip);
+    solvePrizeCollectingTSP(
+        scip, exact_graph, heuristic_edges, exact_cost_map, exact_prize_map, quota, root_vertex,
+        -1, BranchingStrategy::RELPSCOST, false, false, false, {}, name,
+        true, 0.01, true, -1, 1, true, log_dir, 60
+    );
+    double optimal_cost = SCIPgetPrimalbound(scip);
+    SCIPfree(&scip);
+
+    auto graph = getGraph();
+    auto cost_map = getCostMap(graph);
+    auto prize_map = getPrizeMap(graph);
+    auto variants = defaultSolverVariants();
+    auto stats = solvePrizeCollectingTSPPortfolio(
+        graph, heuristic_edges, cost_map, prize_map, quota, root_vertex, variants, 60
+    );
+    EXPECT_EQ(stats.summary.status, SCIP_STATUS_OPTIMAL);
+    EXPECT_DOUBLE_EQ(stats.summary.upper_bound, optimal_cost);
+    EXPECT_DOUBLE_EQ(stats.summary.lower_bound, optimal_cost);
+    EXPECT_EQ(totalCost(stats.solution_edges, cost_map), optimal_cost);
+    ASSERT_EQ(stats.variants.size(), variants.size());
+    ASSERT_GE(stats.winner, 0);
+    EXPECT_TRUE(stats.variants[stats.winner].finished);
+    unsigned int num_exported_secs = 0;
+    for (auto& variant : stats.variants) num_exported_secs += variant.num_exported_secs;
+    for (std::size_t i = 0; i < variants.size(); i++) {
+        EXPECT_EQ(stats.variants[i].name, variants[i].name);
+        EXPECT_LE(stats.variants[i].summary.lower_bound, optimal_cost + 1e-6);
+        // a variant imports only the SECs that the other variants exported
+        EXPECT_LE(stats.variants[i].num_imported_secs, num_exported_secs - stats.variants[i].num_exported_secs);
+    }
+}
+
+TEST_P(PortfolioFixture, testSingleVariantExportsWithoutImporting) {
+    auto graph = getGraph();
+    auto cost_map = getCostMap(graph);
+    auto prize_map = getPrizeMap(graph);
+    std::vector<PCTSPedge> heuristic_edges;
+    std::vector<SolverVariant> variants = {defaultSolverVariants().front()};
+    auto stats = solvePrizeCollectingTSPPortfolio(
+        graph, heuristic_edges, cost_map, prize_map, getQuota(), getRootVertex(), variants, 60
+    );
+    EXPECT_EQ(stats.summary.status, SCIP_STATUS_OPTIMAL);
+    ASSERT_EQ(stats.variants.size(), 1);
+    auto& variant = stats.variants.front();
+    EXPECT_EQ(stats.winner, 0);
+    // the tours and SECs in the shared pools are the variant's own
+    EXPECT_EQ(variant.num_imported_tours, 0);
+    EXPECT_EQ(variant.num_imported_secs, 0);
+    // every node exports the SECs separated at the node
+    auto num_secs = variant.summary.num_sec_disjoint_tour + variant.summary.num_sec_maxflow_mincut;
+    EXPECT_EQ(variant.num_exported_secs > 0, num_secs > 0);
+    EXPECT_LE(variant.num_exported_secs, num_secs);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TestPortfolio,
+    PortfolioFixture,
+    ::testing::Values(GraphType::COMPLETE4, GraphType::COMPLETE5, GraphType::COMPLETE25, GraphType::GRID8, GraphType::SUURBALLE)
+);
@@ -0,0 +1,86 @@
+/** Test pricing edge variables into a sparse core */
+
+#include "fixtures.hh"
+#include "pctsp/algorithms.hh"
+#include "pctsp/pricing.hh"
+
+typedef GraphFixture PricingFixture;
+
+TEST_P(PricingFixture, testNearestNeighborCoreEdges) {
+    auto graph = getGraph();
+    auto cost_map = getCostMap(graph);
+    addSelfLoopsToGraph(graph);
+    assignZeroCostToSelfLoops(graph, cost_map);
+    auto tour = getSmallTour();
+    auto first = tour.begin();
+    auto last = tour.end();
+    auto tour_edges = getEdgesInWalk(graph, first, last);
+    std::size_t k = 2;
+
+    auto core_edges = nearestNeighborCoreEdges(graph, cost_map, k, tour_edges);
+    std::set<PCTSPedge> core (core_edges.begin(), core_edges.end());
+    EXPECT_EQ(core.size(), core_edges.size());
+    EXPECT_LE(core_edges.size(), boost::num_edges(graph));
+    for (auto edge : tour_edges) EXPECT_EQ(core.count(edge), 1);
+    for (auto vertex : boost::make_iterator_range(boost::vertices(graph))) {
+        EXPECT_EQ(core.count(boost::edge(vertex, vertex, graph).first), 1);
+
+        // the core contains the k cheapest edges of every vertex
+        std::vector<CostNumberType> costs;
+        CostNumberType max_core_cost = 0;
+        std::size_t num_core_edges = 0;
+        for (auto edge : boost::make_iterator_range(boost::out_edges(vertex, graph))) {
+            if (boost::source(edge, graph) == boost::target(edge, graph)) continue;
+            costs.push_back(cost_map[edge]);
+            if (core.count(edge) > 0) {
+                num_core_edges++;
+                max_core_cost = std::max(max_core_cost, cost_map[edge]);
+            }
+        }
+        std::sort(costs.begin(), costs.end());
+        EXPECT_GE(num_core_edges, std::min(k, costs.size()));
+        if (costs.size() > k) {
+            EXPECT_GE(max_core_cost, costs[k - 1]);
+        }
+    }
+}
+
+TEST_P(PricingFixture, testSolveWithPricing) {
+    auto graph = getGraph();
+    if (!isCompleteGraph(graph)) GTEST_SKIP();
+    auto pricing_graph = getGraph();
+    auto quota = getQuota();
+    auto root_vertex = getRootVertex();
+    std::filesystem::path log_dir = ".logs";
+
+    // solve the full model and the model that prices edges into a core of two neighbours
+    std::vector<double> objective_values;
+    for (int pricing_num_neighbors : {0, 2}) {
+        auto& model_graph = pricing_num_neighbors > 0 ? pricing_graph : graph;
+        auto cost_map = getCostMap(model_graph);
+        auto prize_map = getPrizeMap(model_graph);
+        std::vector<PCTSPedge> heuristic_edges;
+        std::string name = "test-pricing-" + std::to_string(pricing_num_neighbors);
+        SCIP* scip = NULL;
+        SCIPcreate(&scip);
+        solvePrizeCollectingTSP(
+            scip, model_graph, heuristic_edges, cost_map, prize_map, quota, root_vertex,
+            -1, BranchingStrategy::RELPSCOST, false, false, false, {}, name,
+            true, 0.01, true, -1, 1, true, log_dir, 60, false, pricing_num_neighbors
+        );
+        EXPECT_EQ(SCIPgetStatus(scip), SCIP_STATUS_OPTIMAL);
+        objective_values.push_back(SCIPgetPrimalbound(scip));
+        if (pricing_num_neighbors > 0) {
+            EXPECT_NE(findEdgePricer(scip), nullptr);
+            EXPECT_LE(SCIPgetNOrigVars(scip), boost::num_edges(model_graph));
+        }
+        SCIPfree(&scip);
+    }
+    EXPECT_DOUBLE_EQ(objective_values[0], objective_values[1]);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TestPricing,
+    PricingFixture,
+    ::testing::Values(GraphType::COMPLETE4, GraphType::COMPLETE5, GraphType::COMPLETE25, GraphType::GRID8, GraphType::SUURBALLE)
+);
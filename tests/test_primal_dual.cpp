@@ -0,0 +1,152 @@
+/** Test the Goemans-Williamson tree, strong pruning and the primal-dual tour */
+
+#include "pctsp/primal_dual.hh"
+#include "fixtures.hh"
+#include <gtest/gtest.h>
+#include <random>
+
+typedef GraphFixture PrimalDualFixture;
+
+/** Cost of the minimum spanning tree over the chosen vertices, or infinity if they are disconnected */
+double minimumSpanningTreeCost(std::size_t n, const std::vector<PrimalDualEdge>& edges, std::vector<bool>& chosen, std::size_t root) {
+    std::vector<bool> in_tree (n, false);
+    in_tree[root] = true;
+    double cost = 0.0;
+    std::size_t num_chosen = std::count(chosen.begin(), chosen.end(), true);
+    for (std::size_t added = 1; added < num_chosen; added++) {
+        double cheapest = std::numeric_limits<double>::infinity();
+        std::size_t next = n;
+        for (auto& edge : edges) {
+            if (!chosen[edge.source] || !chosen[edge.target]) continue;
+            if (in_tree[edge.source] == in_tree[edge.target]) continue;
+            if (edge.cost < cheapest) {
+                cheapest = edge.cost;
+                next = in_tree[edge.source] ? edge.target : edge.source;
+            }
+        }
+        if (next == n) return std::numeric_limits<double>::infinity();
+        in_tree[next] = true;
+        cost += cheapest;
+    }
+    return cost;
+}
+
+TEST(TestPrimalDual, testGoemansWilliamsonOnPath) {
+    std::vector<PrimalDualEdge> edges = {{0, 1, 2.0}, {1, 2, 2.0}};
+    std::vector<double> penalties = {0.0, 3.0, 3.0};
+    auto tree = goemansWilliamsonTree(3, edges, penalties, 0);
+    // vertices 1 and 2 merge at time 1, then reach the root at time 2
+    EXPECT_DOUBLE_EQ(tree.dual_objective, 3.0);
+    EXPECT_EQ(tree.edges, std::vector<std::size_t>({1, 0}));
+    EXPECT_EQ(strongPruning(3, edges, tree.edges, penalties, 0).size(), 2);
+
+    // the penalties do not pay for the edges
+    penalties = {0.0, 1.0, 1.0};
+    tree = goemansWilliamsonTree(3, edges, penalties, 0);
+    EXPECT_DOUBLE_EQ(tree.dual_objective, 2.0);
+    EXPECT_TRUE(tree.edges.empty());
+}
+
+TEST(TestPrimalDual, testStrongPruning) {
+    // a star around the root with one branch that is not worth its edge
+    std::vector<PrimalDualEdge> edges = {{0, 1, 1.0}, {0, 2, 5.0}, {2, 3, 1.0}};
+    std::vector<double> penalties = {0.0, 2.0, 1.0, 1.0};
+    std::vector<std::size_t> tree_edges = {0, 1, 2};
+    EXPECT_EQ(strongPruning(4, edges, tree_edges, penalties, 0), std::vector<std::size_t>({0}));
+    penalties[3] = 10.0;
+    EXPECT_EQ(strongPruning(4, edges, tree_edges, penalties, 0), std::vector<std::size_t>({0, 1, 2}));
+}
+
+TEST(TestPrimalDual, testDualIsLowerBoundOnOptimalTree) {
+    std::mt19937 generator (1);
+    std::uniform_int_distribution<int> value (0, 10);
+    std::size_t n = 7;
+    for (int trial = 0; trial < 50; trial++) {
+        std::vector<PrimalDualEdge> edges;
+        for (std::size_t u = 0; u < n; u++)
+            for (std::size_t v = u + 1; v < n; v++)
+                if (value(generator) < 8) edges.push_back({u, v, (double) value(generator)});
+        std::vector<double> penalties (n);
+        for (auto& penalty : penalties) penalty = value(generator);
+        auto tree = goemansWilliamsonTree(n, edges, penalties, 0);
+        auto pruned = strongPruning(n, edges, tree.edges, penalties, 0);
+
+        // the pruned edges form a tree that contains the root
+        std::vector<bool> in_tree (n, false);
+        in_tree[0] = true;
+        for (auto e : pruned) in_tree[edges[e].source] = in_tree[edges[e].target] = true;
+        EXPECT_EQ((std::size_t) std::count(in_tree.begin(), in_tree.end(), true), pruned.size() + 1);
+        EXPECT_LT(minimumSpanningTreeCost(n, edges, in_tree, 0), std::numeric_limits<double>::infinity());
+
+        // brute force the optimal prize collecting Steiner tree
+        double optimal = std::numeric_limits<double>::infinity();
+        for (unsigned int subset = 0; subset < (1u << (n - 1)); subset++) {
+            std::vector<bool> chosen (n, false);
+            chosen[0] = true;
+            double penalty = 0.0;
+            for (std::size_t v = 1; v < n; v++) {
+                chosen[v] = (subset >> (v - 1)) & 1;
+                if (!chosen[v]) penalty += penalties[v];
+            }
+            optimal = std::min(optimal, minimumSpanningTreeCost(n, edges, chosen, 0) + penalty);
+        }
+        EXPECT_LE(tree.dual_objective, optimal + 1e-9);
+    }
+}
+
+TEST_P(PrimalDualFixture, testPrimalDualTour) {
+    auto graph = getGraph();
+    auto cost_map = getCostMap(graph);
+    auto prize_map = getPrizeMap(graph);
+    auto quota = getQuota();
+    auto root = getRootVertex();
+    std::list<PCTSPvertex> tour;
+    double lower_bound = primalDualTour(graph, tour, cost_map, prize_map, quota, root);
+
+    ASSERT_GT(tour.size(), 3);
+    EXPECT_EQ(tour.front(), root);
+    EXPECT_EQ(tour.back(), root);
+    EXPECT_GE(totalPrizeOfTour(prize_map, tour), quota);
+    std::vector<PCTSPvertex> distinct (tour.begin(), std::prev(tour.end()));
+    std::sort(distinct.begin(), distinct.end());
+    EXPECT_EQ(std::adjacent_find(distinct.begin(), distinct.end()), distinct.end());
+    auto first = tour.begin();
+    auto last = tour.end();
+    auto tour_edges = getEdgesInWalk(graph, first, last);
+    EXPECT_EQ(tour_edges.size(), tour.size() - 1);
+
+    EXPECT_GE(lower_bound, 0.0);
+    EXPECT_LE(lower_bound, totalCost(tour_edges, cost_map));
+
+    // the dense cost matrix gives the same tour
+    if (isCompleteGraph(graph)) {
+        PCTSPdenseCostMap dense_cost_map (graph, cost_map);
+        std::list<PCTSPvertex> dense_tour;
+        EXPECT_EQ(primalDualTour(graph, dense_tour, dense_cost_map, prize_map, quota, root), lower_bound);
+        EXPECT_EQ(dense_tour, tour);
+    }
+}
+
+TEST(TestPrimalDual, testInfeasibleQuota) {
+    PCTSPgraph graph (4);
+    for (int u = 0; u < 4; u++)
+        for (int v = u + 1; v < 4; v++)
+            boost::add_edge(u, v, graph);
+    EdgeCostMap cost_map = boost::get(edge_weight, graph);
+    VertexPrizeMap prize_map = boost::get(vertex_distance, graph);
+    for (auto edge : boost::make_iterator_range(boost::edges(graph))) cost_map[edge] = 1;
+    for (int u = 0; u < 4; u++) prize_map[u] = 1;
+    std::list<PCTSPvertex> tour;
+    EXPECT_EQ(primalDualTour(graph, tour, cost_map, prize_map, 5, 0), 0.0);
+    EXPECT_TRUE(tour.empty());
+
+    // a triangle is the smallest tour even when the root alone meets the quota
+    EXPECT_GE(primalDualTour(graph, tour, cost_map, prize_map, 1, 0), 0.0);
+    EXPECT_EQ(tour.size(), 4);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TestPrimalDual,
+    PrimalDualFixture,
+    ::testing::Values(GraphType::COMPLETE4, GraphType::COMPLETE5, GraphType::COMPLETE25, GraphType::GRID8, GraphType::SUURBALLE)
+);
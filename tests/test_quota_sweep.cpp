@@ -0,0 +1,52 @@
+/** Test solving the prize collecting TSP for a list of quotas */
+
+#include "fixtures.hh"
+#include "pctsp/algorithms.hh"
+#include "pctsp/quota_sweep.hh"
+
+typedef GraphFixture QuotaSweepFixture;
+
+TEST_P(QuotaSweepFixture, testSolveQuotaSweep) {
+    auto root_vertex = getRootVertex();
+    std::filesystem::path log_dir = ".logs";
+    std::vector<PrizeNumberType> quotas = {getQuota(), getQuota() / 2};
+
+    auto graph = getGraph();
+    auto cost_map = getCostMap(graph);
+    auto prize_map = getPrizeMap(graph);
+    SCIP* scip = NULL;
+    SCIPcreate(&scip);
+    auto frontier = solveQuotaSweep(scip, graph, cost_map, prize_map, quotas, root_vertex);
+    SCIPfree(&scip);
+    ASSERT_EQ(frontier.size(), quotas.size());
+    EXPECT_LT(frontier[0].quota, frontier[1].quota);
+    EXPECT_EQ(frontier[0].num_kept_secs, 0);
+
+    // every point of the sweep is the optimal tour of its quota
+    for (auto& point : frontier) {
+        EXPECT_EQ(point.status, SCIP_STATUS_OPTIMAL);
+        EXPECT_GE(point.prize, point.quota);
+        EXPECT_EQ(totalCost(point.solution_edges, cost_map), point.upper_bound);
+
+        auto quota_graph = getGraph();
+        auto quota_cost_map = getCostMap(quota_graph);
+        auto quota_prize_map = getPrizeMap(quota_graph);
+        std::vector<PCTSPedge> heuristic_edges;
+        std::string name = "test-quota-sweep-" + std::to_string(point.quota);
+        SCIPcreate(&scip);
+        solvePrizeCollectingTSP(
+            scip, quota_graph, heuristic_edges, quota_cost_map, quota_prize_map, point.quota, root_vertex,
+            -1, BranchingStrategy::RELPSCOST, false, false, false, {}, name,
+            true, 0.01, true, -1, 1, true, log_dir, 60
+        );
+        EXPECT_DOUBLE_EQ(point.upper_bound, SCIPgetPrimalbound(scip));
+        SCIPfree(&scip);
+    }
+    EXPECT_LE(frontier[0].upper_bound, frontier[1].upper_bound);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TestQuotaSweep,
+    QuotaSweepFixture,
+    ::testing::Values(GraphType::COMPLETE4, GraphType::COMPLETE5, GraphType::COMPLETE25, GraphType::GRID8, GraphType::SUURBALLE)
+);
@@ -0,0 +1,53 @@
+/** Test solving the root LP relaxation */
+
+#include "fixtures.hh"
+#include "pctsp/algorithms.hh"
+#include "pctsp/relaxation.hh"
+
+typedef GraphFixture RelaxationFixture;
+
+TEST_P(RelaxationFixture, testSolveRootRelaxation) {
+    auto quota = getQuota();
+    auto root_vertex = getRootVertex();
+    std::filesystem::path log_dir = ".logs";
+
+    // the root relaxation bounds the optimal tour from below
+    auto graph = getGraph();
+    auto cost_map = getCostMap(graph);
+    auto prize_map = getPrizeMap(graph);
+    std::vector<PCTSPedge> heuristic_edges;
+    SCIP* scip = NULL;
+    SCIPcreate(&scip);
+    auto stats = solveRootRelaxation(scip, graph, heuristic_edges, cost_map, prize_map, quota, root_vertex);
+    // the root LP was solved: the root has degree two and edges have positive cost
+    EXPECT_NE(stats.status, SCIP_STATUS_UNKNOWN);
+    EXPECT_LT(stats.lower_bound, SCIPinfinity(scip));
+    EXPECT_GT(stats.lower_bound, 0);
+    SCIPfree(&scip);
+
+    auto exact_graph = getGraph();
+    auto exact_cost_map = getCostMap(exact_graph);
+    auto exact_prize_map = getPrizeMap(exact_graph);
+    std::string name = "test-root-relaxation";
+    SCIPcreate(&scip);
+    solvePrizeCollectingTSP(
+        scip, exact_graph, heuristic_edges, exact_cost_map, exact_prize_map, quota, root_vertex,
+        -1, BranchingStrategy::RELPSCOST, false, false, false, {}, name,
+        true, 0.01, true, -1, 1, true, log_dir, 60
+    );
+    EXPECT_EQ(SCIPgetStatus(scip), SCIP_STATUS_OPTIMAL);
+    EXPECT_LE(stats.lower_bound, SCIPgetPrimalbound(scip) + 1e-6);
+    EXPECT_GE(stats.num_separation_rounds, 0);
+    EXPECT_GE(stats.num_lp_iterations, 1);
+    EXPECT_GE(stats.solving_time, 0);
+    EXPECT_EQ(stats.num_cycle_cover, 0);
+    EXPECT_EQ(stats.num_cost_cover_disjoint_paths, 0);
+    EXPECT_EQ(stats.num_cost_cover_shortest_paths, 0);
+    SCIPfree(&scip);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TestRelaxation,
+    RelaxationFixture,
+    ::testing::Values(GraphType::COMPLETE4, GraphType::COMPLETE5, GraphType::COMPLETE25, GraphType::GRID8, GraphType::SUURBALLE)
+);
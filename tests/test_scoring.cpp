@@ -0,0 +1,96 @@
+/** Test the vectorized scoring kernels agree with the scalar loop */
+
+#include "pctsp/scoring.hh"
+#include <gtest/gtest.h>
+#include <random>
+
+class ScoringKernelFixture : public::testing::TestWithParam<unsigned int> {};
+
+TEST_P(ScoringKernelFixture, testArgmaxUnitaryGain) {
+    auto kernel = GetParam();
+    if (!isScoringKernelSupported(kernel)) GTEST_SKIP();
+    std::mt19937 generator (1);
+    std::uniform_int_distribution<int> cost (0, 20);
+    std::bernoulli_distribution adjacent (0.8);
+    // include lengths that do not fill the vector registers
+    for (int n : {0, 1, 3, 4, 7, 8, 9, 17, 64, 101}) {
+        for (int trial = 0; trial < 20; trial++) {
+            std::vector<CostNumberType> cost_to_tour (n + 1);
+            std::vector<int> is_adjacent (n + 1);
+            std::vector<CostNumberType> tour_cost (n);
+            for (int i = 0; i <= n; i++) {
+                cost_to_tour[i] = cost(generator);
+                is_adjacent[i] = adjacent(generator);
+            }
+            // costs that break the triangle inequality give zero and negative denominators
+            for (int i = 0; i < n; i++) tour_cost[i] = cost(generator);
+            PrizeNumberType prize = trial % 5;
+            auto expected = argmaxUnitaryGain(prize, cost_to_tour.data(), is_adjacent.data(), tour_cost.data(), n, ScoringKernel::SCALAR);
+            auto actual = argmaxUnitaryGain(prize, cost_to_tour.data(), is_adjacent.data(), tour_cost.data(), n, kernel);
+            EXPECT_EQ(actual.index, expected.index);
+            EXPECT_EQ(actual.value, expected.value);
+        }
+    }
+}
+
+TEST_P(ScoringKernelFixture, testArgmaxUnitaryGainTies) {
+    auto kernel = GetParam();
+    if (!isScoringKernelSupported(kernel)) GTEST_SKIP();
+    int n = 20;
+    std::vector<CostNumberType> cost_to_tour (n + 1, 2);
+    std::vector<int> is_adjacent (n + 1, 1);
+    std::vector<CostNumberType> tour_cost (n, 1);
+    is_adjacent[0] = 0;
+    auto best = argmaxUnitaryGain(3, cost_to_tour.data(), is_adjacent.data(), tour_cost.data(), n, kernel);
+    EXPECT_EQ(best.index, 1);
+    EXPECT_EQ(best.value, 1.0);
+
+    // no positive gain
+    best = argmaxUnitaryGain(0, cost_to_tour.data(), is_adjacent.data(), tour_cost.data(), n, kernel);
+    EXPECT_EQ(best.index, -1);
+}
+
+TEST_P(ScoringKernelFixture, testArgminUnitaryLoss) {
+    auto kernel = GetParam();
+    if (!isScoringKernelSupported(kernel)) GTEST_SKIP();
+    std::mt19937 generator (1);
+    std::uniform_int_distribution<int> value (0, 10);
+    for (int n : {0, 1, 3, 4, 7, 8, 9, 17, 64, 101}) {
+        for (int trial = 0; trial < 20; trial++) {
+            std::vector<CostNumberType> external_cost (n);
+            std::vector<PrizeNumberType> external_prize (n);
+            for (int i = 0; i < n; i++) {
+                external_cost[i] = value(generator);
+                external_prize[i] = value(generator);
+            }
+            CostNumberType internal_cost = value(generator);
+            PrizeNumberType internal_prize = value(generator);
+            auto expected = argminUnitaryLoss(external_cost.data(), external_prize.data(), internal_cost, internal_prize, n, ScoringKernel::SCALAR);
+            auto actual = argminUnitaryLoss(external_cost.data(), external_prize.data(), internal_cost, internal_prize, n, kernel);
+            EXPECT_EQ(actual.index, expected.index);
+            EXPECT_EQ(actual.value, expected.value);
+        }
+    }
+}
+
+TEST_P(ScoringKernelFixture, testArgminUnitaryLossTies) {
+    auto kernel = GetParam();
+    if (!isScoringKernelSupported(kernel)) GTEST_SKIP();
+    int n = 12;
+    std::vector<CostNumberType> external_cost (n, 5);
+    std::vector<PrizeNumberType> external_prize (n, 3);
+    external_prize[0] = 1;  // not more prize than the internal path
+    auto best = argminUnitaryLoss(external_cost.data(), external_prize.data(), 1, 1, n, kernel);
+    EXPECT_EQ(best.index, 1);
+    EXPECT_EQ(best.value, 2.0);
+
+    // no external path has more prize
+    best = argminUnitaryLoss(external_cost.data(), external_prize.data(), 1, 3, n, kernel);
+    EXPECT_EQ(best.index, -1);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TestScoring,
+    ScoringKernelFixture,
+    ::testing::Values(ScoringKernel::AUTO, ScoringKernel::SCALAR, ScoringKernel::SSE41, ScoringKernel::AVX2)
+);
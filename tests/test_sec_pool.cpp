@@ -0,0 +1,183 @@
+#include "pctsp/algorithms.hh"
+#include "pctsp/event_handlers.hh"
+#include "pctsp/subtour_elimination.hh"
+#include "fixtures.hh"
+#include <objscip/objscip.h>
+#include <objscip/objscipdefplugins.h>
+
+typedef GraphFixture SECPoolFixture;
+
+TEST_P(SECPoolFixture, testManagedSECRowsFindOptimalTour) {
+    auto quota = getQuota();
+    auto root_vertex = getRootVertex();
+    std::vector<double> optimal_costs;
+    for (bool manage : {false, true}) {
+        auto graph = getGraph();
+        auto cost_map = getCostMap(graph);
+        auto prize_map = getPrizeMap(graph);
+        std::vector<PCTSPedge> heuristic_edges;
+        std::string name = "test-sec-pool";
+        SCIP* scip = NULL;
+        SCIPcreate(&scip);
+        modelPrizeCollectingTSP(scip, graph, heuristic_edges, cost_map, prize_map, quota, root_vertex, name);
+        SCIPincludeObjEventhdlr(scip, new NodeEventhdlr(scip), TRUE);
+        auto sec_conshdlr = dynamic_cast<PCTSPconshdlrSubtour*>(SCIPfindObjConshdlr(scip, SEC_CONSHDLR_NAME.c_str()));
+        // rows leave the LP after a single slack round
+        if (manage) {
+            sec_conshdlr->setManageSECRows(scip, true, 1);
+            // the rows are aged once per solved LP
+            EXPECT_NE(SCIPfindObjEventhdlr(scip, SEC_POOL_EVENTHDLR_NAME.c_str()), nullptr);
+        }
+        SCIPsolve(scip);
+        EXPECT_EQ(SCIPgetStatus(scip), SCIP_STATUS_OPTIMAL);
+        optimal_costs.push_back(SCIPgetPrimalbound(scip));
+
+        auto summary = getSummaryStatsFromSCIP(scip);
+        auto num_secs = summary.num_sec_disjoint_tour + summary.num_sec_maxflow_mincut;
+        auto stats = sec_conshdlr->getSECRowPool().getStats();
+        if (manage) {
+            // every separated SEC is either a row of the pool or dominated by one
+            if (num_secs > 0) EXPECT_GT(stats.num_rows + stats.num_dominated, 0);
+            // max flow only stops for a round in which the pool added rows
+            EXPECT_LE(stats.num_maxflow_skipped, stats.num_readded);
+        }
+        else {
+            EXPECT_EQ(stats.num_rows, 0);
+            EXPECT_EQ(stats.num_readded, 0);
+            EXPECT_EQ(stats.num_dominated, 0);
+        }
+        SCIPfree(&scip);
+    }
+    EXPECT_DOUBLE_EQ(optimal_costs[0], optimal_costs[1]);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TestSECPool,
+    SECPoolFixture,
+    ::testing::Values(GraphType::COMPLETE4, GraphType::COMPLETE5, GraphType::COMPLETE25, GraphType::GRID8, GraphType::SUURBALLE)
+);
+
+/** Runs the pool against a fixed solution in the first separation round of the root */
+class SECPoolTestSepa : public scip::ObjSepa {
+public:
+    bool executed;
+
+    SECPoolTestSepa(SCIP* scip)
+        : ObjSepa(scip, "sec_pool_test", "exercise the SEC row pool", 1000000, 0, 1.0, FALSE, FALSE),
+          executed(false) {}
+
+    SCIP_RETCODE createRow(SCIP* scip, SCIP_SEPA* sepa, const char* name, std::vector<int> var_ids, double rhs, SCIP_ROW** row) {
+        SCIP_VAR** vars = SCIPgetVars(scip);
+        SCIP_CALL(SCIPcreateEmptyRowSepa(scip, row, sepa, name, -SCIPinfinity(scip), rhs, FALSE, FALSE, TRUE));
+        for (int i : var_ids) SCIP_CALL(SCIPaddVarToRow(scip, *row, vars[i], 1.0));
+        return SCIP_OKAY;
+    }
+
+    virtual SCIP_DECL_SEPAEXECLP(scip_execlp) {
+        *result = SCIP_DIDNOTFIND;
+        if (executed) return SCIP_OKAY;
+        executed = true;
+
+        // every variable is one, so the rows over two variables are violated by one
+        SCIP_SOL* sol;
+        SCIP_CALL(SCIPcreateSol(scip, &sol, NULL));
+        for (int i = 0; i < SCIPgetNVars(scip); i++) SCIP_CALL(SCIPsetSolVal(scip, sol, SCIPgetVars(scip)[i], 1.0));
+
+        SECRowPool pool;
+        SCIP_ROW* row_a;
+        SCIP_ROW* row_b;
+        SCIP_ROW* row_c;
+        SCIP_CALL(createRow(scip, sepa, "sec-a", {0, 1}, 1.0, &row_a));
+        SCIP_CALL(createRow(scip, sepa, "sec-b", {1, 2}, 1.0, &row_b));
+        SCIP_CALL(createRow(scip, sepa, "sec-c", {0}, 1.0, &row_c));
+        std::vector<PCTSPvertex> set_a = {1, 2, 3};
+        std::vector<PCTSPvertex> set_b = {3, 4};
+        std::vector<PCTSPvertex> set_c = {5};
+        SCIP_CALL(pool.addRow(scip, row_a, set_a, 1));
+        SCIP_CALL(pool.addRow(scip, row_b, set_b, 3));
+        SCIP_CALL(pool.addRow(scip, row_c, set_c, 5));
+        SCIP_CALL(SCIPreleaseRow(scip, &row_a));
+        SCIP_CALL(SCIPreleaseRow(scip, &row_b));
+        SCIP_CALL(SCIPreleaseRow(scip, &row_c));
+        EXPECT_EQ(pool.getStats().num_rows, 3);
+
+        // a row that is not pooled over a nested set with the same target dominates without being added
+        bool dominated;
+        std::vector<PCTSPvertex> superset = {1, 2, 3, 4};
+        SCIP_CALL(pool.findDominatingRow(scip, sol, result, superset, 1, 0.5, dominated));
+        EXPECT_TRUE(dominated);
+        std::vector<PCTSPvertex> subset = {1, 2};
+        SCIP_CALL(pool.findDominatingRow(scip, sol, result, subset, 1, 0.5, dominated));
+        EXPECT_TRUE(dominated);
+        EXPECT_EQ(*result, SCIP_DIDNOTFIND);
+
+        // another target, a set that is not nested or a larger violation is not dominated
+        SCIP_CALL(pool.findDominatingRow(scip, sol, result, set_a, 2, 0.5, dominated));
+        EXPECT_FALSE(dominated);
+        std::vector<PCTSPvertex> crossing = {1, 4};
+        SCIP_CALL(pool.findDominatingRow(scip, sol, result, crossing, 1, 0.5, dominated));
+        EXPECT_FALSE(dominated);
+        SCIP_CALL(pool.findDominatingRow(scip, sol, result, set_a, 1, 2.0, dominated));
+        EXPECT_FALSE(dominated);
+        EXPECT_EQ(pool.getStats().num_dominated, 2);
+
+        // none of the rows is in the LP, so every row is pooled
+        pool.ageRows(scip);
+        EXPECT_EQ(pool.getStats().num_pooled, 3);
+
+        // a pooled row that dominates is added to the LP
+        std::vector<PCTSPvertex> superset_b = {3, 4, 6};
+        SCIP_CALL(pool.findDominatingRow(scip, sol, result, superset_b, 3, 0.5, dominated));
+        EXPECT_TRUE(dominated);
+        EXPECT_EQ(*result, SCIP_SEPARATED);
+        auto stats = pool.getStats();
+        EXPECT_EQ(stats.num_readded, 1);
+        EXPECT_EQ(stats.num_dominated, 3);
+        EXPECT_EQ(stats.num_pooled, 2);
+
+        // only the violated pooled row is added again, the satisfied row stays in the pool
+        int num_rows_added = 0;
+        SCIP_CALL(pool.separate(scip, sol, result, num_rows_added));
+        EXPECT_EQ(num_rows_added, 1);
+        stats = pool.getStats();
+        EXPECT_EQ(stats.num_readded, 2);
+        EXPECT_EQ(stats.num_pooled, 1);
+        num_rows_added = 0;
+        SCIP_CALL(pool.separate(scip, sol, result, num_rows_added));
+        EXPECT_EQ(num_rows_added, 0);
+
+        SCIP_CALL(pool.clear(scip));
+        EXPECT_EQ(pool.getStats().num_rows, 3);
+        SCIP_CALL(SCIPfreeSol(scip, &sol));
+        return SCIP_OKAY;
+    }
+};
+
+TEST(TestSECPool, testFindDominatingRowAndSeparate) {
+    // max x0 + x1 + x2 s.t. x0 + x1 + x2 <= 1.5 has a fractional LP, so the root is separated
+    SCIP* scip = NULL;
+    SCIPcreate(&scip);
+    SCIPincludeDefaultPlugins(scip);
+    SCIPsetMessagehdlrQuiet(scip, TRUE);
+    SCIPsetPresolving(scip, SCIP_PARAMSETTING_OFF, TRUE);
+    SCIPcreateProbBasic(scip, "test-sec-pool-unit");
+    SCIPsetObjsense(scip, SCIP_OBJSENSE_MAXIMIZE);
+    std::vector<SCIP_VAR*> vars (3);
+    for (int i = 0; i < 3; i++) {
+        std::string var_name = "x" + std::to_string(i);
+        SCIPcreateVarBasic(scip, &vars[i], var_name.c_str(), 0.0, 1.0, 1.0, SCIP_VARTYPE_BINARY);
+        SCIPaddVar(scip, vars[i]);
+    }
+    std::vector<double> coefs (3, 1.0);
+    SCIP_CONS* cons;
+    SCIPcreateConsBasicLinear(scip, &cons, "sum", 3, vars.data(), coefs.data(), -SCIPinfinity(scip), 1.5);
+    SCIPaddCons(scip, cons);
+    SCIPreleaseCons(scip, &cons);
+    for (auto& var : vars) SCIPreleaseVar(scip, &var);
+
+    auto sepa = new SECPoolTestSepa(scip);
+    SCIPincludeObjSepa(scip, sepa, TRUE);
+    SCIPsolve(scip);
+    EXPECT_TRUE(sepa->executed);
+    SCIPfree(&scip);
+}
@@ -123,3 +123,59 @@ TEST(TestSeparation, testIsSimpleCycle) {
     auto edge_vector3 = getEdgeVectorOfGraph(graph1);
     EXPECT_FALSE(isSimpleCycle(graph1, edge_vector3));
 }
+
+TEST(TestSeparation, testUnionFindViolatedSets) {
+    // the root triangle {0, 1, 2} is joined to the subtour {3, 4, 5}
+    VertexPairVector edges = {{0, 1}, {1, 2}, {0, 2}, {3, 4}, {4, 5}, {3, 5}, {2, 3}};
+    std::vector<double> edge_values = {0.8, 0.8, 0.8, 1.0, 1.0, 1.0, 0.5};
+    std::vector<double> vertex_values = {1.0, 1.0, 1.0, 0.5, 1.0, 1.0};
+    PCTSPvertex root_vertex = 0;
+    auto violated_sets = unionFindViolatedSets(6, edges, edge_values, vertex_values, root_vertex, 1e-6);
+    EXPECT_EQ(violated_sets.size(), 1);
+    std::vector<PCTSPvertex> expected_set = {3, 4, 5};
+    EXPECT_EQ(violated_sets[0].vertex_set, expected_set);
+    EXPECT_EQ(violated_sets[0].targets, expected_set);
+
+    // a path of three vertices satisfies every SEC
+    VertexPairVector path_edges = {{0, 1}, {1, 2}, {0, 2}, {3, 4}, {4, 5}, {2, 3}};
+    std::vector<double> path_values = {0.8, 0.8, 0.8, 1.0, 1.0, 0.5};
+    std::vector<double> path_vertex_values (6, 1.0);
+    EXPECT_EQ(unionFindViolatedSets(6, path_edges, path_values, path_vertex_values, root_vertex, 1e-6).size(), 0);
+}
+
+TEST(TestSeparation, testShrinkSupportGraph) {
+    // the path 1-2-3 is integral and the half paths 3-4-0 and 3-5-0 close the tour
+    VertexPairVector edges = {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {3, 5}, {0, 4}, {0, 5}};
+    std::vector<double> edge_values = {1.0, 1.0, 1.0, 0.5, 0.5, 0.5, 0.5};
+    std::vector<double> vertex_values = {1.0, 1.0, 1.0, 1.0, 0.5, 0.5};
+    PCTSPvertex root_vertex = 0;
+    auto shrunk = shrinkSupportGraph(edges, edge_values, vertex_values, root_vertex, 1e-6);
+    VertexPairVector expected_edges = {{0, 1}};
+    EXPECT_EQ(shrunk.edges, expected_edges);
+    EXPECT_DOUBLE_EQ(shrunk.edge_values[0], 2.0);
+    std::vector<PCTSPvertex> expected_root_members = {0};
+    std::vector<PCTSPvertex> expected_members = {1, 2, 3, 4, 5};
+    EXPECT_EQ(shrunk.members[0], expected_root_members);
+    EXPECT_EQ(shrunk.members[1], expected_members);
+}
+
+TEST(TestSeparation, testShrinkSupportGraphKeepsRootAlone) {
+    // x_ru = 1 and the triangle u, w1, w2 has x = 0.5 on each edge, twice over
+    // the SEC of {u, w1, w2} with target u is violated: 1.5 > y(S) - y_u = 1
+    VertexPairVector edges = {{0, 1}, {1, 2}, {1, 3}, {2, 3}, {0, 4}, {4, 5}, {4, 6}, {5, 6}};
+    std::vector<double> edge_values = {1.0, 0.5, 0.5, 0.5, 1.0, 0.5, 0.5, 0.5};
+    std::vector<double> vertex_values = {1.0, 1.0, 0.5, 0.5, 1.0, 0.5, 0.5};
+    PCTSPvertex root_vertex = 0;
+    auto shrunk = shrinkSupportGraph(edges, edge_values, vertex_values, root_vertex, 1e-6);
+    VertexPairVector expected_edges = {{0, 1}, {0, 4}, {1, 3}, {4, 6}};
+    EXPECT_EQ(shrunk.edges, expected_edges);
+    for (double value : shrunk.edge_values) EXPECT_DOUBLE_EQ(value, 1.0);
+
+    // u stays apart from the root, so the min cut from the root to u is {u, w1, w2}
+    std::vector<PCTSPvertex> expected_root_members = {0};
+    std::vector<PCTSPvertex> expected_u_members = {1, 2};
+    std::vector<PCTSPvertex> expected_w2_members = {3};
+    EXPECT_EQ(shrunk.members[0], expected_root_members);
+    EXPECT_EQ(shrunk.members[1], expected_u_members);
+    EXPECT_EQ(shrunk.members[3], expected_w2_members);
+}
@@ -0,0 +1,132 @@
+#include "pctsp/algorithms.hh"
+#include "pctsp/separation_controller.hh"
+#include "fixtures.hh"
+#include <objscip/objscip.h>
+
+TEST(TestSeparationController, testRunsUntilWindowIsFull) {
+    SCIP* scip = NULL;
+    SCIPcreate(&scip);
+    {
+        // the controller frees its name with SCIP, so it goes out of scope first
+        SeparationController controller (scip, 2, 0.5, 3);
+        EXPECT_TRUE(controller.shouldRun(MAXFLOW_MINCUT_SEPARATOR, false));
+        controller.recordCall(MAXFLOW_MINCUT_SEPARATOR, 0.5, 3);
+        auto stats = controller.getSeparatorStats(MAXFLOW_MINCUT_SEPARATOR);
+        EXPECT_EQ(stats.num_calls, 1);
+        EXPECT_EQ(stats.num_cuts, 3);
+        EXPECT_EQ(stats.num_skipped, 0);
+        EXPECT_EQ(controller.getSeparatorStats(CYCLE_COVER_SEPARATOR).num_calls, 0);
+    }
+    SCIPfree(&scip);
+}
+
+TEST(TestSeparationController, testSkipsSeparatorWithDiminishingReturns) {
+    SCIP* scip = NULL;
+    SCIPcreate(&scip);
+    {
+        SeparationController controller (scip, 2, 0.5, 3);
+        // max flow buys a tenth of the bound improvement per second of disjoint tour
+        for (int i = 0; i < 2; i++) {
+            controller.recordRound(MAXFLOW_MINCUT_SEPARATOR, 1.0, 0.1);
+            controller.recordRound(DISJOINT_TOUR_SEPARATOR, 0.1, 1.0);
+        }
+        EXPECT_TRUE(controller.shouldRun(DISJOINT_TOUR_SEPARATOR, false));
+        EXPECT_FALSE(controller.shouldRun(MAXFLOW_MINCUT_SEPARATOR, false));
+        EXPECT_FALSE(controller.shouldRun(MAXFLOW_MINCUT_SEPARATOR, false));
+        // the third call probes the throttled separator
+        EXPECT_TRUE(controller.shouldRun(MAXFLOW_MINCUT_SEPARATOR, false));
+        EXPECT_EQ(controller.getSeparatorStats(MAXFLOW_MINCUT_SEPARATOR).num_probes, 1);
+        EXPECT_FALSE(controller.shouldRun(MAXFLOW_MINCUT_SEPARATOR, false));
+        // the fallback always runs
+        EXPECT_TRUE(controller.shouldRun(MAXFLOW_MINCUT_SEPARATOR, true));
+        EXPECT_EQ(controller.getSeparatorStats(MAXFLOW_MINCUT_SEPARATOR).num_skipped, 3);
+        EXPECT_EQ(controller.getSeparatorStats(MAXFLOW_MINCUT_SEPARATOR).num_probes, 1);
+        EXPECT_EQ(controller.getSeparatorStats(DISJOINT_TOUR_SEPARATOR).num_skipped, 0);
+        EXPECT_EQ(controller.getSeparatorStats(DISJOINT_TOUR_SEPARATOR).num_probes, 0);
+    }
+    SCIPfree(&scip);
+}
+
+typedef GraphFixture SeparationControllerFixture;
+
+TEST_P(SeparationControllerFixture, testControlledSeparationFindsOptimalTour) {
+    auto quota = getQuota();
+    auto root_vertex = getRootVertex();
+    std::filesystem::path log_dir = ".logs";
+    std::vector<PCTSPedge> heuristic_edges;
+    std::vector<double> optimal_costs;
+    for (bool controlled : {false, true}) {
+        auto graph = getGraph();
+        auto cost_map = getCostMap(graph);
+        auto prize_map = getPrizeMap(graph);
+        std::string name = "test-separation-controller";
+        SCIP* scip = NULL;
+        SCIPcreate(&scip);
+        // a short window and a high relative return throttle max flow often
+        if (controlled) includeSeparationController(scip, 2, 0.9, 3);
+        solvePrizeCollectingTSP(
+            scip, graph, heuristic_edges, cost_map, prize_map, quota, root_vertex,
+            -1, BranchingStrategy::RELPSCOST, false, false, false, {}, name,
+            true, 0.01, true, -1, 1, true, log_dir, 60, false, 0, false, false, 0, controlled
+        );
+        EXPECT_EQ(SCIPgetStatus(scip), SCIP_STATUS_OPTIMAL);
+        optimal_costs.push_back(SCIPgetPrimalbound(scip));
+        EXPECT_EQ(findSeparationController(scip) != nullptr, controlled);
+        SCIPfree(&scip);
+    }
+    EXPECT_DOUBLE_EQ(optimal_costs[0], optimal_costs[1]);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TestSeparationController,
+    SeparationControllerFixture,
+    ::testing::Values(GraphType::COMPLETE4, GraphType::COMPLETE5, GraphType::COMPLETE25, GraphType::GRID8, GraphType::SUURBALLE)
+);
+
+TEST(TestSeparationController, testMaxflowIsSkippedAndProbed) {
+    // eight triangles of cost one, joined in pairs at cost 3, in quads at cost 9 and at cost 27 otherwise
+    // the LP grows from triangles to pairs to quads, so disjoint tour separation finds SECs in three rounds
+    int num_vertices = 24;
+    PCTSPgraph graph;
+    std::vector<std::pair<int, int>> edges;
+    for (int u = 0; u < num_vertices; u++) {
+        for (int v = u + 1; v < num_vertices; v++) {
+            edges.push_back({u, v});
+            boost::add_edge(u, v, graph);
+        }
+    }
+    auto cost_map = boost::get(edge_weight, graph);
+    for (auto& [u, v] : edges) {
+        int cost = 27;
+        if (u / 3 == v / 3) cost = 1;
+        else if (u / 6 == v / 6) cost = 3;
+        else if (u / 12 == v / 12) cost = 9;
+        cost_map[boost::edge(u, v, graph).first] = cost;
+    }
+    auto prize_map = boost::get(vertex_distance, graph);
+    for (int vertex = 0; vertex < num_vertices; vertex++) prize_map[vertex] = vertex == 0 ? 0 : 1;
+    PrizeNumberType quota = num_vertices - 1;
+    PCTSPvertex root_vertex = 0;
+    std::vector<PCTSPedge> heuristic_edges;
+    std::string name = "test-separation-controller-skips-maxflow";
+    std::filesystem::path log_dir = ".logs";
+
+    SCIP* scip = NULL;
+    SCIPcreate(&scip);
+    // only the separator with the best return is never skipped, max flow is slower than disjoint tour
+    // separation for the same SECs, a window is full after one round and every second call is a probe
+    includeSeparationController(scip, 1, 1.0, 2);
+    solvePrizeCollectingTSP(
+        scip, graph, heuristic_edges, cost_map, prize_map, quota, root_vertex,
+        -1, BranchingStrategy::RELPSCOST, false, false, false, {}, name,
+        true, 0.01, true, -1, 1, true, log_dir, 60, false, 0, false, false, 0, true
+    );
+    EXPECT_EQ(SCIPgetStatus(scip), SCIP_STATUS_OPTIMAL);
+    auto controller = findSeparationController(scip);
+    ASSERT_NE(controller, nullptr);
+    auto stats = controller->getSeparatorStats(MAXFLOW_MINCUT_SEPARATOR);
+    EXPECT_GT(stats.num_skipped, 0);
+    EXPECT_GT(stats.num_probes, 0);
+    EXPECT_GT(stats.num_calls, stats.num_probes);
+    SCIPfree(&scip);
+}
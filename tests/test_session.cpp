@@ -0,0 +1,67 @@
+/** Test re-solving the prize collecting TSP after updating costs and prizes */
+
+#include "fixtures.hh"
+#include "pctsp/algorithms.hh"
+#include "pctsp/session.hh"
+
+typedef GraphFixture SessionFixture;
+
+TEST_P(SessionFixture, testSolverSessionUpdates) {
+    auto quota = getQuota();
+    auto root_vertex = getRootVertex();
+    std::filesystem::path log_dir = ".logs";
+
+    auto graph = getGraph();
+    auto cost_map = getCostMap(graph);
+    auto prize_map = getPrizeMap(graph);
+    SolverSession session (graph, cost_map, prize_map, quota, root_vertex);
+    auto first_stats = session.solve();
+    EXPECT_EQ(first_stats.summary.status, SCIP_STATUS_OPTIMAL);
+    EXPECT_EQ(first_stats.num_kept_secs, 0);
+    EXPECT_GE(first_stats.prize, quota);
+    ASSERT_GT(first_stats.solution_edges.size(), 0);
+
+    // make an edge of the optimal tour more expensive and a vertex more valuable
+    auto edge = first_stats.solution_edges.front();
+    auto u = boost::source(edge, session.getGraph());
+    auto v = boost::target(edge, session.getGraph());
+    CostNumberType new_cost = session.getCostMap()[edge] + 10;
+    PCTSPvertex vertex = 1;
+    PrizeNumberType new_prize = session.getPrizeMap()[vertex] + 1;
+    session.updateEdgeCost(u, v, new_cost);
+    session.updateVertexPrize(vertex, new_prize);
+    auto second_stats = session.solve();
+    EXPECT_EQ(second_stats.summary.status, SCIP_STATUS_OPTIMAL);
+    EXPECT_GE(second_stats.prize, quota);
+    EXPECT_EQ(totalCost(second_stats.solution_edges, session.getCostMap()), second_stats.summary.upper_bound);
+    EXPECT_LE(second_stats.summary.upper_bound, second_stats.warm_start_cost);
+
+    // the session finds the same optimal cost as a fresh model of the updated instance
+    auto fresh_graph = getGraph();
+    auto fresh_cost_map = getCostMap(fresh_graph);
+    auto fresh_prize_map = getPrizeMap(fresh_graph);
+    fresh_cost_map[boost::edge(u, v, fresh_graph).first] = new_cost;
+    fresh_prize_map[vertex] = new_prize;
+    std::vector<PCTSPedge> heuristic_edges;
+    std::string name = "test-session";
+    SCIP* scip = NULL;
+    SCIPcreate(&scip);
+    solvePrizeCollectingTSP(
+        scip, fresh_graph, heuristic_edges, fresh_cost_map, fresh_prize_map, quota, root_vertex,
+        -1, BranchingStrategy::RELPSCOST, false, false, false, {}, name,
+        true, 0.01, true, -1, 1, true, log_dir, 60
+    );
+    EXPECT_DOUBLE_EQ(second_stats.summary.upper_bound, SCIPgetPrimalbound(scip));
+    SCIPfree(&scip);
+
+    // updates must name edges and vertices of the graph
+    PCTSPvertex missing_vertex = boost::num_vertices(session.getGraph());
+    EXPECT_THROW(session.updateVertexPrize(missing_vertex, 1), VertexNotFoundException);
+    EXPECT_THROW(session.updateEdgeCost(root_vertex, missing_vertex, 1), VertexNotFoundException);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TestSession,
+    SessionFixture,
+    ::testing::Values(GraphType::COMPLETE4, GraphType::COMPLETE5, GraphType::COMPLETE25, GraphType::GRID8, GraphType::SUURBALLE)
+);
@@ -5,7 +5,7 @@
 #include <boost/filesystem.hpp>
 
 TEST(TestStats, testWriteNodeStatsToCSV) {
-    NodeStats node = { 5.2, 0, 0, 1, 0, 0, 2, 0, 7.0 };
+    NodeStats node = { 5.2, 0, 0, 1, 0, 0, 0, 2, 0, 7.0 };
     std::vector<NodeStats> stats = { node };
     std::filesystem::path file_path = ".logs/test_node_stats.csv";
     writeNodeStatsToCSV(stats, file_path);
@@ -20,8 +20,9 @@ TEST(TestYamlCpp, testYamlCppIsFound) {
 }
 
 TEST(TestYamlCpp, testWriteSummaryStatsToYaml) {
-    SummaryStats summary = {SCIP_Status::SCIP_STATUS_OPTIMAL, 1.0, 2.0, 2, 0, 1, 0, 1, 5, 0, 8};
+    SummaryStats summary = {SCIP_Status::SCIP_STATUS_OPTIMAL, 1.0, 2.0, 2, 0, 1, 0, 1, 5, 0, 8, 3};
     std::filesystem::path filename = ".logs/testWriteSummaryStatsToYaml.yaml";
     writeSummaryStatsToYaml(summary, filename);
     EXPECT_TRUE(std::filesystem::exists(filename));
+    EXPECT_EQ(readSummaryStatsFromYaml(filename).num_sec_union_find, 3);
 }
\ No newline at end of file
@@ -376,6 +376,127 @@ TEST_P(SubtourGraphFixture, testTailingOff) {
     SCIPfree(&scip);
 }
 
+TEST_P(SubtourGraphFixture, testUnionFindSeparation) {
+    auto quota = getQuota();
+    auto root_vertex = getRootVertex();
+    std::vector<double> optimal_costs;
+    for (bool union_find : {false, true}) {
+        auto graph = getGraph();
+        auto cost_map = getCostMap(graph);
+        auto prize_map = getPrizeMap(graph);
+        std::vector<PCTSPedge> heuristic_edges;
+        std::string name = "test-union-find-separation";
+        SCIP* scip = NULL;
+        SCIPcreate(&scip);
+        // without disjoint tour separation, union-find runs in every separation round
+        modelPrizeCollectingTSP(scip, graph, heuristic_edges, cost_map, prize_map, quota, root_vertex, name, false);
+        SCIPincludeObjEventhdlr(scip, new NodeEventhdlr(scip), TRUE);
+        auto sec_conshdlr = dynamic_cast<PCTSPconshdlrSubtour*>(SCIPfindObjConshdlr(scip, SEC_CONSHDLR_NAME.c_str()));
+        sec_conshdlr->setUnionFindSeparation(union_find);
+        EXPECT_EQ(sec_conshdlr->isSeparatingUnionFind(), union_find);
+        SCIPsolve(scip);
+        EXPECT_EQ(SCIPgetStatus(scip), SCIP_STATUS_OPTIMAL);
+        auto summary = getSummaryStatsFromSCIP(scip);
+        if (!union_find) EXPECT_EQ(summary.num_sec_union_find, 0);
+        optimal_costs.push_back(SCIPgetPrimalbound(scip));
+        SCIPfree(&scip);
+    }
+    EXPECT_DOUBLE_EQ(optimal_costs[0], optimal_costs[1]);
+}
+
+/**
+ * Complete graph over triangles of cost one, joined in pairs at cost 3 and at
+ * cost 9 otherwise. Every vertex but the root has prize one and the quota visits
+ * every vertex, so the first LP is a triangle on every vertex.
+ */
+void buildTrianglesInstance(PCTSPgraph& graph, EdgeCostMap& cost_map, VertexPrizeMap& prize_map, int num_vertices) {
+    for (int u = 0; u < num_vertices; u++) {
+        for (int v = u + 1; v < num_vertices; v++) boost::add_edge(u, v, graph);
+    }
+    cost_map = boost::get(edge_weight, graph);
+    for (auto edge : boost::make_iterator_range(boost::edges(graph))) {
+        auto u = boost::source(edge, graph);
+        auto v = boost::target(edge, graph);
+        int cost = 9;
+        if (u / 3 == v / 3) cost = 1;
+        else if (u / 6 == v / 6) cost = 3;
+        cost_map[edge] = cost;
+    }
+    prize_map = boost::get(vertex_distance, graph);
+    for (int vertex = 0; vertex < num_vertices; vertex++) prize_map[vertex] = vertex == 0 ? 0 : 1;
+}
+
+TEST(TestSubtourElimination, testUnionFindSeparatesTriangles) {
+    // the triangles away from the root are the components that union-find merges last
+    int num_vertices = 12;
+    PCTSPgraph graph;
+    EdgeCostMap cost_map;
+    VertexPrizeMap prize_map;
+    buildTrianglesInstance(graph, cost_map, prize_map, num_vertices);
+    PrizeNumberType quota = num_vertices - 1;
+    PCTSPvertex root_vertex = 0;
+    std::vector<PCTSPedge> heuristic_edges;
+    std::string name = "test-union-find-separates-triangles";
+    SCIP* scip = NULL;
+    SCIPcreate(&scip);
+    modelPrizeCollectingTSP(scip, graph, heuristic_edges, cost_map, prize_map, quota, root_vertex, name, false);
+    SCIPincludeObjEventhdlr(scip, new NodeEventhdlr(scip), TRUE);
+    auto sec_conshdlr = dynamic_cast<PCTSPconshdlrSubtour*>(SCIPfindObjConshdlr(scip, SEC_CONSHDLR_NAME.c_str()));
+    sec_conshdlr->setUnionFindSeparation(true);
+    SCIPsolve(scip);
+    EXPECT_EQ(SCIPgetStatus(scip), SCIP_STATUS_OPTIMAL);
+    auto summary = getSummaryStatsFromSCIP(scip);
+    EXPECT_GT(summary.num_sec_union_find, 0);
+    SCIPfree(&scip);
+}
+
+TEST_P(SubtourGraphFixture, testShrinkSupportGraph) {
+    auto quota = getQuota();
+    auto root_vertex = getRootVertex();
+    std::vector<double> optimal_costs;
+    for (bool shrink : {false, true}) {
+        auto graph = getGraph();
+        auto cost_map = getCostMap(graph);
+        auto prize_map = getPrizeMap(graph);
+        std::vector<PCTSPedge> heuristic_edges;
+        std::string name = "test-shrink-support-graph";
+        SCIP* scip = NULL;
+        SCIPcreate(&scip);
+        modelPrizeCollectingTSP(scip, graph, heuristic_edges, cost_map, prize_map, quota, root_vertex, name);
+        auto sec_conshdlr = dynamic_cast<PCTSPconshdlrSubtour*>(SCIPfindObjConshdlr(scip, SEC_CONSHDLR_NAME.c_str()));
+        sec_conshdlr->setShrinkSupportGraph(shrink);
+        EXPECT_EQ(sec_conshdlr->isShrinkingSupportGraph(), shrink);
+        SCIPsolve(scip);
+        EXPECT_EQ(SCIPgetStatus(scip), SCIP_STATUS_OPTIMAL);
+        if (!shrink) EXPECT_EQ(sec_conshdlr->getNumMergedVertices(), 0);
+        optimal_costs.push_back(SCIPgetPrimalbound(scip));
+        SCIPfree(&scip);
+    }
+    EXPECT_DOUBLE_EQ(optimal_costs[0], optimal_costs[1]);
+}
+
+TEST(TestSubtourElimination, testShrinkSupportGraphMergesVertices) {
+    // the edge of the root triangle away from the root has value one between two vertices with value one
+    int num_vertices = 12;
+    PCTSPgraph graph;
+    EdgeCostMap cost_map;
+    VertexPrizeMap prize_map;
+    buildTrianglesInstance(graph, cost_map, prize_map, num_vertices);
+    PrizeNumberType quota = num_vertices - 1;
+    PCTSPvertex root_vertex = 0;
+    std::vector<PCTSPedge> heuristic_edges;
+    std::string name = "test-shrink-support-graph-merges";
+    SCIP* scip = NULL;
+    SCIPcreate(&scip);
+    modelPrizeCollectingTSP(scip, graph, heuristic_edges, cost_map, prize_map, quota, root_vertex, name);
+    auto sec_conshdlr = dynamic_cast<PCTSPconshdlrSubtour*>(SCIPfindObjConshdlr(scip, SEC_CONSHDLR_NAME.c_str()));
+    sec_conshdlr->setShrinkSupportGraph(true);
+    SCIPsolve(scip);
+    EXPECT_EQ(SCIPgetStatus(scip), SCIP_STATUS_OPTIMAL);
+    EXPECT_GT(sec_conshdlr->getNumMergedVertices(), 0);
+    SCIPfree(&scip);
+}
+
 TEST(TestBeingDump, testAmIDump) {
     std::vector<std::list<double>> v (5);
     v[4].push_back(0.1);
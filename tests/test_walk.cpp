@@ -115,6 +115,25 @@ TEST_P(WalkFixture, testGetEdgeVector) {
     }
 }
 
+TEST_P(WalkFixture, testTourFromCycleEdges) {
+    auto graph = getGraph();
+    std::list<PCTSPvertex> tour = {2, 0, 1, 3, 2};
+    auto first = tour.begin();
+    auto last = tour.end();
+    auto edges = getEdgesInWalk(graph, first, last);
+    PCTSPvertex root_vertex = 0;
+    auto root_tour = tourFromCycleEdges(graph, edges, root_vertex);
+    EXPECT_EQ(root_tour.size(), tour.size());
+    EXPECT_EQ(root_tour.front(), root_vertex);
+    EXPECT_EQ(root_tour.back(), root_vertex);
+    auto cost_map = getCostMap(graph);
+    EXPECT_EQ(totalCost(graph, root_tour, cost_map), totalCost(edges, cost_map));
+
+    // a path is not a cycle
+    edges.pop_back();
+    EXPECT_EQ(tourFromCycleEdges(graph, edges, root_vertex).size(), 0);
+}
+
 TEST_P(SuurballeGraphFixture, testShortestPathBlacklist) {
     auto graph = getGraph();
     auto cost_map = getCostMap(graph);